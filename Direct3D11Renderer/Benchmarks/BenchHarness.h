@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Minimal self-registering benchmark harness, the counterpart of Tests/TestHarness.h.
+//
+// BENCHMARK("name") { BenchHarness::Measure("label", items, [&]() { ... }); } in any linked
+// translation unit, Main.cpp runs them all. Measure repeats the body until it has run for long
+// enough to time reliably and prints the time per call and per item.
+namespace BenchHarness
+{
+	struct Case
+	{
+		const char* name;
+		std::function<void()> body;
+	};
+
+	inline std::vector<Case>& Registry()
+	{
+		static std::vector<Case> cases;
+		return cases;
+	}
+
+	struct Registrar
+	{
+		Registrar(const char* name, std::function<void()> body)
+		{
+			Registry().push_back({ name, std::move(body) });
+		}
+	};
+
+	// keeps the compiler from dropping a result nothing else reads
+	template<typename T>
+	inline void DoNotOptimize(T value)
+	{
+		static_assert(std::is_scalar_v<T>, "Pass a number or pointer derived from the result");
+		[[maybe_unused]] static volatile T sink;
+		sink = value;
+	}
+
+	inline double& MinimumSeconds()
+	{
+		static double seconds = 0.25;
+		return seconds;
+	}
+
+	// body is one call covering itemsPerCall items (vertices, lookups, ...), returns nanoseconds per item
+	template<typename F>
+	double Measure(const char* label, size_t itemsPerCall, F&& body)
+	{
+		using Clock = std::chrono::steady_clock;
+		// one untimed call for caches and lazy initialization
+		body();
+		size_t calls = 1u;
+		double seconds = 0.0;
+		while (true)
+		{
+			const auto start = Clock::now();
+			for (size_t i = 0; i < calls; i++)
+			{
+				body();
+			}
+			seconds = std::chrono::duration<double>(Clock::now() - start).count();
+			if (seconds >= MinimumSeconds() || calls >= (size_t(1u) << 30u))
+			{
+				break;
+			}
+			calls *= 2u;
+		}
+		const double nsPerCall = seconds * 1e9 / static_cast<double>(calls);
+		const double nsPerItem = nsPerCall / static_cast<double>(itemsPerCall);
+		std::printf("  %-48s %12.1f ns/call %10.2f ns/item\n", label, nsPerCall, nsPerItem);
+		return nsPerItem;
+	}
+
+	// filter is a substring of the case names to run, empty runs everything
+	inline void RunAll(const std::string& filter)
+	{
+		for (const auto& benchCase : Registry())
+		{
+			if (!filter.empty() && std::string(benchCase.name).find(filter) == std::string::npos)
+			{
+				continue;
+			}
+			std::printf("%s\n", benchCase.name);
+			benchCase.body();
+		}
+	}
+}
+
+#define BENCH_HARNESS_CONCAT_IMPL(a, b) a##b
+#define BENCH_HARNESS_CONCAT(a, b) BENCH_HARNESS_CONCAT_IMPL(a, b)
+#define BENCHMARK_IMPL(name, fn) \
+	static void fn(); \
+	static const BenchHarness::Registrar BENCH_HARNESS_CONCAT(fn, _registrar){ name, &fn }; \
+	static void fn()
+#define BENCHMARK(name) BENCHMARK_IMPL(name, BENCH_HARNESS_CONCAT(Benchmark_, __LINE__))
@@ -0,0 +1,83 @@
+#include "BenchHarness.h"
+#include "TestGraphics.h"
+#include "Bindable/BindableCache.h"
+#include "Bindable/Stencil.h"
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+	// stand-in with Texture's key shape (a path and a slot) that needs no file on disk
+	class PathBindable : public Bindable
+	{
+	public:
+		PathBindable(Graphics&, const std::string&, UINT)
+		{}
+		void Bind(Graphics&) noexcept override
+		{}
+		static std::string GenerateUID(const std::string& path, UINT slot)
+		{
+			return typeid(PathBindable).name() + std::string("#") + path + "#" + std::to_string(slot);
+		}
+		static uint64_t GenerateKey(const std::string& path, UINT slot) noexcept
+		{
+			return BindableKey::Of<PathBindable>().Add(path).Add(slot).Get();
+		}
+	};
+
+	// the lookup Resolve did before structural keys: spell out the UID string on every call, then
+	// hash it again in a string keyed map under a shared lock
+	class StringKeyedCache
+	{
+	public:
+		template<typename T, typename... Args>
+		std::shared_ptr<T> Resolve(Graphics& gfx, Args&&... args)
+		{
+			const std::string uid = T::GenerateUID(args...);
+			{
+				std::shared_lock lock(mutex);
+				auto it = entries.find(uid);
+				if (it != entries.end())
+				{
+					return std::static_pointer_cast<T>(it->second);
+				}
+			}
+			auto pBindable = std::make_shared<T>(gfx, std::forward<Args>(args)...);
+			std::unique_lock lock(mutex);
+			entries.emplace(uid, pBindable);
+			return pBindable;
+		}
+	private:
+		std::shared_mutex mutex;
+		std::unordered_map<std::string, std::shared_ptr<Bindable>> entries;
+	};
+}
+
+BENCHMARK("BindableCache hit path, string UIDs (before) vs structural keys (after)")
+{
+	auto& gfx = TestHarness::GetGraphics();
+	StringKeyedCache stringCache;
+
+	// what FrameManager resolves every frame
+	BenchHarness::Measure("Stencil, string UID", 1u, [&]()
+		{
+			BenchHarness::DoNotOptimize(stringCache.Resolve<Stencil>(gfx, Stencil::Mode::Mask).get());
+		});
+	BenchHarness::Measure("Stencil, BindableCache::Resolve", 1u, [&]()
+		{
+			BenchHarness::DoNotOptimize(BindableCache::Resolve<Stencil>(gfx, Stencil::Mode::Mask).get());
+		});
+
+	// a typical texture path, long enough that the UID no longer fits the small string buffer
+	const std::string path = "assets\\models\\nano_textured\\textures\\arm_dif.png";
+	BenchHarness::Measure("Texture-like path, string UID", 1u, [&]()
+		{
+			BenchHarness::DoNotOptimize(stringCache.Resolve<PathBindable>(gfx, path, 0u).get());
+		});
+	BenchHarness::Measure("Texture-like path, BindableCache::Resolve", 1u, [&]()
+		{
+			BenchHarness::DoNotOptimize(BindableCache::Resolve<PathBindable>(gfx, path, 0u).get());
+		});
+}
@@ -0,0 +1,87 @@
+#include "BenchHarness.h"
+#include "Camera/Frustum.h"
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+namespace
+{
+	// the straightforward test the SIMD kernel replaces: all eight corners against each plane in turn
+	bool IntersectsByCorners(const XMVECTOR (&planes)[6], const AABB& box) noexcept
+	{
+		for (const auto& plane : planes)
+		{
+			bool anyInside = false;
+			for (int corner = 0; corner < 8 && !anyInside; corner++)
+			{
+				const auto point = XMVectorSet(
+					(corner & 1) ? box.max.x : box.min.x,
+					(corner & 2) ? box.max.y : box.min.y,
+					(corner & 4) ? box.max.z : box.min.z, 1.0f);
+				anyInside = XMVectorGetX(XMVector4Dot(point, plane)) >= 0.0f;
+			}
+			if (!anyInside)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+BENCHMARK("Frustum culling of mesh bounds")
+{
+	const auto viewProjection = XMMatrixPerspectiveFovLH(XM_PIDIV2, 16.0f / 9.0f, 0.5f, 500.0f);
+	const auto frustum = Frustum::FromViewProjection(viewProjection);
+	const auto m = XMMatrixTranspose(viewProjection);
+	const XMVECTOR planes[6] = {
+		XMVectorAdd(m.r[3], m.r[0]), XMVectorSubtract(m.r[3], m.r[0]),
+		XMVectorAdd(m.r[3], m.r[1]), XMVectorSubtract(m.r[3], m.r[1]),
+		m.r[2], XMVectorSubtract(m.r[3], m.r[2]) };
+
+	// boxes scattered all around the camera, about a third of them in view
+	std::mt19937 rng{ 3u };
+	std::uniform_real_distribution<float> position{ -300.0f, 300.0f };
+	std::uniform_real_distribution<float> size{ 0.5f, 5.0f };
+	std::vector<AABB> boxes(100000u);
+	for (auto& box : boxes)
+	{
+		const XMFLOAT3 center{ position(rng), position(rng) * 0.2f, position(rng) };
+		const float halfSize = size(rng);
+		box.Merge(XMFLOAT3{ center.x - halfSize, center.y - halfSize, center.z - halfSize });
+		box.Merge(XMFLOAT3{ center.x + halfSize, center.y + halfSize, center.z + halfSize });
+	}
+	const auto world = XMMatrixRotationRollPitchYaw(0.0f, 0.3f, 0.0f) * XMMatrixTranslation(0.0f, 0.0f, 10.0f);
+
+	size_t visible = 0u;
+	BenchHarness::Measure("8 corners x 6 planes (reference)", boxes.size(), [&]()
+		{
+			visible = 0u;
+			for (const auto& box : boxes)
+			{
+				visible += IntersectsByCorners(planes, box);
+			}
+			BenchHarness::DoNotOptimize(visible);
+		});
+	BenchHarness::Measure("Frustum::Intersects", boxes.size(), [&]()
+		{
+			visible = 0u;
+			for (const auto& box : boxes)
+			{
+				visible += frustum.Intersects(box);
+			}
+			BenchHarness::DoNotOptimize(visible);
+		});
+	std::printf("  %zu of %zu boxes in view\n", visible, boxes.size());
+	// what Node::Submit does per mesh: bring the bounds into world space, then test them
+	BenchHarness::Measure("AABB::Transformed + Frustum::Intersects", boxes.size(), [&]()
+		{
+			visible = 0u;
+			for (const auto& box : boxes)
+			{
+				visible += frustum.Intersects(box.Transformed(world));
+			}
+			BenchHarness::DoNotOptimize(visible);
+		});
+}
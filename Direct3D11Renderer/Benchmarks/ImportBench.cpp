@@ -0,0 +1,149 @@
+#include "BenchHarness.h"
+#include "Geometry/Vertex.h"
+#include <Importer.hpp>
+#include <postprocess.h>
+#include <scene.h>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace DirectX;
+using Type = D3::VertexLayout::ElementType;
+
+namespace
+{
+	// the float layout normal mapped materials import with
+	D3::VertexLayout MakeLayout()
+	{
+		D3::VertexLayout layout;
+		layout.Append(Type::Position3D).Append(Type::Normal).Append(Type::Tangent).Append(Type::Bitangent).Append(Type::Texture2D);
+		return layout;
+	}
+
+	bool HasLayoutSources(const aiMesh& mesh) noexcept
+	{
+		return mesh.HasNormals() && mesh.HasTangentsAndBitangents() && mesh.HasTextureCoords(0);
+	}
+
+	template<Type T>
+	auto& AttrByScan(char* pVertex, const D3::VertexLayout& layout)
+	{
+		return *reinterpret_cast<typename D3::VertexLayout::Map<T>::SysType*>(pVertex + layout.Resolve<T>().GetOffset());
+	}
+
+	// how VertexBuffer(layout, mesh) filled a buffer before the bulk path: one vertex proxy and one
+	// linear layout scan per vertex per attribute
+	D3::VertexBuffer FillPerVertex(const aiMesh& mesh)
+	{
+		D3::VertexBuffer buffer{ MakeLayout(), mesh.mNumVertices };
+		const auto& layout = buffer.GetLayout();
+		const size_t stride = layout.Size();
+		char* const pFirst = reinterpret_cast<char*>(&buffer.View<Type::Position3D>()[0]) - layout.GetOffset<Type::Position3D>();
+		const auto asFloat3 = [](const aiVector3D& v) { return XMFLOAT3{ v.x, v.y, v.z }; };
+		for (size_t i = 0; i < mesh.mNumVertices; i++)
+		{
+			char* const pVertex = pFirst + stride * i;
+			AttrByScan<Type::Position3D>(pVertex, layout) = asFloat3(mesh.mVertices[i]);
+			AttrByScan<Type::Normal>(pVertex, layout) = asFloat3(mesh.mNormals[i]);
+			AttrByScan<Type::Tangent>(pVertex, layout) = asFloat3(mesh.mTangents[i]);
+			AttrByScan<Type::Bitangent>(pVertex, layout) = asFloat3(mesh.mBitangents[i]);
+			AttrByScan<Type::Texture2D>(pVertex, layout) = { mesh.mTextureCoords[0][i].x, mesh.mTextureCoords[0][i].y };
+		}
+		return buffer;
+	}
+
+	// times both fill paths over every mesh the layout can be filled from
+	void MeasureFill(const std::vector<const aiMesh*>& meshes)
+	{
+		size_t vertexCount = 0u;
+		for (const auto* pMesh : meshes)
+		{
+			vertexCount += pMesh->mNumVertices;
+		}
+		// both paths allocate and zero the buffer first, which dominates for large meshes
+		BenchHarness::Measure("allocation only (baseline)", vertexCount, [&]()
+			{
+				for (const auto* pMesh : meshes)
+				{
+					BenchHarness::DoNotOptimize(D3::VertexBuffer{ MakeLayout(), pMesh->mNumVertices }.Size());
+				}
+			});
+		BenchHarness::Measure("per vertex Attr fill (before)", vertexCount, [&]()
+			{
+				for (const auto* pMesh : meshes)
+				{
+					BenchHarness::DoNotOptimize(FillPerVertex(*pMesh).Size());
+				}
+			});
+		BenchHarness::Measure("VertexBuffer(layout, mesh)", vertexCount, [&]()
+			{
+				for (const auto* pMesh : meshes)
+				{
+					BenchHarness::DoNotOptimize(D3::VertexBuffer{ MakeLayout(), *pMesh }.Size());
+				}
+			});
+	}
+}
+
+BENCHMARK("Model import, Assimp and vertex buffer fill")
+{
+	// Sponza ships only its materials and textures, it is timed whenever sponza.obj is added
+	const std::filesystem::path models = std::filesystem::path(RENDERER_SOURCE_DIR) / "assets" / "models";
+	for (const auto& path : { models / "Sponza" / "sponza.obj", models / "nano_textured" / "nanosuit.obj", models / "brick_wall" / "brick_wall.obj" })
+	{
+		std::printf(" %s\n", path.filename().string().c_str());
+		if (!std::filesystem::exists(path))
+		{
+			std::printf("  not in assets, skipped\n");
+			continue;
+		}
+
+		// the flags Model imports with
+		constexpr unsigned int flags = aiProcess_Triangulate | aiProcess_ConvertToLeftHanded | aiProcess_GenNormals |
+			aiProcess_JoinIdenticalVertices | aiProcess_CalcTangentSpace;
+		Assimp::Importer importer;
+		BenchHarness::Measure("Assimp::Importer::ReadFile", 1u, [&]()
+			{
+				BenchHarness::DoNotOptimize(importer.ReadFile(path.string(), flags));
+			});
+		const aiScene* pScene = importer.ReadFile(path.string(), flags);
+		if (pScene == nullptr)
+		{
+			std::printf("  %s\n", importer.GetErrorString());
+			continue;
+		}
+
+		std::vector<const aiMesh*> meshes;
+		for (unsigned int i = 0; i < pScene->mNumMeshes; i++)
+		{
+			if (HasLayoutSources(*pScene->mMeshes[i]))
+			{
+				meshes.push_back(pScene->mMeshes[i]);
+			}
+		}
+		std::printf("  %zu of %u meshes have every attribute of the layout\n", meshes.size(), pScene->mNumMeshes);
+		MeasureFill(meshes);
+	}
+
+	// the imported meshes are all below ParallelImportThreshold, this one takes the parallel path
+	std::printf(" generated mesh, 1M vertices\n");
+	constexpr unsigned int largeVertexCount = 1000000u;
+	aiMesh large;
+	large.mNumVertices = largeVertexCount;
+	large.mVertices = new aiVector3D[largeVertexCount];
+	large.mNormals = new aiVector3D[largeVertexCount];
+	large.mTangents = new aiVector3D[largeVertexCount];
+	large.mBitangents = new aiVector3D[largeVertexCount];
+	large.mTextureCoords[0] = new aiVector3D[largeVertexCount];
+	large.mNumUVComponents[0] = 2u;
+	for (unsigned int i = 0; i < largeVertexCount; i++)
+	{
+		large.mVertices[i] = { float(i % 1000u), float(i / 1000u), 0.0f };
+		large.mNormals[i] = { 0.0f, 0.0f, -1.0f };
+		large.mTangents[i] = { 1.0f, 0.0f, 0.0f };
+		large.mBitangents[i] = { 0.0f, 1.0f, 0.0f };
+		large.mTextureCoords[0][i] = { float(i % 1000u) / 1000.0f, float(i / 1000u) / 1000.0f, 0.0f };
+	}
+	MeasureFill({ &large });
+}
@@ -0,0 +1,100 @@
+#include "BenchHarness.h"
+#include "DynamicConstantBuffer/DynamicConstantBuffer.h"
+#include "DynamicConstantBuffer/LayoutCache.h"
+#include <string>
+#include <unordered_map>
+
+using D3::ElementType;
+
+namespace
+{
+	// what a material declares for the BlinnPhong_Diffuse_PS cbuffer
+	D3::LayoutBuilder MakeFlatLayout()
+	{
+		D3::LayoutBuilder builder;
+		builder.Add<ElementType::Float>("specularReflectance");
+		builder.Add<ElementType::Float>("specularShininess");
+		builder.Add<ElementType::Float2>("materialPadding");
+		return builder;
+	}
+
+	// four levels deep: an array of lights, each with a struct holding an array of cascade structs
+	D3::LayoutBuilder MakeDeepLayout()
+	{
+		D3::LayoutBuilder builder;
+		builder.Add<ElementType::Matrix4x4>("viewProjection");
+		builder.Add<ElementType::Array>("lights");
+		builder["lights"].SetArrayType(ElementType::Struct, 16u);
+		auto& light = builder["lights"].GetArrayElementType();
+		light.AddMember(ElementType::Float3, "color");
+		light.AddMember(ElementType::Float, "intensity");
+		light.AddMember(ElementType::Struct, "shadow");
+		light["shadow"].AddMember(ElementType::Matrix4x4, "transform");
+		light["shadow"].AddMember(ElementType::Array, "cascades");
+		light["shadow"]["cascades"].SetArrayType(ElementType::Struct, 4u);
+		auto& cascade = light["shadow"]["cascades"].GetArrayElementType();
+		cascade.AddMember(ElementType::Float, "split");
+		cascade.AddMember(ElementType::Float2, "bias");
+		cascade.AddMember(ElementType::Bool, "enabled");
+		builder.Add<ElementType::Struct>("fog");
+		builder["fog"].AddMember(ElementType::Float3, "color");
+		builder["fog"].AddMember(ElementType::Float, "density");
+		return builder;
+	}
+
+	// the lookup Resolve did before structural hashes: spell out the signature string, then find it
+	// in a string keyed map
+	class SignatureKeyedCache
+	{
+	public:
+		const D3::FinalizedLayout& Resolve(D3::LayoutBuilder&& builder)
+		{
+			auto signature = builder.GetSignature();
+			auto it = layouts.find(signature);
+			if (it == layouts.end())
+			{
+				it = layouts.emplace(std::move(signature), D3::LayoutCache::Resolve(std::move(builder))).first;
+			}
+			return it->second;
+		}
+	private:
+		std::unordered_map<std::string, D3::FinalizedLayout> layouts;
+	};
+
+	template<typename MakeLayout>
+	void MeasureLayout(MakeLayout makeLayout)
+	{
+		const auto builder = makeLayout();
+		std::printf("  %zu bytes, %zu character signature\n",
+			D3::LayoutCache::Resolve(makeLayout()).GetSizeInBytes(), builder.GetSignature().size());
+		// the key alone, on a builder so the hash is not the cached one of a finalized layout
+		BenchHarness::Measure("GetSignature", 1u, [&]()
+			{
+				BenchHarness::DoNotOptimize(builder.GetSignature().size());
+			});
+		BenchHarness::Measure("GetHash", 1u, [&]()
+			{
+				BenchHarness::DoNotOptimize(builder.GetHash());
+			});
+
+		// what a material pays per Resolve, building the description included; both caches are warm
+		// after Measure's untimed first call, so these time the hit path
+		SignatureKeyedCache signatureCache;
+		BenchHarness::Measure("build + signature keyed lookup", 1u, [&]()
+			{
+				BenchHarness::DoNotOptimize(signatureCache.Resolve(makeLayout()).GetRoot().get());
+			});
+		BenchHarness::Measure("build + LayoutCache::Resolve", 1u, [&]()
+			{
+				BenchHarness::DoNotOptimize(D3::LayoutCache::Resolve(makeLayout()).GetRoot().get());
+			});
+	}
+}
+
+BENCHMARK("LayoutCache hits, signature strings (before) vs structural hashes (after)")
+{
+	std::printf(" flat material layout\n");
+	MeasureLayout(MakeFlatLayout);
+	std::printf(" nested struct / array layout\n");
+	MeasureLayout(MakeDeepLayout);
+}
@@ -0,0 +1,23 @@
+#include "BenchHarness.h"
+#include <cstdlib>
+#include <cstring>
+
+// usage: RendererBench [name filter] [--quick]
+// --quick runs every body only briefly, to check the benchmarks still work rather than to time them
+int main(int argc, char** argv)
+{
+	std::string filter;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--quick") == 0)
+		{
+			BenchHarness::MinimumSeconds() = 0.0;
+		}
+		else
+		{
+			filter = argv[i];
+		}
+	}
+	BenchHarness::RunAll(filter);
+	return EXIT_SUCCESS;
+}
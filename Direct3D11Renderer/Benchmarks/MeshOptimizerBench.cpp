@@ -0,0 +1,224 @@
+#include "BenchHarness.h"
+#include "Geometry/MeshOptimizer.h"
+#include <Importer.hpp>
+#include <postprocess.h>
+#include <scene.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+using Type = D3::VertexLayout::ElementType;
+namespace MeshOptimizer = D3::MeshOptimizer;
+
+namespace
+{
+	struct Mesh
+	{
+		D3::VertexBuffer vertices;
+		std::vector<unsigned int> indices;
+	};
+
+	D3::VertexLayout MakeLayout()
+	{
+		D3::VertexLayout layout;
+		layout.Append(Type::Position3D).Append(Type::Normal).Append(Type::Texture2D);
+		return layout;
+	}
+
+	// a bumpy size x size grid with its triangles and vertices shuffled, the worst case an exporter
+	// can hand over
+	Mesh MakeShuffledGrid(unsigned int size)
+	{
+		Mesh mesh{ D3::VertexBuffer{ MakeLayout(), size_t(size + 1u) * (size + 1u) }, {} };
+		auto positions = mesh.vertices.View<Type::Position3D>();
+		auto normals = mesh.vertices.View<Type::Normal>();
+		auto texcoords = mesh.vertices.View<Type::Texture2D>();
+		for (unsigned int y = 0; y <= size; y++)
+		{
+			for (unsigned int x = 0; x <= size; x++)
+			{
+				const size_t i = size_t(y) * (size + 1u) + x;
+				const float u = float(x) / size;
+				const float v = float(y) / size;
+				positions[i] = { u, std::sin(u * 20.0f) * std::cos(v * 20.0f) * 0.05f, v };
+				normals[i] = { 0.0f, 1.0f, 0.0f };
+				texcoords[i] = { u, v };
+			}
+		}
+		std::vector<std::array<unsigned int, 3>> triangles;
+		for (unsigned int y = 0; y < size; y++)
+		{
+			for (unsigned int x = 0; x < size; x++)
+			{
+				const unsigned int i = y * (size + 1u) + x;
+				triangles.push_back({ i, i + size + 1u, i + 1u });
+				triangles.push_back({ i + 1u, i + size + 1u, i + size + 2u });
+			}
+		}
+		std::mt19937 rng{ 11u };
+		std::shuffle(triangles.begin(), triangles.end(), rng);
+		std::vector<unsigned int> order(mesh.vertices.Size());
+		std::iota(order.begin(), order.end(), 0u);
+		std::shuffle(order.begin(), order.end(), rng);
+		std::vector<unsigned int> newIndex(order.size());
+		for (unsigned int i = 0; i < order.size(); i++)
+		{
+			newIndex[order[i]] = i;
+		}
+		mesh.vertices.Remap(order);
+		for (const auto& triangle : triangles)
+		{
+			for (const auto index : triangle)
+			{
+				mesh.indices.push_back(newIndex[index]);
+			}
+		}
+		return mesh;
+	}
+
+	void PrintMetrics(const char* label, const MeshOptimizer::Metrics& metrics)
+	{
+		std::printf("  %-12s %8zu triangles %8zu vertices  ACMR %.3f  ATVR %.3f  overdraw %.3f\n",
+			label, metrics.triangleCount, metrics.vertexCount, metrics.acmr, metrics.atvr, metrics.overdraw);
+	}
+
+	void PrintReport(const MeshOptimizer::Report& report)
+	{
+		PrintMetrics("before", report.before);
+		PrintMetrics("after", report.after);
+		std::printf("  %zu vertices welded, %zu clusters\n", report.weldedVertices, report.clusterCount);
+	}
+
+	// Optimize works in place, so every call starts from a copy; the copy alone is timed as well
+	void MeasureOptimize(const Mesh& source, size_t triangleCount)
+	{
+		BenchHarness::Measure("copy only (baseline)", triangleCount, [&]()
+			{
+				Mesh mesh = source;
+				BenchHarness::DoNotOptimize(mesh.indices.data());
+			});
+		BenchHarness::Measure("Optimize", triangleCount, [&]()
+			{
+				Mesh mesh = source;
+				BenchHarness::DoNotOptimize(MeshOptimizer::Optimize(mesh.vertices, mesh.indices).clusterCount);
+			});
+	}
+}
+
+BENCHMARK("MeshOptimizer on a shuffled grid")
+{
+	constexpr unsigned int gridSize = 256u;
+	const auto source = MakeShuffledGrid(gridSize);
+	const size_t triangleCount = source.indices.size() / 3u;
+	MeshOptimizer::Settings settings;
+
+	{
+		Mesh mesh = source;
+		settings.measureMetrics = true;
+		PrintReport(MeshOptimizer::Optimize(mesh.vertices, mesh.indices, settings));
+		settings.measureMetrics = false;
+	}
+	MeasureOptimize(source, triangleCount);
+
+	// the steps on their own, each fed what the previous one produced
+	std::vector<size_t> clusters;
+	std::vector<unsigned int> cacheOrdered;
+	BenchHarness::Measure("OptimizeVertexCache", triangleCount, [&]()
+		{
+			cacheOrdered = MeshOptimizer::OptimizeVertexCache(source.indices, source.vertices.Size(), settings.cacheSize, &clusters);
+			BenchHarness::DoNotOptimize(cacheOrdered.data());
+		});
+	const auto positions = MeshOptimizer::ExtractPositions(source.vertices);
+	std::vector<unsigned int> overdrawOrdered;
+	BenchHarness::Measure("OptimizeOverdraw", triangleCount, [&]()
+		{
+			overdrawOrdered = MeshOptimizer::OptimizeOverdraw(cacheOrdered, positions, clusters, settings.cacheSize, settings.overdrawThreshold);
+			BenchHarness::DoNotOptimize(overdrawOrdered.data());
+		});
+	BenchHarness::Measure("OptimizeVertexFetch", triangleCount, [&]()
+		{
+			auto indices = overdrawOrdered;
+			BenchHarness::DoNotOptimize(MeshOptimizer::OptimizeVertexFetch(indices, source.vertices.Size()).data());
+		});
+	BenchHarness::Measure("Analyze, run before and after with measureMetrics", triangleCount, [&]()
+		{
+			BenchHarness::DoNotOptimize(MeshOptimizer::Analyze(source.indices, positions, settings.cacheSize).acmr);
+		});
+}
+
+BENCHMARK("MeshOptimizer on imported models")
+{
+	const std::filesystem::path models = std::filesystem::path(RENDERER_SOURCE_DIR) / "assets" / "models";
+	for (const auto& path : { models / "nano_textured" / "nanosuit.obj", models / "brick_wall" / "brick_wall.obj" })
+	{
+		std::printf(" %s\n", path.filename().string().c_str());
+		Assimp::Importer importer;
+		// the flags Model imports with
+		const aiScene* pScene = importer.ReadFile(path.string(), aiProcess_Triangulate | aiProcess_ConvertToLeftHanded |
+			aiProcess_GenNormals | aiProcess_JoinIdenticalVertices | aiProcess_CalcTangentSpace);
+		if (pScene == nullptr)
+		{
+			std::printf("  %s\n", importer.GetErrorString());
+			continue;
+		}
+
+		// the whole model as one report, summed over its meshes
+		std::vector<Mesh> meshes;
+		MeshOptimizer::Report total;
+		size_t triangleCount = 0u;
+		const auto accumulate = [](MeshOptimizer::Metrics& sum, const MeshOptimizer::Metrics& metrics)
+		{
+			// ACMR and ATVR are per triangle and per vertex, overdraw is weighted by triangles as an estimate
+			sum.acmr += metrics.acmr * float(metrics.triangleCount);
+			sum.atvr += metrics.atvr * float(metrics.vertexCount);
+			sum.overdraw += metrics.overdraw * float(metrics.triangleCount);
+			sum.triangleCount += metrics.triangleCount;
+			sum.vertexCount += metrics.vertexCount;
+		};
+		for (unsigned int i = 0; i < pScene->mNumMeshes; i++)
+		{
+			const auto& imported = *pScene->mMeshes[i];
+			if (!imported.HasNormals() || !imported.HasTextureCoords(0))
+			{
+				continue;
+			}
+			Mesh mesh{ D3::VertexBuffer{ MakeLayout(), imported }, {} };
+			for (unsigned int face = 0; face < imported.mNumFaces; face++)
+			{
+				mesh.indices.insert(mesh.indices.end(), imported.mFaces[face].mIndices, imported.mFaces[face].mIndices + 3u);
+			}
+			triangleCount += imported.mNumFaces;
+
+			Mesh optimized = mesh;
+			MeshOptimizer::Settings settings;
+			settings.measureMetrics = true;
+			const auto report = MeshOptimizer::Optimize(optimized.vertices, optimized.indices, settings);
+			accumulate(total.before, report.before);
+			accumulate(total.after, report.after);
+			total.weldedVertices += report.weldedVertices;
+			total.clusterCount += report.clusterCount;
+			meshes.push_back(std::move(mesh));
+		}
+		for (auto* pMetrics : { &total.before, &total.after })
+		{
+			pMetrics->acmr /= float(std::max<size_t>(pMetrics->triangleCount, 1u));
+			pMetrics->atvr /= float(std::max<size_t>(pMetrics->vertexCount, 1u));
+			pMetrics->overdraw /= float(std::max<size_t>(pMetrics->triangleCount, 1u));
+		}
+		PrintReport(total);
+
+		BenchHarness::Measure("Optimize, every mesh", triangleCount, [&]()
+			{
+				for (const auto& source : meshes)
+				{
+					Mesh mesh = source;
+					BenchHarness::DoNotOptimize(MeshOptimizer::Optimize(mesh.vertices, mesh.indices).clusterCount);
+				}
+			});
+	}
+}
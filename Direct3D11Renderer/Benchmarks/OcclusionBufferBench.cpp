@@ -0,0 +1,84 @@
+#include "BenchHarness.h"
+#include "Camera/OcclusionBuffer.h"
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+namespace
+{
+	// a wall of size x size quads facing the camera, tessellated like an imported mesh would be
+	OcclusionBuffer::OccluderMesh MakeGrid(unsigned int size)
+	{
+		OcclusionBuffer::OccluderMesh grid;
+		for (unsigned int y = 0; y <= size; y++)
+		{
+			for (unsigned int x = 0; x <= size; x++)
+			{
+				grid.positions.push_back({ float(x) / size - 0.5f, float(y) / size - 0.5f, 0.0f });
+			}
+		}
+		for (unsigned int y = 0; y < size; y++)
+		{
+			for (unsigned int x = 0; x < size; x++)
+			{
+				const unsigned int i = y * (size + 1u) + x;
+				grid.indices.insert(grid.indices.end(), { i, i + 1u, i + size + 2u, i, i + size + 2u, i + size + 1u });
+			}
+		}
+		return grid;
+	}
+}
+
+BENCHMARK("OcclusionBuffer rasterization and box tests")
+{
+	const auto viewProjection = XMMatrixPerspectiveFovLH(XM_PIDIV2, 16.0f / 9.0f, 0.5f, 500.0f);
+	std::mt19937 rng{ 7u };
+	std::uniform_real_distribution<float> spread{ -40.0f, 40.0f };
+	std::uniform_real_distribution<float> distance{ 10.0f, 200.0f };
+
+	// 64 walls of 512 triangles scattered through the view, like the larger meshes of an interior
+	const auto wall = MakeGrid(16u);
+	std::vector<XMFLOAT4X4> walls(64u);
+	for (auto& world : walls)
+	{
+		XMStoreFloat4x4(&world, XMMatrixScaling(20.0f, 10.0f, 1.0f) *
+			XMMatrixTranslation(spread(rng), spread(rng) * 0.25f, distance(rng)));
+	}
+	std::vector<AABB> boxes(4096u);
+	for (auto& box : boxes)
+	{
+		const XMFLOAT3 center{ spread(rng), spread(rng) * 0.25f, distance(rng) };
+		box.Merge(XMFLOAT3{ center.x - 1.0f, center.y - 1.0f, center.z - 1.0f });
+		box.Merge(XMFLOAT3{ center.x + 1.0f, center.y + 1.0f, center.z + 1.0f });
+	}
+
+	OcclusionBuffer buffer;
+	const auto drawOccluders = [&]()
+	{
+		buffer.BeginFrame(viewProjection);
+		for (const auto& world : walls)
+		{
+			buffer.AddOccluder(wall, XMLoadFloat4x4(&world));
+		}
+		buffer.Rasterize();
+	};
+	BenchHarness::Measure("64 occluders, 32768 triangles (per triangle)", walls.size() * wall.indices.size() / 3u, [&]()
+		{
+			drawOccluders();
+			BenchHarness::DoNotOptimize(buffer.GetDepth()[0]);
+		});
+
+	drawOccluders();
+	size_t rejected = 0u;
+	BenchHarness::Measure("IsVisible on 4096 boxes (per box)", boxes.size(), [&]()
+		{
+			rejected = 0u;
+			for (const auto& box : boxes)
+			{
+				rejected += !buffer.IsVisible(box);
+			}
+			BenchHarness::DoNotOptimize(rejected);
+		});
+	std::printf("  %zu of %zu boxes occluded\n", rejected, boxes.size());
+}
@@ -0,0 +1,81 @@
+#include "BenchHarness.h"
+#include "Geometry/Vertex.h"
+
+using namespace DirectX;
+using Type = D3::VertexLayout::ElementType;
+
+namespace
+{
+	constexpr size_t vertexCount = 1000000u;
+
+	// the layout a normal mapped model imports with, so the scanned attributes are not all up front
+	D3::VertexBuffer MakeBuffer()
+	{
+		D3::VertexLayout layout;
+		layout.Append(Type::Position3D).Append(Type::Normal).Append(Type::Tangent).Append(Type::Bitangent).Append(Type::Texture2D);
+		D3::VertexBuffer buffer{ std::move(layout), vertexCount };
+		auto positions = buffer.View<Type::Position3D>();
+		auto texcoords = buffer.View<Type::Texture2D>();
+		for (size_t i = 0; i < vertexCount; i++)
+		{
+			positions[i] = { float(i % 1000u), float(i / 1000u), 0.0f };
+			texcoords[i] = { float(i % 1000u) / 1000.0f, float(i / 1000u) / 1000.0f };
+		}
+		return buffer;
+	}
+
+	// how Vertex::Attr found an attribute before the offset table: a linear scan of the elements on
+	// every access
+	template<Type T>
+	auto& AttrByScan(char* pVertex, const D3::VertexLayout& layout)
+	{
+		return *reinterpret_cast<typename D3::VertexLayout::Map<T>::SysType*>(pVertex + layout.Resolve<T>().GetOffset());
+	}
+}
+
+BENCHMARK("Vertex attribute access over a million vertices")
+{
+	auto buffer = MakeBuffer();
+	const auto& layout = buffer.GetLayout();
+	const size_t stride = layout.Size();
+	char* const pFirst = reinterpret_cast<char*>(&buffer.View<Type::Position3D>()[0]) - layout.GetOffset<Type::Position3D>();
+
+	// a translate and a read of the last attribute per vertex, what IndexedTriangleList::Transform and
+	// the generators do
+	float sum = 0.0f;
+	BenchHarness::Measure("linear Resolve per access (before)", vertexCount, [&]()
+		{
+			sum = 0.0f;
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				char* const pVertex = pFirst + stride * i;
+				AttrByScan<Type::Position3D>(pVertex, layout).z += 1.0f;
+				sum += AttrByScan<Type::Texture2D>(pVertex, layout).x;
+			}
+			BenchHarness::DoNotOptimize(sum);
+		});
+	BenchHarness::Measure("Vertex proxy, offset table", vertexCount, [&]()
+		{
+			sum = 0.0f;
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				auto vertex = buffer[i];
+				vertex.Attr<Type::Position3D>().z += 1.0f;
+				sum += vertex.Attr<Type::Texture2D>().x;
+			}
+			BenchHarness::DoNotOptimize(sum);
+		});
+	// one pass like the loops above; walking each column separately would stream the buffer twice
+	BenchHarness::Measure("AttributeView", vertexCount, [&]()
+		{
+			const auto positions = buffer.View<Type::Position3D>();
+			const auto texcoords = buffer.View<Type::Texture2D>();
+			sum = 0.0f;
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				positions[i].z += 1.0f;
+				sum += texcoords[i].x;
+			}
+			BenchHarness::DoNotOptimize(sum);
+		});
+}
@@ -0,0 +1,253 @@
+#include "TestHarness.h"
+#include "TestGraphics.h"
+#include "Bindable/BindableCache.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr size_t threadCount = 8u;
+	constexpr int keyCount = 32;
+	constexpr size_t resolvesPerThread = 2000u;
+
+	// counts how often each key is built; the constructor sleeps so concurrent misses on the
+	// same key really overlap instead of one finishing before the next thread looks
+	class CountedBindable : public Bindable
+	{
+	public:
+		CountedBindable(Graphics&, int id)
+			:
+			id(id)
+		{
+			builds[id].fetch_add(1u, std::memory_order_relaxed);
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+		void Bind(Graphics&) noexcept override
+		{}
+		std::string GetUID() const noexcept override
+		{
+			return GenerateUID(id);
+		}
+		static std::string GenerateUID(int id)
+		{
+			return typeid(CountedBindable).name() + std::string("#") + std::to_string(id);
+		}
+		static uint64_t GenerateKey(int id) noexcept
+		{
+			return BindableKey::Of<CountedBindable>().Add(id).Get();
+		}
+	public:
+		const int id;
+		static std::array<std::atomic<size_t>, keyCount> builds;
+	};
+	std::array<std::atomic<size_t>, keyCount> CountedBindable::builds{};
+
+	// fails its first build, every later one succeeds
+	class FlakyBindable : public Bindable
+	{
+	public:
+		FlakyBindable(Graphics&, int id)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			if (attempts.fetch_add(1u, std::memory_order_relaxed) == 0u)
+			{
+				throw std::runtime_error("first build fails");
+			}
+		}
+		void Bind(Graphics&) noexcept override
+		{}
+		static std::string GenerateUID(int id)
+		{
+			return typeid(FlakyBindable).name() + std::string("#") + std::to_string(id);
+		}
+		static uint64_t GenerateKey(int id) noexcept
+		{
+			return BindableKey::Of<FlakyBindable>().Add(id).Get();
+		}
+	public:
+		static std::atomic<size_t> attempts;
+	};
+	std::atomic<size_t> FlakyBindable::attempts = 0u;
+
+	// charges the cache a fixed footprint, so budgets can be set in whole bindables
+	class SizedBindable : public Bindable
+	{
+	public:
+		static constexpr size_t gpuBytes = 1000u;
+		static constexpr size_t cpuBytes = 24u;
+		static constexpr size_t totalBytes = gpuBytes + cpuBytes;
+	public:
+		SizedBindable(Graphics&, int)
+		{}
+		void Bind(Graphics&) noexcept override
+		{}
+		MemoryFootprint GetMemoryFootprint() const noexcept override
+		{
+			return { gpuBytes, cpuBytes };
+		}
+		static std::string GenerateUID(int id)
+		{
+			return typeid(SizedBindable).name() + std::string("#") + std::to_string(id);
+		}
+		static uint64_t GenerateKey(int id) noexcept
+		{
+			return BindableKey::Of<SizedBindable>().Add(id).Get();
+		}
+		static bool IsResident(int id)
+		{
+			return !BindableCache::GetUID(GenerateKey(id)).empty();
+		}
+	};
+}
+
+TEST_CASE("BindableCache builds each key once when threads resolve overlapping keys")
+{
+	auto& gfx = TestHarness::GetGraphics();
+	const auto statsBefore = BindableCache::GetStats();
+
+	// every thread walks all keys from a different start, so each key is first requested by
+	// several threads at about the same time and then hit over and over
+	std::vector<std::vector<std::shared_ptr<CountedBindable>>> resolved(threadCount);
+	std::atomic<bool> go = false;
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < threadCount; t++)
+	{
+		threads.emplace_back([&, t]()
+			{
+				auto& results = resolved[t];
+				results.resize(keyCount);
+				while (!go.load(std::memory_order_acquire))
+				{
+					std::this_thread::yield();
+				}
+				for (size_t i = 0; i < resolvesPerThread; i++)
+				{
+					const int id = static_cast<int>((t * 3u + i) % keyCount);
+					auto pBindable = BindableCache::Resolve<CountedBindable>(gfx, id);
+					if (!results[id])
+					{
+						results[id] = std::move(pBindable);
+					}
+					else if (results[id] != pBindable)
+					{
+						// remembered as a null, checked below on the test thread
+						results[id] = nullptr;
+						return;
+					}
+				}
+			});
+	}
+	go.store(true, std::memory_order_release);
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (int id = 0; id < keyCount; id++)
+	{
+		CHECK(CountedBindable::builds[id].load() == 1u);
+		const auto& pFirst = resolved[0][id];
+		CHECK(pFirst && pFirst->id == id);
+		for (const auto& results : resolved)
+		{
+			CHECK(results[id] == pFirst);
+		}
+	}
+
+	const auto statsAfter = BindableCache::GetStats();
+	const size_t misses = statsAfter.misses - statsBefore.misses;
+	const size_t hits = statsAfter.hits - statsBefore.hits;
+	CHECK(misses == static_cast<size_t>(keyCount));
+	CHECK(hits + misses == threadCount * resolvesPerThread);
+}
+
+TEST_CASE("BindableCache lets a later resolve retry a build that threw")
+{
+	auto& gfx = TestHarness::GetGraphics();
+
+	// threads that waited on the failed build see its exception, none of them get a null
+	std::atomic<size_t> failures = 0u;
+	std::atomic<size_t> nulls = 0u;
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < threadCount; t++)
+	{
+		threads.emplace_back([&]()
+			{
+				try
+				{
+					if (!BindableCache::Resolve<FlakyBindable>(gfx, 7))
+					{
+						nulls.fetch_add(1u);
+					}
+				}
+				catch (const std::runtime_error&)
+				{
+					failures.fetch_add(1u);
+				}
+			});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	CHECK(failures.load() >= 1u);
+	CHECK(nulls.load() == 0u);
+
+	// the failed entry was dropped, so the next resolve builds again and is cached
+	const auto pRetried = BindableCache::Resolve<FlakyBindable>(gfx, 7);
+	CHECK(pRetried != nullptr);
+	CHECK(BindableCache::Resolve<FlakyBindable>(gfx, 7) == pRetried);
+}
+
+TEST_CASE("BindableCache trims unreferenced entries, least recently resolved first")
+{
+	auto& gfx = TestHarness::GetGraphics();
+	const auto oldBudget = BindableCache::GetBudget();
+
+	// start from a cache holding only referenced entries: with a zero budget the released bindable
+	// keeps Trim going through everything unreferenced the other tests left behind
+	BindableCache::Resolve<SizedBindable>(gfx, -1);
+	BindableCache::SetBudget(0u);
+	BindableCache::Trim();
+	CHECK(!SizedBindable::IsResident(-1));
+	const auto before = BindableCache::GetStats();
+
+	// room for three
+	BindableCache::SetBudget(before.gpuBytes + before.cpuBytes + 3u * SizedBindable::totalBytes);
+	BindableCache::Resolve<SizedBindable>(gfx, 0);
+	const auto pHeld = BindableCache::Resolve<SizedBindable>(gfx, 1);
+	BindableCache::Resolve<SizedBindable>(gfx, 2);
+	// resolving 0 again makes 2 the least recently used of the released ones
+	BindableCache::Resolve<SizedBindable>(gfx, 0);
+	auto stats = BindableCache::GetStats();
+	CHECK(stats.evictions == before.evictions);
+	CHECK(stats.gpuBytes - before.gpuBytes == 3u * SizedBindable::gpuBytes);
+	CHECK(stats.cpuBytes - before.cpuBytes == 3u * SizedBindable::cpuBytes);
+
+	// the fourth goes over budget and its miss trims the least recently resolved entry
+	const auto pNewest = BindableCache::Resolve<SizedBindable>(gfx, 3);
+	CHECK(SizedBindable::IsResident(0) && SizedBindable::IsResident(1) && !SizedBindable::IsResident(2) && SizedBindable::IsResident(3));
+	stats = BindableCache::GetStats();
+	CHECK(stats.evictions - before.evictions == 1u);
+	CHECK(stats.gpuBytes - before.gpuBytes == 3u * SizedBindable::gpuBytes);
+	CHECK(stats.cpuBytes - before.cpuBytes == 3u * SizedBindable::cpuBytes);
+	CHECK(stats.resident - before.resident == 3u);
+
+	// room for one: only 0 can go, the referenced ones stay even though the cache is over budget
+	BindableCache::SetBudget(before.gpuBytes + before.cpuBytes + SizedBindable::totalBytes);
+	BindableCache::Trim();
+	CHECK(!SizedBindable::IsResident(0) && SizedBindable::IsResident(1) && SizedBindable::IsResident(3));
+	stats = BindableCache::GetStats();
+	CHECK(stats.evictions - before.evictions == 2u);
+	CHECK(stats.gpuBytes - before.gpuBytes == 2u * SizedBindable::gpuBytes);
+	CHECK(stats.cpuBytes - before.cpuBytes == 2u * SizedBindable::cpuBytes);
+	CHECK(pHeld == BindableCache::Resolve<SizedBindable>(gfx, 1));
+
+	BindableCache::SetBudget(oldBudget);
+}
@@ -0,0 +1,112 @@
+#include "TestHarness.h"
+#include "RenderPass/DrawPacket.h"
+#include <vector>
+
+namespace
+{
+	using Stage = DrawPacket::Stage;
+
+	// the builder never dereferences what it records, so distinct addresses stand in for D3D objects
+	struct FakeObjects
+	{
+		template<typename T>
+		T* Get(size_t i) noexcept
+		{
+			return reinterpret_cast<T*>(&storage[i]);
+		}
+		void* Raw(size_t i) noexcept
+		{
+			return &storage[i];
+		}
+		unsigned char storage[64] = {};
+	};
+
+	bool RangeIs(const DrawPacket::SlotRange& range, Stage stage, uint32_t startSlot, uint32_t count, uint32_t firstObject)
+	{
+		return range.stage == stage && range.startSlot == startSlot && range.count == count && range.firstObject == firstObject;
+	}
+}
+
+TEST_CASE("DrawPacketBuilder sorts slotted objects by stage, then slot")
+{
+	FakeObjects fake;
+	DrawPacketBuilder builder;
+	builder.AddPixelSampler(0u, fake.Get<ID3D11SamplerState>(0));
+	builder.AddPixelShaderResource(2u, fake.Get<ID3D11ShaderResourceView>(1));
+	builder.AddVertexConstantBuffer(1u, fake.Get<ID3D11Buffer>(2));
+	builder.AddPixelConstantBuffer(0u, fake.Get<ID3D11Buffer>(3));
+	builder.AddVertexConstantBuffer(0u, fake.Get<ID3D11Buffer>(4));
+	builder.AddPixelShaderResource(0u, fake.Get<ID3D11ShaderResourceView>(5));
+	const auto packet = builder.Build();
+
+	const auto& ranges = packet.GetRanges();
+	CHECK(ranges.size() == 5u);
+	CHECK(RangeIs(ranges[0], Stage::VertexConstantBuffer, 0u, 2u, 0u));
+	CHECK(RangeIs(ranges[1], Stage::PixelConstantBuffer, 0u, 1u, 2u));
+	CHECK(RangeIs(ranges[2], Stage::PixelShaderResource, 0u, 1u, 3u));
+	CHECK(RangeIs(ranges[3], Stage::PixelShaderResource, 2u, 1u, 4u));
+	CHECK(RangeIs(ranges[4], Stage::PixelSampler, 0u, 1u, 5u));
+	CHECK(packet.GetObjects() == std::vector<void*>({ fake.Raw(4), fake.Raw(2), fake.Raw(3), fake.Raw(5), fake.Raw(1), fake.Raw(0) }));
+}
+
+TEST_CASE("DrawPacketBuilder keeps the last object added to a slot")
+{
+	FakeObjects fake;
+	DrawPacketBuilder builder;
+	builder.AddPixelShaderResource(0u, fake.Get<ID3D11ShaderResourceView>(0));
+	builder.AddPixelShaderResource(1u, fake.Get<ID3D11ShaderResourceView>(1));
+	builder.AddPixelShaderResource(0u, fake.Get<ID3D11ShaderResourceView>(2));
+	builder.AddPixelShaderResource(0u, fake.Get<ID3D11ShaderResourceView>(3));
+	// the same slot of another stage is not a duplicate
+	builder.AddPixelSampler(0u, fake.Get<ID3D11SamplerState>(4));
+	const auto packet = builder.Build();
+
+	CHECK(packet.GetRanges().size() == 2u);
+	CHECK(RangeIs(packet.GetRanges()[0], Stage::PixelShaderResource, 0u, 2u, 0u));
+	CHECK(RangeIs(packet.GetRanges()[1], Stage::PixelSampler, 0u, 1u, 2u));
+	CHECK(packet.GetObjects() == std::vector<void*>({ fake.Raw(3), fake.Raw(1), fake.Raw(4) }));
+}
+
+TEST_CASE("DrawPacketBuilder merges contiguous slots into one range")
+{
+	FakeObjects fake;
+	DrawPacketBuilder builder;
+	// slots 3, 1, 2 and 5 of one stage: 1..3 merge, the gap at 4 starts a new range
+	builder.AddPixelConstantBuffer(3u, fake.Get<ID3D11Buffer>(0));
+	builder.AddPixelConstantBuffer(1u, fake.Get<ID3D11Buffer>(1));
+	builder.AddPixelConstantBuffer(2u, fake.Get<ID3D11Buffer>(2));
+	builder.AddPixelConstantBuffer(5u, fake.Get<ID3D11Buffer>(3));
+	// a different stage continuing the slot numbers does not join the range
+	builder.AddPixelShaderResource(6u, fake.Get<ID3D11ShaderResourceView>(4));
+	const auto packet = builder.Build();
+
+	const auto& ranges = packet.GetRanges();
+	CHECK(ranges.size() == 3u);
+	CHECK(RangeIs(ranges[0], Stage::PixelConstantBuffer, 1u, 3u, 0u));
+	CHECK(RangeIs(ranges[1], Stage::PixelConstantBuffer, 5u, 1u, 3u));
+	CHECK(RangeIs(ranges[2], Stage::PixelShaderResource, 6u, 1u, 4u));
+	CHECK(packet.GetObjects() == std::vector<void*>({ fake.Raw(1), fake.Raw(2), fake.Raw(0), fake.Raw(3), fake.Raw(4) }));
+}
+
+TEST_CASE("DrawPacketBuilder keeps hooks and fixed state apart from the slotted objects")
+{
+	FakeObjects fake;
+	DrawPacketBuilder builder;
+	builder.SetVertexShader(fake.Get<ID3D11VertexShader>(0));
+	builder.SetBlendState(fake.Get<ID3D11BlendState>(1), 0xFFu);
+	builder.AddDynamic(*fake.Get<Bindable>(2));
+	builder.AddVertexConstantBuffer(0u, fake.Get<ID3D11Buffer>(3));
+	builder.AddDynamic(*fake.Get<Bindable>(4));
+	const auto packet = builder.Build();
+
+	CHECK(packet.GetStateMask() == (DrawPacket::VertexShaderBit | DrawPacket::BlendBit));
+	CHECK(packet.GetRanges().size() == 1u);
+	CHECK(packet.GetObjects() == std::vector<void*>({ fake.Raw(3) }));
+	// hooks keep the order they were added in
+	CHECK(packet.GetHooks() == std::vector<Bindable*>({ fake.Get<Bindable>(2), fake.Get<Bindable>(4) }));
+
+	// Build leaves the builder empty for the next packet
+	const auto empty = builder.Build();
+	CHECK(empty.GetStateMask() == 0u);
+	CHECK(empty.GetRanges().empty() && empty.GetObjects().empty() && empty.GetHooks().empty());
+}
@@ -0,0 +1,90 @@
+#include "TestHarness.h"
+#include "DynamicConstantBuffer/DynamicConstantBuffer.h"
+#include <string>
+#include <utility>
+
+using D3::ElementType;
+
+namespace
+{
+	// an array of light structs between two scalars, so element offsets are not register aligned by accident
+	D3::ConstantBufferData MakeLightBuffer()
+	{
+		D3::LayoutBuilder builder;
+		builder.Add<ElementType::Float>("ambient");
+		builder.Add<ElementType::Array>("lights");
+		builder["lights"].SetArrayType(ElementType::Struct, 4u);
+		auto& light = builder["lights"].GetArrayElementType();
+		light.AddMember(ElementType::Float3, "color");
+		light.AddMember(ElementType::Float, "intensity");
+		light.AddMember(ElementType::Float2, "range");
+		builder.Add<ElementType::Float>("exposure");
+		return D3::ConstantBufferData{ std::move(builder) };
+	}
+
+	// offset of what a runtime proxy refers to, read without marking the buffer dirty
+	template<typename T>
+	size_t ProxyOffset(const D3::ConstantBufferData& buffer, const D3::ConstantBufferDataConstRef& proxy)
+	{
+		return size_t(reinterpret_cast<const char*>(&static_cast<const T&>(proxy)) - buffer.GetData());
+	}
+}
+
+TEST_CASE("ElementHandle offsets match the runtime proxy")
+{
+	const auto buffer = MakeLightBuffer();
+	for (size_t i = 0; i < 4u; i++)
+	{
+		const auto prefix = "lights[" + std::to_string(i) + "]";
+		const auto color = buffer.Resolve(prefix + ".color");
+		const auto intensity = buffer.Resolve(prefix + ".intensity");
+		const auto range = buffer.Resolve(prefix + ".range");
+		CHECK(color.Exists() && color.GetType() == ElementType::Float3);
+		CHECK(intensity.Exists() && intensity.GetType() == ElementType::Float);
+		CHECK(range.Exists() && range.GetType() == ElementType::Float2);
+		CHECK(color.GetOffset() == ProxyOffset<DirectX::XMFLOAT3>(buffer, buffer["lights"][i]["color"]));
+		CHECK(intensity.GetOffset() == ProxyOffset<float>(buffer, buffer["lights"][i]["intensity"]));
+		CHECK(range.GetOffset() == ProxyOffset<DirectX::XMFLOAT2>(buffer, buffer["lights"][i]["range"]));
+	}
+	CHECK(buffer.Resolve("exposure").GetOffset() == ProxyOffset<float>(buffer, buffer["exposure"]));
+}
+
+TEST_CASE("ElementHandle reads and writes the bytes the proxy does")
+{
+	auto buffer = MakeLightBuffer();
+	const auto color = buffer.Resolve("lights[3].color");
+	buffer.Set(color, DirectX::XMFLOAT3{ 1.0f, 2.0f, 3.0f });
+	const DirectX::XMFLOAT3 viaProxy = buffer["lights"][3]["color"];
+	CHECK(viaProxy.x == 1.0f && viaProxy.y == 2.0f && viaProxy.z == 3.0f);
+
+	buffer["lights"][2]["intensity"] = 0.5f;
+	CHECK(buffer.Get<float>(buffer.Resolve("lights[2].intensity")) == 0.5f);
+}
+
+TEST_CASE("ElementHandle rejects paths that do not name a leaf of the layout")
+{
+	const auto buffer = MakeLightBuffer();
+	for (const char* path : {
+		"lights[4].color",   // index past the end
+		"lights[-1].color",
+		"lights[].color",
+		"lights[1x].color",
+		"lights[0",
+		"missing",           // unknown names
+		"lights[0].missing",
+		"ambient.color",     // member of a scalar
+		"ambient[0]",        // index into a scalar
+		"lights..color",     // empty member names
+		"lights[0]..color",
+		"lights[0].",
+		".ambient",
+		"lights[0]color",    // member without its '.'
+		"" })
+	{
+		if (buffer.Resolve(path).Exists())
+		{
+			TestHarness::ReportFailure(__FILE__, __LINE__, std::string("resolved \"") + path + "\"");
+		}
+	}
+	CHECK(!D3::ElementHandle{}.Exists());
+}
@@ -0,0 +1,92 @@
+#include "TestHarness.h"
+#include "Camera/Frustum.h"
+#include <cmath>
+
+using namespace DirectX;
+
+namespace
+{
+	// camera at the origin looking down +z, 90 degree vertical field of view
+	Frustum MakeFrustum()
+	{
+		return Frustum::FromViewProjection(XMMatrixPerspectiveFovLH(XM_PIDIV2, 1.0f, 1.0f, 100.0f));
+	}
+
+	AABB MakeBox(XMFLOAT3 center, float halfSize)
+	{
+		AABB box;
+		box.Merge(XMFLOAT3{ center.x - halfSize, center.y - halfSize, center.z - halfSize });
+		box.Merge(XMFLOAT3{ center.x + halfSize, center.y + halfSize, center.z + halfSize });
+		return box;
+	}
+}
+
+TEST_CASE("Frustum default constructed contains every non-empty box")
+{
+	const Frustum everything;
+	CHECK(everything.Intersects(MakeBox({ 0.0f, 0.0f, 0.0f }, 1.0f)));
+	CHECK(everything.Intersects(MakeBox({ -1e6f, 1e6f, -1e6f }, 1.0f)));
+	CHECK(!everything.Intersects(AABB{}));
+}
+
+TEST_CASE("Frustum rejects boxes outside each of its six planes")
+{
+	const auto frustum = MakeFrustum();
+	CHECK(frustum.Intersects(MakeBox({ 0.0f, 0.0f, 10.0f }, 1.0f)));
+	CHECK(!frustum.Intersects(MakeBox({ -30.0f, 0.0f, 10.0f }, 1.0f)));  // left
+	CHECK(!frustum.Intersects(MakeBox({ 30.0f, 0.0f, 10.0f }, 1.0f)));   // right
+	CHECK(!frustum.Intersects(MakeBox({ 0.0f, -30.0f, 10.0f }, 1.0f)));  // bottom
+	CHECK(!frustum.Intersects(MakeBox({ 0.0f, 30.0f, 10.0f }, 1.0f)));   // top
+	CHECK(!frustum.Intersects(MakeBox({ 0.0f, 0.0f, -10.0f }, 1.0f)));   // behind the near plane
+	CHECK(!frustum.Intersects(MakeBox({ 0.0f, 0.0f, 120.0f }, 1.0f)));   // past the far plane
+}
+
+TEST_CASE("Frustum keeps boxes straddling a plane")
+{
+	const auto frustum = MakeFrustum();
+	// the side planes are at |x| = z
+	CHECK(frustum.Intersects(MakeBox({ 10.5f, 0.0f, 10.0f }, 1.0f)));
+	CHECK(frustum.Intersects(MakeBox({ 0.0f, 0.0f, 100.5f }, 1.0f)));
+	CHECK(frustum.Intersects(MakeBox({ 0.0f, 0.0f, 0.5f }, 1.0f)));
+	// a box around the camera
+	CHECK(frustum.Intersects(MakeBox({ 0.0f, 0.0f, 0.0f }, 50.0f)));
+}
+
+TEST_CASE("Frustum follows the view matrix")
+{
+	// turned 180 degrees, the camera now looks down -z
+	const auto view = XMMatrixRotationRollPitchYaw(0.0f, XM_PI, 0.0f);
+	const auto frustum = Frustum::FromViewProjection(view * XMMatrixPerspectiveFovLH(XM_PIDIV2, 1.0f, 1.0f, 100.0f));
+	CHECK(!frustum.Intersects(MakeBox({ 0.0f, 0.0f, 10.0f }, 1.0f)));
+	CHECK(frustum.Intersects(MakeBox({ 0.0f, 0.0f, -10.0f }, 1.0f)));
+}
+
+TEST_CASE("AABB transformed encloses every transformed corner")
+{
+	AABB box;
+	box.Merge(XMFLOAT3{ -1.0f, -2.0f, -3.0f });
+	box.Merge(XMFLOAT3{ 4.0f, 5.0f, 6.0f });
+	const auto transform = XMMatrixRotationRollPitchYaw(0.3f, 0.7f, -0.2f) * XMMatrixTranslation(10.0f, -4.0f, 2.0f);
+	const auto result = box.Transformed(transform);
+
+	bool encloses = true;
+	for (int corner = 0; corner < 8; corner++)
+	{
+		const auto point = XMVector3Transform(XMVectorSet(
+			(corner & 1) ? box.max.x : box.min.x,
+			(corner & 2) ? box.max.y : box.min.y,
+			(corner & 4) ? box.max.z : box.min.z, 1.0f), transform);
+		XMFLOAT3 p;
+		XMStoreFloat3(&p, point);
+		constexpr float epsilon = 1e-4f;
+		encloses = encloses &&
+			p.x >= result.min.x - epsilon && p.x <= result.max.x + epsilon &&
+			p.y >= result.min.y - epsilon && p.y <= result.max.y + epsilon &&
+			p.z >= result.min.z - epsilon && p.z <= result.max.z + epsilon;
+	}
+	CHECK(encloses);
+	// a pure translation moves the box without growing it
+	const auto moved = box.Transformed(XMMatrixTranslation(1.0f, 2.0f, 3.0f));
+	CHECK(std::abs(moved.min.x - 0.0f) < 1e-5f && std::abs(moved.max.z - 9.0f) < 1e-5f);
+	CHECK(AABB{}.Transformed(transform).IsEmpty());
+}
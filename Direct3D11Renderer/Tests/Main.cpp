@@ -0,0 +1,7 @@
+#include "TestHarness.h"
+
+// usage: RendererTests [name filter]
+int main(int argc, char** argv)
+{
+	return TestHarness::RunAll(argc > 1 ? argv[1] : "");
+}
@@ -0,0 +1,152 @@
+#include "TestHarness.h"
+#include "Geometry/MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using Type = D3::VertexLayout::ElementType;
+namespace MeshOptimizer = D3::MeshOptimizer;
+
+namespace
+{
+	struct Mesh
+	{
+		D3::VertexBuffer vertices;
+		std::vector<unsigned int> indices;
+	};
+
+	// two nested lat/long spheres with their triangles shuffled: the seam and pole vertices are
+	// byte-identical duplicates for welding, and the inner sphere gives the overdraw step clusters
+	Mesh MakeShuffledSpheres()
+	{
+		constexpr unsigned int rings = 12u;
+		constexpr unsigned int segments = 24u;
+		D3::VertexLayout layout;
+		layout.Append(Type::Position3D).Append(Type::Normal);
+		Mesh mesh{ D3::VertexBuffer{ std::move(layout) }, {} };
+
+		std::vector<std::array<unsigned int, 3>> triangles;
+		for (const float radius : { 0.5f, 1.0f })
+		{
+			const auto base = static_cast<unsigned int>(mesh.vertices.Size());
+			for (unsigned int i = 0; i <= rings; i++)
+			{
+				for (unsigned int j = 0; j <= segments; j++)
+				{
+					const float theta = DirectX::XM_PI * float(i) / float(rings);
+					const float phi = 2.0f * DirectX::XM_PI * float(j % segments) / float(segments);
+					const DirectX::XMFLOAT3 normal{ std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+					mesh.vertices.EmplaceBack(DirectX::XMFLOAT3{ normal.x * radius, normal.y * radius, normal.z * radius }, normal);
+				}
+			}
+			for (unsigned int i = 0; i < rings; i++)
+			{
+				for (unsigned int j = 0; j < segments; j++)
+				{
+					const unsigned int a = base + i * (segments + 1u) + j;
+					const unsigned int c = a + segments + 1u;
+					triangles.push_back({ a, a + 1u, c });
+					triangles.push_back({ a + 1u, c + 1u, c });
+				}
+			}
+		}
+
+		std::mt19937 rng{ 3u };
+		std::shuffle(triangles.begin(), triangles.end(), rng);
+		for (const auto& triangle : triangles)
+		{
+			mesh.indices.insert(mesh.indices.end(), triangle.begin(), triangle.end());
+		}
+		return mesh;
+	}
+
+	std::string VertexBytes(const D3::VertexBuffer& vertices, unsigned int index)
+	{
+		const auto stride = vertices.GetLayout().Size();
+		return std::string(vertices.GetData() + stride * index, stride);
+	}
+
+	// every triangle as the bytes of its corners, rotated to start at the smallest corner so the
+	// comparison ignores which corner comes first but not the winding
+	std::map<std::array<std::string, 3>, size_t> TriangleSet(const Mesh& mesh)
+	{
+		std::map<std::array<std::string, 3>, size_t> triangles;
+		for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+		{
+			std::array<std::string, 3> corners;
+			for (size_t c = 0; c < 3; c++)
+			{
+				corners[c] = VertexBytes(mesh.vertices, mesh.indices[i + c]);
+			}
+			const auto first = std::min_element(corners.begin(), corners.end()) - corners.begin();
+			std::rotate(corners.begin(), corners.begin() + first, corners.end());
+			triangles[corners]++;
+		}
+		return triangles;
+	}
+}
+
+TEST_CASE("MeshOptimizer::Optimize keeps every triangle and its winding")
+{
+	auto mesh = MakeShuffledSpheres();
+	const auto before = TriangleSet(mesh);
+	const auto vertexCount = mesh.vertices.Size();
+	const auto report = MeshOptimizer::Optimize(mesh.vertices, mesh.indices);
+
+	CHECK(mesh.indices.size() % 3u == 0u);
+	CHECK(TriangleSet(mesh) == before);
+	// the seams and poles were welded and the duplicates dropped
+	CHECK(report.weldedVertices > 0u);
+	CHECK(mesh.vertices.Size() == vertexCount - report.weldedVertices);
+}
+
+TEST_CASE("MeshOptimizer::OptimizeVertexFetch and Remap keep the vertex behind every index")
+{
+	auto mesh = MakeShuffledSpheres();
+	// one unreferenced vertex, Remap has to drop it
+	mesh.vertices.EmplaceBack(DirectX::XMFLOAT3{ 5.0f, 5.0f, 5.0f }, DirectX::XMFLOAT3{ 0.0f, 1.0f, 0.0f });
+	const auto original = mesh;
+
+	const auto order = MeshOptimizer::OptimizeVertexFetch(mesh.indices, mesh.vertices.Size());
+	mesh.vertices.Remap(order);
+	CHECK(mesh.vertices.Size() == original.vertices.Size() - 1u);
+	CHECK(mesh.indices.size() == original.indices.size());
+
+	bool sameVertices = true;
+	// vertices are numbered in the order the indices first reach them
+	unsigned int nextNew = 0u;
+	bool firstUseOrder = true;
+	for (size_t i = 0; i < mesh.indices.size(); i++)
+	{
+		sameVertices = sameVertices && VertexBytes(mesh.vertices, mesh.indices[i]) == VertexBytes(original.vertices, original.indices[i]);
+		if (mesh.indices[i] >= nextNew)
+		{
+			firstUseOrder = firstUseOrder && mesh.indices[i] == nextNew;
+			nextNew++;
+		}
+	}
+	CHECK(sameVertices);
+	CHECK(firstUseOrder);
+}
+
+TEST_CASE("MeshOptimizer::Optimize is deterministic")
+{
+	// Renderable rebuilds the geometry for a vertex buffer miss and pairs it with a cached index
+	// buffer, so the same input has to give the same output byte for byte
+	auto first = MakeShuffledSpheres();
+	auto second = MakeShuffledSpheres();
+	MeshOptimizer::Settings settings;
+	settings.measureMetrics = true;
+	const auto firstReport = MeshOptimizer::Optimize(first.vertices, first.indices, settings);
+	const auto secondReport = MeshOptimizer::Optimize(second.vertices, second.indices, settings);
+
+	CHECK(first.indices == second.indices);
+	CHECK(first.vertices.SizeBytes() == second.vertices.SizeBytes());
+	CHECK(std::equal(first.vertices.GetData(), first.vertices.GetData() + first.vertices.SizeBytes(), second.vertices.GetData()));
+	CHECK(firstReport.clusterCount == secondReport.clusterCount);
+	CHECK(firstReport.after.acmr == secondReport.after.acmr && firstReport.after.overdraw == secondReport.after.overdraw);
+}
@@ -0,0 +1,169 @@
+#include "TestHarness.h"
+#include "Camera/OcclusionBuffer.h"
+#include <cmath>
+
+using namespace DirectX;
+
+namespace
+{
+	constexpr unsigned int width = 320u;
+	constexpr unsigned int height = 180u;
+	constexpr float nearZ = 0.5f;
+	constexpr float farZ = 100.0f;
+
+	// camera at the origin looking down +z, so world space is view space
+	XMMATRIX MakeViewProjection()
+	{
+		return XMMatrixPerspectiveFovLH(XM_PIDIV2, float(width) / float(height), nearZ, farZ);
+	}
+
+	// two triangles facing the camera at distance z
+	OcclusionBuffer::OccluderMesh MakeWall(float z, float halfSize)
+	{
+		OcclusionBuffer::OccluderMesh wall;
+		wall.positions = {
+			{ -halfSize, -halfSize, z }, { halfSize, -halfSize, z },
+			{ halfSize, halfSize, z }, { -halfSize, halfSize, z } };
+		wall.indices = { 0u, 1u, 2u, 0u, 2u, 3u };
+		return wall;
+	}
+
+	AABB MakeBox(XMFLOAT3 min, XMFLOAT3 max)
+	{
+		AABB box;
+		box.Merge(min);
+		box.Merge(max);
+		return box;
+	}
+
+	float DepthAt(const OcclusionBuffer& buffer, unsigned int x, unsigned int y)
+	{
+		return buffer.GetDepth()[size_t(y) * buffer.GetWidth() + x];
+	}
+
+	float ProjectedDepth(float z)
+	{
+		const auto clip = XMVector4Transform(XMVectorSet(0.0f, 0.0f, z, 1.0f), MakeViewProjection());
+		return XMVectorGetZ(clip) / XMVectorGetW(clip);
+	}
+}
+
+TEST_CASE("OcclusionBuffer rounds its width up to whole groups of four pixels")
+{
+	OcclusionBuffer buffer{ 318u, 10u };
+	CHECK(buffer.GetWidth() == 320u);
+	CHECK(buffer.GetHeight() == 10u);
+}
+
+TEST_CASE("OcclusionBuffer keeps everything visible when no occluder was drawn")
+{
+	OcclusionBuffer buffer{ width, height };
+	buffer.BeginFrame(MakeViewProjection());
+	buffer.Rasterize();
+	bool cleared = true;
+	for (unsigned int i = 0; i < width * height; i++)
+	{
+		cleared = cleared && buffer.GetDepth()[i] == 1.0f;
+	}
+	CHECK(cleared);
+	CHECK(buffer.IsVisible(MakeBox({ -1.0f, -1.0f, 50.0f }, { 1.0f, 1.0f, 52.0f })));
+}
+
+TEST_CASE("OcclusionBuffer rasterizes an occluder at its depth without gaps")
+{
+	OcclusionBuffer buffer{ width, height };
+	buffer.BeginFrame(MakeViewProjection());
+	buffer.AddOccluder(MakeWall(10.0f, 5.0f), XMMatrixIdentity());
+	buffer.Rasterize();
+
+	const float wallDepth = ProjectedDepth(10.0f);
+	CHECK(std::abs(DepthAt(buffer, width / 2u, height / 2u) - wallDepth) < 1e-5f);
+	CHECK(DepthAt(buffer, 0u, 0u) == 1.0f);
+	CHECK(DepthAt(buffer, width - 1u, height - 1u) == 1.0f);
+
+	// every pixel well inside the projected square is covered, including along the shared diagonal
+	// and across the row bands that are rasterized in parallel
+	const float halfWidth = 5.0f / 10.0f * (float(height) / float(width)) * 0.5f * float(width);
+	const float halfHeight = 5.0f / 10.0f * 0.5f * float(height);
+	size_t gaps = 0u;
+	for (unsigned int y = unsigned(height / 2.0f - halfHeight) + 1u; y + 1u < unsigned(height / 2.0f + halfHeight); y++)
+	{
+		for (unsigned int x = unsigned(width / 2.0f - halfWidth) + 1u; x + 1u < unsigned(width / 2.0f + halfWidth); x++)
+		{
+			gaps += std::abs(DepthAt(buffer, x, y) - wallDepth) > 1e-5f;
+		}
+	}
+	CHECK(gaps == 0u);
+	CHECK(buffer.GetStats().occludersDrawn == 1u);
+	CHECK(buffer.GetStats().trianglesRasterized == 2u);
+}
+
+TEST_CASE("OcclusionBuffer keeps the nearest of overlapping occluders")
+{
+	OcclusionBuffer buffer{ width, height };
+	buffer.BeginFrame(MakeViewProjection());
+	buffer.AddOccluder(MakeWall(10.0f, 5.0f), XMMatrixIdentity());
+	// the nearer wall is added second and placed through the world matrix
+	buffer.AddOccluder(MakeWall(0.0f, 1.0f), XMMatrixTranslation(0.0f, 0.0f, 6.0f));
+	buffer.Rasterize();
+	CHECK(std::abs(DepthAt(buffer, width / 2u, height / 2u) - ProjectedDepth(6.0f)) < 1e-5f);
+}
+
+TEST_CASE("OcclusionBuffer rejects only boxes completely behind an occluder")
+{
+	OcclusionBuffer buffer{ width, height };
+	buffer.BeginFrame(MakeViewProjection());
+	buffer.AddOccluder(MakeWall(10.0f, 5.0f), XMMatrixIdentity());
+	buffer.Rasterize();
+
+	// behind the wall and inside its silhouette
+	CHECK(!buffer.IsVisible(MakeBox({ -1.0f, -1.0f, 20.0f }, { 1.0f, 1.0f, 22.0f })));
+	// in front of the wall
+	CHECK(buffer.IsVisible(MakeBox({ -1.0f, -1.0f, 5.0f }, { 1.0f, 1.0f, 6.0f })));
+	// straddling the wall
+	CHECK(buffer.IsVisible(MakeBox({ -1.0f, -1.0f, 9.0f }, { 1.0f, 1.0f, 11.0f })));
+	// behind the wall but sticking out past its edge
+	CHECK(buffer.IsVisible(MakeBox({ 5.0f, -1.0f, 20.0f }, { 15.0f, 1.0f, 22.0f })));
+	// reaching the camera plane, cannot be projected
+	CHECK(buffer.IsVisible(MakeBox({ -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 22.0f })));
+	// off screen, left to the frustum test
+	CHECK(buffer.IsVisible(MakeBox({ -200.0f, -1.0f, 20.0f }, { -190.0f, 1.0f, 22.0f })));
+	// empty boxes have nothing to hide
+	CHECK(buffer.IsVisible(AABB{}));
+
+	CHECK(buffer.GetStats().occludeesTested == 7u);
+	CHECK(buffer.GetStats().occludeesRejected == 1u);
+}
+
+TEST_CASE("OcclusionBuffer drops occluder triangles crossing the near plane")
+{
+	// a floor running from behind the camera into the distance
+	OcclusionBuffer::OccluderMesh floor;
+	floor.positions = { { -5.0f, -1.0f, -5.0f }, { 5.0f, -1.0f, -5.0f }, { 5.0f, -1.0f, 20.0f }, { -5.0f, -1.0f, 20.0f } };
+	floor.indices = { 0u, 1u, 2u, 0u, 2u, 3u };
+
+	OcclusionBuffer buffer{ width, height };
+	buffer.BeginFrame(MakeViewProjection());
+	buffer.AddOccluder(floor, XMMatrixIdentity());
+	buffer.Rasterize();
+	// dropping them only costs culling, a box under the floor stays visible
+	CHECK(buffer.GetStats().occludersDrawn == 1u);
+	CHECK(buffer.GetStats().trianglesRasterized == 0u);
+	CHECK(buffer.IsVisible(MakeBox({ -1.0f, -4.0f, 10.0f }, { 1.0f, -2.0f, 12.0f })));
+}
+
+TEST_CASE("OcclusionBuffer forgets the previous frame's occluders")
+{
+	OcclusionBuffer buffer{ width, height };
+	const auto hidden = MakeBox({ -1.0f, -1.0f, 20.0f }, { 1.0f, 1.0f, 22.0f });
+	buffer.BeginFrame(MakeViewProjection());
+	buffer.AddOccluder(MakeWall(10.0f, 5.0f), XMMatrixIdentity());
+	buffer.Rasterize();
+	CHECK(!buffer.IsVisible(hidden));
+
+	buffer.BeginFrame(MakeViewProjection());
+	buffer.Rasterize();
+	CHECK(buffer.IsVisible(hidden));
+	CHECK(buffer.GetStats().occludeesTested == 1u);
+	CHECK(buffer.GetStats().occludeesRejected == 0u);
+}
@@ -0,0 +1,36 @@
+#include "TestHarness.h"
+#include "RenderPass/Pass.h"
+#include "Utilities/AllocationCounter.h"
+#include "Utilities/FrameArena.h"
+
+TEST_CASE("Pass submit, sort and reset stay off the heap once warmed up")
+{
+	// small enough that the first frames overflow both arena buffers and have to grow them
+	FrameArena arena{ 1024u };
+	Pass pass;
+	// submission order is neither keyed nor drawn here, so the jobs need no renderable or step
+	const Job job{ nullptr, nullptr };
+	const auto view = DirectX::XMMatrixIdentity();
+
+	size_t steadyAllocations = 0u;
+	for (int frame = 0; frame < 6; frame++)
+	{
+		// rewinding grows the arena, like FrameManager::Reset it is outside the counted part
+		arena.BeginFrame();
+		pass.Reset(arena);
+
+		const AllocationCounter::Scope allocations;
+		for (int i = 0; i < 300; i++)
+		{
+			pass.Accept(job);
+		}
+		pass.Sort(view);
+		// one frame per arena buffer to grow it
+		if (frame >= 2)
+		{
+			steadyAllocations += allocations.Elapsed();
+		}
+	}
+	// the counter only counts in debug builds, release ones pass trivially
+	CHECK(steadyAllocations == 0u);
+}
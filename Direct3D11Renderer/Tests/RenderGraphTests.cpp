@@ -0,0 +1,189 @@
+#include "TestHarness.h"
+#include "RenderPass/RenderGraph.h"
+#include <algorithm>
+
+namespace
+{
+	using Type = RenderGraph::ResourceType;
+	using Builder = RenderGraph::PassBuilder;
+
+	const RenderGraph::ResourceDesc colorDesc{ Type::RenderTarget, 640u, 480u, 28u };
+	const RenderGraph::ResourceDesc halfDesc{ Type::RenderTarget, 320u, 240u, 28u };
+
+	size_t PositionOf(const RenderGraph& graph, size_t pass)
+	{
+		const auto& order = graph.GetExecutionOrder();
+		return static_cast<size_t>(std::find(order.begin(), order.end(), pass) - order.begin());
+	}
+}
+
+TEST_CASE("RenderGraph keeps the FrameManager passes in dependency order")
+{
+	RenderGraph graph;
+	auto backBuffer = graph.Import("backBuffer", { Type::RenderTarget });
+	auto depth = graph.Import("depthStencil", { Type::DepthStencil });
+	const auto phong = graph.AddPass("Phong", [&](Builder& b) { backBuffer = b.Write(backBuffer); depth = b.Write(depth); });
+	const auto mask = graph.AddPass("OutlineMask", [&](Builder& b) { depth = b.Write(depth); });
+	const auto draw = graph.AddPass("OutlineDraw", [&](Builder& b) { b.Read(depth); backBuffer = b.Write(backBuffer); });
+	graph.Compile();
+
+	CHECK(graph.IsCompiled());
+	CHECK((graph.GetExecutionOrder() == std::vector<size_t>{ phong, mask, draw }));
+	CHECK(!graph.IsCulled(phong) && !graph.IsCulled(mask) && !graph.IsCulled(draw));
+	// imported resources are never shared
+	CHECK(graph.GetPhysicalCount() == 2u);
+	CHECK(graph.GetPhysicalIndex(backBuffer) != graph.GetPhysicalIndex(depth));
+}
+
+TEST_CASE("RenderGraph culls passes whose outputs nobody reads")
+{
+	RenderGraph graph;
+	auto backBuffer = graph.Import("backBuffer", { Type::RenderTarget });
+	const auto unread = graph.CreateTransient("unread", colorDesc);
+	const auto feeding = graph.CreateTransient("feeding", colorDesc);
+
+	auto feedingOut = feeding;
+	const auto producer = graph.AddPass("Producer", [&](Builder& b) { feedingOut = b.Write(feeding); });
+	// only consumer of Producer, itself unread, so both go
+	const auto deadEnd = graph.AddPass("DeadEnd", [&](Builder& b) { b.Read(feedingOut); b.Write(unread); });
+	const auto noWrites = graph.AddPass("NoWrites", [&](Builder& b) { b.Read(backBuffer); });
+	const auto debug = graph.AddPass("Debug", [&](Builder& b) { b.Read(backBuffer); b.SetSideEffects(); });
+	const auto present = graph.AddPass("Present", [&](Builder& b) { backBuffer = b.Write(backBuffer); });
+	graph.Compile();
+
+	CHECK(graph.IsCulled(producer));
+	CHECK(graph.IsCulled(deadEnd));
+	CHECK(graph.IsCulled(noWrites));
+	CHECK(!graph.IsCulled(debug));
+	CHECK(!graph.IsCulled(present));
+	CHECK((graph.GetExecutionOrder() == std::vector<size_t>{ debug, present }));
+	// culled transients get no memory
+	CHECK(graph.GetPhysicalIndex(feeding) == RenderGraph::Invalid);
+	CHECK(graph.GetPhysicalIndex(unread) == RenderGraph::Invalid);
+	CHECK(graph.GetPhysicalCount() == 1u);
+}
+
+TEST_CASE("RenderGraph runs a stale reader before the pass that overwrites it")
+{
+	RenderGraph graph;
+	auto backBuffer = graph.Import("backBuffer", { Type::RenderTarget });
+	auto history = graph.Import("history", { Type::RenderTarget });
+	const auto previous = history;
+	const auto update = graph.AddPass("UpdateHistory", [&](Builder& b) { history = b.Write(history); });
+	// declared later but reads what UpdateHistory writes over
+	const auto resolve = graph.AddPass("Resolve", [&](Builder& b) { b.Read(previous); backBuffer = b.Write(backBuffer); });
+	graph.Compile();
+
+	CHECK(PositionOf(graph, resolve) < PositionOf(graph, update));
+}
+
+TEST_CASE("RenderGraph rejects passes that depend on each other in a cycle")
+{
+	RenderGraph graph;
+	auto backBuffer = graph.Import("backBuffer", { Type::RenderTarget });
+	auto history = graph.Import("history", { Type::RenderTarget });
+	auto scratch = graph.CreateTransient("scratch", colorDesc);
+	const auto previous = history;
+	graph.AddPass("Update", [&](Builder& b) { history = b.Write(history); scratch = b.Write(scratch); });
+	// needs Update's scratch output, but also the history version Update writes over
+	graph.AddPass("Resolve", [&](Builder& b) { b.Read(scratch); b.Read(previous); backBuffer = b.Write(backBuffer); });
+
+	CHECK_THROWS(graph.Compile());
+	CHECK(!graph.IsCompiled());
+}
+
+TEST_CASE("RenderGraph ignores cycles through culled passes")
+{
+	RenderGraph graph;
+	auto backBuffer = graph.Import("backBuffer", { Type::RenderTarget });
+	auto scratch = graph.CreateTransient("scratch", colorDesc);
+	auto unread = graph.CreateTransient("unread", colorDesc);
+	const auto previous = scratch;
+	graph.AddPass("Present", [&](Builder& b) { backBuffer = b.Write(backBuffer); });
+	graph.AddPass("Update", [&](Builder& b) { scratch = b.Write(scratch); });
+	graph.AddPass("Dead", [&](Builder& b) { b.Read(scratch); b.Read(previous); b.Write(unread); });
+
+	graph.Compile();
+	CHECK(graph.GetExecutionOrder().size() == 1u);
+}
+
+TEST_CASE("RenderGraph shares one physical slot between transients with disjoint lifetimes")
+{
+	// silhouette followed by two separable blur iterations, the last one composites into the back buffer
+	RenderGraph graph;
+	auto backBuffer = graph.Import("backBuffer", { Type::RenderTarget });
+	std::vector<RenderGraph::ResourceHandle> chain;
+	for (int i = 0; i < 4; i++)
+	{
+		chain.push_back(graph.CreateTransient("blur" + std::to_string(i), colorDesc));
+	}
+	graph.AddPass("Silhouette", [&](Builder& b) { chain[0] = b.Write(chain[0]); });
+	graph.AddPass("BlurH0", [&](Builder& b) { b.Read(chain[0]); chain[1] = b.Write(chain[1]); });
+	graph.AddPass("BlurV0", [&](Builder& b) { b.Read(chain[1]); chain[2] = b.Write(chain[2]); });
+	graph.AddPass("BlurH1", [&](Builder& b) { b.Read(chain[2]); chain[3] = b.Write(chain[3]); });
+	graph.AddPass("BlurV1", [&](Builder& b) { b.Read(chain[3]); backBuffer = b.Write(backBuffer); });
+	graph.Compile();
+
+	// ping-pong falls out of the lifetimes: 0 and 2 share, 1 and 3 share
+	CHECK(graph.GetPhysicalIndex(chain[0]) == graph.GetPhysicalIndex(chain[2]));
+	CHECK(graph.GetPhysicalIndex(chain[1]) == graph.GetPhysicalIndex(chain[3]));
+	CHECK(graph.GetPhysicalIndex(chain[0]) != graph.GetPhysicalIndex(chain[1]));
+	CHECK(graph.GetPhysicalCount() == 3u);
+	CHECK(graph.GetTransientCount() == 4u);
+	CHECK(graph.GetPhysicalDesc(graph.GetPhysicalIndex(chain[0])) == colorDesc);
+	CHECK(graph.IsPhysicalImported(graph.GetPhysicalIndex(backBuffer)));
+	CHECK(!graph.IsPhysicalImported(graph.GetPhysicalIndex(chain[0])));
+}
+
+TEST_CASE("RenderGraph keeps transients with overlapping lifetimes or different descs apart")
+{
+	RenderGraph graph;
+	auto backBuffer = graph.Import("backBuffer", { Type::RenderTarget });
+	auto a = graph.CreateTransient("a", colorDesc);
+	auto b = graph.CreateTransient("b", colorDesc);
+	auto half = graph.CreateTransient("half", halfDesc);
+	graph.AddPass("WriteA", [&](Builder& builder) { a = builder.Write(a); });
+	graph.AddPass("WriteB", [&](Builder& builder) { builder.Read(a); b = builder.Write(b); });
+	// a is still alive here, so b cannot take its slot
+	graph.AddPass("Combine", [&](Builder& builder) { builder.Read(a); builder.Read(b); half = builder.Write(half); });
+	graph.AddPass("Upsample", [&](Builder& builder) { builder.Read(half); backBuffer = builder.Write(backBuffer); });
+	graph.Compile();
+
+	CHECK(graph.GetPhysicalIndex(a) != graph.GetPhysicalIndex(b));
+	// a and b are dead by the time Upsample runs, but half has a different size
+	CHECK(graph.GetPhysicalIndex(half) != graph.GetPhysicalIndex(a));
+	CHECK(graph.GetPhysicalIndex(half) != graph.GetPhysicalIndex(b));
+	CHECK(graph.GetPhysicalCount() == 4u);
+}
+
+TEST_CASE("RenderGraph schedules independent chains back to back so they can alias")
+{
+	RenderGraph graph;
+	auto backBuffer = graph.Import("backBuffer", { Type::RenderTarget });
+	auto first = graph.CreateTransient("first", colorDesc);
+	auto second = graph.CreateTransient("second", colorDesc);
+	// declared interleaved, which would keep both transients alive at once
+	const auto produceFirst = graph.AddPass("ProduceFirst", [&](Builder& b) { first = b.Write(first); });
+	const auto produceSecond = graph.AddPass("ProduceSecond", [&](Builder& b) { second = b.Write(second); });
+	const auto consumeFirst = graph.AddPass("ConsumeFirst", [&](Builder& b) { b.Read(first); backBuffer = b.Write(backBuffer); });
+	const auto consumeSecond = graph.AddPass("ConsumeSecond", [&](Builder& b) { b.Read(second); backBuffer = b.Write(backBuffer); });
+	graph.Compile();
+
+	CHECK((graph.GetExecutionOrder() == std::vector<size_t>{ produceFirst, consumeFirst, produceSecond, consumeSecond }));
+	CHECK(graph.GetPhysicalIndex(first) == graph.GetPhysicalIndex(second));
+	CHECK(graph.GetPhysicalCount() == 2u);
+}
+
+TEST_CASE("RenderGraph recompiles after a pass is added")
+{
+	RenderGraph graph;
+	auto backBuffer = graph.Import("backBuffer", { Type::RenderTarget });
+	graph.AddPass("First", [&](Builder& b) { backBuffer = b.Write(backBuffer); });
+	graph.Compile();
+	CHECK(graph.GetExecutionOrder().size() == 1u);
+
+	graph.AddPass("Second", [&](Builder& b) { backBuffer = b.Write(backBuffer); });
+	CHECK(!graph.IsCompiled());
+	graph.Compile();
+	CHECK(graph.GetExecutionOrder().size() == 2u);
+}
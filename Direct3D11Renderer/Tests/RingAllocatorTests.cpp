@@ -0,0 +1,120 @@
+#include "TestHarness.h"
+#include "Utilities/RingAllocator.h"
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	// ConstantRing's alignment: D3D11.1 constant offsets are in 16 constants of 16 bytes
+	constexpr size_t constantAlignment = 256u;
+}
+
+TEST_CASE("RingAllocator hands out consecutive offsets rounded to the alignment")
+{
+	RingAllocator ring{ 4096u, constantAlignment };
+	const auto first = ring.Allocate(64u);
+	const auto second = ring.Allocate(256u);
+	const auto third = ring.Allocate(257u);
+	CHECK(first && second && third);
+	CHECK(first->offset == 0u && first->size == 256u);
+	CHECK(second->offset == 256u && second->size == 256u);
+	CHECK(third->offset == 512u && third->size == 512u);
+	CHECK(ring.GetHead() == 1024u);
+	for (const auto& allocation : { *first, *second, *third })
+	{
+		CHECK(allocation.offset % constantAlignment == 0u);
+	}
+}
+
+TEST_CASE("RingAllocator starts the first allocation with a discard")
+{
+	RingAllocator ring{ 1024u, constantAlignment };
+	CHECK(ring.GetGenerationCount() == 0u);
+	const auto first = ring.Allocate(16u);
+	CHECK(first && first->discard);
+	const auto second = ring.Allocate(16u);
+	CHECK(second && !second->discard);
+	CHECK(ring.GetGenerationCount() == 1u);
+}
+
+TEST_CASE("RingAllocator rejects empty and oversized requests without moving the head")
+{
+	RingAllocator ring{ 1024u, constantAlignment };
+	ring.Allocate(16u);
+	const auto head = ring.GetHead();
+	CHECK(!ring.Allocate(0u));
+	CHECK(!ring.Allocate(1025u));
+	CHECK(ring.GetHead() == head);
+	CHECK(ring.GetGenerationCount() == 1u);
+	// the whole ring is still a valid request
+	const auto whole = ring.Allocate(1024u);
+	CHECK(whole && whole->offset == 0u && whole->discard);
+}
+
+TEST_CASE("RingAllocator wraps to a new generation when the tail is too small")
+{
+	RingAllocator ring{ 1024u, constantAlignment };
+	ring.Allocate(512u);
+	ring.Allocate(256u);
+	// 256 bytes left, exactly enough, no wrap
+	const auto fits = ring.Allocate(200u);
+	CHECK(fits && fits->offset == 768u && !fits->discard);
+	CHECK(ring.GetHead() == 1024u);
+	const auto wrapped = ring.Allocate(16u);
+	CHECK(wrapped && wrapped->offset == 0u && wrapped->discard);
+	CHECK(ring.GetGenerationCount() == 2u);
+
+	// a request larger than the tail wraps even with space left
+	ring.Allocate(512u);
+	const auto big = ring.Allocate(512u);
+	CHECK(big && big->offset == 0u && big->discard);
+	CHECK(ring.GetGenerationCount() == 3u);
+}
+
+TEST_CASE("RingAllocator fences frames by discarding on the first allocation after Reset")
+{
+	// ConstantRing resets at BeginFrame, the GPU may still read last frame's constants
+	RingAllocator ring{ 4096u, constantAlignment };
+	for (int frame = 0; frame < 3; frame++)
+	{
+		ring.Reset();
+		const auto first = ring.Allocate(64u);
+		CHECK(first && first->offset == 0u && first->discard);
+		const auto second = ring.Allocate(64u);
+		CHECK(second && second->offset == 256u && !second->discard);
+		CHECK(ring.GetGenerationCount() == static_cast<size_t>(frame) + 1u);
+	}
+}
+
+TEST_CASE("RingAllocator never overlaps allocations of one generation")
+{
+	RingAllocator ring{ 64u * 1024u, constantAlignment };
+	std::mt19937 rng{ 1234u };
+	std::uniform_int_distribution<size_t> sizes{ 1u, 3000u };
+	std::vector<std::pair<size_t, size_t>> live;
+	for (int i = 0; i < 10000; i++)
+	{
+		if (i % 500 == 0)
+		{
+			ring.Reset();
+		}
+		const auto allocation = ring.Allocate(sizes(rng));
+		CHECK(allocation.has_value());
+		if (!allocation)
+		{
+			continue;
+		}
+		if (allocation->discard)
+		{
+			live.clear();
+		}
+		CHECK(allocation->offset % constantAlignment == 0u);
+		CHECK(allocation->offset + allocation->size <= ring.GetCapacity());
+		for (const auto& [offset, size] : live)
+		{
+			CHECK(allocation->offset >= offset + size || allocation->offset + allocation->size <= offset);
+		}
+		live.emplace_back(allocation->offset, allocation->size);
+	}
+}
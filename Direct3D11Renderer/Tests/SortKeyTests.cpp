@@ -0,0 +1,143 @@
+#include "TestHarness.h"
+#include "RenderPass/SortKey.h"
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// entries with the given keys, indexed in submission order
+	std::vector<SortKey::Entry> MakeEntries(const std::vector<uint64_t>& keys)
+	{
+		std::vector<SortKey::Entry> entries;
+		for (size_t i = 0; i < keys.size(); i++)
+		{
+			entries.push_back({ keys[i], uint32_t(i) });
+		}
+		return entries;
+	}
+
+	// RadixSort against std::stable_sort on the same entries, indices included
+	bool SortsLikeStableSort(const std::vector<uint64_t>& keys)
+	{
+		auto sorted = MakeEntries(keys);
+		std::vector<SortKey::Entry> scratch;
+		SortKey::RadixSort(sorted, scratch);
+		auto expected = MakeEntries(keys);
+		std::stable_sort(expected.begin(), expected.end(), [](const SortKey::Entry& a, const SortKey::Entry& b) { return a.key < b.key; });
+		return std::equal(sorted.begin(), sorted.end(), expected.begin(), expected.end(),
+			[](const SortKey::Entry& a, const SortKey::Entry& b) { return a.key == b.key && a.index == b.index; });
+	}
+}
+
+TEST_CASE("SortKey::RadixSort is stable over duplicate keys")
+{
+	std::mt19937_64 rng{ 9u };
+	std::vector<uint64_t> keys;
+	for (int i = 0; i < 5000; i++)
+	{
+		// few distinct keys spread over every byte, so most keys repeat
+		keys.push_back((rng() % 16u) * 0x0101010101010101ull);
+	}
+	CHECK(SortsLikeStableSort(keys));
+
+	std::vector<uint64_t> random;
+	for (int i = 0; i < 5000; i++)
+	{
+		random.push_back(rng());
+	}
+	CHECK(SortsLikeStableSort(random));
+}
+
+TEST_CASE("SortKey::RadixSort skips digits every key shares")
+{
+	// only the lowest byte differs: one pass, the result ends up in scratch and is copied back
+	std::vector<uint64_t> oneDigit;
+	// two bytes differ: two passes, the result is back in the entries
+	std::vector<uint64_t> twoDigits;
+	for (uint64_t i = 0; i < 300u; i++)
+	{
+		oneDigit.push_back(0xABCD000000000000ull | ((i * 37u) % 7u));
+		twoDigits.push_back(0x1200000000000000ull | (((i * 53u) % 11u) << 40u) | ((i * 37u) % 5u));
+	}
+	CHECK(SortsLikeStableSort(oneDigit));
+	CHECK(SortsLikeStableSort(twoDigits));
+
+	// no digit differs, the order is untouched
+	CHECK(SortsLikeStableSort(std::vector<uint64_t>(100u, 0x42ull)));
+	CHECK(SortsLikeStableSort({}));
+	CHECK(SortsLikeStableSort({ 7u }));
+}
+
+TEST_CASE("SortKey::QuantizeDepth is monotonic and maps non-positive depths to 0")
+{
+	uint32_t previous = 0u;
+	bool monotonic = true;
+	for (float depth = 1e-4f; depth < 1e5f; depth *= 1.01f)
+	{
+		const auto quantized = SortKey::QuantizeDepth(depth);
+		monotonic = monotonic && quantized >= previous;
+		previous = quantized;
+	}
+	CHECK(monotonic);
+	CHECK(previous < (1u << SortKey::DepthBits));
+	CHECK(SortKey::QuantizeDepth(1.0f) < SortKey::QuantizeDepth(1.1f));
+	CHECK(SortKey::QuantizeDepth(10.0f) < SortKey::QuantizeDepth(11.0f));
+
+	CHECK(SortKey::QuantizeDepth(0.0f) == 0u);
+	CHECK(SortKey::QuantizeDepth(-0.0f) == 0u);
+	CHECK(SortKey::QuantizeDepth(-5.0f) == 0u);
+	CHECK(SortKey::QuantizeDepth(-std::numeric_limits<float>::infinity()) == 0u);
+	CHECK(SortKey::QuantizeDepth(std::numeric_limits<float>::quiet_NaN()) == 0u);
+}
+
+TEST_CASE("SortKey::Make orders FrontToBack by state, then near to far")
+{
+	const auto policy = SortKey::Policy::FrontToBack;
+	const auto stateA = SortKey::MakeState(1u, 2u, 3u);
+	const auto stateB = stateA + 1u;
+	const auto nearDepth = SortKey::QuantizeDepth(1.0f);
+	const auto farDepth = SortKey::QuantizeDepth(100.0f);
+	// state wins over depth
+	CHECK(SortKey::Make(policy, stateA, farDepth) < SortKey::Make(policy, stateB, nearDepth));
+	CHECK(SortKey::Make(policy, stateA, nearDepth) < SortKey::Make(policy, stateA, farDepth));
+	// state sits above the depth bits
+	CHECK(SortKey::Make(policy, stateA, nearDepth) >> SortKey::DepthBits == stateA);
+}
+
+TEST_CASE("SortKey::Make orders BackToFront far to near, then by state")
+{
+	const auto policy = SortKey::Policy::BackToFront;
+	const auto stateA = SortKey::MakeState(1u, 2u, 3u);
+	const auto stateB = stateA + 1u;
+	const auto nearDepth = SortKey::QuantizeDepth(1.0f);
+	const auto farDepth = SortKey::QuantizeDepth(100.0f);
+	// depth wins over state
+	CHECK(SortKey::Make(policy, stateB, farDepth) < SortKey::Make(policy, stateA, nearDepth));
+	CHECK(SortKey::Make(policy, stateA, farDepth) < SortKey::Make(policy, stateB, farDepth));
+	CHECK((SortKey::Make(policy, stateA, farDepth) & ((1ull << SortKey::StateBits) - 1ull)) == stateA);
+
+	CHECK(SortKey::Make(SortKey::Policy::Submission, stateA, nearDepth) == 0u);
+}
+
+TEST_CASE("SortKey::MakeState packs shader, texture and material from the top")
+{
+	const auto base = SortKey::MakeState(1u, 1u, 1u);
+	const auto shaderMask = ((1ull << SortKey::ShaderBits) - 1ull) << (SortKey::TextureBits + SortKey::MaterialBits);
+	const auto materialMask = (1ull << SortKey::MaterialBits) - 1ull;
+	const auto textureMask = ((1ull << SortKey::StateBits) - 1ull) & ~shaderMask & ~materialMask;
+	CHECK(base >> SortKey::StateBits == 0u);
+	CHECK(((base ^ SortKey::MakeState(2u, 1u, 1u)) & ~shaderMask) == 0u);
+	CHECK(((base ^ SortKey::MakeState(1u, 2u, 1u)) & ~textureMask) == 0u);
+	CHECK(((base ^ SortKey::MakeState(1u, 1u, 2u)) & ~materialMask) == 0u);
+
+	// geometry only touches the material field and is deterministic
+	const auto withGeometry = SortKey::WithGeometry(base, 0x1234u);
+	CHECK(((base ^ withGeometry) & ~materialMask) == 0u);
+	CHECK(withGeometry == SortKey::WithGeometry(base, 0x1234u));
+
+	// replacing the material gives the key MakeState would have made with it
+	CHECK(SortKey::WithMaterial(base, 7u) == SortKey::MakeState(1u, 1u, 7u));
+	CHECK(SortKey::WithMaterial(SortKey::WithMaterial(base, 7u), 1u) == base);
+}
@@ -0,0 +1,231 @@
+#include "TestHarness.h"
+#include "DynamicConstantBuffer/StaticLayout.h"
+#include "DynamicConstantBuffer/LayoutRegistry.h"
+#include <cstring>
+#include <utility>
+
+// Every layout below is checked twice: static_assert against the offsets HLSL packing gives by hand,
+// and at runtime against a LayoutBuilder written out independently, down to the packed bytes.
+namespace
+{
+	using D3::ElementType;
+	template<ElementType Type, size_t ArraySize = 0>
+	using Member = D3::StaticMember<Type, ArraySize>;
+
+	// scalars, including ones pushed to the next register because they would straddle one
+	struct ScalarA : Member<ElementType::Float> { static constexpr const char* name = "a"; };
+	struct ScalarB : Member<ElementType::Float2> { static constexpr const char* name = "b"; };
+	struct ScalarC : Member<ElementType::Float2> { static constexpr const char* name = "c"; };
+	struct ScalarD : Member<ElementType::Float3> { static constexpr const char* name = "d"; };
+	struct ScalarE : Member<ElementType::Bool> { static constexpr const char* name = "e"; };
+	struct ScalarF : Member<ElementType::Matrix4x4> { static constexpr const char* name = "f"; };
+	struct ScalarG : Member<ElementType::Float> { static constexpr const char* name = "g"; };
+	using ScalarLayout = D3::StaticLayout<ScalarA, ScalarB, ScalarC, ScalarD, ScalarE, ScalarF, ScalarG>;
+	static_assert(ScalarLayout::OffsetOf<ScalarA>() == 0u);
+	static_assert(ScalarLayout::OffsetOf<ScalarB>() == 4u);
+	static_assert(ScalarLayout::OffsetOf<ScalarC>() == 16u);
+	static_assert(ScalarLayout::OffsetOf<ScalarD>() == 32u);
+	static_assert(ScalarLayout::OffsetOf<ScalarE>() == 44u);
+	static_assert(ScalarLayout::OffsetOf<ScalarF>() == 48u);
+	static_assert(ScalarLayout::OffsetOf<ScalarG>() == 112u);
+	static_assert(ScalarLayout::size == 128u);
+
+	// arrays start a register and give every element a whole one
+	struct ArrayHead : Member<ElementType::Float> { static constexpr const char* name = "head"; };
+	struct ArrayFloats : Member<ElementType::Float, 3> { static constexpr const char* name = "floats"; };
+	struct ArrayMiddle : Member<ElementType::Float> { static constexpr const char* name = "middle"; };
+	struct ArrayPairs : Member<ElementType::Float2, 2> { static constexpr const char* name = "pairs"; };
+	struct ArrayTail : Member<ElementType::Float> { static constexpr const char* name = "tail"; };
+	using ArrayLayout = D3::StaticLayout<ArrayHead, ArrayFloats, ArrayMiddle, ArrayPairs, ArrayTail>;
+	static_assert(ArrayLayout::OffsetOf<ArrayFloats>() == 16u);
+	static_assert(ArrayLayout::OffsetOf<ArrayMiddle>() == 64u);
+	static_assert(ArrayLayout::OffsetOf<ArrayPairs>() == 80u);
+	static_assert(ArrayLayout::OffsetOf<ArrayTail>() == 112u);
+	static_assert(ArrayLayout::size == 128u);
+
+	// nested structs start a register, a following scalar packs into the struct's last one
+	struct LightColor : Member<ElementType::Float3> { static constexpr const char* name = "color"; };
+	struct LightIntensity : Member<ElementType::Float> { static constexpr const char* name = "intensity"; };
+	struct Light : D3::StaticStruct<LightColor, LightIntensity> { static constexpr const char* name = "light"; };
+	struct FogDensity : Member<ElementType::Float> { static constexpr const char* name = "density"; };
+	struct Fog : D3::StaticStruct<FogDensity> { static constexpr const char* name = "fog"; };
+	struct NestedHead : Member<ElementType::Float> { static constexpr const char* name = "head"; };
+	struct NestedMiddle : Member<ElementType::Float> { static constexpr const char* name = "middle"; };
+	struct NestedTail : Member<ElementType::Float2> { static constexpr const char* name = "tail"; };
+	using NestedLayout = D3::StaticLayout<NestedHead, Light, NestedMiddle, Fog, NestedTail>;
+	static_assert(NestedLayout::OffsetOf<Light>() == 16u);
+	static_assert(Light::OffsetOf<LightIntensity>() == 12u && Light::size == 16u);
+	static_assert(NestedLayout::OffsetOf<NestedMiddle>() == 32u);
+	static_assert(NestedLayout::OffsetOf<Fog>() == 48u);
+	static_assert(NestedLayout::OffsetOf<NestedTail>() == 52u);
+	static_assert(NestedLayout::size == 64u);
+
+	// members ending exactly on a register boundary do not move
+	struct EdgeA : Member<ElementType::Float3> { static constexpr const char* name = "a"; };
+	struct EdgeB : Member<ElementType::Float3> { static constexpr const char* name = "b"; };
+	struct EdgeC : Member<ElementType::Float4> { static constexpr const char* name = "c"; };
+	struct EdgeD : Member<ElementType::Float> { static constexpr const char* name = "d"; };
+	struct EdgeE : Member<ElementType::Float3> { static constexpr const char* name = "e"; };
+	using EdgeLayout = D3::StaticLayout<EdgeA, EdgeB, EdgeC, EdgeD, EdgeE>;
+	static_assert(EdgeLayout::OffsetOf<EdgeB>() == 16u);
+	static_assert(EdgeLayout::OffsetOf<EdgeC>() == 32u);
+	static_assert(EdgeLayout::OffsetOf<EdgeD>() == 48u);
+	static_assert(EdgeLayout::OffsetOf<EdgeE>() == 52u);
+	static_assert(EdgeLayout::size == 64u);
+
+	// BlinnPhong_Diffuse_PS material cbuffer, as TestCube declares it
+	struct SpecularReflectance : Member<ElementType::Float> { static constexpr const char* name = "specularReflectance"; };
+	struct SpecularShininess : Member<ElementType::Float> { static constexpr const char* name = "specularShininess"; };
+	struct MaterialPadding : Member<ElementType::Float2> { static constexpr const char* name = "materialPadding"; };
+	using SpecularLayout = D3::StaticLayout<SpecularReflectance, SpecularShininess, MaterialPadding>;
+
+	bool SameBytes(const D3::ConstantBufferData& lhs, const D3::ConstantBufferData& rhs)
+	{
+		return lhs.GetSizeInBytes() == rhs.GetSizeInBytes() &&
+			std::memcmp(lhs.GetData(), rhs.GetData(), lhs.GetSizeInBytes()) == 0;
+	}
+
+	DirectX::XMFLOAT4X4 Sequence()
+	{
+		DirectX::XMFLOAT4X4 matrix{};
+		for (int i = 0; i < 16; i++)
+		{
+			matrix.m[i / 4][i % 4] = static_cast<float>(i);
+		}
+		return matrix;
+	}
+}
+
+TEST_CASE("StaticLayout packs scalars like the runtime layout")
+{
+	D3::LayoutBuilder builder;
+	builder.Add<ElementType::Float>("a");
+	builder.Add<ElementType::Float2>("b");
+	builder.Add<ElementType::Float2>("c");
+	builder.Add<ElementType::Float3>("d");
+	builder.Add<ElementType::Bool>("e");
+	builder.Add<ElementType::Matrix4x4>("f");
+	builder.Add<ElementType::Float>("g");
+	D3::ConstantBufferData runtime{ std::move(builder) };
+	CHECK(runtime.GetSizeInBytes() == ScalarLayout::size);
+	CHECK(runtime.GetRootLayout().GetHash() == ScalarLayout::GetFinalized().GetHash());
+
+	auto buffer = ScalarLayout::MakeBuffer();
+	D3::StaticView<ScalarLayout> view(buffer);
+	view.Get<ScalarA>() = 1.0f;
+	view.Get<ScalarB>() = { 2.0f, 3.0f };
+	view.Get<ScalarC>() = { 4.0f, 5.0f };
+	view.Get<ScalarD>() = { 6.0f, 7.0f, 8.0f };
+	view.Get<ScalarE>() = true;
+	view.Get<ScalarF>() = Sequence();
+	view.Get<ScalarG>() = 9.0f;
+	runtime["a"] = 1.0f;
+	runtime["b"] = DirectX::XMFLOAT2{ 2.0f, 3.0f };
+	runtime["c"] = DirectX::XMFLOAT2{ 4.0f, 5.0f };
+	runtime["d"] = DirectX::XMFLOAT3{ 6.0f, 7.0f, 8.0f };
+	runtime["e"] = true;
+	runtime["f"] = Sequence();
+	runtime["g"] = 9.0f;
+	CHECK(SameBytes(buffer, runtime));
+}
+
+TEST_CASE("StaticLayout packs arrays like the runtime layout")
+{
+	D3::LayoutBuilder builder;
+	builder.Add<ElementType::Float>("head");
+	builder.Add<ElementType::Array>("floats");
+	builder["floats"].SetArrayType(ElementType::Float, 3);
+	builder.Add<ElementType::Float>("middle");
+	builder.Add<ElementType::Array>("pairs");
+	builder["pairs"].SetArrayType(ElementType::Float2, 2);
+	builder.Add<ElementType::Float>("tail");
+	D3::ConstantBufferData runtime{ std::move(builder) };
+	CHECK(runtime.GetSizeInBytes() == ArrayLayout::size);
+	CHECK(runtime.GetRootLayout().GetHash() == ArrayLayout::GetFinalized().GetHash());
+
+	auto buffer = ArrayLayout::MakeBuffer();
+	D3::StaticView<ArrayLayout> view(buffer);
+	view.Get<ArrayHead>() = 1.0f;
+	runtime["head"] = 1.0f;
+	for (size_t i = 0; i < 3; i++)
+	{
+		view.Get<ArrayFloats>(i) = 10.0f + i;
+		runtime["floats"][i] = 10.0f + i;
+	}
+	view.Get<ArrayMiddle>() = 2.0f;
+	runtime["middle"] = 2.0f;
+	for (size_t i = 0; i < 2; i++)
+	{
+		view.Get<ArrayPairs>(i) = { 20.0f + i, 30.0f + i };
+		runtime["pairs"][i] = DirectX::XMFLOAT2{ 20.0f + i, 30.0f + i };
+	}
+	view.Get<ArrayTail>() = 3.0f;
+	runtime["tail"] = 3.0f;
+	CHECK(SameBytes(buffer, runtime));
+}
+
+TEST_CASE("StaticLayout packs nested structs like the runtime layout")
+{
+	D3::LayoutBuilder builder;
+	builder.Add<ElementType::Float>("head");
+	builder.Add<ElementType::Struct>("light");
+	builder["light"].AddMember(ElementType::Float3, "color");
+	builder["light"].AddMember(ElementType::Float, "intensity");
+	builder.Add<ElementType::Float>("middle");
+	builder.Add<ElementType::Struct>("fog");
+	builder["fog"].AddMember(ElementType::Float, "density");
+	builder.Add<ElementType::Float2>("tail");
+	D3::ConstantBufferData runtime{ std::move(builder) };
+	CHECK(runtime.GetSizeInBytes() == NestedLayout::size);
+	CHECK(runtime.GetRootLayout().GetHash() == NestedLayout::GetFinalized().GetHash());
+
+	auto buffer = NestedLayout::MakeBuffer();
+	D3::StaticView<NestedLayout> view(buffer);
+	view.Get<NestedHead>() = 1.0f;
+	view.Get<Light, LightColor>() = { 2.0f, 3.0f, 4.0f };
+	view.Get<Light, LightIntensity>() = 5.0f;
+	view.Get<NestedMiddle>() = 6.0f;
+	view.Get<Fog, FogDensity>() = 7.0f;
+	view.Get<NestedTail>() = { 8.0f, 9.0f };
+	runtime["head"] = 1.0f;
+	runtime["light"]["color"] = DirectX::XMFLOAT3{ 2.0f, 3.0f, 4.0f };
+	runtime["light"]["intensity"] = 5.0f;
+	runtime["middle"] = 6.0f;
+	runtime["fog"]["density"] = 7.0f;
+	runtime["tail"] = DirectX::XMFLOAT2{ 8.0f, 9.0f };
+	CHECK(SameBytes(buffer, runtime));
+}
+
+TEST_CASE("StaticLayout keeps members that end on a 16-byte boundary in place")
+{
+	D3::LayoutBuilder builder;
+	builder.Add<ElementType::Float3>("a");
+	builder.Add<ElementType::Float3>("b");
+	builder.Add<ElementType::Float4>("c");
+	builder.Add<ElementType::Float>("d");
+	builder.Add<ElementType::Float3>("e");
+	D3::ConstantBufferData runtime{ std::move(builder) };
+	CHECK(runtime.GetSizeInBytes() == EdgeLayout::size);
+
+	auto buffer = EdgeLayout::MakeBuffer();
+	D3::StaticView<EdgeLayout> view(buffer);
+	view.Get<EdgeA>() = { 1.0f, 2.0f, 3.0f };
+	view.Get<EdgeB>() = { 4.0f, 5.0f, 6.0f };
+	view.Get<EdgeC>() = { 7.0f, 8.0f, 9.0f, 10.0f };
+	view.Get<EdgeD>() = 11.0f;
+	view.Get<EdgeE>() = { 12.0f, 13.0f, 14.0f };
+	runtime["a"] = DirectX::XMFLOAT3{ 1.0f, 2.0f, 3.0f };
+	runtime["b"] = DirectX::XMFLOAT3{ 4.0f, 5.0f, 6.0f };
+	runtime["c"] = DirectX::XMFLOAT4{ 7.0f, 8.0f, 9.0f, 10.0f };
+	runtime["d"] = 11.0f;
+	runtime["e"] = DirectX::XMFLOAT3{ 12.0f, 13.0f, 14.0f };
+	CHECK(SameBytes(buffer, runtime));
+}
+
+TEST_CASE("StaticLayout matches the layout generated from the shader cbuffer")
+{
+	const auto& generated = D3::LayoutRegistry::Get("BlinnPhong_Diffuse_PS", 1u);
+	CHECK(generated.GetHash() == SpecularLayout::GetFinalized().GetHash());
+	CHECK(generated.GetSizeInBytes() == SpecularLayout::size);
+	CHECK(generated["specularShininess"].GetOffset() == SpecularLayout::OffsetOf<SpecularShininess>());
+}
@@ -0,0 +1,37 @@
+#include "TestGraphics.h"
+#include "Core/Graphics.h"
+#include <stdexcept>
+
+namespace TestHarness
+{
+	namespace
+	{
+		// never shown, the swap chain only needs a window handle
+		struct HiddenWindow
+		{
+			HiddenWindow()
+				:
+				hwnd(CreateWindowExW(0, L"STATIC", L"RendererTests", WS_OVERLAPPEDWINDOW,
+					0, 0, 64, 64, nullptr, nullptr, GetModuleHandleW(nullptr), nullptr))
+			{
+				if (hwnd == nullptr)
+				{
+					throw std::runtime_error("Could not create the window for the test device");
+				}
+			}
+			~HiddenWindow()
+			{
+				DestroyWindow(hwnd);
+			}
+			HWND hwnd;
+		};
+	}
+
+	Graphics& GetGraphics()
+	{
+		// destroyed in reverse order, the device goes before its window
+		static HiddenWindow window;
+		static Graphics gfx{ window.hwnd, 64, 64 };
+		return gfx;
+	}
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+class Graphics;
+
+namespace TestHarness
+{
+	// device on a hidden window, created on first use and shared by every test that needs one
+	Graphics& GetGraphics();
+}
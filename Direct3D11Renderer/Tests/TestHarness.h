@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Minimal self-registering test harness for the CPU-only parts of the renderer, so the tests build
+// anywhere CMake and a C++17 compiler do without pulling in a framework.
+//
+// TEST_CASE("name") { CHECK(expr); CHECK_THROWS(expr); } in any linked translation unit, Main.cpp
+// runs them all and returns the number of failed cases.
+namespace TestHarness
+{
+	struct Case
+	{
+		const char* name;
+		std::function<void()> body;
+	};
+
+	inline std::vector<Case>& Registry()
+	{
+		static std::vector<Case> cases;
+		return cases;
+	}
+
+	// failed checks of the case currently running
+	inline size_t& Failures()
+	{
+		static size_t failures = 0u;
+		return failures;
+	}
+
+	struct Registrar
+	{
+		Registrar(const char* name, std::function<void()> body)
+		{
+			Registry().push_back({ name, std::move(body) });
+		}
+	};
+
+	inline void ReportFailure(const char* file, int line, const std::string& what)
+	{
+		std::printf("  %s(%d): %s\n", file, line, what.c_str());
+		Failures()++;
+	}
+
+	// filter is a substring of the case names to run, empty runs everything
+	inline int RunAll(const std::string& filter)
+	{
+		size_t failedCases = 0u;
+		size_t ran = 0u;
+		for (const auto& testCase : Registry())
+		{
+			if (!filter.empty() && std::string(testCase.name).find(filter) == std::string::npos)
+			{
+				continue;
+			}
+			ran++;
+			Failures() = 0u;
+			try
+			{
+				testCase.body();
+			}
+			catch (const std::exception& e)
+			{
+				ReportFailure(testCase.name, 0, std::string("unexpected exception: ") + e.what());
+			}
+			std::printf("[%s] %s\n", Failures() == 0u ? "pass" : "FAIL", testCase.name);
+			failedCases += Failures() != 0u;
+		}
+		std::printf("%zu of %zu test cases passed\n", ran - failedCases, ran);
+		return static_cast<int>(failedCases);
+	}
+}
+
+#define TEST_HARNESS_CONCAT_IMPL(a, b) a##b
+#define TEST_HARNESS_CONCAT(a, b) TEST_HARNESS_CONCAT_IMPL(a, b)
+#define TEST_CASE_IMPL(name, fn) \
+	static void fn(); \
+	static const TestHarness::Registrar TEST_HARNESS_CONCAT(fn, _registrar){ name, &fn }; \
+	static void fn()
+#define TEST_CASE(name) TEST_CASE_IMPL(name, TEST_HARNESS_CONCAT(TestCase_, __LINE__))
+
+#define CHECK(expr) \
+	do { if (!(expr)) TestHarness::ReportFailure(__FILE__, __LINE__, "CHECK(" #expr ") failed"); } while (false)
+
+#define CHECK_THROWS(expr) \
+	do { \
+		bool thrown_ = false; \
+		try { (void)(expr); } catch (...) { thrown_ = true; } \
+		if (!thrown_) TestHarness::ReportFailure(__FILE__, __LINE__, "CHECK_THROWS(" #expr ") did not throw"); \
+	} while (false)
@@ -0,0 +1,147 @@
+#include "TestHarness.h"
+#include "Geometry/VertexCompression.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+namespace VertexPacking = D3::VertexPacking;
+
+// Error bounds the packed formats guarantee:
+//   positions   16-bit UNORM over the mesh bounds, half a step (extent / 65535 / 2) per axis
+//   normals     16-bit SNORM octahedral, well under 0.01 degrees
+//   tangents    same as normals, the bitangent is rebuilt exactly up to the tangent's error
+//   texcoords   half floats, 11 significant bits, so a relative error of 2^-11
+namespace
+{
+	constexpr float maxDirectionErrorDegrees = 0.01f;
+
+	// atan2 of the cross and dot products, acos loses the small angles measured here to rounding
+	float AngleDegrees(const XMFLOAT3& a, const XMFLOAT3& b)
+	{
+		const auto va = XMLoadFloat3(&a);
+		const auto vb = XMLoadFloat3(&b);
+		return XMConvertToDegrees(std::atan2(XMVectorGetX(XMVector3Length(XMVector3Cross(va, vb))), XMVectorGetX(XMVector3Dot(va, vb))));
+	}
+
+	// unit vectors covering both hemispheres, plus the axes and the octahedron's folds
+	std::vector<XMFLOAT3> MakeDirections()
+	{
+		std::vector<XMFLOAT3> directions = {
+			{ 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f },
+			{ 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }, { 0.7071068f, 0.0f, -0.7071068f }, { 0.0f, -0.7071068f, -0.7071068f } };
+		std::mt19937 rng{ 5u };
+		std::normal_distribution<float> axis{ 0.0f, 1.0f };
+		for (int i = 0; i < 2000; i++)
+		{
+			XMFLOAT3 v{ axis(rng), axis(rng), axis(rng) };
+			XMStoreFloat3(&v, XMVector3Normalize(XMLoadFloat3(&v)));
+			directions.push_back(v);
+		}
+		return directions;
+	}
+}
+
+TEST_CASE("VertexPacking positions decode within half a quantization step")
+{
+	D3::VertexQuantization q;
+	q.positionMin = { -3.0f, 0.5f, -100.0f };
+	q.positionExtent = { 6.0f, 2.0f, 250.0f };
+	std::mt19937 rng{ 7u };
+	std::uniform_real_distribution<float> unit{ 0.0f, 1.0f };
+	float worstSteps = 0.0f;
+	for (int i = 0; i < 5000; i++)
+	{
+		// the corners of the range included
+		const float tx = i == 0 ? 0.0f : i == 1 ? 1.0f : unit(rng);
+		const float ty = i == 0 ? 0.0f : i == 1 ? 1.0f : unit(rng);
+		const float tz = i == 0 ? 0.0f : i == 1 ? 1.0f : unit(rng);
+		const XMFLOAT3 p{ q.positionMin.x + tx * q.positionExtent.x, q.positionMin.y + ty * q.positionExtent.y, q.positionMin.z + tz * q.positionExtent.z };
+		const auto decoded = VertexPacking::DecodePosition(VertexPacking::EncodePosition(p, q), q);
+		worstSteps = std::max({ worstSteps,
+			std::abs(decoded.x - p.x) / q.positionExtent.x * 65535.0f,
+			std::abs(decoded.y - p.y) / q.positionExtent.y * 65535.0f,
+			std::abs(decoded.z - p.z) / q.positionExtent.z * 65535.0f });
+	}
+	// half a step, with a little room for the float math around it
+	CHECK(worstSteps <= 0.51f);
+}
+
+TEST_CASE("VertexPacking positions on a flat axis decode to the range minimum")
+{
+	D3::VertexQuantization q;
+	q.positionMin = { 1.0f, 2.0f, 3.0f };
+	q.positionExtent = { 4.0f, 0.0f, 4.0f };
+	const auto decoded = VertexPacking::DecodePosition(VertexPacking::EncodePosition({ 2.0f, 2.0f, 5.0f }, q), q);
+	CHECK(decoded.y == 2.0f);
+	// outside the range clamps to its edge instead of wrapping
+	const auto clamped = VertexPacking::DecodePosition(VertexPacking::EncodePosition({ 10.0f, 2.0f, -10.0f }, q), q);
+	CHECK(clamped.x == 5.0f && clamped.z == 3.0f);
+}
+
+TEST_CASE("VertexPacking octahedral normals decode within 0.01 degrees")
+{
+	float worst = 0.0f;
+	for (const auto& n : MakeDirections())
+	{
+		worst = std::max(worst, AngleDegrees(VertexPacking::DecodeNormal(VertexPacking::EncodeNormal(n)), n));
+	}
+	CHECK(worst <= maxDirectionErrorDegrees);
+}
+
+TEST_CASE("VertexPacking tangent frames keep the tangent and the bitangent's handedness")
+{
+	float worstTangent = 0.0f;
+	float worstBitangent = 0.0f;
+	bool handednessKept = true;
+	const auto directions = MakeDirections();
+	for (size_t i = 0; i < directions.size(); i++)
+	{
+		// an orthonormal frame around each direction, mirrored for every other vertex
+		const auto n = XMLoadFloat3(&directions[i]);
+		const auto helper = std::abs(directions[i].y) < 0.9f ? XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f) : XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);
+		const auto t = XMVector3Normalize(XMVector3Cross(helper, n));
+		const auto b = XMVectorScale(XMVector3Cross(n, t), i % 2u == 0u ? 1.0f : -1.0f);
+		XMFLOAT3 normal, tangent, bitangent;
+		XMStoreFloat3(&normal, n);
+		XMStoreFloat3(&tangent, t);
+		XMStoreFloat3(&bitangent, b);
+
+		XMFLOAT3 decodedTangent, decodedBitangent;
+		VertexPacking::DecodeTangentFrame(VertexPacking::EncodeTangentFrame(normal, tangent, bitangent), normal, decodedTangent, decodedBitangent);
+		worstTangent = std::max(worstTangent, AngleDegrees(decodedTangent, tangent));
+		worstBitangent = std::max(worstBitangent, AngleDegrees(decodedBitangent, bitangent));
+		handednessKept = handednessKept && XMVectorGetX(XMVector3Dot(XMLoadFloat3(&decodedBitangent), b)) > 0.0f;
+	}
+	CHECK(handednessKept);
+	CHECK(worstTangent <= maxDirectionErrorDegrees);
+	CHECK(worstBitangent <= maxDirectionErrorDegrees);
+}
+
+TEST_CASE("VertexPacking texture coordinates decode within half float precision")
+{
+	float worstRelative = 0.0f;
+	// tiling coordinates outside [0, 1] included
+	for (float u = -4.0f; u <= 4.0f; u += 0.0137f)
+	{
+		const float v = 1.0f - u * 0.5f;
+		const auto decoded = VertexPacking::DecodeTexCoord(VertexPacking::EncodeTexCoord(u, v));
+		worstRelative = std::max({ worstRelative,
+			std::abs(decoded.x - u) / std::max(std::abs(u), 1.0f / 1024.0f),
+			std::abs(decoded.y - v) / std::max(std::abs(v), 1.0f / 1024.0f) });
+	}
+	CHECK(worstRelative <= 1.0f / 2048.0f);
+	const auto exact = VertexPacking::DecodeTexCoord(VertexPacking::EncodeTexCoord(0.5f, 1.0f));
+	CHECK(exact.x == 0.5f && exact.y == 1.0f);
+}
+
+TEST_CASE("VertexQuantization covers every vertex of a mesh")
+{
+	aiMesh mesh;
+	mesh.mNumVertices = 3u;
+	mesh.mVertices = new aiVector3D[3]{ { -1.0f, 2.0f, 0.0f }, { 3.0f, -2.0f, 0.5f }, { 0.0f, 0.0f, 4.0f } };
+	const auto q = D3::VertexQuantization::FromMesh(mesh);
+	CHECK(q.positionMin.x == -1.0f && q.positionMin.y == -2.0f && q.positionMin.z == 0.0f);
+	CHECK(q.positionExtent.x == 4.0f && q.positionExtent.y == 4.0f && q.positionExtent.z == 4.0f);
+}
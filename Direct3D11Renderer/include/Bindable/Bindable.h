@@ -1,12 +1,22 @@
 #pragma once
 #include "Core/Graphics.h"
+#include "BindableKey.h"
+#include <memory>
 #include <string>
 
 class Renderable;
+class DrawPacketBuilder;
 class TechniqueProbe;
 
 class Bindable
 {
+public:
+	// rough memory held by a bindable, BindableCache uses it to stay within its budget
+	struct MemoryFootprint
+	{
+		size_t gpuBytes = 0u;
+		size_t cpuBytes = 0u;
+	};
 public:
 	virtual void Bind(Graphics& gfx) noexcept = 0;
 	virtual std::string GetUID() const noexcept
@@ -17,9 +27,25 @@ public:
 	virtual ~Bindable() = default;
 	virtual void Accept(TechniqueProbe& probe) {};
 	virtual void InitializeParentReference(const Renderable&) noexcept {};
+	// Bindables holding per-object state (a parent reference) return a copy of themselves, so a Step
+	// copied into another Renderable gets its own. Shared state returns nullptr and stays shared.
+	virtual std::shared_ptr<Bindable> Clone() const
+	{
+		return nullptr;
+	}
+	// records this bindable into a Step's draw packet; by default it stays a per-draw Bind hook
+	virtual void Compile(DrawPacketBuilder& builder);
+	// state objects and other small bindables report nothing
+	virtual MemoryFootprint GetMemoryFootprint() const noexcept
+	{
+		return {};
+	}
 protected:
+	static size_t GetBufferBytes(ID3D11Buffer* pBuffer) noexcept;
 	static ID3D11DeviceContext* const GetContext(Graphics& gfx) noexcept;
 	static ID3D11Device* const GetDevice(Graphics& gfx) noexcept;
+	static PipelineStateCache& GetStateCache(Graphics& gfx) noexcept;
+	static ConstantRing& GetConstantRing(Graphics& gfx) noexcept;
 #ifndef NDEBUG
 	static DxgiDebugManager& GetInfoManager(Graphics& gfx) noexcept(_DEBUG);
 #endif
@@ -1,12 +1,47 @@
 #pragma once
 
 #include "Bindable.h"
+#include "BindableKey.h"
 #include "Exceptions/BindableLookupException.h"
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <stdexcept>
+#include <vector>
 
+// Process-wide cache of shared bindables keyed by T::GenerateKey, a 64-bit hash of the same values
+// T::GenerateUID spells out, so hits never allocate. Safe to call from several
+// threads: the map is split into shards with their own reader / writer lock, hits only take a
+// shared lock, and concurrent misses on the same UID construct the bindable once while the other
+// callers wait for it. The bindable's constructor runs outside any lock.
+//
+// Resident bindables are charged their GetMemoryFootprint(). When the total goes over the budget,
+// entries nobody else holds a reference to are evicted least recently resolved first. Resolve only
+// trims on a miss, so Application also calls Trim at the end of every frame.
 class BindableCache
 {
+public:
+    struct Stats
+    {
+        size_t hits = 0u;
+        size_t misses = 0u;
+        size_t evictions = 0u;
+        size_t resident = 0u;
+        size_t gpuBytes = 0u;
+        size_t cpuBytes = 0u;
+    };
+    struct TypeStats
+    {
+        const char* typeName;
+        size_t resident = 0u;
+        size_t gpuBytes = 0u;
+        size_t cpuBytes = 0u;
+    };
 public:
     BindableCache() = default;
     ~BindableCache() = default;
@@ -18,25 +53,157 @@ public:
     {
         static_assert(std::is_base_of<Bindable, T>::value, "Can only resolve classes derived from Bindable");
         
-        // Generate the proper UID using the class's own method
-        std::string uid = T::GenerateUID(std::forward<Args>(args)...);
+        // Generate the key using the class's own method
+        const uint64_t key = T::GenerateKey(args...);
+        auto& shard = GetShard(key);
+
+        // Check if it already exists (or is being built by another thread)
+        {
+            std::shared_lock lock(shard.mutex);
+            auto it = shard.entries.find(key);
+            if (it != shard.entries.end())
+            {
+                VerifyHit<T>(it->second, args...);
+                it->second.lastUse.store(clock.fetch_add(1u, std::memory_order_relaxed), std::memory_order_relaxed);
+                auto result = it->second.result;
+                lock.unlock();
+                hits.fetch_add(1u, std::memory_order_relaxed);
+                // VerifyHit checked the stored type, so the downcast is safe
+                return std::static_pointer_cast<T>(result.get());
+            }
+        }
+
+        // Whoever inserts the entry first builds the bindable, everyone else waits on its future
+        std::promise<std::shared_ptr<Bindable>> promise;
+        std::string uid = T::GenerateUID(args...);
+        std::shared_future<std::shared_ptr<Bindable>> result;
+        bool isBuilder = false;
+        {
+            std::unique_lock lock(shard.mutex);
+            auto it = shard.entries.find(key);
+            if (it == shard.entries.end())
+            {
+                it = shard.entries.try_emplace(key, promise.get_future().share(), std::move(uid), typeid(T).name(),
+                    clock.fetch_add(1u, std::memory_order_relaxed)).first;
+                isBuilder = true;
+            }
+            else
+            {
+                VerifyHit<T>(it->second, args...);
+            }
+            result = it->second.result;
+        }
+
+        if (!isBuilder)
+        {
+            hits.fetch_add(1u, std::memory_order_relaxed);
+            return std::static_pointer_cast<T>(result.get());
+        }
+
+        misses.fetch_add(1u, std::memory_order_relaxed);
+        std::shared_ptr<T> pBindable;
+        try
+        {
+            pBindable = std::make_shared<T>(gfx, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            // forget the failed build so a later call can retry, waiting callers see the exception
+            {
+                std::unique_lock lock(shard.mutex);
+                shard.entries.erase(key);
+            }
+            promise.set_exception(std::current_exception());
+            throw;
+        }
 
-        // Check if it already exists
-        auto it = cache.find(uid);
-        if (it != cache.end())
+        // the footprint is recorded before the entry becomes ready, Trim only looks at ready entries
+        const auto footprint = pBindable->GetMemoryFootprint();
         {
-            // Return existing instance if found
-            return std::static_pointer_cast<T>(it->second);
+            std::unique_lock lock(shard.mutex);
+            shard.entries.find(key)->second.footprint = footprint;
         }
+        gpuBytes.fetch_add(footprint.gpuBytes, std::memory_order_relaxed);
+        cpuBytes.fetch_add(footprint.cpuBytes, std::memory_order_relaxed);
+        promise.set_value(pBindable);
 
-        // Create new bindable
-        auto bindable = std::make_shared<T>(gfx, std::forward<Args>(args)...);
-        cache[uid] = bindable;
-        return bindable;
+        if (GetResidentBytes() > budget.load(std::memory_order_relaxed))
+        {
+            Trim();
+        }
+        return pBindable;
     }
+
+    // total of gpu and cpu bytes the cache may keep alive for bindables nobody else uses
+    static void SetBudget(size_t bytes) noexcept;
+    static size_t GetBudget() noexcept;
+    // evicts unreferenced entries, least recently resolved first, until the cache is within budget;
+    // returns right away when it already is, so calling it every frame is cheap
+    static void Trim();
+    static Stats GetStats();
+    // resident counts and bytes grouped by bindable type (walks the whole cache)
+    static std::vector<TypeStats> GetTypeStats();
+    // readable UID of a cached key, empty if the key is not resident (diagnostics only)
+    static std::string GetUID(uint64_t key);
 private:
-    static std::unordered_map<std::string, std::shared_ptr<Bindable>> cache;
-};
+    struct Entry
+    {
+        Entry(std::shared_future<std::shared_ptr<Bindable>> result, std::string uid, const char* typeName, uint64_t lastUse)
+            :
+            result(std::move(result)),
+            uid(std::move(uid)),
+            typeName(typeName),
+            lastUse(lastUse)
+        {}
+        std::shared_future<std::shared_ptr<Bindable>> result;
+        std::string uid;
+        const char* typeName;
+        Bindable::MemoryFootprint footprint;
+        // updated by hits under the shared lock
+        std::atomic<uint64_t> lastUse;
+    };
+    struct Shard
+    {
+        std::shared_mutex mutex;
+        std::unordered_map<uint64_t, Entry> entries;
+    };
+    static constexpr size_t ShardCount = 16u;
 
-// Define the static member outside the class
-inline std::unordered_map<std::string, std::shared_ptr<Bindable>> BindableCache::cache;
\ No newline at end of file
+    static Shard& GetShard(uint64_t key) noexcept
+    {
+        // BindableKey's multiply only carries upward, so the top bits are the ones that depend on every
+        // input byte even before its final fold. The map hashes the full key again.
+        static_assert(ShardCount == 16u, "GetShard takes the top 4 bits of the key");
+        return shards[key >> 60];
+    }
+    // the 64-bit key alone can collide: a hit must be of the requested type before it is downcast,
+    // and debug builds also compare the readable UID
+    template<typename T, typename... Args>
+    static void VerifyHit(const Entry& entry, const Args&... args)
+    {
+        const char* typeName = typeid(T).name();
+        if (entry.typeName != typeName && std::strcmp(entry.typeName, typeName) != 0)
+        {
+            throw BINDABLE_COLLISION_EXCEPT(typeName, T::GenerateUID(args...), entry.typeName, entry.uid);
+        }
+#ifndef NDEBUG
+        if (entry.uid != T::GenerateUID(args...))
+        {
+            throw BINDABLE_COLLISION_EXCEPT(typeName, T::GenerateUID(args...), entry.typeName, entry.uid);
+        }
+#endif
+    }
+    static size_t GetResidentBytes() noexcept;
+    // built and referenced by nothing but the cache
+    static bool IsEvictable(const Entry& entry) noexcept;
+private:
+    static std::array<Shard, ShardCount> shards;
+    static std::atomic<uint64_t> clock;
+    static std::atomic<size_t> budget;
+    static std::atomic<size_t> hits;
+    static std::atomic<size_t> misses;
+    static std::atomic<size_t> evictions;
+    static std::atomic<size_t> gpuBytes;
+    static std::atomic<size_t> cpuBytes;
+    static std::mutex trimMutex;
+};
@@ -2,6 +2,7 @@
 
 #include "ConstantBuffer.h"
 #include "IndexBuffer.h"
+#include "InstanceBuffer.h"
 #include "InputLayout.h"
 #include "PixelShader.h"
 #include "Topology.h"
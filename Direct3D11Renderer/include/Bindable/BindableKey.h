@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+
+// 64-bit structural key for BindableCache: a tag for the bindable's type mixed with the values
+// that make an instance unique (path, slot, mode, ...). Building one never allocates, unlike the
+// string UIDs, which are only produced on a cache miss for diagnostics.
+class BindableKey
+{
+public:
+	template<typename T>
+	static BindableKey Of() noexcept
+	{
+		// typeid names are static strings, so the tag is hashed once per type
+		static const uint64_t tag = HashBytes(OffsetBasis, typeid(T).name(), std::strlen(typeid(T).name()));
+		return BindableKey(tag);
+	}
+	BindableKey& Add(std::string_view text) noexcept
+	{
+		// length first so ("ab", "c") and ("a", "bc") hash differently
+		Add(text.size());
+		value = HashBytes(value, text.data(), text.size());
+		return *this;
+	}
+	template<typename V, typename = std::enable_if_t<std::is_integral_v<V> || std::is_enum_v<V>>>
+	BindableKey& Add(V v) noexcept
+	{
+		value = HashBytes(value, &v, sizeof(v));
+		return *this;
+	}
+	uint64_t Get() const noexcept
+	{
+		return value;
+	}
+private:
+	explicit BindableKey(uint64_t seed) noexcept
+		:
+		value(seed)
+	{}
+	// FNV-1a's offset basis as the seed, but eight bytes per step: byte at a time hashing made up
+	// half the cost of a cache hit on a texture path (see Benchmarks/BindableCacheBench.cpp)
+	static constexpr uint64_t OffsetBasis = 14695981039346656037ull;
+	static uint64_t HashBytes(uint64_t hash, const void* pData, size_t size) noexcept
+	{
+		const auto* pBytes = static_cast<const unsigned char*>(pData);
+		for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), pBytes += sizeof(uint64_t))
+		{
+			uint64_t word;
+			std::memcpy(&word, pBytes, sizeof(word));
+			hash = Mix(hash ^ word);
+		}
+		if (size > 0u)
+		{
+			// zero padded, strings hash their length first so "a" and "a\0" still differ
+			uint64_t word = 0u;
+			std::memcpy(&word, pBytes, size);
+			hash = Mix(hash ^ word);
+		}
+		return hash;
+	}
+	// the multiply carries every input bit upward, the shift folds the well mixed top half back down
+	static uint64_t Mix(uint64_t value) noexcept
+	{
+		value *= 0x9E3779B97F4A7C15ull;
+		return value ^ (value >> 29u);
+	}
+private:
+	uint64_t value;
+};
@@ -8,8 +8,10 @@ class Blender : public Bindable
 public:
 	Blender(Graphics& gfx, bool blendEnable);
 	void Bind(Graphics& gfx) noexcept override;
+	void Compile(DrawPacketBuilder& builder) override;
 	static std::shared_ptr<Blender> Resolve(Graphics& gfx, bool blendEnable = true) noexcept;
 	static std::string GenerateUID(bool blendEnable) noexcept;
+	static uint64_t GenerateKey(bool blendEnable) noexcept;
 	std::string GetUID() const noexcept override;
 private:
 	Microsoft::WRL::ComPtr<ID3D11BlendState> pBlender;
@@ -2,6 +2,7 @@
 
 #include "Bindable.h"
 #include "BindableCache.h"
+#include "RenderPass/DrawPacket.h"
 #include "Exceptions/GraphicsExceptions.h"
 #include <wrl.h>
 #include <typeinfo>
@@ -46,6 +47,10 @@ public:
 		memcpy(mappedResource.pData, &constBufferData, sizeof(C));
 		GetContext(gfx)->Unmap(pConstantBuffer.Get(), 0u);
 	}
+	MemoryFootprint GetMemoryFootprint() const noexcept override
+	{
+		return { sizeof(C), 0u };
+	}
 protected:
 	Microsoft::WRL::ComPtr<ID3D11Buffer> pConstantBuffer;
 	UINT slot;
@@ -56,12 +61,16 @@ class VertexConstantBuffer : public ConstantBuffer<C>
 {
 	using ConstantBuffer<C>::pConstantBuffer;
 	using ConstantBuffer<C>::slot;
-	using Bindable::GetContext;
+	using Bindable::GetStateCache;
 public:
 	using ConstantBuffer<C>::ConstantBuffer;
 	void Bind(Graphics& gfx) noexcept override
 	{
-		GetContext(gfx)->VSSetConstantBuffers(slot, 1u, pConstantBuffer.GetAddressOf());
+		GetStateCache(gfx).SetVertexConstantBuffer(slot, pConstantBuffer.Get());
+	}
+	void Compile(DrawPacketBuilder& builder) override
+	{
+		builder.AddVertexConstantBuffer(slot, pConstantBuffer.Get());
 	}
 	static std::shared_ptr<VertexConstantBuffer> Resolve(Graphics& gfx, const C& consts, UINT slot = 0)
 	{
@@ -80,6 +89,14 @@ public:
 		using namespace std::string_literals;
 		return typeid(VertexConstantBuffer).name() + "#"s + std::to_string(slot);
 	}
+	static uint64_t GenerateKey(const C&, UINT slot) noexcept
+	{
+		return GenerateKey(slot);
+	}
+	static uint64_t GenerateKey(UINT slot = 0) noexcept
+	{
+		return BindableKey::Of<VertexConstantBuffer>().Add(slot).Get();
+	}
 	std::string GetUID() const noexcept override
 	{
 		return GenerateUID(slot);
@@ -91,12 +108,16 @@ class PixelConstantBuffer : public ConstantBuffer<C>
 {
 	using ConstantBuffer<C>::pConstantBuffer;
 	using ConstantBuffer<C>::slot;
-	using Bindable::GetContext;
+	using Bindable::GetStateCache;
 public:
 	using ConstantBuffer<C>::ConstantBuffer;
 	void Bind(Graphics& gfx) noexcept override
 	{
-		GetContext(gfx)->PSSetConstantBuffers(slot, 1u, pConstantBuffer.GetAddressOf());
+		GetStateCache(gfx).SetPixelConstantBuffer(slot, pConstantBuffer.Get());
+	}
+	void Compile(DrawPacketBuilder& builder) override
+	{
+		builder.AddPixelConstantBuffer(slot, pConstantBuffer.Get());
 	}
 	static std::shared_ptr<PixelConstantBuffer> Resolve(Graphics& gfx, const C& consts, UINT slot = 0)
 	{
@@ -115,6 +136,14 @@ public:
 		using namespace std::string_literals;
 		return typeid(PixelConstantBuffer).name() + "#"s + std::to_string(slot);
 	}
+	static uint64_t GenerateKey(const C&, UINT slot) noexcept
+	{
+		return GenerateKey(slot);
+	}
+	static uint64_t GenerateKey(UINT slot = 0) noexcept
+	{
+		return BindableKey::Of<PixelConstantBuffer>().Add(slot).Get();
+	}
 	std::string GetUID() const noexcept override
 	{
 		return GenerateUID(slot);
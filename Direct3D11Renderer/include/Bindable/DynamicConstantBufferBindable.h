@@ -2,6 +2,7 @@
 
 #include "Bindable.h"
 #include "BindableCache.h"
+#include "ShaderStage.h"
 #include "Exceptions/GraphicsExceptions.h"
 #include "DynamicConstantBuffer/DynamicConstantBuffer.h"
 #include "DynamicConstantBuffer/LayoutCache.h"
@@ -21,19 +22,22 @@
 /// - Efficient GPU data uploads using dynamic mapping
 /// - Integration with the bindable cache system for resource sharing
 /// - Automatic dirty tracking to minimize GPU uploads
+/// - Binding one buffer to several shader stages (ShaderStage mask), so data shared by the
+///   vertex and pixel shaders is uploaded once instead of once per stage
 /// </file>
 
 /// <summary>
-/// Abstract base class for dynamic constant buffer bindables that bind to pixel shader slots.
+/// Abstract base class for dynamic constant buffer bindables. The buffer is bound at the same
+/// slot in every stage of its ShaderStage mask.
 /// Provides common functionality for DirectX 11 buffer management, data uploading, and
 /// GPU binding. Derived classes must implement GetRootLayoutElement() to provide layout information.
 ///
 /// This class handles the low-level DirectX 11 operations:
 /// - Creating dynamic constant buffers with D3D11_USAGE_DYNAMIC
 /// - Mapping/unmapping buffers for CPU writes
-/// - Binding buffers to the pixel shader pipeline stage
+/// - Binding buffers to each requested shader stage
 /// </summary>
-class DynamicPixelConstantBufferBindable : public Bindable
+class DynamicConstantBufferBindable : public Bindable
 {
 public:
     /// <summary>
@@ -46,12 +50,18 @@ public:
     void Update(Graphics& gfx, const D3::ConstantBufferData& buffer);
 
     /// <summary>
-    /// Binds this constant buffer to the pixel shader stage at the specified slot.
+    /// Binds this constant buffer to every stage in its mask at the specified slot.
     /// Called during the rendering pipeline to make the buffer available to shaders.
     /// </summary>
     /// <param name="gfx">Graphics context for DirectX operations</param>
     void Bind(Graphics& gfx) noexcept override;
 
+    /// <summary>
+    /// Records the buffer into a step's draw packet at this bindable's slot, once per stage.
+    /// </summary>
+    /// <param name="builder">Draw packet builder of the owning step</param>
+    void Compile(DrawPacketBuilder& builder) override;
+
     /// <summary>
     /// Pure virtual function that derived classes must implement to provide
     /// access to the root layout element for validation and size calculations.
@@ -59,6 +69,10 @@ public:
     /// <returns>Reference to the root LayoutElement defining this buffer's structure</returns>
     virtual const D3::LayoutElement& GetRootLayoutElement() const noexcept = 0;
 
+    /// <summary>Gets the shader stages this buffer binds to</summary>
+    /// <returns>Stage mask</returns>
+    ShaderStage GetStages() const noexcept;
+
 protected:
     /// <summary>
     /// Protected constructor for use by derived classes. Creates the DirectX 11 buffer
@@ -66,14 +80,17 @@ protected:
     /// </summary>
     /// <param name="gfx">Graphics context for buffer creation</param>
     /// <param name="layoutRoot">Root layout element defining buffer structure and size</param>
-    /// <param name="slot">Pixel shader slot number for binding</param>
+    /// <param name="slot">Constant buffer slot, the same in every bound stage</param>
+    /// <param name="stages">Shader stages the buffer binds to</param>
     /// <param name="pBuffer">Optional initial data to upload to the buffer</param>
-    DynamicPixelConstantBufferBindable(Graphics& gfx, const D3::LayoutElement& layoutRoot, UINT slot, const D3::ConstantBufferData* pBuffer = nullptr);
+    DynamicConstantBufferBindable(Graphics& gfx, const D3::LayoutElement& layoutRoot, UINT slot, ShaderStage stages, const D3::ConstantBufferData* pBuffer = nullptr);
 
     /// <summary>DirectX 11 constant buffer resource</summary>
     Microsoft::WRL::ComPtr<ID3D11Buffer> pConstantBuffer;
-    /// <summary>Pixel shader slot number for binding</summary>
+    /// <summary>Constant buffer slot number for binding</summary>
     UINT slot;
+    /// <summary>Shader stages the buffer is bound to</summary>
+    ShaderStage stages;
 };
 
 /// <summary>
@@ -93,7 +110,7 @@ protected:
 /// - Multiple objects might share the same buffer layout
 /// - You want automatic dirty tracking and efficient GPU uploads
 /// </summary>
-class CachingDynamicPixelConstantBufferBindable : public DynamicPixelConstantBufferBindable
+class CachingDynamicConstantBufferBindable : public DynamicConstantBufferBindable
 {
 public:
     /// <summary>
@@ -102,8 +119,9 @@ public:
     /// </summary>
     /// <param name="gfx">Graphics context for buffer creation</param>
     /// <param name="layout">Finalized layout defining buffer structure</param>
-    /// <param name="slot">Pixel shader slot number for binding</param>
-    CachingDynamicPixelConstantBufferBindable(Graphics& gfx, const D3::FinalizedLayout& layout, UINT slot);
+    /// <param name="slot">Constant buffer slot, the same in every bound stage</param>
+    /// <param name="stages">Shader stages the buffer binds to</param>
+    CachingDynamicConstantBufferBindable(Graphics& gfx, const D3::FinalizedLayout& layout, UINT slot, ShaderStage stages = ShaderStage::Pixel);
 
     /// <summary>
     /// Creates a caching constant buffer bindable from existing buffer data.
@@ -111,8 +129,9 @@ public:
     /// </summary>
     /// <param name="gfx">Graphics context for buffer creation</param>
     /// <param name="buffer">Source data and layout for the constant buffer</param>
-    /// <param name="slot">Pixel shader slot number for binding</param>
-    CachingDynamicPixelConstantBufferBindable(Graphics& gfx, const D3::ConstantBufferData& buffer, UINT slot);
+    /// <param name="slot">Constant buffer slot, the same in every bound stage</param>
+    /// <param name="stages">Shader stages the buffer binds to</param>
+    CachingDynamicConstantBufferBindable(Graphics& gfx, const D3::ConstantBufferData& buffer, UINT slot, ShaderStage stages = ShaderStage::Pixel);
 
     /// <summary>Returns the root layout element for this buffer</summary>
     const D3::LayoutElement& GetRootLayoutElement() const noexcept override;
@@ -122,7 +141,24 @@ public:
     const D3::ConstantBufferData& GetBuffer() const noexcept;
 
     /// <summary>
-    /// Updates the cached buffer data and marks it as dirty for the next GPU upload.
+    /// Content hash of the data the GPU buffer holds. Changes when Bind uploads an edit, so
+    /// steps can tell their material sort key went stale.
+    /// </summary>
+    /// <returns>Hash of the last upload, 0 before the first one (layout-only construction)</returns>
+    uint64_t GetUploadedHash() const noexcept;
+
+    /// <summary>
+    /// Checks whether binding other instead of this buffer would give the shaders the same
+    /// constants: same slot, stages and layout and byte-identical CPU data. Lets draws of separate
+    /// but equal materials be merged.
+    /// </summary>
+    /// <param name="other">Buffer to compare with</param>
+    /// <returns>True if the two are interchangeable</returns>
+    bool HasSameContents(const CachingDynamicConstantBufferBindable& other) const noexcept;
+
+    /// <summary>
+    /// Copies new data into the cached buffer. Only bytes that actually differ are marked
+    /// dirty, so re-applying identical values does not cause an upload.
     /// The new buffer data must have the same layout as the existing buffer.
     /// </summary>
     /// <param name="buffer">New buffer data to copy (layout must match)</param>
@@ -130,11 +166,19 @@ public:
 
     /// <summary>
     /// Binds the constant buffer, uploading dirty data to GPU if necessary.
-    /// Implements lazy upload strategy - data is only uploaded when dirty and binding is requested.
+    /// Implements lazy upload strategy - data is only uploaded when some bytes were written
+    /// and the content hash differs from what was last uploaded.
     /// </summary>
     /// <param name="gfx">Graphics context for operations</param>
     void Bind(Graphics& gfx) noexcept override;
 
+    /// <summary>
+    /// Keeps this bindable as a per-draw hook in the draw packet so pending
+    /// CPU-side changes still get uploaded on bind.
+    /// </summary>
+    /// <param name="builder">Draw packet builder of the owning step</param>
+    void Compile(DrawPacketBuilder& builder) override;
+
     /// <summary>
     /// Accepts a TechniqueProbe object, typically for visitor pattern operations.
     /// </summary>
@@ -142,25 +186,49 @@ public:
     void Accept(TechniqueProbe& probe) override;
 
     /// <summary>Creates or retrieves a cached bindable from the BindableCache using a layout</summary>
-    static std::shared_ptr<CachingDynamicPixelConstantBufferBindable> Resolve(Graphics& gfx, const D3::FinalizedLayout& layout, UINT slot = 1);
+    static std::shared_ptr<CachingDynamicConstantBufferBindable> Resolve(Graphics& gfx, const D3::FinalizedLayout& layout, UINT slot = 1, ShaderStage stages = ShaderStage::Pixel);
 
     /// <summary>Creates or retrieves a cached bindable from the BindableCache using buffer data</summary>
-    static std::shared_ptr<CachingDynamicPixelConstantBufferBindable> Resolve(Graphics& gfx, const D3::ConstantBufferData& buffer, UINT slot = 1);
+    static std::shared_ptr<CachingDynamicConstantBufferBindable> Resolve(Graphics& gfx, const D3::ConstantBufferData& buffer, UINT slot = 1, ShaderStage stages = ShaderStage::Pixel);
+
+    /// <summary>Generates unique identifier for BindableCache based on layout, slot and stages</summary>
+    static std::string GenerateUID(const D3::FinalizedLayout& layout, UINT slot, ShaderStage stages = ShaderStage::Pixel);
 
-    /// <summary>Generates unique identifier for BindableCache based on layout and slot</summary>
-    static std::string GenerateUID(const D3::FinalizedLayout& layout, UINT slot);
+    /// <summary>Generates unique identifier for BindableCache based on buffer data, slot and stages</summary>
+    static std::string GenerateUID(const D3::ConstantBufferData& buffer, UINT slot, ShaderStage stages = ShaderStage::Pixel);
 
-    /// <summary>Generates unique identifier for BindableCache based on buffer data and slot</summary>
-    static std::string GenerateUID(const D3::ConstantBufferData& buffer, UINT slot);
+    /// <summary>Generates the 64-bit BindableCache key based on layout, slot and stages</summary>
+    static uint64_t GenerateKey(const D3::FinalizedLayout& layout, UINT slot, ShaderStage stages = ShaderStage::Pixel);
+
+    /// <summary>Generates the 64-bit BindableCache key based on buffer data, slot and stages</summary>
+    static uint64_t GenerateKey(const D3::ConstantBufferData& buffer, UINT slot, ShaderStage stages = ShaderStage::Pixel);
 
     /// <summary>Returns the unique identifier for this bindable instance</summary>
     std::string GetUID() const noexcept override;
 
+    /// <summary>Reports the GPU buffer plus the CPU-side copy of its data</summary>
+    MemoryFootprint GetMemoryFootprint() const noexcept override;
+
+    /// <summary>Counters for dirty buffers that were uploaded versus skipped as unchanged</summary>
+    struct UploadStats
+    {
+        size_t performed = 0u;
+        size_t skipped = 0u;
+    };
+
+    /// <summary>Gets the upload counters accumulated across all caching buffers</summary>
+    /// <returns>Totals since startup</returns>
+    static const UploadStats& GetUploadStats() noexcept;
+
 private:
-    /// <summary>Flag indicating whether the buffer data has been modified since last GPU upload</summary>
-    bool isDirty = false;
+    /// <summary>Content hash of the data last uploaded to the GPU</summary>
+    uint64_t uploadedHash = 0u;
+    /// <summary>False until the GPU buffer holds the CPU data (layout-only construction)</summary>
+    bool uploaded = false;
     /// <summary>Cached copy of the constant buffer data on the CPU side</summary>
     D3::ConstantBufferData buffer;
+    /// <summary>Upload counters shared by all instances (bound from the render thread only)</summary>
+    static UploadStats uploadStats;
 };
 
 /// <summary>
@@ -180,7 +248,7 @@ private:
 /// - Data updates are infrequent or controlled externally
 /// - You don't need automatic dirty tracking
 /// </summary>
-class NoCacheDynamicPixelConstantBufferBindable : public DynamicPixelConstantBufferBindable
+class NoCacheDynamicConstantBufferBindable : public DynamicConstantBufferBindable
 {
 public:
     /// <summary>
@@ -189,8 +257,9 @@ public:
     /// </summary>
     /// <param name="gfx">Graphics context for buffer creation</param>
     /// <param name="layout">Finalized layout defining buffer structure</param>
-    /// <param name="slot">Pixel shader slot number for binding</param>
-    NoCacheDynamicPixelConstantBufferBindable(Graphics& gfx, const D3::FinalizedLayout& layout, UINT slot);
+    /// <param name="slot">Constant buffer slot, the same in every bound stage</param>
+    /// <param name="stages">Shader stages the buffer binds to</param>
+    NoCacheDynamicConstantBufferBindable(Graphics& gfx, const D3::FinalizedLayout& layout, UINT slot, ShaderStage stages = ShaderStage::Pixel);
 
     /// <summary>
     /// Creates a non-caching constant buffer bindable from existing buffer data.
@@ -198,8 +267,9 @@ public:
     /// </summary>
     /// <param name="gfx">Graphics context for buffer creation</param>
     /// <param name="buffer">Source data and layout for initial GPU upload</param>
-    /// <param name="slot">Pixel shader slot number for binding</param>
-    NoCacheDynamicPixelConstantBufferBindable(Graphics& gfx, const D3::ConstantBufferData& buffer, UINT slot);
+    /// <param name="slot">Constant buffer slot, the same in every bound stage</param>
+    /// <param name="stages">Shader stages the buffer binds to</param>
+    NoCacheDynamicConstantBufferBindable(Graphics& gfx, const D3::ConstantBufferData& buffer, UINT slot, ShaderStage stages = ShaderStage::Pixel);
 
     /// <summary>Returns the root layout element for this buffer</summary>
     const D3::LayoutElement& GetRootLayoutElement() const noexcept override;
@@ -1,29 +1,52 @@
 #pragma once
 #include "Bindable.h"
+#include <functional>
 #include <vector>
 #include <wrl.h>
 #include <memory>
 
+// Indices are stored as 16 bits whenever every index fits, and as 32 bits otherwise, so meshes
+// over 65,535 vertices draw correctly while small meshes keep the bandwidth saving.
 class IndexBuffer : public Bindable
 {
+public:
+	// produces the indices on demand, so expensive preprocessing only runs on a cache miss
+	using Source = std::function<const std::vector<unsigned int>&()>;
 public:
 	IndexBuffer(Graphics& gfx, const std::vector<unsigned short>& indices);
 	IndexBuffer(Graphics& gfx, std::string tag, const std::vector<unsigned short>& indices);
+	IndexBuffer(Graphics& gfx, const std::vector<unsigned int>& indices);
+	IndexBuffer(Graphics& gfx, std::string tag, const std::vector<unsigned int>& indices);
+	IndexBuffer(Graphics& gfx, std::string tag, const Source& source);
 	void Bind(Graphics& gfx) noexcept override;
 	UINT GetCount() const noexcept;
+	// DXGI_FORMAT_R16_UINT or DXGI_FORMAT_R32_UINT
+	DXGI_FORMAT GetFormat() const noexcept;
 	std::string GetUID() const noexcept override;
+	MemoryFootprint GetMemoryFootprint() const noexcept override;
 
 	static std::shared_ptr<IndexBuffer> Resolve(Graphics& gfx, const std::string tag,
 		const std::vector<unsigned short>& indices);
+	static std::shared_ptr<IndexBuffer> Resolve(Graphics& gfx, const std::string tag,
+		const std::vector<unsigned int>& indices);
+	static std::shared_ptr<IndexBuffer> Resolve(Graphics& gfx, const std::string tag,
+		const Source& source);
 	template<typename... Ignore>
 	static std::string GenerateUID(const std::string& tag, Ignore&&... ignore)
 	{
 		return GenerateUID_(tag);
 	}
+	template<typename... Ignore>
+	static uint64_t GenerateKey(const std::string& tag, Ignore&&... ignore) noexcept
+	{
+		return BindableKey::Of<IndexBuffer>().Add(tag).Get();
+	}
 protected:
 	UINT count;
+	DXGI_FORMAT format = DXGI_FORMAT_R16_UINT;
 	std::string tag;
 	Microsoft::WRL::ComPtr<ID3D11Buffer> pIndexBuffer;
 private:
+	void CreateBuffer(Graphics& gfx, const void* pIndices, UINT indexSize);
 	static std::string GenerateUID_(const std::string& tag);
 };
\ No newline at end of file
@@ -10,14 +10,18 @@
 class InputLayout : public Bindable
 {
 public:
-	InputLayout(Graphics& gfx, D3::VertexLayout layout, ID3DBlob* pVertexShaderByteCode);
+	// instanced appends the InstanceBuffer per-instance elements after the vertex elements
+	InputLayout(Graphics& gfx, D3::VertexLayout layout, ID3DBlob* pVertexShaderByteCode, bool instanced = false);
 	void Bind(Graphics& gfx) noexcept override;
+	void Compile(DrawPacketBuilder& builder) override;
 	std::string GetUID() const noexcept override;
 	const D3::VertexLayout GetLayout() const noexcept;
 
-	static std::shared_ptr<InputLayout> Resolve(Graphics& gfx, D3::VertexLayout layout, ID3DBlob* pVertexShaderByteCode);
-	static std::string GenerateUID(const D3::VertexLayout& layout, ID3DBlob* pVertexShaderByteCode = nullptr);
+	static std::shared_ptr<InputLayout> Resolve(Graphics& gfx, D3::VertexLayout layout, ID3DBlob* pVertexShaderByteCode, bool instanced = false);
+	static std::string GenerateUID(const D3::VertexLayout& layout, ID3DBlob* pVertexShaderByteCode = nullptr, bool instanced = false);
+	static uint64_t GenerateKey(const D3::VertexLayout& layout, ID3DBlob* pVertexShaderByteCode = nullptr, bool instanced = false) noexcept;
 protected:
 	D3::VertexLayout layout;
+	bool instanced;
 	Microsoft::WRL::ComPtr<ID3D11InputLayout> pInputLayout;
 };
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include "Bindable.h"
+#include <DirectXMath.h>
+#include <array>
+#include <vector>
+#include <wrl.h>
+
+// Dynamic per-instance vertex buffer bound to input slot 1. Holds the transforms that
+// TransformConstantBuffer would otherwise upload once per draw, so a run of identical
+// jobs can be issued as one DrawIndexedInstanced.
+class InstanceBuffer : public Bindable
+{
+public:
+	static constexpr UINT Slot = 1u;
+
+	// matrices are stored untransposed, the instanced shaders rebuild them from rows
+	struct InstanceData
+	{
+		DirectX::XMFLOAT4X4 modelView;
+		DirectX::XMFLOAT4X4 modelViewProj;
+	};
+public:
+	InstanceBuffer(Graphics& gfx, UINT capacity = 64u);
+	void Update(Graphics& gfx, const std::vector<InstanceData>& instances);
+	void Bind(Graphics& gfx) noexcept override;
+	UINT GetCapacity() const noexcept;
+	// per-instance elements to append to a mesh's input layout for the *_Instanced_VS shaders
+	static const std::array<D3D11_INPUT_ELEMENT_DESC, 8>& GetInputElements() noexcept;
+private:
+	void Allocate(Graphics& gfx, UINT capacity_in);
+private:
+	UINT capacity = 0u;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> pInstanceBuffer;
+};
@@ -7,7 +7,9 @@ class NullPixelShader : public Bindable
 public:
 	NullPixelShader(Graphics& gfx);
 	void Bind(Graphics& gfx) noexcept override;
+	void Compile(DrawPacketBuilder& builder) override;
 	static std::shared_ptr<NullPixelShader> Resolve(Graphics& gfx);
 	static std::string GenerateUID();
+	static uint64_t GenerateKey() noexcept;
 	std::string GetUID() const noexcept override;
 };
\ No newline at end of file
@@ -9,10 +9,14 @@ class PixelShader : public Bindable
 public:
 	PixelShader(Graphics& gfx, const std::string& path);
 	void Bind(Graphics& gfx) noexcept override;
+	void Compile(DrawPacketBuilder& builder) override;
 	static std::shared_ptr<PixelShader> Resolve(Graphics& gfx, const std::string& path);
 	static std::string GenerateUID(const std::string& path);
+	static uint64_t GenerateKey(const std::string& path) noexcept;
 	std::string GetUID() const noexcept override;
+	MemoryFootprint GetMemoryFootprint() const noexcept override;
 protected:
 	std::string path;
+	size_t byteCodeSize = 0u;
 	Microsoft::WRL::ComPtr<ID3D11PixelShader> pPixelShader;
 };
\ No newline at end of file
@@ -7,8 +7,10 @@ class Rasterizer : public Bindable
 public:
 	Rasterizer(Graphics& gfx, bool twoSided = false);
 	void Bind(Graphics& gfx) noexcept override;
+	void Compile(DrawPacketBuilder& builder) override;
 	static std::shared_ptr<Rasterizer> Resolve(Graphics& gfx, bool twoSided = false);
 	static std::string GenerateUID(bool twoSided = false);
+	static uint64_t GenerateKey(bool twoSided = false) noexcept;
 	std::string GetUID() const noexcept override;
 private:
 	Microsoft::WRL::ComPtr<ID3D11RasterizerState> pRasterizer;
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Bindable.h"
+#include <wrl.h>
+
+/** @brief Texture that passes render into and later passes sample.
+ *
+ *  Backs one physical slot of the render graph; every transient resource the graph
+ *  assigns to that slot renders into the same texture. Binding it as a bindable
+ *  exposes it to the pixel shader, BindAsTarget makes it the output of the pipeline.
+ *  Not cached: the FrameManager owns one per physical slot.
+ */
+class RenderTarget : public Bindable
+{
+public:
+	/** @brief Creates the texture with render target and shader resource views.
+	 *  @param gfx Graphics context for D3D11 operations
+	 *  @param width Width in pixels
+	 *  @param height Height in pixels
+	 *  @param format Texel format of the texture
+	 *  @param slot Pixel shader resource slot Bind() uses
+	 */
+	RenderTarget(Graphics& gfx, UINT width, UINT height, DXGI_FORMAT format, UINT slot = 0u);
+
+	/** @brief Binds the texture to the pixel shader at the slot given on construction.
+	 *  @param gfx Graphics context for binding operations
+	 */
+	void Bind(Graphics& gfx) noexcept override;
+
+	/** @brief Makes this the only render target, without depth/stencil, and sizes the viewport to it.
+	 *  @param gfx Graphics context for binding operations
+	 *  @note Unbinds the texture from the pixel shader first, it cannot be read and written at once
+	 */
+	void BindAsTarget(Graphics& gfx) noexcept;
+
+	/** @brief Fills the texture with a color.
+	 *  @param gfx Graphics context
+	 *  @param color RGBA clear color
+	 */
+	void Clear(Graphics& gfx, const float color[4]) noexcept;
+
+	/** @brief Reports the texture size.
+	 *  @return Footprint of the single mip level
+	 */
+	MemoryFootprint GetMemoryFootprint() const noexcept override;
+
+	UINT GetWidth() const noexcept;
+	UINT GetHeight() const noexcept;
+private:
+	UINT width;                                                    /**< Width in pixels */
+	UINT height;                                                   /**< Height in pixels */
+	UINT slot;                                                     /**< Pixel shader resource slot */
+	size_t bytesPerTexel;                                          /**< Size of one texel of the format */
+	Microsoft::WRL::ComPtr<ID3D11RenderTargetView> pTargetView;    /**< Output view */
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> pTextureView; /**< Shader input view */
+};
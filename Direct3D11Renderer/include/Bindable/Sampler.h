@@ -7,9 +7,11 @@ class Sampler : public Bindable
 public:
 	Sampler(Graphics& gfx);
 	void Bind(Graphics& gfx) noexcept override;
+	void Compile(DrawPacketBuilder& builder) override;
 	std::string GetUID() const noexcept override;
 	static std::shared_ptr<Sampler> Resolve(Graphics& gfx);
 	static std::string GenerateUID();
+	static uint64_t GenerateKey() noexcept;
 protected:
 	Microsoft::WRL::ComPtr<ID3D11SamplerState> pSampler;
 };
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+// Bit mask of programmable pipeline stages a bindable binds to. Add new stages as further bits;
+// bindables that understand a stage test for it with HasStage and ignore the rest.
+enum class ShaderStage : uint32_t
+{
+	None = 0u,
+	Vertex = 1u << 0,
+	Pixel = 1u << 1,
+	Both = Vertex | Pixel,
+};
+
+constexpr ShaderStage operator|(ShaderStage lhs, ShaderStage rhs) noexcept
+{
+	return static_cast<ShaderStage>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+}
+
+constexpr ShaderStage operator&(ShaderStage lhs, ShaderStage rhs) noexcept
+{
+	return static_cast<ShaderStage>(static_cast<uint32_t>(lhs) & static_cast<uint32_t>(rhs));
+}
+
+constexpr bool HasStage(ShaderStage mask, ShaderStage stage) noexcept
+{
+	return (mask & stage) != ShaderStage::None;
+}
+
+// short tag used in bindable UIDs, e.g. "VP" for vertex + pixel
+inline const char* GetStageTag(ShaderStage mask) noexcept
+{
+	switch (mask)
+	{
+	case ShaderStage::Vertex: return "V";
+	case ShaderStage::Pixel: return "P";
+	case ShaderStage::Both: return "VP";
+	default: return "?";
+	}
+}
@@ -15,8 +15,10 @@ public:
 	Stencil(Graphics& gfx, Mode mode);
 
 	void Bind(Graphics& gfx) noexcept override;
+	void Compile(DrawPacketBuilder& builder) override;
 	static std::shared_ptr<Stencil> Resolve(Graphics& gfx, Mode mode);
 	static std::string GenerateUID(Mode mode);
+	static uint64_t GenerateKey(Mode mode) noexcept;
 	std::string GetUID() const noexcept override;
 
 private:
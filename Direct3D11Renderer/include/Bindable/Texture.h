@@ -29,11 +29,21 @@ public:
 	 */
 	void Bind(Graphics& gfx) noexcept override;
 	
+	/** @brief Records this texture's view into a draw packet.
+	 *  @param builder Packet builder of the owning step
+	 */
+	void Compile(DrawPacketBuilder& builder) override;
+	
 	/** @brief Gets the unique identifier for this texture.
 	 *  @return UID string combining type name, path, and slot
 	 */
 	std::string GetUID() const noexcept override;
 
+	/** @brief Estimates the GPU memory used by the texture and its mip chain.
+	 *  @return Footprint derived from the texture description
+	 */
+	MemoryFootprint GetMemoryFootprint() const noexcept override;
+
 	/** @brief Resolves a texture from the bindable cache or creates new one.
 	 *  @param gfx Graphics context
 	 *  @param path File path to the texture
@@ -48,6 +58,13 @@ public:
 	 *  @return Generated UID string
 	 */
 	static std::string GenerateUID(const std::string& path, UINT slot);
+
+	/** @brief Generates the allocation-free cache key for the same parameters as GenerateUID.
+	 *  @param path File path of the texture
+	 *  @param slot Shader resource slot
+	 *  @return 64-bit key used by BindableCache
+	 */
+	static uint64_t GenerateKey(const std::string& path, UINT slot) noexcept;
 	
 	/** @brief Checks if the texture has an active alpha channel.
 	 *  @return True if alpha channel contains non-255 values
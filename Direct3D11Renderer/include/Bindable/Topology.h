@@ -10,6 +10,7 @@ public:
 
 	static std::shared_ptr<Topology> Resolve(Graphics& gfx, D3D11_PRIMITIVE_TOPOLOGY topology) noexcept;
 	static std::string GenerateUID(D3D11_PRIMITIVE_TOPOLOGY topology) noexcept;
+	static uint64_t GenerateKey(D3D11_PRIMITIVE_TOPOLOGY topology) noexcept;
 protected:
 	D3D11_PRIMITIVE_TOPOLOGY topology;
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include "ConstantBuffer.h"
+#include "ShaderStage.h"
 #include "Renderable/Renderable.h"
 #include <DirectXMath.h>
 #include <memory>
@@ -7,13 +8,13 @@
 class TransformConstantBuffer : public Bindable
 {
 public:
-	enum class ShaderStage { Vertex = 1, Pixel = 2, Both = 3 };
-	
 	TransformConstantBuffer(Graphics& gfx, UINT slot = 0u);
 	TransformConstantBuffer(Graphics& gfx, ShaderStage stages, 
 						   UINT vertexSlot = 0u, UINT pixelSlot = 0u);
 	void Bind(Graphics& gfx) noexcept override;
 	void InitializeParentReference(const Renderable& parent) noexcept override;
+	std::shared_ptr<Bindable> Clone() const override;
+	ShaderStage GetStages() const noexcept;
 	
 protected:
 	struct TransformBuffer
@@ -3,25 +3,37 @@
 #include "BindableCommon.h"
 #include "Exceptions/GraphicsExceptions.h"
 #include "Geometry/Vertex.h"
+#include <functional>
 #include <vector>
 #include <wrl.h>
 
 class VertexBuffer : public Bindable
 {
+public:
+	// produces the vertices on demand, so expensive preprocessing only runs on a cache miss
+	using Source = std::function<const D3::VertexBuffer&()>;
 public:
 	VertexBuffer(Graphics& gfx, std::string tag, const D3::VertexBuffer& vbuf);
+	VertexBuffer(Graphics& gfx, std::string tag, const Source& source);
 	VertexBuffer(Graphics& gfx, const D3::VertexBuffer& vbuf) noexcept(!_DEBUG);
 	void Bind(Graphics& gfx) noexcept override;
 	std::string GetUID() const noexcept override;
+	MemoryFootprint GetMemoryFootprint() const noexcept override;
 	const D3::VertexLayout& GetLayout() const noexcept;
 
 	static std::shared_ptr<VertexBuffer> Resolve(Graphics& gfx, const std::string& tag, const D3::VertexBuffer& vbuf);
+	static std::shared_ptr<VertexBuffer> Resolve(Graphics& gfx, const std::string& tag, const Source& source);
 
 	template<typename ... Ignore>
 	static std::string GenerateUID(const std::string& tag, Ignore&&... ignore)
 	{
 		return GenerateUID_(tag);
 	}
+	template<typename... Ignore>
+	static uint64_t GenerateKey(const std::string& tag, Ignore&&... ignore) noexcept
+	{
+		return BindableKey::Of<VertexBuffer>().Add(tag).Get();
+	}
 protected:
 	UINT stride;
 	std::string tag;
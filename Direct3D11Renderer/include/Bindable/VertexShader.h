@@ -10,10 +10,13 @@ class VertexShader : public Bindable
 public:
 	VertexShader(Graphics& gfx, const std::string& path);
 	void Bind(Graphics& gfx) noexcept override;
+	void Compile(DrawPacketBuilder& builder) override;
 	ID3DBlob* GetByteCode() const noexcept;
 	static std::shared_ptr<VertexShader> Resolve(Graphics& gfx, const std::string& path);
 	static std::string GenerateUID(const std::string& path);
+	static uint64_t GenerateKey(const std::string& path) noexcept;
 	std::string GetUID() const noexcept override;
+	MemoryFootprint GetMemoryFootprint() const noexcept override;
 protected:
 	std::string path;
 	Microsoft::WRL::ComPtr<ID3DBlob> pByteCodeBlob;
@@ -1,6 +1,7 @@
 #pragma once
 #include "Utilities/ChiliWin.h"
 #include <DirectXMath.h>
+#include "Camera/Frustum.h"
 
 // Forward declarations
 class Window;
@@ -68,6 +69,14 @@ public:
 	/// <returns>A DirectX::XMMATRIX representing the projection matrix for the given viewport size.</returns>
 	DirectX::XMMATRIX GetProjectionMatrix(float viewportWidth, float viewportHeight) const noexcept;
 
+	/// <summary>
+	/// Returns the world-space view frustum for the specified viewport dimensions.
+	/// </summary>
+	/// <param name="viewportWidth">The width of the viewport in pixels.</param>
+	/// <param name="viewportHeight">The height of the viewport in pixels.</param>
+	/// <returns>The frustum built from the current view and projection matrices.</returns>
+	Frustum GetFrustum(float viewportWidth, float viewportHeight) const noexcept;
+
     /**
      * @brief Processes all input and updates camera state
      * 
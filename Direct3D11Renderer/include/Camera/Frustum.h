@@ -0,0 +1,22 @@
+#pragma once
+#include <DirectXMath.h>
+#include "Geometry/AABB.h"
+
+// View frustum as six world-space planes, stored transposed (x / y / z / w of four planes per
+// vector) so a box can be tested against four planes at once. A default constructed frustum
+// contains everything.
+class Frustum
+{
+public:
+	Frustum() noexcept;
+	// extracts the planes from a combined view * projection matrix (Gribb / Hartmann)
+	static Frustum FromViewProjection(DirectX::FXMMATRIX viewProjection) noexcept;
+	// conservative, boxes straddling a plane or near a frustum corner count as visible
+	bool Intersects(const AABB& box) const noexcept;
+private:
+	// planes 0-3 in the first vector of each array, planes 4-5 (repeated) in the second
+	DirectX::XMFLOAT4A planeX[2];
+	DirectX::XMFLOAT4A planeY[2];
+	DirectX::XMFLOAT4A planeZ[2];
+	DirectX::XMFLOAT4A planeW[2];
+};
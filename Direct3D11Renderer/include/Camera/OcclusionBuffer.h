@@ -0,0 +1,61 @@
+#pragma once
+#include <DirectXMath.h>
+#include <vector>
+#include "Geometry/AABB.h"
+
+// Low resolution CPU depth buffer for software occlusion culling. Each frame the big, cheap
+// meshes marked as occluders are rasterized into it, then bounding boxes are tested against the
+// result before their meshes are submitted. Only depends on DirectXMath, so it runs (and can be
+// exercised) without a D3D device.
+//
+// Usage per frame: BeginFrame(viewProj) -> AddOccluder(...)* -> Rasterize() -> IsVisible(...)*
+class OcclusionBuffer
+{
+public:
+	// CPU copy of an occluder's triangles in mesh space
+	struct OccluderMesh
+	{
+		std::vector<DirectX::XMFLOAT3> positions;
+		std::vector<unsigned int> indices;
+	};
+	struct Stats
+	{
+		size_t occludersDrawn = 0u;
+		size_t trianglesRasterized = 0u;
+		size_t occludeesTested = 0u;
+		size_t occludeesRejected = 0u;
+	};
+	// rows per band, bands are rasterized in parallel
+	static constexpr unsigned int BandHeight = 16u;
+public:
+	// width is rounded up to a multiple of 4 so rows can be processed four pixels at a time
+	OcclusionBuffer(unsigned int width = 320u, unsigned int height = 180u);
+	// clears depth, triangles and stats
+	void BeginFrame(DirectX::FXMMATRIX viewProjection) noexcept;
+	// transforms and bins the occluder's triangles, nothing is rasterized until Rasterize()
+	void AddOccluder(const OccluderMesh& occluder, DirectX::FXMMATRIX world);
+	void Rasterize();
+	// conservative test of a world-space box, false only if it is completely hidden
+	bool IsVisible(const AABB& box) noexcept;
+	const Stats& GetStats() const noexcept;
+	unsigned int GetWidth() const noexcept;
+	unsigned int GetHeight() const noexcept;
+	// row-major depth, 0 = near plane and 1 = far plane / nothing drawn
+	const float* GetDepth() const noexcept;
+private:
+	// screen-space x / y in pixels and depth in z
+	struct Triangle
+	{
+		DirectX::XMFLOAT3 v[3];
+	};
+	void RasterizeBand(unsigned int band) noexcept;
+private:
+	unsigned int width;
+	unsigned int height;
+	DirectX::XMFLOAT4X4 viewProjection;
+	std::vector<float> depth;
+	std::vector<Triangle> triangles;
+	std::vector<DirectX::XMFLOAT4> clipScratch;
+	std::vector<unsigned int> bands;
+	Stats stats;
+};
@@ -1,11 +1,13 @@
 #pragma once
 #include "Window.h"
 #include "Utilities/D3Timer.h"
+#include "Utilities/AllocationCounter.h"
 #include "Renderable/Renderable.h"
 #include "Renderable/Model/Model.h"
 #include "Renderable/TestCube.h"
 #include "Camera/FreeFlyCamera.h"
 #include "Renderable/PointLight.h"
+#include "Camera/OcclusionBuffer.h"
 #include <vector>
 #include <memory>
 #include <set>
@@ -18,6 +20,10 @@ public:
 private:
 	void ProcessFrame();
 	void SpawnSimulationWindow() noexcept;
+	// draws the wall into the occlusion buffer, SubmitModels tests the suits against it
+	void RasterizeOccluders(const Frustum& frustum);
+	// submits what survives frustum and occlusion culling
+	void SubmitModels(const Frustum& frustum);
 
 	FreeFlyCamera camera;
 	Window wnd;
@@ -25,7 +31,14 @@ private:
 	FrameManager frameManager;
 	static float ui_speed_factor;
 	float speed_factor = 1.0f;
+	// heap allocations made while submitting and executing the last frame (debug builds only)
+	size_t frameAllocations = 0u;
 	PointLight light;
-	//std::unique_ptr<Model> model;
+	// a row of nanosuits, most of them standing behind the brick wall
+	std::vector<std::unique_ptr<Model>> suits;
+	std::unique_ptr<Model> wall;
+	OcclusionBuffer occlusion;
+	// summed over the suits for the last frame
+	Node::CullStats suitCullStats;
 	std::vector<std::unique_ptr<TestCube>> testCubes;
 };
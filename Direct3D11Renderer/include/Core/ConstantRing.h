@@ -0,0 +1,61 @@
+#pragma once
+#include "Utilities/ChiliWin.h"
+#include "Utilities/RingAllocator.h"
+#include <d3d11_1.h>
+#include <wrl.h>
+#include <cstddef>
+#include <optional>
+
+class Graphics;
+#ifdef _DEBUG
+class DxgiDebugManager;
+#endif
+
+// Frame-scoped suballocator for per-draw constant data. Every push lands in one large dynamic constant
+// buffer: appends are mapped with MAP_WRITE_NO_OVERWRITE, the first push of each frame (and any push
+// after the ring wraps) with MAP_WRITE_DISCARD, and the data is bound by offset through the D3D11.1
+// *SetConstantBuffers1 calls. This needs the ConstantBufferOffsetting and MapNoOverwriteOnDynamicConstantBuffer
+// options; without them IsSupported() is false and callers keep using their own small constant buffers.
+class ConstantRing
+{
+public:
+	struct Allocation
+	{
+		ID3D11Buffer* pBuffer;
+		// in 16-byte shader constants, both multiples of 16 as *SetConstantBuffers1 requires
+		UINT firstConstant;
+		UINT numConstants;
+	};
+	struct Stats
+	{
+		size_t pushes = 0u;
+		size_t bytes = 0u;
+		size_t discards = 0u;
+	};
+public:
+	ConstantRing(Graphics& gfx, size_t capacity = 1024u * 1024u);
+	ConstantRing(const ConstantRing&) = delete;
+	ConstantRing& operator=(const ConstantRing&) = delete;
+
+	bool IsSupported() const noexcept;
+	// starts a new generation so the frame's first push renames the buffer instead of syncing with the GPU
+	void BeginFrame() noexcept;
+	// closes the current frame's counters, GetStats() reports the frame that just ended
+	void EndFrame() noexcept;
+	// copies size bytes into the ring, the returned window is valid for draws issued this frame.
+	// nullopt if size is 0 or larger than the whole ring, the caller has to bind its own buffer then
+	std::optional<Allocation> Push(Graphics& gfx, const void* pData, size_t size);
+	const Stats& GetStats() const noexcept;
+private:
+#ifdef _DEBUG
+	static DxgiDebugManager& GetInfoManager(Graphics& gfx) noexcept;
+#endif
+private:
+	// *SetConstantBuffers1 offsets and sizes must be multiples of 16 constants
+	static constexpr size_t ConstantAlignment = 16u * 16u;
+	bool supported = false;
+	RingAllocator allocator;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> pBuffer;
+	Stats current;
+	Stats last;
+};
@@ -1,8 +1,11 @@
 #pragma once
 #include "Utilities/ChiliWin.h"
 #include "Exceptions/GraphicsExceptions.h" 
-#include <d3d11.h>
+#include "Core/PipelineStateCache.h"
+#include "Core/ConstantRing.h"
+#include <d3d11_1.h>
 #include <vector>
+#include <memory>
 #include <wrl.h>
 #include <DirectXMath.h>
 #ifdef _DEBUG
@@ -20,6 +23,14 @@ public:
     void BeginFrame(float red, float green, float blue);
     void EndFrame();
     void DrawIndexed(UINT count) noexcept(!_DEBUG);
+    void DrawIndexedInstanced(UINT indexCount, UINT instanceCount) noexcept(!_DEBUG);
+    // non-indexed draw, for fullscreen passes that generate their vertices in the shader
+    void Draw(UINT vertexCount) noexcept(!_DEBUG);
+    // restores the swap chain target, the main depth/stencil and the full viewport after a pass
+    // rendered somewhere else
+    void BindBackBuffer() noexcept;
+    UINT GetWidth() const noexcept;
+    UINT GetHeight() const noexcept;
 
     DirectX::XMMATRIX GetProjection() const noexcept;
     void SetProjection(DirectX::FXMMATRIX proj) noexcept;
@@ -35,6 +46,10 @@ public:
 
 	ID3D11DeviceContext* const GetContext() noexcept;
     ID3D11Device* const GetDevice() noexcept;
+    // nullptr when the D3D11.1 runtime is not available
+    ID3D11DeviceContext1* const GetContext1() noexcept;
+    PipelineStateCache& GetStateCache() noexcept;
+    ConstantRing& GetConstantRing() noexcept;
 #ifdef _DEBUG
 	DxgiDebugManager& GetInfoManager() noexcept;
 #endif
@@ -51,7 +66,10 @@ private:
     Microsoft::WRL::ComPtr<ID3D11Device> pDevice;
     Microsoft::WRL::ComPtr<IDXGISwapChain> pSwapChain;
     Microsoft::WRL::ComPtr<ID3D11DeviceContext> pContext;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext1> pContext1;
     Microsoft::WRL::ComPtr<ID3D11RenderTargetView> pTarget;
 	Microsoft::WRL::ComPtr<ID3D11DepthStencilView> pDepthStencilView;
+    std::unique_ptr<PipelineStateCache> pStateCache;
+    std::unique_ptr<ConstantRing> pConstantRing;
 };
 
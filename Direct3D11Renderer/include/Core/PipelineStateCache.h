@@ -0,0 +1,180 @@
+#pragma once
+#include "Utilities/ChiliWin.h"
+#include <d3d11_1.h>
+#include <array>
+#include <cstddef>
+
+// Shadow copy of the pipeline state bound through the renderer. Every set call is compared
+// against what was last issued for that stage / slot and dropped if it would be a no-op.
+// Anything that touches the context behind our back (e.g. ImGui) must be followed by Invalidate().
+class PipelineStateCache
+{
+public:
+    struct Stats
+    {
+        size_t issued = 0u;
+        size_t skipped = 0u;
+    };
+public:
+    // pContext1 is optional, the offset binding calls below require it
+    PipelineStateCache(ID3D11DeviceContext* pContext, ID3D11DeviceContext1* pContext1 = nullptr) noexcept;
+    PipelineStateCache(const PipelineStateCache&) = delete;
+    PipelineStateCache& operator=(const PipelineStateCache&) = delete;
+
+    // forget everything we think is bound, the next set call for each slot will be issued
+    void Invalidate() noexcept;
+    // closes the current frame's counters, GetStats() reports the frame that just ended
+    void EndFrame() noexcept;
+    const Stats& GetStats() const noexcept;
+
+    void SetInputLayout(ID3D11InputLayout* pLayout) noexcept;
+    void SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) noexcept;
+    void SetVertexBuffer(UINT slot, ID3D11Buffer* pBuffer, UINT stride, UINT offset) noexcept;
+    void SetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset) noexcept;
+
+    void SetVertexShader(ID3D11VertexShader* pShader) noexcept;
+    void SetVertexConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept;
+
+    void SetPixelShader(ID3D11PixelShader* pShader) noexcept;
+    void SetPixelConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept;
+    void SetPixelShaderResource(UINT slot, ID3D11ShaderResourceView* pView) noexcept;
+    void SetPixelSampler(UINT slot, ID3D11SamplerState* pSampler) noexcept;
+    // clears every pixel slot the view is bound to, needed before its texture becomes a render target
+    // (the runtime would unbind it silently and the shadow copy would go stale)
+    void UnbindPixelShaderResource(ID3D11ShaderResourceView* pView) noexcept;
+
+    // range variants issue a single call for the whole range if any slot in it changed
+    void SetVertexConstantBuffers(UINT startSlot, UINT count, ID3D11Buffer* const* ppBuffers) noexcept;
+    void SetPixelConstantBuffers(UINT startSlot, UINT count, ID3D11Buffer* const* ppBuffers) noexcept;
+    void SetPixelShaderResources(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* ppViews) noexcept;
+    void SetPixelSamplers(UINT startSlot, UINT count, ID3D11SamplerState* const* ppSamplers) noexcept;
+
+    // bind a window of a larger buffer (offsets in 16-byte constants, multiples of 16), D3D11.1 only
+    void SetVertexConstantBuffer1(UINT slot, ID3D11Buffer* pBuffer, UINT firstConstant, UINT numConstants) noexcept;
+    void SetPixelConstantBuffer1(UINT slot, ID3D11Buffer* pBuffer, UINT firstConstant, UINT numConstants) noexcept;
+
+    void SetRasterizerState(ID3D11RasterizerState* pState) noexcept;
+    void SetBlendState(ID3D11BlendState* pState, UINT sampleMask) noexcept;
+    void SetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef) noexcept;
+private:
+    template<typename T>
+    struct Shadow
+    {
+        T value{};
+        bool valid = false;
+    };
+    struct VertexBufferState
+    {
+        ID3D11Buffer* pBuffer;
+        UINT stride;
+        UINT offset;
+        bool operator==(const VertexBufferState& rhs) const noexcept
+        {
+            return pBuffer == rhs.pBuffer && stride == rhs.stride && offset == rhs.offset;
+        }
+    };
+    struct IndexBufferState
+    {
+        ID3D11Buffer* pBuffer;
+        DXGI_FORMAT format;
+        UINT offset;
+        bool operator==(const IndexBufferState& rhs) const noexcept
+        {
+            return pBuffer == rhs.pBuffer && format == rhs.format && offset == rhs.offset;
+        }
+    };
+    // numConstants == 0 means the whole buffer was bound through the non-offset call
+    struct ConstantBufferState
+    {
+        ID3D11Buffer* pBuffer;
+        UINT firstConstant;
+        UINT numConstants;
+        bool operator==(const ConstantBufferState& rhs) const noexcept
+        {
+            return pBuffer == rhs.pBuffer && firstConstant == rhs.firstConstant && numConstants == rhs.numConstants;
+        }
+    };
+    using ConstantBufferSlots = std::array<Shadow<ConstantBufferState>, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT>;
+    template<typename S>
+    struct WithRef
+    {
+        S* pState;
+        UINT ref;
+        bool operator==(const WithRef& rhs) const noexcept
+        {
+            return pState == rhs.pState && ref == rhs.ref;
+        }
+    };
+
+    // returns true when the call has to reach the context and records the new value
+    template<typename T>
+    bool Filter(Shadow<T>& shadow, const T& value) noexcept
+    {
+        if (shadow.valid && shadow.value == value)
+        {
+            current.skipped++;
+            return false;
+        }
+        shadow.value = value;
+        shadow.valid = true;
+        current.issued++;
+        return true;
+    }
+    // slots outside the tracked range are never filtered
+    template<typename T, size_t N>
+    bool Filter(std::array<Shadow<T>, N>& shadows, UINT slot, const T& value) noexcept
+    {
+        if (slot >= N)
+        {
+            current.issued++;
+            return true;
+        }
+        return Filter(shadows[slot], value);
+    }
+    template<typename T, size_t N>
+    bool FilterRange(std::array<Shadow<T>, N>& shadows, UINT startSlot, UINT count, const T* pValues) noexcept
+    {
+        if (size_t(startSlot) + count > N)
+        {
+            current.issued++;
+            return true;
+        }
+        bool changed = false;
+        for (UINT i = 0; i < count; i++)
+        {
+            auto& shadow = shadows[startSlot + i];
+            if (!shadow.valid || !(shadow.value == pValues[i]))
+            {
+                shadow.value = pValues[i];
+                shadow.valid = true;
+                changed = true;
+            }
+        }
+        changed ? current.issued++ : current.skipped++;
+        return changed;
+    }
+    // whole-buffer range binding for the constant buffer shadows
+    bool FilterConstantBufferRange(ConstantBufferSlots& shadows, UINT startSlot, UINT count, ID3D11Buffer* const* ppBuffers) noexcept;
+private:
+    ID3D11DeviceContext* pContext;
+    ID3D11DeviceContext1* pContext1;
+    Stats current;
+    Stats last;
+
+    Shadow<ID3D11InputLayout*> inputLayout;
+    Shadow<D3D11_PRIMITIVE_TOPOLOGY> topology;
+    std::array<Shadow<VertexBufferState>, D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT> vertexBuffers;
+    Shadow<IndexBufferState> indexBuffer;
+
+    Shadow<ID3D11VertexShader*> vertexShader;
+    ConstantBufferSlots vertexConstantBuffers;
+
+    Shadow<ID3D11PixelShader*> pixelShader;
+    ConstantBufferSlots pixelConstantBuffers;
+    std::array<Shadow<ID3D11ShaderResourceView*>, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT> pixelShaderResources;
+    std::array<Shadow<ID3D11SamplerState*>, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT> pixelSamplers;
+
+    Shadow<ID3D11RasterizerState*> rasterizerState;
+    Shadow<WithRef<ID3D11BlendState>> blendState;
+    Shadow<WithRef<ID3D11DepthStencilState>> depthStencilState;
+};
@@ -6,12 +6,16 @@
 #include <string>
 #include <unordered_map>
 #include <optional>
+#include <string_view>
+#include <cstdint>
 #include <cassert>
 
 namespace D3
 {
     namespace dx = DirectX;
 
+    struct LayoutRecord;
+
     /// <summary>
     /// Enumeration of supported HLSL data types for dynamic constant buffers.
     /// Each type corresponds to a specific HLSL shader type with proper GPU alignment.
@@ -127,9 +131,24 @@ namespace D3
         size_t GetSize() const;
 
         /// <summary>Generates a unique string signature for this element's layout</summary>
-        /// <returns>String signature used for layout caching</returns>
+        /// <returns>Human-readable signature string (diagnostics and debug UIs)</returns>
         std::string GetSignature() const;
 
+        /// <summary>
+        /// Gets a 64-bit structural hash of this element (types, member names, array counts).
+        /// Computed without allocating; cached once the element has been finalized.
+        /// </summary>
+        /// <returns>Structural hash used for layout caching</returns>
+        uint64_t GetHash() const noexcept;
+
+        /// <summary>
+        /// Compares the structure of two elements member by member. Offsets are ignored,
+        /// so a builder can be compared against a finalized layout.
+        /// </summary>
+        /// <param name="other">Element to compare against</param>
+        /// <returns>True if both elements describe the same layout</returns>
+        bool IsSameStructure(const LayoutElement& other) const noexcept;
+
         // Struct operations
         /// <summary>Adds a new member to this struct element</summary>
         /// <param name="memberType">Type of the member to add</param>
@@ -194,7 +213,25 @@ namespace D3
             return GetOffset();
         }
 
+        /// <summary>
+        /// Looks up a struct member by name without allocating. Used by path resolution
+        /// where the member name is a slice of a larger path string.
+        /// </summary>
+        /// <param name="name">Name of the member to find</param>
+        /// <returns>Pointer to the member element, or nullptr if not found or not a struct</returns>
+        const LayoutElement* FindMember(std::string_view name) const noexcept;
+
     private:
+        friend class LayoutRegistry;
+
+        /// <summary>
+        /// Rebuilds an element and its children from generated pre-order records, taking the
+        /// offsets as given instead of running Finalize. Advances pRecord past the subtree.
+        /// </summary>
+        /// <param name="pRecord">Cursor at the element's record</param>
+        /// <returns>Finalized element with its structural hash cached</returns>
+        static LayoutElement FromRecords(const LayoutRecord*& pRecord);
+
         /// <summary>Returns a static empty element for error cases</summary>
         static LayoutElement& GetEmptyElement();
 
@@ -210,6 +247,9 @@ namespace D3
         /// <summary>Validates that a name is a valid C++ identifier</summary>
         static bool IsValidSymbolName(const std::string& name);
 
+        /// <summary>Calculates offsets for this element and its children by type</summary>
+        size_t FinalizeOffsets(size_t startOffset);
+
         /// <summary>Finalizes layout for struct type elements</summary>
         size_t FinalizeStruct(size_t startOffset);
 
@@ -222,8 +262,12 @@ namespace D3
         /// <summary>Generates signature string for array elements</summary>
         std::string GetArraySignature() const;
 
+        /// <summary>Computes the FNV-1a structural hash from this element and its children's hashes</summary>
+        uint64_t ComputeHash() const noexcept;
+
         ElementType type = ElementType::Empty;  ///< The type of this element
         std::optional<size_t> offset;           ///< Byte offset within parent (set during finalization)
+        uint64_t hash = 0;                      ///< Cached structural hash (valid once finalized)
 
         // Struct data
         /// <summary>Storage for struct members as (name, element) pairs</summary>
@@ -236,6 +280,50 @@ namespace D3
         size_t arraySize = 0;
     };
 
+    /// <summary>
+    /// Precompiled accessor for a single leaf of a finalized layout. A member path such as
+    /// "lights[3].color" is resolved once into an absolute byte offset and element type, so
+    /// per-frame reads and writes through ConstantBufferData::Get/Set are a pointer add with
+    /// no string comparisons. The type (and, in debug builds, the owning layout) is checked
+    /// with an assert only, so release builds pay nothing for the validation.
+    /// </summary>
+    class ElementHandle
+    {
+    public:
+        /// <summary>Default constructor creates an invalid handle (Exists() returns false)</summary>
+        ElementHandle() = default;
+
+        /// <summary>Checks if the path resolved to an element of the layout</summary>
+        /// <returns>True if the handle refers to a valid element</returns>
+        bool Exists() const noexcept { return type != ElementType::Empty; }
+
+        /// <summary>Gets the ElementType of the referenced element</summary>
+        /// <returns>The ElementType enum value, or Empty for an invalid handle</returns>
+        ElementType GetType() const noexcept { return type; }
+
+        /// <summary>Gets the absolute byte offset of the referenced element within the buffer</summary>
+        /// <returns>Byte offset from the start of the constant buffer data</returns>
+        size_t GetOffset() const noexcept { return offset; }
+
+        /// <summary>
+        /// Resolves a member path against a finalized root element. Paths are member names
+        /// separated by '.', with array elements selected by "[index]" (e.g. "lights[3].color").
+        /// </summary>
+        /// <param name="root">Finalized root element of the layout</param>
+        /// <param name="path">Member path to resolve</param>
+        /// <returns>Handle to the element, or an invalid handle if the path does not resolve</returns>
+        static ElementHandle Resolve(const LayoutElement& root, std::string_view path);
+
+    private:
+        friend class ConstantBufferData;
+
+        uint32_t offset = 0;                    ///< Absolute byte offset within the buffer
+        ElementType type = ElementType::Empty;  ///< Type of the referenced element
+#ifndef NDEBUG
+        const LayoutElement* root = nullptr;    ///< Layout the handle was resolved against (debug only)
+#endif
+    };
+
     /// <summary>
     /// Base class for constant buffer layouts. Provides common functionality
     /// for accessing layout size and signature. Contains the root LayoutElement
@@ -248,10 +336,14 @@ namespace D3
         /// <returns>Total size in bytes</returns>
         size_t GetSizeInBytes() const;
 
-        /// <summary>Gets the unique signature string for this layout used in caching</summary>
+        /// <summary>Gets the human-readable signature string for this layout</summary>
         /// <returns>Layout signature string</returns>
         std::string GetSignature() const;
 
+        /// <summary>Gets the structural hash for this layout used in caching</summary>
+        /// <returns>64-bit structural hash</returns>
+        uint64_t GetHash() const noexcept;
+
     protected:
         /// <summary>Protected constructor - only derived classes can create Layout objects</summary>
         /// <param name="root">Shared pointer to the root LayoutElement</param>
@@ -320,6 +412,11 @@ namespace D3
         /// <returns>Shared pointer to the root LayoutElement</returns>
         std::shared_ptr<LayoutElement> GetRoot() const { return rootElement; }
 
+        /// <summary>Resolves a member path (e.g. "lights[3].color") into a reusable handle</summary>
+        /// <param name="path">Member path to resolve</param>
+        /// <returns>Handle valid for any ConstantBufferData created from this layout</returns>
+        ElementHandle Resolve(std::string_view path) const;
+
     private:
         friend class LayoutCache;
 
@@ -365,10 +462,54 @@ namespace D3
         /// <returns>Const proxy object for type-safe data access</returns>
         ConstantBufferDataConstRef operator[](const std::string& name) const;
 
+        /// <summary>Resolves a member path (e.g. "lights[3].color") against this buffer's layout</summary>
+        /// <param name="path">Member path to resolve</param>
+        /// <returns>Handle valid for any ConstantBufferData sharing this layout</returns>
+        ElementHandle Resolve(std::string_view path) const;
+
+        /// <summary>
+        /// Accesses an element through a precompiled handle. The handle must come from this
+        /// buffer's layout and refer to an element of type T; both are checked in debug builds only.
+        /// </summary>
+        /// <typeparam name="T">C++ type of the element</typeparam>
+        /// <param name="handle">Handle obtained from Resolve</param>
+        /// <returns>Mutable reference to the element data</returns>
+        template<typename T>
+        T& Get(const ElementHandle& handle)
+        {
+            const auto offset = CheckHandle<T>(handle);
+            MarkDirty(offset, sizeof(T));
+            return *reinterpret_cast<T*>(data.data() + offset);
+        }
+
+        /// <summary>Const version of handle access</summary>
+        /// <typeparam name="T">C++ type of the element</typeparam>
+        /// <param name="handle">Handle obtained from Resolve</param>
+        /// <returns>Const reference to the element data</returns>
+        template<typename T>
+        const T& Get(const ElementHandle& handle) const
+        {
+            return *reinterpret_cast<const T*>(data.data() + CheckHandle<T>(handle));
+        }
+
+        /// <summary>Writes an element through a precompiled handle</summary>
+        /// <typeparam name="T">C++ type of the value being assigned</typeparam>
+        /// <param name="handle">Handle obtained from Resolve</param>
+        /// <param name="value">Value to assign</param>
+        template<typename T>
+        void Set(const ElementHandle& handle, const T& value)
+        {
+            Get<T>(handle) = value;
+        }
+
         /// <summary>Gets raw pointer to the data bytes (for GPU upload)</summary>
         /// <returns>Pointer to the data buffer</returns>
         const char* GetData() const { return data.data(); }
 
+        /// <summary>Gets mutable raw pointer to the data bytes (marks the whole buffer dirty)</summary>
+        /// <returns>Pointer to the data buffer</returns>
+        char* GetData() { MarkDirty(0u, data.size()); return data.data(); }
+
         /// <summary>Gets the total size of the data buffer in bytes</summary>
         /// <returns>Size in bytes</returns>
         size_t GetSizeInBytes() const { return data.size(); }
@@ -385,11 +526,60 @@ namespace D3
         /// <returns>Shared pointer to the root LayoutElement</returns>
         std::shared_ptr<LayoutElement> GetLayoutRoot() const { return rootLayout; }
 
+        // Dirty tracking
+        /// <summary>
+        /// Half-open byte range [begin, end) that may have been written since the last ClearDirty().
+        /// Every mutable access path (proxies, handles, StaticView, CopyFrom) widens it, so it is
+        /// conservative: a read through a mutable proxy also counts as a potential write.
+        /// </summary>
+        struct DirtyRange
+        {
+            size_t begin;
+            size_t end;
+        };
+
+        /// <summary>Checks if any bytes may have changed since the last ClearDirty()</summary>
+        /// <returns>True if the dirty range is non-empty</returns>
+        bool IsDirty() const noexcept { return dirtyBegin < dirtyEnd; }
+
+        /// <summary>Gets the byte range that may have changed since the last ClearDirty()</summary>
+        /// <returns>Dirty range, empty (begin == end) when clean</returns>
+        DirtyRange GetDirtyRange() const noexcept { return IsDirty() ? DirtyRange{ dirtyBegin, dirtyEnd } : DirtyRange{ 0u, 0u }; }
+
+        /// <summary>Widens the dirty range to include the given bytes</summary>
+        /// <param name="offset">Byte offset of the written data</param>
+        /// <param name="size">Number of bytes written</param>
+        void MarkDirty(size_t offset, size_t size) noexcept
+        {
+            dirtyBegin = offset < dirtyBegin ? offset : dirtyBegin;
+            dirtyEnd = offset + size > dirtyEnd ? offset + size : dirtyEnd;
+        }
+
+        /// <summary>Resets the dirty range, typically after the data has been uploaded</summary>
+        void ClearDirty() noexcept { dirtyBegin = SIZE_MAX; dirtyEnd = 0u; }
+
+        /// <summary>Computes a 64-bit FNV-1a hash of the data bytes</summary>
+        /// <returns>Content hash used to skip redundant uploads</returns>
+        uint64_t GetContentHash() const noexcept;
+
     private:
+        /// <summary>Validates a handle against this buffer (debug only) and returns its offset</summary>
+        template<typename T>
+        size_t CheckHandle(const ElementHandle& handle) const
+        {
+            assert(handle.root == rootLayout.get() && "Handle was resolved against a different layout");
+            assert(TypeRegistry::GetElementType<T>() == handle.type && "Handle type does not match requested type");
+            return handle.offset;
+        }
+
         /// <summary>Shared pointer to the root layout element</summary>
         std::shared_ptr<LayoutElement> rootLayout;
         /// <summary>Raw data buffer with proper size and alignment</summary>
         std::vector<char> data;
+        /// <summary>Start of the dirty byte range (SIZE_MAX when clean)</summary>
+        size_t dirtyBegin = SIZE_MAX;
+        /// <summary>End of the dirty byte range (0 when clean)</summary>
+        size_t dirtyEnd = 0u;
     };
 
     /// <summary>
@@ -487,7 +677,7 @@ namespace D3
         template<typename T>
         operator T&() const
         {
-            return *reinterpret_cast<T*>(dataPtr + currentOffset + element->ResolveOffset<T>());
+            return *reinterpret_cast<T*>(dataPtr + MarkDirty<T>());
         }
 
         /// <summary>
@@ -530,17 +720,27 @@ namespace D3
         template<typename T>
         T* GetPointer() const
         {
-            return reinterpret_cast<T*>(dataPtr + currentOffset + element->ResolveOffset<T>());
+            return reinterpret_cast<T*>(dataPtr + MarkDirty<T>());
         }
 
     private:
         friend class ConstantBufferData;
 
         /// <summary>Private constructor - only created by ConstantBufferData</summary>
-        ConstantBufferDataRef(const LayoutElement* element, char* dataPtr, size_t offset);
+        ConstantBufferDataRef(const LayoutElement* element, char* dataPtr, size_t offset, ConstantBufferData* pOwner);
+
+        /// <summary>Resolves the element offset for type T and records it as potentially written</summary>
+        template<typename T>
+        size_t MarkDirty() const
+        {
+            const auto offset = currentOffset + element->ResolveOffset<T>();
+            pOwner->MarkDirty(offset, sizeof(T));
+            return offset;
+        }
 
         const LayoutElement* element;   ///< Pointer to the layout element being referenced
         char* dataPtr;                 ///< Pointer to the start of the data buffer
         size_t currentOffset;          ///< Current offset within the data buffer
+        ConstantBufferData* pOwner;    ///< Buffer whose dirty range is widened on mutable access
     };
 }
\ No newline at end of file
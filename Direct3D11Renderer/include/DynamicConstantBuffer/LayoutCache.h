@@ -2,8 +2,10 @@
 
 #include "DynamicConstantBuffer.h"
 #include <unordered_map>
-#include <string>
+#include <vector>
 #include <memory>
+#include <shared_mutex>
+#include <cstdint>
 
 namespace D3
 {
@@ -11,20 +13,23 @@ namespace D3
     /// Singleton cache for layout definitions that prevents duplicate layout creation
     /// and enables efficient sharing of identical layouts across multiple ConstantBufferData instances.
     ///
-    /// The cache uses layout signatures as keys to identify identical layouts. When a layout
-    /// is requested, the cache either returns an existing finalized layout or creates a new one
-    /// from the provided builder. This optimization is crucial for performance when many objects
-    /// use the same constant buffer layout (e.g., multiple meshes with the same material type).
+    /// The cache uses 64-bit structural hashes (LayoutElement::GetHash) as keys. Because distinct
+    /// layouts could in principle share a hash, each key maps to a small bucket and a hit is only
+    /// accepted after a full structural comparison. When a layout is requested, the cache either
+    /// returns an existing finalized layout or creates a new one from the provided builder.
+    /// This optimization is crucial for performance when many objects use the same constant
+    /// buffer layout (e.g., multiple meshes with the same material type).
     ///
-    /// Thread Safety: This class is not thread-safe. It should only be used from the main
-    /// rendering thread or proper synchronization must be implemented.
+    /// Thread Safety: Resolve may be called concurrently (e.g. from parallel model import).
+    /// Lookups take a shared lock; the builder is finalized outside any lock and only the
+    /// insertion takes an exclusive lock, re-checking for a layout inserted in the meantime.
     /// </summary>
     class LayoutCache
     {
     public:
         /// <summary>
         /// Resolves a LayoutBuilder into a FinalizedLayout, either by returning a cached
-        /// layout with the same signature or by finalizing the builder and caching the result.
+        /// layout with the same structure or by finalizing the builder and caching the result.
         ///
         /// The builder is consumed in the process - it will be reset to empty state regardless
         /// of whether a cached layout was found or a new one was created.
@@ -34,6 +39,19 @@ namespace D3
         static FinalizedLayout Resolve(LayoutBuilder&& builder);
 
     private:
+        friend class LayoutRegistry;
+
+        /// <summary>
+        /// Adds an already finalized layout (built from generated records) to the cache, or
+        /// returns the cached layout if one with the same structure exists.
+        /// </summary>
+        /// <param name="root">Finalized root element</param>
+        /// <returns>FinalizedLayout sharing the cached root</returns>
+        static FinalizedLayout Register(std::shared_ptr<LayoutElement> root);
+
+        /// <summary>List of layouts sharing one structural hash (almost always a single entry)</summary>
+        using Bucket = std::vector<std::shared_ptr<LayoutElement>>;
+
         /// <summary>
         /// Gets the singleton instance of the LayoutCache. Uses static local variable
         /// pattern to ensure proper initialization and cleanup.
@@ -41,11 +59,20 @@ namespace D3
         /// <returns>Reference to the singleton LayoutCache instance</returns>
         static LayoutCache& GetInstance();
 
+        /// <summary>Finds a layout in a bucket with the same structure as the given element</summary>
+        /// <param name="bucket">Bucket to search</param>
+        /// <param name="element">Element to compare against</param>
+        /// <returns>Matching finalized layout, or nullptr if none matches</returns>
+        static std::shared_ptr<LayoutElement> Find(const Bucket& bucket, const LayoutElement& element);
+
+        /// <summary>Guards layoutCache; shared for lookups, exclusive for insertion</summary>
+        std::shared_mutex mutex;
+
         /// <summary>
-        /// Hash map that stores finalized layouts keyed by their signature strings.
-        /// The signature uniquely identifies the structure of a layout, allowing
-        /// identical layouts to be shared even if they were created independently.
+        /// Hash map that stores finalized layouts keyed by their structural hash.
+        /// The hash identifies the structure of a layout, allowing identical layouts
+        /// to be shared even if they were created independently.
         /// </summary>
-        std::unordered_map<std::string, std::shared_ptr<LayoutElement>> layoutCache;
+        std::unordered_map<uint64_t, Bucket> layoutCache;
     };
-}
\ No newline at end of file
+}
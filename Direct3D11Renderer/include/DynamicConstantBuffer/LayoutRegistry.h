@@ -0,0 +1,105 @@
+#pragma once
+
+#include "DynamicConstantBuffer.h"
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+/// <file>
+/// Layout registry generated from shader source
+///
+/// tools/generate_cbuffer_layouts.py parses the cbuffer declarations in shaders/*.hlsl
+/// (following #include "Common/*.hlsli") and writes GeneratedLayouts.cpp: flat tables of
+/// precomputed element records. At startup the registry rebuilds each layout straight from
+/// its records (offsets included, no LayoutBuilder or Finalize pass) and shares it through
+/// the LayoutCache, so C++ code can look up a shader's cbuffer instead of repeating its
+/// structure by hand:
+///
+///     D3::ConstantBufferData buffer{ D3::LayoutRegistry::Get("SolidColor_PS", 1u) };
+///     buffer["color"] = DirectX::XMFLOAT4{ 1.0f, 0.0f, 0.0f, 1.0f };
+///
+/// The generator rejects cbuffers whose HLSL packing the dynamic layout system cannot
+/// reproduce, and its --check mode fails when the generated file is out of date with the
+/// shaders.
+/// </file>
+
+namespace D3
+{
+    /// <summary>
+    /// One element of a generated layout, stored in pre-order. Struct records are followed by
+    /// their members, Array records by their element type.
+    /// </summary>
+    struct LayoutRecord
+    {
+        ElementType type;   ///< Element type
+        const char* name;   ///< Member name (empty for the root and array element types)
+        uint32_t offset;    ///< Absolute byte offset, as Finalize would compute it
+        uint32_t count;     ///< Member count for structs, element count for arrays, otherwise 0
+    };
+
+    /// <summary>One cbuffer declared by a shader, referencing its first record</summary>
+    struct GeneratedLayout
+    {
+        const char* shader;     ///< Shader file name without extension (matches the .cso name)
+        const char* cbuffer;    ///< cbuffer name in HLSL
+        int32_t slot;           ///< Register number (bN), or -1 if the cbuffer has no register
+        uint32_t size;          ///< Total size in bytes
+        uint32_t firstRecord;   ///< Index of the root record in GeneratedLayouts::records
+    };
+
+    namespace GeneratedLayouts
+    {
+        extern const LayoutRecord records[];
+        extern const GeneratedLayout layouts[];
+        extern const size_t layoutCount;
+    }
+
+    /// <summary>
+    /// Lookup of finalized layouts for the cbuffers declared in the shader sources.
+    /// Built once on first use (Load() forces this at startup) and immutable afterwards,
+    /// so lookups are safe from any thread.
+    /// </summary>
+    class LayoutRegistry
+    {
+    public:
+        /// <summary>Builds every generated layout and registers it with the LayoutCache</summary>
+        static void Load();
+
+        /// <summary>Finds the layout of a shader's cbuffer by name</summary>
+        /// <param name="shader">Shader name without extension (e.g. "SolidColor_PS")</param>
+        /// <param name="cbuffer">cbuffer name in HLSL</param>
+        /// <returns>Layout, or nullptr if the shader does not declare that cbuffer</returns>
+        static const FinalizedLayout* Find(std::string_view shader, std::string_view cbuffer);
+
+        /// <summary>Finds the layout of the cbuffer bound at a register slot</summary>
+        /// <param name="shader">Shader name without extension (e.g. "SolidColor_PS")</param>
+        /// <param name="slot">Register number of the cbuffer (bN)</param>
+        /// <returns>Layout, or nullptr if the shader has no cbuffer at that slot</returns>
+        static const FinalizedLayout* Find(std::string_view shader, uint32_t slot);
+
+        /// <summary>Gets the layout of a shader's cbuffer by name (must exist)</summary>
+        static const FinalizedLayout& Get(std::string_view shader, std::string_view cbuffer);
+
+        /// <summary>Gets the layout of the cbuffer bound at a register slot (must exist)</summary>
+        static const FinalizedLayout& Get(std::string_view shader, uint32_t slot);
+
+    private:
+        /// <summary>Registered cbuffer and its finalized layout</summary>
+        struct Entry
+        {
+            const GeneratedLayout* pSource;
+            FinalizedLayout layout;
+        };
+
+        LayoutRegistry();
+
+        /// <summary>Gets the singleton registry, building it on first use</summary>
+        static const LayoutRegistry& GetInstance();
+
+        /// <summary>
+        /// All generated cbuffers in generator order (grouped by shader). A few dozen entries,
+        /// looked up when materials are created, so a linear scan is sufficient.
+        /// </summary>
+        std::vector<Entry> entries;
+    };
+}
@@ -0,0 +1,416 @@
+#pragma once
+
+#include "DynamicConstantBuffer.h"
+#include "LayoutCache.h"
+#include <array>
+#include <type_traits>
+#include <cstring>
+#include <utility>
+
+/// <file>
+/// Compile-time constant buffer layouts
+///
+/// For layouts whose structure is known at compile time, StaticLayout computes the HLSL
+/// packing with constexpr functions that mirror LayoutElement::Finalize, so offsets and the
+/// total size are compile-time constants checked with static_assert. Members are named by
+/// tag types rather than strings:
+///
+///     struct Scale : D3::StaticMember<D3::ElementType::Float> { static constexpr const char* name = "scale"; };
+///     using OutlineLayout = D3::StaticLayout<Scale>;
+///
+///     D3::ConstantBufferData buffer = OutlineLayout::MakeBuffer();
+///     D3::StaticView<OutlineLayout>(buffer).Get<Scale>() = 1.04f;
+///
+/// Nested structs derive from StaticStruct and are accessed with Get<Struct, Member>():
+///
+///     struct Intensity : D3::StaticMember<D3::ElementType::Float> { static constexpr const char* name = "intensity"; };
+///     struct Light : D3::StaticStruct<Color, Intensity> { static constexpr const char* name = "light"; };
+///
+/// GetFinalized() converts the layout into a regular FinalizedLayout (shared through the
+/// LayoutCache), so buffers created from a static layout still work with TechniqueProbe and
+/// CachingDynamicConstantBufferBindable. Arrays of structs are not supported; use the
+/// runtime LayoutBuilder for those.
+/// </file>
+
+namespace D3
+{
+    /// <summary>
+    /// Compile-time counterpart of TypeRegistry: maps a primitive ElementType to the C++ type
+    /// used to access it and its HLSL size.
+    /// </summary>
+    template<ElementType Type>
+    struct StaticElementTraits;
+
+    template<> struct StaticElementTraits<ElementType::Float>     { using ValueType = float;                 static constexpr size_t size = 4u; };
+    template<> struct StaticElementTraits<ElementType::Float2>    { using ValueType = DirectX::XMFLOAT2;     static constexpr size_t size = 8u; };
+    template<> struct StaticElementTraits<ElementType::Float3>    { using ValueType = DirectX::XMFLOAT3;     static constexpr size_t size = 12u; };
+    template<> struct StaticElementTraits<ElementType::Float4>    { using ValueType = DirectX::XMFLOAT4;     static constexpr size_t size = 16u; };
+    template<> struct StaticElementTraits<ElementType::Matrix4x4> { using ValueType = DirectX::XMFLOAT4X4;   static constexpr size_t size = 64u; };
+    template<> struct StaticElementTraits<ElementType::Bool>      { using ValueType = bool;                  static constexpr size_t size = 4u; };  // HLSL bool is always 4 bytes
+
+    /// <summary>
+    /// Base for member tag types. Derive from it and add a static constexpr const char* name
+    /// matching the HLSL member name. ArraySize > 0 declares an array of that many elements.
+    /// </summary>
+    /// <typeparam name="Type">Primitive element type of the member</typeparam>
+    /// <typeparam name="ArraySize">Number of array elements, or 0 for a scalar member</typeparam>
+    template<ElementType Type, size_t ArraySize = 0>
+    struct StaticMember
+    {
+        using Traits = StaticElementTraits<Type>;
+        using ValueType = typename Traits::ValueType;
+        static constexpr ElementType type = Type;
+        static constexpr size_t arraySize = ArraySize;
+
+        static_assert(sizeof(ValueType) <= Traits::size, "C++ type must fit in the HLSL element");
+    };
+
+    namespace StaticPacking
+    {
+        /// <summary>True for member tags deriving from StaticStruct</summary>
+        template<typename Member>
+        constexpr bool IsStruct() noexcept
+        {
+            return Member::type == ElementType::Struct;
+        }
+
+        /// <summary>Constexpr mirror of LayoutElement::AdvanceToBoundary</summary>
+        constexpr size_t AdvanceToBoundary(size_t offset) noexcept
+        {
+            return offset + (16u - offset % 16u) % 16u;
+        }
+
+        /// <summary>Constexpr mirror of LayoutElement::CrossesBoundary</summary>
+        constexpr bool CrossesBoundary(size_t offset, size_t size) noexcept
+        {
+            const auto end = offset + size;
+            return (offset / 16u != end / 16u && end % 16u != 0u) || size > 16u;
+        }
+
+        /// <summary>Constexpr mirror of LayoutElement::AdvanceIfCrossesBoundary</summary>
+        constexpr size_t AdvanceIfCrossesBoundary(size_t offset, size_t size) noexcept
+        {
+            return CrossesBoundary(offset, size) ? AdvanceToBoundary(offset) : offset;
+        }
+
+        /// <summary>Offset at which a member is placed given the current packing offset</summary>
+        template<typename Member>
+        constexpr size_t Place(size_t offset) noexcept
+        {
+            if constexpr (Member::arraySize > 0 || IsStruct<Member>())
+            {
+                return AdvanceToBoundary(offset);
+            }
+            else
+            {
+                return AdvanceIfCrossesBoundary(offset, Member::Traits::size);
+            }
+        }
+
+        /// <summary>
+        /// Bytes occupied by a member (arrays use a 16-byte aligned stride). A struct ends at
+        /// its last member, like LayoutElement::FinalizeStruct, so a following scalar may pack
+        /// into its last register.
+        /// </summary>
+        template<typename Member>
+        constexpr size_t Footprint() noexcept
+        {
+            if constexpr (IsStruct<Member>())
+            {
+                return Member::size;
+            }
+            else if constexpr (Member::arraySize > 0)
+            {
+                return AdvanceToBoundary(Member::Traits::size) * Member::arraySize;
+            }
+            else
+            {
+                return Member::Traits::size;
+            }
+        }
+
+        /// <summary>True if a member at offset follows the HLSL packing rules</summary>
+        template<typename Member>
+        constexpr bool IsValidPlacement(size_t offset) noexcept
+        {
+            if constexpr (Member::arraySize > 0 || IsStruct<Member>())
+            {
+                return offset % 16u == 0u;
+            }
+            else
+            {
+                return Member::Traits::size > 16u ? offset % 16u == 0u : !CrossesBoundary(offset, Member::Traits::size);
+            }
+        }
+
+        /// <summary>Offsets of consecutive members packed from offset 0</summary>
+        template<typename... Members>
+        constexpr std::array<size_t, sizeof...(Members)> Offsets() noexcept
+        {
+            std::array<size_t, sizeof...(Members)> result{};
+            size_t offset = 0;
+            size_t i = 0;
+            ((result[i] = Place<Members>(offset), offset = result[i] + Footprint<Members>(), ++i), ...);
+            return result;
+        }
+
+        /// <summary>End of the last of consecutive members packed from offset 0, before padding</summary>
+        template<typename... Members>
+        constexpr size_t End() noexcept
+        {
+            constexpr auto offsets = Offsets<Members...>();
+            size_t end = 0;
+            size_t i = 0;
+            ((end = offsets[i] + Footprint<Members>(), ++i), ...);
+            return end;
+        }
+
+        /// <summary>True if every one of consecutive members follows the HLSL packing rules</summary>
+        template<typename... Members>
+        constexpr bool IsValidPacking() noexcept
+        {
+            constexpr auto offsets = Offsets<Members...>();
+            size_t i = 0;
+            bool valid = true;
+            ((valid = valid && IsValidPlacement<Members>(offsets[i]), ++i), ...);
+            return valid;
+        }
+
+        /// <summary>Checks the members of a nested struct against its finalized runtime element</summary>
+        template<typename Member>
+        bool MatchesNested(const LayoutElement& element)
+        {
+            if constexpr (IsStruct<Member>())
+            {
+                return Member::MatchesRuntime(element);
+            }
+            else
+            {
+                return true;
+            }
+        }
+
+        /// <summary>Index of a member tag among consecutive members</summary>
+        template<typename Member, typename... Members>
+        constexpr size_t IndexOf() noexcept
+        {
+            static_assert((std::is_same_v<Member, Members> || ...), "Member is not part of this layout");
+            size_t index = 0;
+            size_t i = 0;
+            ((std::is_same_v<Member, Members> ? (index = i, ++i) : ++i), ...);
+            return index;
+        }
+    }
+
+    /// <summary>
+    /// Base for nested struct member tags. Derive from it and add a static constexpr const char*
+    /// name matching the HLSL member name. Offsets are relative to the start of the struct, which
+    /// always lies on a 16-byte boundary, so they pack the same as at the top level.
+    /// </summary>
+    /// <typeparam name="Members">Member tag types of the struct, in declaration order</typeparam>
+    template<typename... Members>
+    struct StaticStruct
+    {
+        static_assert(sizeof...(Members) > 0, "Struct must have at least one member");
+        static_assert(StaticPacking::IsValidPacking<Members...>(), "Member placement violates HLSL packing rules");
+
+        static constexpr ElementType type = ElementType::Struct;
+        static constexpr size_t arraySize = 0;
+
+        /// <summary>Byte offset of each member relative to the struct, in declaration order</summary>
+        static constexpr std::array<size_t, sizeof...(Members)> offsets = StaticPacking::Offsets<Members...>();
+
+        /// <summary>Bytes from the start of the struct to the end of its last member</summary>
+        static constexpr size_t size = StaticPacking::End<Members...>();
+
+        /// <summary>Byte offset of a member tag relative to the struct</summary>
+        template<typename Member>
+        static constexpr size_t OffsetOf() noexcept
+        {
+            return offsets[StaticPacking::IndexOf<Member, Members...>()];
+        }
+
+        /// <summary>Adds the struct's members to its runtime element</summary>
+        /// <param name="element">Struct element created for this member</param>
+        static void AddMembers(LayoutElement& element)
+        {
+            (AddMember<Members>(element), ...);
+        }
+
+        /// <summary>True if the runtime element places every member where the static layout does</summary>
+        /// <param name="element">Finalized struct element created for this member</param>
+        static bool MatchesRuntime(const LayoutElement& element)
+        {
+            return ((element[Members::name].GetOffset() == element.GetOffset() + OffsetOf<Members>() &&
+                StaticPacking::MatchesNested<Members>(element[Members::name])) && ...);
+        }
+
+    private:
+        template<typename Member>
+        static void AddMember(LayoutElement& element)
+        {
+            element.AddMember(Member::arraySize > 0 ? ElementType::Array : Member::type, Member::name);
+            if constexpr (StaticPacking::IsStruct<Member>())
+            {
+                Member::AddMembers(element[Member::name]);
+            }
+            else if constexpr (Member::arraySize > 0)
+            {
+                element[Member::name].SetArrayType(Member::type, Member::arraySize);
+            }
+        }
+    };
+
+    /// <summary>
+    /// Compile-time constant buffer layout. Computes the same HLSL-conformant offsets as the
+    /// runtime LayoutBuilder/Finalize path and exposes them as constants.
+    /// </summary>
+    /// <typeparam name="Members">Member tag types deriving from StaticMember, in declaration order</typeparam>
+    template<typename... Members>
+    class StaticLayout
+    {
+        static_assert(sizeof...(Members) > 0, "Struct must have at least one member");
+
+    public:
+        /// <summary>Number of top-level members</summary>
+        static constexpr size_t count = sizeof...(Members);
+
+        /// <summary>Byte offset of each member, in declaration order</summary>
+        static constexpr std::array<size_t, count> offsets = StaticPacking::Offsets<Members...>();
+
+        /// <summary>Total size in bytes, padded to a 16-byte boundary like the runtime root struct</summary>
+        static constexpr size_t size = StaticPacking::AdvanceToBoundary(StaticPacking::End<Members...>());
+
+        static_assert(size % 16u == 0u, "Constant buffer size must be a multiple of 16 bytes");
+        static_assert(StaticPacking::IsValidPacking<Members...>(), "Member placement violates HLSL packing rules");
+
+        /// <summary>Index of a member tag within this layout</summary>
+        template<typename Member>
+        static constexpr size_t IndexOf() noexcept
+        {
+            return StaticPacking::IndexOf<Member, Members...>();
+        }
+
+        /// <summary>Byte offset of a member tag within this layout</summary>
+        template<typename Member>
+        static constexpr size_t OffsetOf() noexcept
+        {
+            return offsets[IndexOf<Member>()];
+        }
+
+        /// <summary>
+        /// Converts this layout into a FinalizedLayout shared through the LayoutCache.
+        /// Built once per layout type; in debug builds the runtime offsets are checked
+        /// against the compile-time ones.
+        /// </summary>
+        /// <returns>FinalizedLayout with the same structure and packing</returns>
+        static const FinalizedLayout& GetFinalized()
+        {
+            static const FinalizedLayout layout = [] {
+                LayoutBuilder builder;
+                (AddMember<Members>(builder), ...);
+                auto finalized = LayoutCache::Resolve(std::move(builder));
+                assert(finalized.GetSizeInBytes() == size && "Static layout size differs from runtime packing");
+                assert(((finalized[Members::name].GetOffset() == OffsetOf<Members>()) && ...) && "Static layout offsets differ from runtime packing");
+                assert((StaticPacking::MatchesNested<Members>(finalized[Members::name]) && ...) && "Static struct offsets differ from runtime packing");
+                return finalized;
+            }();
+            return layout;
+        }
+
+        /// <summary>Creates a zero-initialized ConstantBufferData using this layout</summary>
+        /// <returns>Buffer compatible with TechniqueProbe and the dynamic constant buffer bindables</returns>
+        static ConstantBufferData MakeBuffer()
+        {
+            return ConstantBufferData(GetFinalized());
+        }
+
+    private:
+        /// <summary>Adds a member tag to a runtime builder</summary>
+        template<typename Member>
+        static void AddMember(LayoutBuilder& builder)
+        {
+            if constexpr (StaticPacking::IsStruct<Member>())
+            {
+                builder.Add<ElementType::Struct>(Member::name);
+                Member::AddMembers(builder[Member::name]);
+            }
+            else if constexpr (Member::arraySize > 0)
+            {
+                builder.Add<ElementType::Array>(Member::name);
+                builder[Member::name].SetArrayType(Member::type, Member::arraySize);
+            }
+            else
+            {
+                builder.Add<Member::type>(Member::name);
+            }
+        }
+    };
+
+    /// <summary>
+    /// Typed, non-owning view over a ConstantBufferData created from a StaticLayout. Field
+    /// access compiles down to a constant offset from the data pointer plus widening the
+    /// buffer's dirty range; the only check is a debug-build assert that the buffer really
+    /// uses the static layout.
+    /// </summary>
+    /// <typeparam name="Layout">StaticLayout instantiation describing the buffer</typeparam>
+    template<typename Layout>
+    class StaticView
+    {
+    public:
+        /// <summary>Creates a view over a buffer that was created from Layout</summary>
+        /// <param name="buffer">Buffer to view (must outlive the view)</param>
+        explicit StaticView(ConstantBufferData& buffer) noexcept
+            // const GetData so creating the view does not dirty the whole buffer; each Get marks its own bytes
+            : pBuffer(&buffer), pData(const_cast<char*>(std::as_const(buffer).GetData()))
+        {
+            assert(&buffer.GetRootLayout() == Layout::GetFinalized().GetRoot().get() && "Buffer was not created from this static layout");
+        }
+
+        /// <summary>Accesses a scalar member</summary>
+        /// <typeparam name="Member">Member tag from Layout</typeparam>
+        /// <returns>Reference to the member data</returns>
+        template<typename Member>
+        typename Member::ValueType& Get() const noexcept
+        {
+            static_assert(Member::arraySize == 0, "Use Get<Member>(index) for array members");
+            static_assert(!StaticPacking::IsStruct<Member>(), "Use Get<Struct, Member>() for members of nested structs");
+            constexpr size_t offset = Layout::template OffsetOf<Member>();
+            pBuffer->MarkDirty(offset, sizeof(typename Member::ValueType));
+            return *reinterpret_cast<typename Member::ValueType*>(pData + offset);
+        }
+
+        /// <summary>Accesses a scalar member of a nested struct</summary>
+        /// <typeparam name="Struct">Struct member tag from Layout</typeparam>
+        /// <typeparam name="Member">Scalar member tag from Struct</typeparam>
+        /// <returns>Reference to the member data</returns>
+        template<typename Struct, typename Member>
+        typename Member::ValueType& Get() const noexcept
+        {
+            static_assert(StaticPacking::IsStruct<Struct>(), "Get<Struct, Member>() needs a StaticStruct member");
+            static_assert(Member::arraySize == 0 && !StaticPacking::IsStruct<Member>(), "Only scalar members of nested structs are accessible");
+            constexpr size_t offset = Layout::template OffsetOf<Struct>() + Struct::template OffsetOf<Member>();
+            pBuffer->MarkDirty(offset, sizeof(typename Member::ValueType));
+            return *reinterpret_cast<typename Member::ValueType*>(pData + offset);
+        }
+
+        /// <summary>Accesses one element of an array member</summary>
+        /// <typeparam name="Member">Array member tag from Layout</typeparam>
+        /// <param name="index">Element index (must be less than the array size)</param>
+        /// <returns>Reference to the element data</returns>
+        template<typename Member>
+        typename Member::ValueType& Get(size_t index) const noexcept
+        {
+            static_assert(Member::arraySize > 0, "Use Get<Member>() for scalar members");
+            assert(index < Member::arraySize && "Array index out of bounds");
+            constexpr size_t stride = StaticPacking::AdvanceToBoundary(Member::Traits::size);
+            const size_t offset = Layout::template OffsetOf<Member>() + stride * index;
+            pBuffer->MarkDirty(offset, sizeof(typename Member::ValueType));
+            return *reinterpret_cast<typename Member::ValueType*>(pData + offset);
+        }
+
+    private:
+        ConstantBufferData* pBuffer;
+        char* pData;
+    };
+}
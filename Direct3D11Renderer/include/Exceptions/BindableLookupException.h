@@ -7,6 +7,9 @@ class BindableLookupException : public D3Exception
 {
 public:
     BindableLookupException(int line, const char* file, const char* type, const std::string& id);
+    // the requested bindable's key matched a cached entry with a different type or UID
+    BindableLookupException(int line, const char* file, const char* type, const std::string& id,
+        const char* cachedType, const std::string& cachedId);
 
     const char* GetType() const noexcept override;
 
@@ -19,7 +22,10 @@ public:
 private:
     std::string type_name;
     std::string bindable_id;
+    std::string cached_type_name;
+    std::string cached_bindable_id;
 };
 
 // Define a macro for easier exception throwing
 #define BINDABLE_LOOKUP_EXCEPT(type, id) BindableLookupException(__LINE__, __FILE__, type, id)
+#define BINDABLE_COLLISION_EXCEPT(type, id, cachedType, cachedId) BindableLookupException(__LINE__, __FILE__, type, id, cachedType, cachedId)
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <limits>
+
+// Axis aligned bounding box. A default constructed box is empty and absorbs nothing until
+// a point or another box is merged into it.
+struct AABB
+{
+	DirectX::XMFLOAT3 min = {
+		std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+	DirectX::XMFLOAT3 max = {
+		std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+
+	bool IsEmpty() const noexcept
+	{
+		return min.x > max.x;
+	}
+
+	void Merge(const DirectX::XMFLOAT3& point) noexcept
+	{
+		namespace dx = DirectX;
+		dx::XMStoreFloat3(&min, dx::XMVectorMin(dx::XMLoadFloat3(&min), dx::XMLoadFloat3(&point)));
+		dx::XMStoreFloat3(&max, dx::XMVectorMax(dx::XMLoadFloat3(&max), dx::XMLoadFloat3(&point)));
+	}
+
+	void Merge(const AABB& other) noexcept
+	{
+		namespace dx = DirectX;
+		if (other.IsEmpty())
+		{
+			return;
+		}
+		dx::XMStoreFloat3(&min, dx::XMVectorMin(dx::XMLoadFloat3(&min), dx::XMLoadFloat3(&other.min)));
+		dx::XMStoreFloat3(&max, dx::XMVectorMax(dx::XMLoadFloat3(&max), dx::XMLoadFloat3(&other.max)));
+	}
+
+	DirectX::XMVECTOR GetCenter() const noexcept
+	{
+		namespace dx = DirectX;
+		return dx::XMVectorScale(dx::XMVectorAdd(dx::XMLoadFloat3(&min), dx::XMLoadFloat3(&max)), 0.5f);
+	}
+
+	DirectX::XMVECTOR GetExtents() const noexcept
+	{
+		namespace dx = DirectX;
+		return dx::XMVectorScale(dx::XMVectorSubtract(dx::XMLoadFloat3(&max), dx::XMLoadFloat3(&min)), 0.5f);
+	}
+
+	// box enclosing this one after an affine transform (Arvo's method, no corner enumeration)
+	AABB Transformed(DirectX::FXMMATRIX transform) const noexcept
+	{
+		namespace dx = DirectX;
+		if (IsEmpty())
+		{
+			return *this;
+		}
+		const auto extents = GetExtents();
+		const auto center = dx::XMVector3Transform(GetCenter(), transform);
+		auto newExtents = dx::XMVectorMultiply(dx::XMVectorSplatX(extents), dx::XMVectorAbs(transform.r[0]));
+		newExtents = dx::XMVectorMultiplyAdd(dx::XMVectorSplatY(extents), dx::XMVectorAbs(transform.r[1]), newExtents);
+		newExtents = dx::XMVectorMultiplyAdd(dx::XMVectorSplatZ(extents), dx::XMVectorAbs(transform.r[2]), newExtents);
+
+		AABB result;
+		dx::XMStoreFloat3(&result.min, dx::XMVectorSubtract(center, newExtents));
+		dx::XMStoreFloat3(&result.max, dx::XMVectorAdd(center, newExtents));
+		return result;
+	}
+};
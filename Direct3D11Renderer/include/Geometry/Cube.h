@@ -1,83 +1,71 @@
 #pragma once
 
-#include "Vertex.h"
+#include "StaticVertexLayout.h"
 #include "IndexedTriangleList.h"
 #include <DirectXMath.h>
 
 class Cube
 {
+	using PNT = D3::StaticVertexLayout<D3::VertexLayout::Position3D, D3::VertexLayout::Normal, D3::VertexLayout::Texture2D>;
+	using PN = D3::StaticVertexLayout<D3::VertexLayout::Position3D, D3::VertexLayout::Normal>;
 public:
 	static IndexedTriangleList Make()
 	{
-		using D3::VertexLayout;
-		namespace dx = DirectX;
-
-		VertexLayout vl;
-		vl.Append(VertexLayout::Position3D);
-		vl.Append(VertexLayout::Normal);
-		vl.Append(VertexLayout::Texture2D);
-
-		return MakeIndependentTextured(std::move(vl));
+		return MakeIndependentTextured();
 	}
 
 	static IndexedTriangleList MakeSolid()
 	{
-		using D3::VertexLayout;
-		namespace dx = DirectX;
-
-		VertexLayout vl;
-		vl.Append(VertexLayout::Position3D);
-		vl.Append(VertexLayout::Normal);
-
-		return MakeIndependentSolid(std::move(vl));
+		return MakeIndependentSolid();
 	}
 
-	static IndexedTriangleList MakeIndependentTextured(D3::VertexLayout layout)
+	static IndexedTriangleList MakeIndependentTextured()
 	{
 		namespace dx = DirectX;
 		constexpr float side = 1.0f / 2.0f;
 
-		D3::VertexBuffer vb{ std::move(layout) };
-
 		// Create 24 vertices (4 for each of the 6 faces) for independent normals
-		// Near face (negative Z)
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, -side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f }, dx::XMFLOAT2{ 0.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, -side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f }, dx::XMFLOAT2{ 1.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f }, dx::XMFLOAT2{ 0.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f }, dx::XMFLOAT2{ 1.0f, 0.0f });
-
-		// Far face (positive Z)
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, -side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f }, dx::XMFLOAT2{ 1.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, -side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f }, dx::XMFLOAT2{ 0.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f }, dx::XMFLOAT2{ 1.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f }, dx::XMFLOAT2{ 0.0f, 0.0f });
-
-		// Left face (negative X)
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, -side, -side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, side, -side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, -side, side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, side, side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 0.0f });
-
-		// Right face (positive X)
-		vb.EmplaceBack(dx::XMFLOAT3{ side, -side, -side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, side, -side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, -side, side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, side, side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 0.0f });
-
-		// Bottom face (negative Y)
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, -side, -side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, -side, -side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, -side, side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, -side, side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 1.0f });
-
-		// Top face (positive Y)
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, side, -side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, side, -side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, side, side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, side, side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 0.0f });
+		std::vector<PNT::Vertex> vertices =
+		{
+			// Near face (negative Z)
+			{ dx::XMFLOAT3{ -side, -side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f }, dx::XMFLOAT2{ 0.0f, 1.0f } },
+			{ dx::XMFLOAT3{ side, -side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f }, dx::XMFLOAT2{ 1.0f, 1.0f } },
+			{ dx::XMFLOAT3{ -side, side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f }, dx::XMFLOAT2{ 0.0f, 0.0f } },
+			{ dx::XMFLOAT3{ side, side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f }, dx::XMFLOAT2{ 1.0f, 0.0f } },
+
+			// Far face (positive Z)
+			{ dx::XMFLOAT3{ -side, -side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f }, dx::XMFLOAT2{ 1.0f, 1.0f } },
+			{ dx::XMFLOAT3{ side, -side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f }, dx::XMFLOAT2{ 0.0f, 1.0f } },
+			{ dx::XMFLOAT3{ -side, side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f }, dx::XMFLOAT2{ 1.0f, 0.0f } },
+			{ dx::XMFLOAT3{ side, side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f }, dx::XMFLOAT2{ 0.0f, 0.0f } },
+
+			// Left face (negative X)
+			{ dx::XMFLOAT3{ -side, -side, -side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 1.0f } },
+			{ dx::XMFLOAT3{ -side, side, -side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 0.0f } },
+			{ dx::XMFLOAT3{ -side, -side, side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 1.0f } },
+			{ dx::XMFLOAT3{ -side, side, side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 0.0f } },
+
+			// Right face (positive X)
+			{ dx::XMFLOAT3{ side, -side, -side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 1.0f } },
+			{ dx::XMFLOAT3{ side, side, -side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 0.0f } },
+			{ dx::XMFLOAT3{ side, -side, side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 1.0f } },
+			{ dx::XMFLOAT3{ side, side, side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 0.0f } },
+
+			// Bottom face (negative Y)
+			{ dx::XMFLOAT3{ -side, -side, -side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 0.0f } },
+			{ dx::XMFLOAT3{ side, -side, -side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 0.0f } },
+			{ dx::XMFLOAT3{ -side, -side, side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 1.0f } },
+			{ dx::XMFLOAT3{ side, -side, side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 1.0f } },
+
+			// Top face (positive Y)
+			{ dx::XMFLOAT3{ -side, side, -side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 1.0f } },
+			{ dx::XMFLOAT3{ side, side, -side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 1.0f } },
+			{ dx::XMFLOAT3{ -side, side, side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f }, dx::XMFLOAT2{ 0.0f, 0.0f } },
+			{ dx::XMFLOAT3{ side, side, side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f }, dx::XMFLOAT2{ 1.0f, 0.0f } },
+		};
 
 		// Define indices for all faces (2 triangles per face)
-		std::vector<unsigned short> indices = {
+		std::vector<unsigned int> indices = {
 			// Near face (negative Z)
 			0, 2, 1,    2, 3, 1,
 			// Far face (positive Z)
@@ -92,55 +80,56 @@ public:
 			20, 23, 21, 20, 22, 23
 		};
 
-		return { std::move(vb), std::move(indices) };
+		return { PNT::MakeBuffer(vertices), std::move(indices) };
 	}
 
-	static IndexedTriangleList MakeIndependentSolid(D3::VertexLayout layout)
+	static IndexedTriangleList MakeIndependentSolid()
 	{
 		namespace dx = DirectX;
 		constexpr float side = 1.0f / 2.0f;
 
-		D3::VertexBuffer vb{ std::move(layout) };
-
 		// Create 24 vertices (4 for each of the 6 faces) for independent normals
-		// Near face (negative Z)
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, -side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, -side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f });
-
-		// Far face (positive Z)
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, -side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, -side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f });
-
-		// Left face (negative X)
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, -side, -side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, side, -side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, -side, side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, side, side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f });
-
-		// Right face (positive X)
-		vb.EmplaceBack(dx::XMFLOAT3{ side, -side, -side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, side, -side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, -side, side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, side, side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f });
-
-		// Bottom face (negative Y)
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, -side, -side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, -side, -side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, -side, side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, -side, side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f });
-
-		// Top face (positive Y)
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, side, -side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, side, -side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ -side, side, side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f });
-		vb.EmplaceBack(dx::XMFLOAT3{ side, side, side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f });
+		std::vector<PN::Vertex> vertices =
+		{
+			// Near face (negative Z)
+			{ dx::XMFLOAT3{ -side, -side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f } },
+			{ dx::XMFLOAT3{ side, -side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f } },
+			{ dx::XMFLOAT3{ -side, side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f } },
+			{ dx::XMFLOAT3{ side, side, -side }, dx::XMFLOAT3{ 0.0f, 0.0f, -1.0f } },
+
+			// Far face (positive Z)
+			{ dx::XMFLOAT3{ -side, -side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f } },
+			{ dx::XMFLOAT3{ side, -side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f } },
+			{ dx::XMFLOAT3{ -side, side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f } },
+			{ dx::XMFLOAT3{ side, side, side }, dx::XMFLOAT3{ 0.0f, 0.0f, 1.0f } },
+
+			// Left face (negative X)
+			{ dx::XMFLOAT3{ -side, -side, -side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f } },
+			{ dx::XMFLOAT3{ -side, side, -side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f } },
+			{ dx::XMFLOAT3{ -side, -side, side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f } },
+			{ dx::XMFLOAT3{ -side, side, side }, dx::XMFLOAT3{ -1.0f, 0.0f, 0.0f } },
+
+			// Right face (positive X)
+			{ dx::XMFLOAT3{ side, -side, -side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f } },
+			{ dx::XMFLOAT3{ side, side, -side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f } },
+			{ dx::XMFLOAT3{ side, -side, side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f } },
+			{ dx::XMFLOAT3{ side, side, side }, dx::XMFLOAT3{ 1.0f, 0.0f, 0.0f } },
+
+			// Bottom face (negative Y)
+			{ dx::XMFLOAT3{ -side, -side, -side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f } },
+			{ dx::XMFLOAT3{ side, -side, -side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f } },
+			{ dx::XMFLOAT3{ -side, -side, side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f } },
+			{ dx::XMFLOAT3{ side, -side, side }, dx::XMFLOAT3{ 0.0f, -1.0f, 0.0f } },
+
+			// Top face (positive Y)
+			{ dx::XMFLOAT3{ -side, side, -side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f } },
+			{ dx::XMFLOAT3{ side, side, -side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f } },
+			{ dx::XMFLOAT3{ -side, side, side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f } },
+			{ dx::XMFLOAT3{ side, side, side }, dx::XMFLOAT3{ 0.0f, 1.0f, 0.0f } },
+		};
 
 		// Define indices for all faces (2 triangles per face)
-		std::vector<unsigned short> indices = {
+		std::vector<unsigned int> indices = {
 			// Near face (negative Z)
 			0, 2, 1,    2, 3, 1,
 			// Far face (positive Z)
@@ -155,6 +144,6 @@ public:
 			20, 23, 21, 20, 22, 23
 		};
 
-		return { std::move(vb), std::move(indices) };
+		return { PN::MakeBuffer(vertices), std::move(indices) };
 	}
 };
\ No newline at end of file
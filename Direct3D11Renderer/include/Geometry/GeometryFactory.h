@@ -32,7 +32,7 @@ public:
             vertices[i].position = positions[i];
         }
 
-        std::vector<unsigned short> indices = {
+        std::vector<unsigned int> indices = {
             0, 2, 1,  2, 3, 1,  // Front face (-Z) - closer to viewer
             1, 3, 5,  3, 7, 5,  // Right face (+X)
             2, 6, 3,  3, 6, 7,  // Top face (+Y)
@@ -141,7 +141,7 @@ public:
         }
 
         // Define indices for all faces (2 triangles per face)
-        std::vector<unsigned short> indices = {
+        std::vector<unsigned int> indices = {
             // Near face (negative Z)
             0, 2, 1,    2, 3, 1,
             // Far face (positive Z)
@@ -215,7 +215,7 @@ public:
         vertices[13].texCoord = { 0.0f / 3.0f, 2.0f / 4.0f };
 
         // Define indices for each face
-        std::vector<unsigned short> indices = {
+        std::vector<unsigned int> indices = {
             0,2,1,    2,3,1,    // Front face
             4,8,5,    5,8,9,    // Bottom face (reusing some vertices with different UVs)
             2,6,3,    3,6,7,    // Top face
@@ -324,7 +324,7 @@ public:
         }
 
         // Define indices for all faces (2 triangles per face)
-        std::vector<unsigned short> indices = {
+        std::vector<unsigned int> indices = {
             // Near face (negative Z)
             0, 2, 1,    2, 3, 1,
             // Far face (positive Z)
@@ -387,18 +387,18 @@ public:
             }
         }
 
-        std::vector<unsigned short> indices;
+        std::vector<unsigned int> indices;
 
         // Create indices for the main body of the sphere (connecting latitude rings)
-        for (unsigned short iLat = 0; iLat < latDiv; iLat++)
+        for (unsigned int iLat = 0; iLat < static_cast<unsigned int>(latDiv); iLat++)
         {
-            for (unsigned short iLong = 0; iLong < longDiv; iLong++)
+            for (unsigned int iLong = 0; iLong < static_cast<unsigned int>(longDiv); iLong++)
             {
                 // Calculate indices for the two triangles of each quad
-                unsigned short i1 = iLat * longDiv + iLong;
-                unsigned short i2 = i1 + longDiv;
-                unsigned short i3 = (iLat * longDiv) + ((iLong + 1) % longDiv);
-                unsigned short i4 = i3 + longDiv;
+                unsigned int i1 = iLat * longDiv + iLong;
+                unsigned int i2 = i1 + longDiv;
+                unsigned int i3 = (iLat * longDiv) + ((iLong + 1) % longDiv);
+                unsigned int i4 = i3 + longDiv;
 
                 // First triangle
                 indices.push_back(i1);
@@ -424,7 +424,7 @@ public:
         longDiv = std::max(3, longDiv);
 
         std::vector<VertexType> vertices;
-        std::vector<unsigned short> indices;
+        std::vector<unsigned int> indices;
 
         // Calculate constants
         const float halfHeight = height / 2.0f;
@@ -456,17 +456,17 @@ public:
             baseCenter.normal = { 0.0f, 0.0f, -1.0f }; // Base normal points down
         }
 
-        unsigned short baseCenterIndex = static_cast<unsigned short>(vertices.size());
+        unsigned int baseCenterIndex = static_cast<unsigned int>(vertices.size());
         vertices.push_back(baseCenter);
 
         // Add tip of the cone
         VertexType tip;
         tip.position = { 0.0f, 0.0f, halfHeight };
-        unsigned short tipIndex = static_cast<unsigned short>(vertices.size());
+        unsigned int tipIndex = static_cast<unsigned int>(vertices.size());
         vertices.push_back(tip);
 
         // Create base indices (connecting each segment to the center)
-        for (unsigned short i = 0; i < longDiv; i++)
+        for (unsigned int i = 0; i < static_cast<unsigned int>(longDiv); i++)
         {
             indices.push_back(baseCenterIndex);
             indices.push_back((i + 1) % longDiv);
@@ -474,9 +474,9 @@ public:
         }
 
         // Create side face indices and calculate normals for the sides
-        for (unsigned short i = 0; i < longDiv; i++)
+        for (unsigned int i = 0; i < static_cast<unsigned int>(longDiv); i++)
         {
-            unsigned short nextI = (i + 1) % longDiv;
+            unsigned int nextI = (i + 1) % longDiv;
 
             // If the vertex type supports normals, calculate the proper side normal
             if constexpr (has_normal_member<VertexType>::value) {
@@ -508,13 +508,13 @@ public:
                 sideVertexTip.normal = normal;
 
                 // Add these vertices to the array
-                unsigned short idx1 = static_cast<unsigned short>(vertices.size());
+                unsigned int idx1 = static_cast<unsigned int>(vertices.size());
                 vertices.push_back(sideVertex1);
 
-                unsigned short idx2 = static_cast<unsigned short>(vertices.size());
+                unsigned int idx2 = static_cast<unsigned int>(vertices.size());
                 vertices.push_back(sideVertex2);
 
-                unsigned short idxTip = static_cast<unsigned short>(vertices.size());
+                unsigned int idxTip = static_cast<unsigned int>(vertices.size());
                 vertices.push_back(sideVertexTip);
 
                 // Add indices for this side triangle
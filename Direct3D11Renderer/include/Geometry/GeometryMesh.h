@@ -1,33 +1,50 @@
 #pragma once
 
+#include "StaticVertexLayout.h"
 #include <vector>
 #include <DirectXMath.h>
 #include <cassert>
+#include <cstddef>
 
+// Each vertex struct names the static layout it is packed like, so a mesh can be copied
+// into a D3::VertexBuffer as one block (see GeometryMesh::MakeVertexBuffer)
 struct VertexPosition
 {
+	using Layout = D3::StaticVertexLayout<D3::VertexLayout::Position3D>;
 	DirectX::XMFLOAT3 position;
 };
 
 struct VertexPositionNormal
 {
+	using Layout = D3::StaticVertexLayout<D3::VertexLayout::Position3D, D3::VertexLayout::Normal>;
 	DirectX::XMFLOAT3 position;
 	DirectX::XMFLOAT3 normal;
 };
 
 struct VertexPositionTexture
 {
+	using Layout = D3::StaticVertexLayout<D3::VertexLayout::Position3D, D3::VertexLayout::Texture2D>;
 	DirectX::XMFLOAT3 position;
 	DirectX::XMFLOAT2 texCoord;
 };
 
 struct VertexPositionNormalTexture
 {
+	using Layout = D3::StaticVertexLayout<D3::VertexLayout::Position3D, D3::VertexLayout::Normal, D3::VertexLayout::Texture2D>;
 	DirectX::XMFLOAT3 position;
 	DirectX::XMFLOAT3 normal;
 	DirectX::XMFLOAT2 texCoord;
 };
 
+static_assert(sizeof(VertexPosition) == VertexPosition::Layout::size, "VertexPosition is not packed like its layout");
+static_assert(sizeof(VertexPositionNormal) == VertexPositionNormal::Layout::size, "VertexPositionNormal is not packed like its layout");
+static_assert(offsetof(VertexPositionNormal, normal) == VertexPositionNormal::Layout::OffsetOf<D3::VertexLayout::Normal>(), "VertexPositionNormal is not packed like its layout");
+static_assert(sizeof(VertexPositionTexture) == VertexPositionTexture::Layout::size, "VertexPositionTexture is not packed like its layout");
+static_assert(offsetof(VertexPositionTexture, texCoord) == VertexPositionTexture::Layout::OffsetOf<D3::VertexLayout::Texture2D>(), "VertexPositionTexture is not packed like its layout");
+static_assert(sizeof(VertexPositionNormalTexture) == VertexPositionNormalTexture::Layout::size, "VertexPositionNormalTexture is not packed like its layout");
+static_assert(offsetof(VertexPositionNormalTexture, normal) == VertexPositionNormalTexture::Layout::OffsetOf<D3::VertexLayout::Normal>(), "VertexPositionNormalTexture is not packed like its layout");
+static_assert(offsetof(VertexPositionNormalTexture, texCoord) == VertexPositionNormalTexture::Layout::OffsetOf<D3::VertexLayout::Texture2D>(), "VertexPositionNormalTexture is not packed like its layout");
+
 // Helper type traits to check for vertex members
 template <typename T, typename = void>
 struct has_texcoord_member : std::false_type {};
@@ -59,7 +76,7 @@ class GeometryMesh
 {
 public:
 	GeometryMesh() = default;
-	GeometryMesh(std::vector<VertexType> vertices_in, std::vector<unsigned short> indicies_in)
+	GeometryMesh(std::vector<VertexType> vertices_in, std::vector<unsigned int> indicies_in)
 		: vertices(std::move(vertices_in)), indices(std::move(indicies_in))
 	{
 		assert(!this->vertices.empty() && "Mesh must have at least one vertex.");
@@ -108,6 +125,14 @@ public:
         }
     }
 
+    // copies the vertices into a dynamic vertex buffer with the equivalent runtime layout
+    D3::VertexBuffer MakeVertexBuffer() const
+    {
+        D3::VertexBuffer vb{ VertexType::Layout::GetLayout() };
+        vb.Append(vertices.data(), vertices.size());
+        return vb;
+    }
+
 	std::vector<VertexType> vertices;
-	std::vector<unsigned short> indices;
+	std::vector<unsigned int> indices;
 };
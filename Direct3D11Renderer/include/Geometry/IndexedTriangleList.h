@@ -7,7 +7,7 @@ class IndexedTriangleList
 {
 public:
 	IndexedTriangleList() = default;
-	IndexedTriangleList(D3::VertexBuffer verts_in, std::vector<unsigned short> indices_in)
+	IndexedTriangleList(D3::VertexBuffer verts_in, std::vector<unsigned int> indices_in)
 		:
 		vertices(std::move(verts_in)),
 		indices(std::move(indices_in))
@@ -18,9 +18,8 @@ public:
 	void Transform(DirectX::FXMMATRIX matrix)
 	{
 		using Elements = D3::VertexLayout::ElementType;
-		for (int i = 0; i < vertices.Size(); i++)
+		for (auto& pos : vertices.View<Elements::Position3D>())
 		{
-			auto& pos = vertices[i].Attr<Elements::Position3D>();
 			DirectX::XMStoreFloat3(
 				&pos,
 				DirectX::XMVector3Transform(DirectX::XMLoadFloat3(&pos), matrix)
@@ -30,5 +29,5 @@ public:
 
 public:
 	D3::VertexBuffer vertices;
-	std::vector<unsigned short> indices;
+	std::vector<unsigned int> indices;
 };
\ No newline at end of file
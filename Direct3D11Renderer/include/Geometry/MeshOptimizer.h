@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Vertex.h"
+#include <DirectXMath.h>
+#include <vector>
+#include <cstddef>
+
+/** @brief Post-import mesh optimization.
+ *
+ *  Reorders the triangles and vertices of an indexed triangle list so the GPU transforms
+ *  fewer vertices, shades fewer hidden pixels and fetches vertex data more linearly, and
+ *  measures the result. CPU only (DirectXMath and D3::VertexBuffer), no device needed.
+ *
+ *  Optimize() runs the full pipeline:
+ *  1. WeldVertices: merges byte-identical vertices (packed element types often create new ones)
+ *  2. OptimizeVertexCache: Tipsify triangle order for the post-transform vertex cache
+ *  3. OptimizeOverdraw: orders triangle clusters front to back from the outside in
+ *  4. OptimizeVertexFetch: stores vertices in the order the triangles first use them
+ *
+ *  Example usage:
+ *  @code
+ *  D3::VertexBuffer vertices{ layout, mesh };
+ *  std::vector<unsigned int> indices = ...;
+ *  D3::MeshOptimizer::Settings settings;
+ *  settings.measureMetrics = true;
+ *  const auto report = D3::MeshOptimizer::Optimize(vertices, indices, settings);
+ *  @endcode
+ */
+namespace D3
+{
+	namespace MeshOptimizer
+	{
+		/** @brief Cost of drawing an index buffer, as estimated on the CPU */
+		struct Metrics
+		{
+			size_t triangleCount = 0;   /**< Number of triangles */
+			size_t vertexCount = 0;     /**< Number of distinct vertices the triangles reference */
+			float acmr = 0.0f;          /**< Average cache miss ratio: vertices transformed per triangle (0.5 to 3, lower is better) */
+			float atvr = 0.0f;          /**< Average transformed vertex ratio: vertices transformed per vertex (1 is optimal) */
+			float overdraw = 0.0f;      /**< Pixels shaded per pixel covered, averaged over six axis views (1 is optimal) */
+		};
+
+		/** @brief Metrics before and after Optimize, plus what each step changed */
+		struct Report
+		{
+			Metrics before;              /**< Metrics of the mesh as imported */
+			Metrics after;               /**< Metrics of the optimized mesh */
+			size_t weldedVertices = 0;   /**< Vertices removed because they duplicated another one */
+			size_t clusterCount = 0;     /**< Triangle clusters the overdraw step ordered */
+		};
+
+		/** @brief Tuning for Optimize */
+		struct Settings
+		{
+			/** @brief Entries in the simulated FIFO post-transform cache (16 is typical of D3D11 class hardware) */
+			unsigned int cacheSize = 16u;
+			/** @brief Largest ACMR increase, as a ratio, the overdraw step may trade for finer clusters */
+			float overdrawThreshold = 1.05f;
+			/** @brief Fills Report::before and Report::after. Off by default, measuring overdraw rasterizes
+			 *  the mesh from six directions twice, which costs more than the optimization itself */
+			bool measureMetrics = false;
+		};
+
+		/** @brief Runs the full pipeline in place.
+		 *  @param vertices Vertex buffer; must contain Position3D or Position3DQuantized
+		 *  @param indices Triangle list indexing vertices
+		 *  @param settings Cache size, overdraw tradeoff and whether to measure the result
+		 *  @return What the steps changed, plus metrics before and after if settings.measureMetrics is set
+		 */
+		Report Optimize(VertexBuffer& vertices, std::vector<unsigned int>& indices, const Settings& settings = {});
+
+		/** @brief Merges byte-identical vertices by rewriting the indices to the first copy.
+		 *  @note The duplicates stay in the buffer until OptimizeVertexFetch drops unreferenced vertices
+		 *  @return Number of vertices that are no longer referenced
+		 */
+		size_t WeldVertices(const VertexBuffer& vertices, std::vector<unsigned int>& indices);
+
+		/** @brief Reorders triangles for the post-transform vertex cache (Tipsify, Sander et al. 2007).
+		 *  @param indices Triangle list to reorder
+		 *  @param vertexCount Number of vertices the indices may reference
+		 *  @param cacheSize Entries in the simulated cache
+		 *  @param pClusters Receives the first triangle of every run that starts after a jump to
+		 *         a non-adjacent part of the mesh (optional, used by OptimizeOverdraw)
+		 *  @return Reordered triangle list
+		 */
+		std::vector<unsigned int> OptimizeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount,
+			unsigned int cacheSize, std::vector<size_t>* pClusters = nullptr);
+
+		/** @brief Orders triangle clusters so outward facing parts of the mesh are drawn first.
+		 *
+		 *  Clusters from OptimizeVertexCache are split further wherever the cache efficiency of
+		 *  a cold-started cluster stays within threshold of the whole mesh, then sorted by how far
+		 *  they face away from the mesh centroid. Triangle order inside a cluster is kept.
+		 *  @param indices Cache-optimized triangle list
+		 *  @param positions Vertex positions
+		 *  @param clusters First triangle of each cluster, as produced by OptimizeVertexCache
+		 *  @param cacheSize Entries in the simulated cache
+		 *  @param threshold Largest ACMR increase allowed, as a ratio
+		 *  @param pClusterCount Receives the number of clusters sorted (optional)
+		 *  @return Reordered triangle list
+		 */
+		std::vector<unsigned int> OptimizeOverdraw(const std::vector<unsigned int>& indices, const std::vector<DirectX::XMFLOAT3>& positions,
+			const std::vector<size_t>& clusters, unsigned int cacheSize, float threshold, size_t* pClusterCount = nullptr);
+
+		/** @brief Numbers vertices in the order the triangles first reference them.
+		 *  @param indices Triangle list, rewritten to the new numbering
+		 *  @param vertexCount Number of vertices the indices may reference
+		 *  @return Source vertex for each new vertex, for VertexBuffer::Remap (unreferenced vertices are dropped)
+		 */
+		std::vector<unsigned int> OptimizeVertexFetch(std::vector<unsigned int>& indices, size_t vertexCount);
+
+		/** @brief Measures cache efficiency and overdraw of a triangle list.
+		 *  @param indices Triangle list
+		 *  @param positions Vertex positions (overdraw is 0 if empty)
+		 *  @param cacheSize Entries in the simulated cache
+		 */
+		Metrics Analyze(const std::vector<unsigned int>& indices, const std::vector<DirectX::XMFLOAT3>& positions, unsigned int cacheSize);
+
+		/** @brief Copies the positions out of a vertex buffer, decoding quantized positions. */
+		std::vector<DirectX::XMFLOAT3> ExtractPositions(const VertexBuffer& vertices);
+	}
+}
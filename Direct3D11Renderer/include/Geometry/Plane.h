@@ -1,7 +1,7 @@
 #pragma once
 
 #include <optional>
-#include "Vertex.h"
+#include "StaticVertexLayout.h"
 #include "IndexedTriangleList.h"
 #include <DirectXMath.h>
 #include <array>
@@ -15,8 +15,9 @@ constexpr auto sq(const T& x)
 
 class Plane
 {
+	using PNT = D3::StaticVertexLayout<D3::VertexLayout::Position3D, D3::VertexLayout::Normal, D3::VertexLayout::Texture2D>;
 public:
-	static IndexedTriangleList MakeTesselatedTextured(D3::VertexLayout layout, int divisions_x, int divisions_y)
+	static IndexedTriangleList MakeTesselatedTextured(int divisions_x, int divisions_y)
 	{
 		namespace dx = DirectX;
 		assert(divisions_x >= 1);
@@ -26,7 +27,8 @@ public:
 		constexpr float height = 2.0f;
 		const int nVertices_x = divisions_x + 1;
 		const int nVertices_y = divisions_y + 1;
-		D3::VertexBuffer vb{ std::move(layout) };
+		std::vector<PNT::Vertex> vertices;
+		vertices.reserve(size_t(nVertices_x) * nVertices_y);
 
 		{
 			const float side_x = width / 2.0f;
@@ -44,27 +46,27 @@ public:
 				{
 					const float x_pos = float(x) * divisionSize_x - 1.0f;
 					const float x_pos_tc = float(x) * divisionSize_x_tc;
-					vb.EmplaceBack(
+					vertices.push_back({
 						dx::XMFLOAT3{ x_pos,y_pos,0.0f },
 						dx::XMFLOAT3{ 0.0f,0.0f,-1.0f },
 						dx::XMFLOAT2{ x_pos_tc,y_pos_tc }
-					);
+					});
 				}
 			}
 		}
 
-		std::vector<unsigned short> indices;
+		std::vector<unsigned int> indices;
 		indices.reserve(sq(divisions_x * divisions_y) * 6);
 		{
 			const auto vxy2i = [nVertices_x](size_t x, size_t y)
 				{
-					return (unsigned short)(y * nVertices_x + x);
+					return (unsigned int)(y * nVertices_x + x);
 				};
 			for (size_t y = 0; y < divisions_y; y++)
 			{
 				for (size_t x = 0; x < divisions_x; x++)
 				{
-					const std::array<unsigned short, 4> indexArray =
+					const std::array<unsigned int, 4> indexArray =
 					{ vxy2i(x,y),vxy2i(x + 1,y),vxy2i(x,y + 1),vxy2i(x + 1,y + 1) };
 					indices.push_back(indexArray[0]);
 					indices.push_back(indexArray[2]);
@@ -76,16 +78,10 @@ public:
 			}
 		}
 
-		return{ std::move(vb),std::move(indices) };
+		return{ PNT::MakeBuffer(vertices),std::move(indices) };
 	}
 	static IndexedTriangleList Make()
 	{
-		using D3::VertexLayout;
-		VertexLayout vl;
-		vl.Append(VertexLayout::Position3D);
-		vl.Append(VertexLayout::Normal);
-		vl.Append(VertexLayout::Texture2D);
-
-		return MakeTesselatedTextured(std::move(vl), 1, 1);
+		return MakeTesselatedTextured(1, 1);
 	}
 };
\ No newline at end of file
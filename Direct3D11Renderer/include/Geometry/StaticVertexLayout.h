@@ -0,0 +1,161 @@
+#pragma once
+
+#include "Vertex.h"
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+namespace D3
+{
+	/** @brief Vertex layout whose elements are fixed at compile time.
+	 *
+	 *  Computes element offsets and the vertex size as constants using the same packing as
+	 *  VertexLayout::Append, and provides a packed, trivially copyable Vertex type for that
+	 *  layout. Geometry built from Vertex values is written with plain stores and copied into
+	 *  a D3::VertexBuffer in one block, instead of going through EmplaceBack and the Bridge
+	 *  switch per attribute.
+	 *
+	 *  GetLayout() converts to a runtime VertexLayout with the same elements in the same
+	 *  order, so GetCode() and GetD3DLayout() match a layout built with Append and the
+	 *  resulting buffers share input layouts and bindable cache entries with it.
+	 *
+	 *  Example usage:
+	 *  @code
+	 *  using PNT = D3::StaticVertexLayout<VertexLayout::Position3D, VertexLayout::Normal, VertexLayout::Texture2D>;
+	 *  std::vector<PNT::Vertex> vertices;
+	 *  vertices.push_back({ { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.5f, 0.0f } });
+	 *  D3::VertexBuffer vb = PNT::MakeBuffer(vertices);
+	 *  @endcode
+	 *
+	 *  @tparam Types Element types in vertex order (each type at most once)
+	 */
+	template<VertexLayout::ElementType... Types>
+	class StaticVertexLayout
+	{
+		static_assert(sizeof...(Types) > 0, "Static vertex layout must have at least one element");
+		static_assert([] {
+			constexpr std::array<VertexLayout::ElementType, sizeof...(Types)> types = { Types... };
+			for (size_t i = 0; i < types.size(); i++)
+			{
+				for (size_t j = i + 1; j < types.size(); j++)
+				{
+					if (types[i] == types[j])
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}(), "Static vertex layout element types must be unique");
+
+	public:
+		/** @brief Number of elements in the layout */
+		static constexpr size_t count = sizeof...(Types);
+
+		/** @brief Byte offset of each element, in layout order */
+		static constexpr std::array<size_t, count> offsets = [] {
+			std::array<size_t, count> result{};
+			size_t offset = 0;
+			size_t i = 0;
+			((result[i++] = offset, offset += sizeof(typename VertexLayout::Map<Types>::SysType)), ...);
+			return result;
+		}();
+
+		/** @brief Size in bytes of one vertex */
+		static constexpr size_t size = (sizeof(typename VertexLayout::Map<Types>::SysType) + ...);
+
+		/** @brief Checks whether the layout contains an element type.
+		 *  @tparam Type The ElementType to check for
+		 */
+		template<VertexLayout::ElementType Type>
+		static constexpr bool Has() noexcept
+		{
+			return ((Type == Types) || ...);
+		}
+
+		/** @brief Gets the byte offset of an element type within a vertex.
+		 *  @tparam Type The ElementType to look up (must be in the layout)
+		 */
+		template<VertexLayout::ElementType Type>
+		static constexpr size_t OffsetOf() noexcept
+		{
+			static_assert(Has<Type>(), "Element type is not part of this static vertex layout");
+			size_t index = 0;
+			size_t i = 0;
+			((Type == Types ? (index = i, ++i) : ++i), ...);
+			return offsets[index];
+		}
+
+		/** @brief Packed vertex with the elements of this layout at their compile-time offsets.
+		 *
+		 *  Trivially copyable and exactly size bytes, so an array of Vertex has the same bytes
+		 *  as a D3::VertexBuffer using GetLayout().
+		 */
+		class Vertex
+		{
+		public:
+			/** @brief The static layout this vertex belongs to */
+			using Layout = StaticVertexLayout;
+
+			Vertex() = default;
+			/** @brief Constructs a vertex from one value per element, in layout order.
+			 *  @param values Attribute values matching the layout's element types
+			 */
+			Vertex(const typename VertexLayout::Map<Types>::SysType&... values) noexcept
+			{
+				size_t i = 0;
+				(std::memcpy(data + offsets[i++], &values, sizeof(values)), ...);
+			}
+			/** @brief Gets a reference to an attribute of this vertex.
+			 *  @tparam Type The ElementType of the attribute (must be in the layout)
+			 *  @return Reference at a constant offset from the vertex start
+			 */
+			template<VertexLayout::ElementType Type>
+			auto& Attr() noexcept
+			{
+				return *reinterpret_cast<typename VertexLayout::Map<Type>::SysType*>(data + OffsetOf<Type>());
+			}
+			/** @brief Gets a const reference to an attribute of this vertex.
+			 *  @tparam Type The ElementType of the attribute (must be in the layout)
+			 */
+			template<VertexLayout::ElementType Type>
+			const auto& Attr() const noexcept
+			{
+				return *reinterpret_cast<const typename VertexLayout::Map<Type>::SysType*>(data + OffsetOf<Type>());
+			}
+		private:
+			// every SysType is a multiple of 4 bytes with at most 4-byte alignment, so the runtime layout never needs padding
+			alignas(4) char data[size];  /**< Raw attribute data, packed like VertexLayout */
+		};
+
+		static_assert(sizeof(Vertex) == size, "Static vertex must be packed like the runtime layout");
+		static_assert(std::is_trivially_copyable_v<Vertex>, "Static vertex must be copyable as raw bytes");
+
+		/** @brief Gets the equivalent runtime layout.
+		 *  @return Layout built once by appending the elements in order
+		 *  @note Debug builds check that the runtime offsets match the compile-time ones
+		 */
+		static const VertexLayout& GetLayout()
+		{
+			static const VertexLayout layout = [] {
+				VertexLayout result;
+				(result.Append(Types), ...);
+				assert(result.Size() == size && "Static vertex layout size differs from runtime packing");
+				assert(((result.GetOffset<Types>() == OffsetOf<Types>()) && ...) && "Static vertex layout offsets differ from runtime packing");
+				return result;
+			}();
+			return layout;
+		}
+
+		/** @brief Creates a vertex buffer holding a copy of the given vertices.
+		 *  @param vertices Vertices to copy
+		 *  @return Buffer using GetLayout(), filled with a single copy
+		 */
+		static VertexBuffer MakeBuffer(const std::vector<Vertex>& vertices)
+		{
+			VertexBuffer vb{ GetLayout() };
+			vb.Append(vertices.data(), vertices.size());
+			return vb;
+		}
+	};
+}
@@ -1,15 +1,24 @@
 #pragma once
 
 #include <vector>
+#include <array>
+#include <cstddef>
+#include <iterator>
 #include <type_traits>
 #include <cassert>
 #include <utility>
 #include <string>
+#include <algorithm>
+#include <cstring>
+#include <execution>
 #include <d3d11.h>
 #include <DirectXMath.h>
 #include <scene.h>
+#include "VertexCompression.h"
 
-#define DVTX_ELEMENT_AI_EXTRACTOR(member) static SysType Extract( const aiMesh& mesh,size_t i ) noexcept {return *reinterpret_cast<const SysType*>(&mesh.member[i]);}
+#define DVTX_ELEMENT_AI_EXTRACTOR(member) static SysType Extract( const aiMesh& mesh,size_t i,const VertexQuantization& ) noexcept {return *reinterpret_cast<const SysType*>(&mesh.member[i]);} \
+	static const char* AiSource( const aiMesh& mesh ) noexcept {return reinterpret_cast<const char*>(mesh.member);} \
+	static constexpr size_t aiStride = sizeof(*std::declval<const aiMesh&>().member);
 
 /** @brief Direct3D11 vertex system namespace containing all vertex-related classes and utilities */
 namespace D3
@@ -58,6 +67,10 @@ namespace D3
 			Float3Color,   /**< RGB color as 3 floats (XMFLOAT3) */
 			Float4Color,   /**< RGBA color as 4 floats (XMFLOAT4) */
 			BGRAColor,     /**< BGRA color as packed bytes (BGRAColor) */
+			Position3DQuantized,     /**< 3D position as 16-bit UNORM relative to the mesh bounds (XMUSHORTN4) */
+			NormalOctahedral,        /**< Octahedral-encoded normal as 16-bit SNORM (XMSHORTN2) */
+			TangentFrameOctahedral,  /**< Octahedral tangent plus bitangent sign as 16-bit SNORM (XMSHORTN4) */
+			Texture2DHalf,           /**< 2D texture coordinates as half floats (XMHALF2) */
 			Count,         /**< Total number of element types - used for iteration */
 		};
 		/** @brief Template struct for mapping ElementType to DirectX types and formats.
@@ -152,6 +165,57 @@ namespace D3
 			static constexpr const char* code = "CB";  /**< Short code for layout identification */
 			DVTX_ELEMENT_AI_EXTRACTOR(mColors[0]);
 		};
+		/** @brief Specialization for quantized 3D positions (decoded with the mesh's VertexQuantization) */
+		template<> struct Map<Position3DQuantized>
+		{
+			using SysType = DirectX::PackedVector::XMUSHORTN4;  /**< 4 x 16-bit unsigned normalized, w unused */
+			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R16G16B16A16_UNORM;  /**< 16-bit normalized RGBA format */
+			static constexpr const char* semantic = "Position";  /**< HLSL semantic name */
+			static constexpr const char* code = "Pq";  /**< Short code for layout identification */
+			static SysType Extract(const aiMesh& mesh, size_t i, const VertexQuantization& q) noexcept
+			{
+				return VertexPacking::EncodePosition(*reinterpret_cast<const DirectX::XMFLOAT3*>(&mesh.mVertices[i]), q);
+			}
+		};
+		/** @brief Specialization for octahedral-encoded normals */
+		template<> struct Map<NormalOctahedral>
+		{
+			using SysType = DirectX::PackedVector::XMSHORTN2;  /**< 2 x 16-bit signed normalized */
+			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R16G16_SNORM;  /**< 16-bit signed normalized RG format */
+			static constexpr const char* semantic = "Normal";  /**< HLSL semantic name */
+			static constexpr const char* code = "No";  /**< Short code for layout identification */
+			static SysType Extract(const aiMesh& mesh, size_t i, const VertexQuantization&) noexcept
+			{
+				return VertexPacking::EncodeNormal(*reinterpret_cast<const DirectX::XMFLOAT3*>(&mesh.mNormals[i]));
+			}
+		};
+		/** @brief Specialization for octahedral tangent frames (replaces Tangent + Bitangent) */
+		template<> struct Map<TangentFrameOctahedral>
+		{
+			using SysType = DirectX::PackedVector::XMSHORTN4;  /**< 4 x 16-bit signed normalized: tangent xy, bitangent sign, unused */
+			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R16G16B16A16_SNORM;  /**< 16-bit signed normalized RGBA format */
+			static constexpr const char* semantic = "Tangent";  /**< HLSL semantic name */
+			static constexpr const char* code = "Fo";  /**< Short code for layout identification */
+			static SysType Extract(const aiMesh& mesh, size_t i, const VertexQuantization&) noexcept
+			{
+				return VertexPacking::EncodeTangentFrame(
+					*reinterpret_cast<const DirectX::XMFLOAT3*>(&mesh.mNormals[i]),
+					*reinterpret_cast<const DirectX::XMFLOAT3*>(&mesh.mTangents[i]),
+					*reinterpret_cast<const DirectX::XMFLOAT3*>(&mesh.mBitangents[i]));
+			}
+		};
+		/** @brief Specialization for half float texture coordinates */
+		template<> struct Map<Texture2DHalf>
+		{
+			using SysType = DirectX::PackedVector::XMHALF2;  /**< 2 x 16-bit float */
+			static constexpr DXGI_FORMAT dxgiFormat = DXGI_FORMAT_R16G16_FLOAT;  /**< 16-bit float RG format */
+			static constexpr const char* semantic = "TexCoord";  /**< HLSL semantic name */
+			static constexpr const char* code = "T2h";  /**< Short code for layout identification */
+			static SysType Extract(const aiMesh& mesh, size_t i, const VertexQuantization&) noexcept
+			{
+				return VertexPacking::EncodeTexCoord(mesh.mTextureCoords[0][i].x, mesh.mTextureCoords[0][i].y);
+			}
+		};
 		/** @brief Specialization for Count (used as sentinel/fallback) */
 		template<> struct Map<Count>
 		{
@@ -198,6 +262,10 @@ namespace D3
 			case VertexLayout::Float3Color: return Functor<VertexLayout::Float3Color>::Exec(std::forward<Args>(args)...);
 			case VertexLayout::Float4Color: return Functor<VertexLayout::Float4Color>::Exec(std::forward<Args>(args)...);
 			case VertexLayout::BGRAColor: return Functor<VertexLayout::BGRAColor>::Exec(std::forward<Args>(args)...);
+			case VertexLayout::Position3DQuantized: return Functor<VertexLayout::Position3DQuantized>::Exec(std::forward<Args>(args)...);
+			case VertexLayout::NormalOctahedral: return Functor<VertexLayout::NormalOctahedral>::Exec(std::forward<Args>(args)...);
+			case VertexLayout::TangentFrameOctahedral: return Functor<VertexLayout::TangentFrameOctahedral>::Exec(std::forward<Args>(args)...);
+			case VertexLayout::Texture2DHalf: return Functor<VertexLayout::Texture2DHalf>::Exec(std::forward<Args>(args)...);
 			}
 			assert(!"Invalid element type");
 			return Functor<VertexLayout::Count>::Exec(std::forward<Args>(args)...);
@@ -210,15 +278,19 @@ namespace D3
 		template<ElementType Type>
 		bool Has() const noexcept
 		{
-			for (auto& e : elements)
-			{
-				if (e.GetType() == Type)
-				{
-					return true;
-				}
-			}
-
-			return false;
+			return offsets[Type] != InvalidOffset;
+		}
+		/** @brief Gets the byte offset of an element type within a vertex.
+		 *  @tparam Type The ElementType to look up
+		 *  @return Offset of the first element of that type, read from the precomputed offset table
+		 *  @note Constant time; this is what Vertex::Attr and AttributeView use per access
+		 *  @warning Asserts if the element type is not present in the layout
+		 */
+		template<ElementType Type>
+		size_t GetOffset() const noexcept
+		{
+			assert(Has<Type>() && "Could not resolve element type");
+			return offsets[Type];
 		}
 
 		/** @brief Represents a single element within a vertex layout.
@@ -316,6 +388,13 @@ namespace D3
 			size_t offset;     /**< Byte offset from start of vertex data */
 		};
 	public:
+		/** @brief Offset table value for element types that are not in the layout */
+		static constexpr size_t InvalidOffset = ~size_t(0);
+		/** @brief Constructs an empty layout with no elements. */
+		VertexLayout() noexcept
+		{
+			offsets.fill(InvalidOffset);
+		}
 		/** @brief Finds and returns an element of the specified type.
 		 *  @tparam Type The ElementType to search for
 		 *  @return Reference to the first element of the specified type
@@ -347,7 +426,13 @@ namespace D3
 		 */
 		VertexLayout& Append(ElementType type)
 		{
-			elements.emplace_back(type, Size());
+			const auto offset = Size();
+			elements.emplace_back(type, offset);
+			// keep the first occurrence so the table agrees with Resolve for repeated types
+			if (offsets[type] == InvalidOffset)
+			{
+				offsets[type] = offset;
+			}
 			return *this;
 		}
 		/** @brief Gets the total size in bytes of a vertex using this layout.
@@ -382,6 +467,8 @@ namespace D3
 		 *  - T2: Texture2D, N: Normal
 		 *  - Nt: Tangent, Nb: Bitangent
 		 *  - C3: Float3Color, C4: Float4Color, CB: BGRAColor
+		 *  - Pq: Position3DQuantized, No: NormalOctahedral
+		 *  - Fo: TangentFrameOctahedral, T2h: Texture2DHalf
 		 */
 		std::string GetCode() const
 		{
@@ -394,6 +481,7 @@ namespace D3
 		}
 	private:
 		std::vector<Element> elements;  /**< Ordered list of vertex elements */
+		std::array<size_t, Count + 1> offsets;  /**< Byte offset of each ElementType, or InvalidOffset if absent (Count slot backs Bridge's fallback) */
 	};
 
 	/** @brief Represents a single vertex with dynamic attribute access.
@@ -434,7 +522,7 @@ namespace D3
 		template<VertexLayout::ElementType Type>
 		auto& Attr()
 		{
-			auto pAttribute = pData + layout.Resolve<Type>().GetOffset();
+			auto pAttribute = pData + layout.GetOffset<Type>();
 			return *reinterpret_cast<typename VertexLayout::Map<Type>::SysType*>(pAttribute);
 		}
 		/** @brief Sets a vertex attribute by its index position in the layout.
@@ -536,6 +624,99 @@ namespace D3
 		Vertex vertex;  /**< Copy of the vertex data for const access */
 	};
 
+	/** @brief Typed, strided view over one attribute of every vertex in a buffer.
+	 *
+	 *  Steps through the buffer by the vertex size starting at the attribute's offset, so
+	 *  whole-column loops (import, transforms) cost one add per vertex instead of building a
+	 *  Vertex proxy and looking up the attribute each time. The view does not own the data
+	 *  and is invalidated when the buffer it came from grows.
+	 *
+	 *  Example usage:
+	 *  @code
+	 *  for (auto& pos : vb.View<VertexLayout::Position3D>())
+	 *  {
+	 *      pos.y += 1.0f;
+	 *  }
+	 *  @endcode
+	 *
+	 *  @tparam Type The ElementType of the attribute to view
+	 *  @tparam IsConst True for a read-only view
+	 */
+	template<VertexLayout::ElementType Type, bool IsConst = false>
+	class AttributeView
+	{
+	public:
+		using SysType = typename VertexLayout::Map<Type>::SysType;
+		using ValueType = std::conditional_t<IsConst, const SysType, SysType>;
+		using BytePointer = std::conditional_t<IsConst, const char*, char*>;
+
+		/** @brief Forward iterator over the attribute column */
+		class Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = SysType;
+			using difference_type = std::ptrdiff_t;
+			using pointer = ValueType*;
+			using reference = ValueType&;
+
+			Iterator(BytePointer pAttribute, size_t stride) noexcept
+				: pAttribute(pAttribute), stride(stride)
+			{}
+			reference operator*() const noexcept { return *reinterpret_cast<pointer>(pAttribute); }
+			pointer operator->() const noexcept { return reinterpret_cast<pointer>(pAttribute); }
+			Iterator& operator++() noexcept
+			{
+				pAttribute += stride;
+				return *this;
+			}
+			Iterator operator++(int) noexcept
+			{
+				auto old = *this;
+				pAttribute += stride;
+				return old;
+			}
+			bool operator==(const Iterator& rhs) const noexcept { return pAttribute == rhs.pAttribute; }
+			bool operator!=(const Iterator& rhs) const noexcept { return pAttribute != rhs.pAttribute; }
+		private:
+			BytePointer pAttribute;  /**< Attribute of the current vertex */
+			size_t stride;           /**< Vertex size in bytes */
+		};
+
+		/** @brief Creates a view over a column of vertex data.
+		 *  @param pFirst Pointer to the attribute in the first vertex
+		 *  @param stride Vertex size in bytes
+		 *  @param count Number of vertices
+		 */
+		AttributeView(BytePointer pFirst, size_t stride, size_t count) noexcept
+			: pFirst(pFirst), stride(stride), count(count)
+		{}
+		/** @brief Gets the attribute of the vertex at the specified index.
+		 *  @param i Index of the vertex (0-based)
+		 *  @return Reference to the attribute data
+		 *  @warning Asserts if index is out of bounds
+		 */
+		ValueType& operator[](size_t i) const noexcept
+		{
+			assert(i < count);
+			return *reinterpret_cast<ValueType*>(pFirst + stride * i);
+		}
+		/** @brief Gets the number of vertices in the view. */
+		size_t Size() const noexcept { return count; }
+		/** @brief Gets the distance in bytes between consecutive attributes (the vertex size). */
+		size_t Stride() const noexcept { return stride; }
+		Iterator begin() const noexcept { return { pFirst, stride }; }
+		Iterator end() const noexcept { return { pFirst + stride * count, stride }; }
+	private:
+		BytePointer pFirst;  /**< Attribute of the first vertex */
+		size_t stride;       /**< Vertex size in bytes */
+		size_t count;        /**< Number of vertices */
+	};
+
+	/** @brief Read-only AttributeView, returned by VertexBuffer::View on a const buffer */
+	template<VertexLayout::ElementType Type>
+	using ConstAttributeView = AttributeView<Type, true>;
+
 	/** @brief Dynamic vertex buffer with flexible layout support.
 	 *
 	 *  Manages a collection of vertices in a contiguous memory buffer.
@@ -550,18 +731,82 @@ namespace D3
 	{
 	public:
 
+		/** @brief Meshes with at least this many vertices are imported on several threads */
+		static constexpr size_t ParallelImportThreshold = 32768u;
+		/** @brief Vertices per range when importing in parallel (also keeps each range's source rows in cache) */
+		static constexpr size_t ImportRangeSize = 16384u;
+
+		/** @brief Detects Map specializations that are a plain copy of an aiMesh array (DVTX_ELEMENT_AI_EXTRACTOR) */
+		template<typename Map, typename = void>
+		struct HasAiSource : std::false_type {};
+		template<typename Map>
+		struct HasAiSource<Map, std::void_t<decltype(Map::AiSource(std::declval<const aiMesh&>()))>> : std::true_type {};
+
+		/** @brief Fills one attribute column for a range of vertices from an imported mesh.
+		 *
+		 *  Plain float attributes are scattered straight from the aiMesh array into the interleaved
+		 *  buffer; packed types go through their Map<>::Extract encoder.
+		 */
 		template<VertexLayout::ElementType type>
 		struct AttributeAiMeshFill
 		{
-			static constexpr void Exec(VertexBuffer* pBuffer, const aiMesh& mesh) noexcept
+			static constexpr void Exec(VertexBuffer* pBuffer, const aiMesh& mesh, size_t begin, size_t end) noexcept
 			{
-				for (auto end = mesh.mNumVertices, i = 0u; i < end; i++)
+				using Map = VertexLayout::Map<type>;
+				if (begin == end)
+				{
+					return;
+				}
+				const auto view = pBuffer->View<type>();
+				if constexpr (HasAiSource<Map>::value)
 				{
-					(*pBuffer)[i].Attr<type>() = VertexLayout::Map<type>::Extract(mesh, i);
+					CopyStrided<sizeof(typename Map::SysType), Map::aiStride>(
+						reinterpret_cast<char*>(&view[begin]), view.Stride(), Map::AiSource(mesh) + Map::aiStride * begin, end - begin);
+				}
+				else
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						view[i] = Map::Extract(mesh, i, pBuffer->quantization);
+					}
 				}
 			}
 		};
 
+		/** @brief Copies count elements of Size bytes from a packed source array into strided vertex data.
+		 *
+		 *  Float3 rows (positions, normals, tangents) are moved four at a time: three unaligned loads
+		 *  cover four source elements, which are permuted into place and stored to their vertices.
+		 *  Other sizes use fixed-size copies the compiler turns into single moves.
+		 *  @tparam Size Bytes copied per element
+		 *  @tparam SourceStride Distance in bytes between source elements
+		 */
+		template<size_t Size, size_t SourceStride>
+		static void CopyStrided(char* pDst, size_t dstStride, const char* pSrc, size_t count) noexcept
+		{
+			size_t i = 0;
+			if constexpr (Size == sizeof(DirectX::XMFLOAT3) && SourceStride == sizeof(DirectX::XMFLOAT3))
+			{
+				namespace dx = DirectX;
+				for (; i + 4 <= count; i += 4)
+				{
+					const auto* pBlock = reinterpret_cast<const dx::XMFLOAT4*>(pSrc + SourceStride * i);
+					const auto a = dx::XMLoadFloat4(&pBlock[0]);  // x0 y0 z0 x1
+					const auto b = dx::XMLoadFloat4(&pBlock[1]);  // y1 z1 x2 y2
+					const auto c = dx::XMLoadFloat4(&pBlock[2]);  // z2 x3 y3 z3
+					char* pVertex = pDst + dstStride * i;
+					dx::XMStoreFloat3(reinterpret_cast<dx::XMFLOAT3*>(pVertex), a);
+					dx::XMStoreFloat3(reinterpret_cast<dx::XMFLOAT3*>(pVertex + dstStride), dx::XMVectorPermute<3, 4, 5, 0>(a, b));
+					dx::XMStoreFloat3(reinterpret_cast<dx::XMFLOAT3*>(pVertex + dstStride * 2), dx::XMVectorPermute<2, 3, 4, 0>(b, c));
+					dx::XMStoreFloat3(reinterpret_cast<dx::XMFLOAT3*>(pVertex + dstStride * 3), dx::XMVectorSwizzle<1, 2, 3, 0>(c));
+				}
+			}
+			for (; i < count; i++)
+			{
+				std::memcpy(pDst + dstStride * i, pSrc + SourceStride * i, Size);
+			}
+		}
+
 		/** @brief Constructs a vertex buffer with the specified layout.
 		 *  @param layout The vertex layout describing the structure of each vertex
 		 *  @note The layout is moved into the buffer for efficiency
@@ -572,13 +817,42 @@ namespace D3
 			Resize(size);
 		}
 
+		/** @brief Constructs a vertex buffer from an imported mesh, encoding packed element types.
+		 *  @param layout_in The vertex layout to fill
+		 *  @param mesh Source mesh; must provide every attribute the layout uses
+		 *  @note Layouts with Position3DQuantized quantize against the mesh bounds, see GetQuantization()
+		 */
 		VertexBuffer(VertexLayout layout_in, const aiMesh& mesh) : layout(std::move(layout_in))
 		{
+			if (layout.Has<VertexLayout::Position3DQuantized>())
+			{
+				quantization = VertexQuantization::FromMesh(mesh);
+			}
 			Resize(mesh.mNumVertices);
-			for (size_t i = 0, end = layout.GetElementCount(); i < end; i++)
+			const size_t vertexCount = mesh.mNumVertices;
+			const auto fillRange = [this, &mesh](size_t begin, size_t end)
+			{
+				for (size_t i = 0, count = layout.GetElementCount(); i < count; i++)
+				{
+					VertexLayout::Bridge<AttributeAiMeshFill>(layout.ResolveByIndex(i).GetType(), this, mesh, begin, end);
+				}
+			};
+			if (vertexCount < ParallelImportThreshold)
 			{
-				VertexLayout::Bridge<AttributeAiMeshFill>(layout.ResolveByIndex(i).GetType(), this, mesh);
+				fillRange(0u, vertexCount);
+				return;
 			}
+			// ranges write disjoint vertices, so they need no synchronization
+			std::vector<size_t> rangeStarts;
+			for (size_t begin = 0; begin < vertexCount; begin += ImportRangeSize)
+			{
+				rangeStarts.push_back(begin);
+			}
+			std::for_each(std::execution::par, rangeStarts.begin(), rangeStarts.end(),
+				[&](size_t begin)
+				{
+					fillRange(begin, std::min(begin + ImportRangeSize, vertexCount));
+				});
 		}
 		/** @brief Gets a pointer to the raw vertex buffer data.
 		 *  @return Const pointer to the buffer data, suitable for D3D11 vertex buffer creation
@@ -589,6 +863,89 @@ namespace D3
 		 */
 
 		const VertexLayout& GetLayout() const { return layout; }
+		/** @brief Gets the range Position3DQuantized elements were encoded against.
+		 *  @return Range to upload for the *_Quantized_VS shaders (identity unless built from an aiMesh)
+		 */
+		const VertexQuantization& GetQuantization() const { return quantization; }
+		/** @brief Measures the size saving and decode error of the packed elements against their source.
+		 *  @param mesh The mesh this buffer was built from
+		 *  @return Sizes and the largest error per attribute kind
+		 */
+		CompressionReport MeasureCompression(const aiMesh& mesh) const
+		{
+			namespace dx = DirectX;
+			using Type = VertexLayout::ElementType;
+			assert(Size() == mesh.mNumVertices && "Buffer was not built from this mesh");
+
+			CompressionReport report;
+			report.vertexCount = Size();
+			report.compressedBytes = SizeBytes();
+			size_t rawVertexSize = 0;
+			for (size_t i = 0; i < layout.GetElementCount(); i++)
+			{
+				switch (const auto type = layout.ResolveByIndex(i).GetType())
+				{
+				case Type::Position3DQuantized: rawVertexSize += sizeof(VertexLayout::Map<Type::Position3D>::SysType); break;
+				case Type::NormalOctahedral: rawVertexSize += sizeof(VertexLayout::Map<Type::Normal>::SysType); break;
+				case Type::TangentFrameOctahedral: rawVertexSize += sizeof(VertexLayout::Map<Type::Tangent>::SysType) * 2; break;
+				case Type::Texture2DHalf: rawVertexSize += sizeof(VertexLayout::Map<Type::Texture2D>::SysType); break;
+				default: rawVertexSize += VertexLayout::Element::SizeOf(type); break;
+				}
+			}
+			report.rawBytes = rawVertexSize * Size();
+
+			const auto source = [](const aiVector3D* pArray, size_t i)
+			{
+				return dx::XMLoadFloat3(reinterpret_cast<const dx::XMFLOAT3*>(&pArray[i]));
+			};
+			const auto angleDegrees = [](dx::FXMVECTOR a, dx::FXMVECTOR b)
+			{
+				return dx::XMConvertToDegrees(dx::XMVectorGetX(dx::XMVector3AngleBetweenNormals(dx::XMVector3Normalize(a), dx::XMVector3Normalize(b))));
+			};
+			if (layout.Has<Type::Position3DQuantized>())
+			{
+				const auto view = View<Type::Position3DQuantized>();
+				for (size_t i = 0; i < view.Size(); i++)
+				{
+					const auto decoded = VertexPacking::DecodePosition(view[i], quantization);
+					const auto error = dx::XMVectorGetX(dx::XMVector3Length(dx::XMVectorSubtract(dx::XMLoadFloat3(&decoded), source(mesh.mVertices, i))));
+					report.maxPositionError = std::max(report.maxPositionError, error);
+				}
+			}
+			if (layout.Has<Type::NormalOctahedral>())
+			{
+				const auto view = View<Type::NormalOctahedral>();
+				for (size_t i = 0; i < view.Size(); i++)
+				{
+					const auto decoded = VertexPacking::DecodeNormal(view[i]);
+					report.maxNormalErrorDegrees = std::max(report.maxNormalErrorDegrees, angleDegrees(dx::XMLoadFloat3(&decoded), source(mesh.mNormals, i)));
+				}
+			}
+			if (layout.Has<Type::TangentFrameOctahedral>())
+			{
+				const auto view = View<Type::TangentFrameOctahedral>();
+				for (size_t i = 0; i < view.Size(); i++)
+				{
+					// decode against the source normal so this measures the tangent frame encoding alone
+					dx::XMFLOAT3 t, b;
+					VertexPacking::DecodeTangentFrame(view[i], *reinterpret_cast<const dx::XMFLOAT3*>(&mesh.mNormals[i]), t, b);
+					report.maxTangentErrorDegrees = std::max({ report.maxTangentErrorDegrees,
+						angleDegrees(dx::XMLoadFloat3(&t), source(mesh.mTangents, i)),
+						angleDegrees(dx::XMLoadFloat3(&b), source(mesh.mBitangents, i)) });
+				}
+			}
+			if (layout.Has<Type::Texture2DHalf>())
+			{
+				const auto view = View<Type::Texture2DHalf>();
+				for (size_t i = 0; i < view.Size(); i++)
+				{
+					const auto decoded = VertexPacking::DecodeTexCoord(view[i]);
+					const auto& uv = mesh.mTextureCoords[0][i];
+					report.maxTexCoordError = std::max({ report.maxTexCoordError, std::abs(decoded.x - uv.x), std::abs(decoded.y - uv.y) });
+				}
+			}
+			return report;
+		}
 		/** @brief Gets the number of vertices in the buffer.
 		 *  @return Number of complete vertices stored in the buffer
 		 */
@@ -631,6 +988,36 @@ namespace D3
 			buffer.resize(buffer.size() + layout.Size());
 			Back().SetAttributeByIndex(0u, std::forward<Params>(params)...);
 		}
+		/** @brief Appends packed vertices with a single copy.
+		 *  @tparam StaticVertex Trivially copyable vertex type exposing its StaticVertexLayout as Layout
+		 *  @param pVertices Pointer to the first vertex to copy
+		 *  @param count Number of vertices to copy
+		 *  @warning Asserts if StaticVertex's layout differs from this buffer's layout
+		 */
+		template<typename StaticVertex>
+		void Append(const StaticVertex* pVertices, size_t count)
+		{
+			static_assert(std::is_trivially_copyable_v<StaticVertex>, "Vertices must be copyable as raw bytes");
+			static_assert(sizeof(StaticVertex) == StaticVertex::Layout::size, "Vertex type is not packed like its layout");
+			assert(StaticVertex::Layout::GetLayout().GetCode() == layout.GetCode() && "Vertex type doesn't match buffer layout");
+			const auto pBytes = reinterpret_cast<const char*>(pVertices);
+			buffer.insert(buffer.end(), pBytes, pBytes + sizeof(StaticVertex) * count);
+		}
+		/** @brief Rebuilds the buffer with its vertices gathered in a new order.
+		 *  @param order Source vertex index for each vertex of the result (vertices may be dropped or repeated)
+		 *  @warning Asserts if an index is out of range
+		 */
+		void Remap(const std::vector<unsigned int>& order)
+		{
+			const size_t stride = layout.Size();
+			std::vector<char> remapped(order.size() * stride);
+			for (size_t i = 0; i < order.size(); i++)
+			{
+				assert(order[i] < Size() && "Remap source vertex out of range");
+				std::memcpy(remapped.data() + stride * i, buffer.data() + stride * order[i], stride);
+			}
+			buffer = std::move(remapped);
+		}
 		/** @brief Gets a mutable reference to the last vertex in the buffer.
 		 *  @return Vertex wrapper for the last vertex
 		 *  @warning Asserts if the buffer is empty
@@ -675,8 +1062,29 @@ namespace D3
 		 *  @warning Asserts if index is out of bounds
 		 */
 		ConstVertex operator[](size_t i) const { return const_cast<VertexBuffer&>(*this)[i]; }
+		/** @brief Gets a strided view over one attribute of every vertex.
+		 *  @tparam Type The ElementType of the attribute to view
+		 *  @return View that iterates the attribute column without Vertex proxies
+		 *  @warning Asserts if the element type is not present in the layout
+		 */
+		template<VertexLayout::ElementType Type>
+		AttributeView<Type> View()
+		{
+			return { buffer.data() + layout.GetOffset<Type>(), layout.Size(), Size() };
+		}
+		/** @brief Gets a read-only strided view over one attribute of every vertex.
+		 *  @tparam Type The ElementType of the attribute to view
+		 *  @return Read-only view over the attribute column
+		 *  @warning Asserts if the element type is not present in the layout
+		 */
+		template<VertexLayout::ElementType Type>
+		ConstAttributeView<Type> View() const
+		{
+			return { buffer.data() + layout.GetOffset<Type>(), layout.Size(), Size() };
+		}
 	private:
 		std::vector<char> buffer;  /**< Raw vertex data storage */
 		VertexLayout layout;       /**< Layout describing vertex structure */
+		VertexQuantization quantization;  /**< Range Position3DQuantized elements are encoded against */
 	};
 }
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+#include <scene.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace D3
+{
+	/** @brief Range used to quantize positions to 16 bits relative to a mesh's bounding box.
+	 *
+	 *  Laid out like the VertexQuantization cbuffer in shaders/Common/VertexDecode.hlsli, so it
+	 *  can be uploaded as is to vertex shader slot 1 for the *_Quantized_VS shaders to decode
+	 *  positions as positionMin + packed * positionExtent.
+	 */
+	struct VertexQuantization
+	{
+		DirectX::XMFLOAT3 positionMin = { 0.0f, 0.0f, 0.0f };  /**< Minimum corner of the mesh bounds */
+		float padding0 = 0.0f;
+		DirectX::XMFLOAT3 positionExtent = { 1.0f, 1.0f, 1.0f };  /**< Size of the mesh bounds on each axis */
+		float padding1 = 0.0f;
+
+		/** @brief Computes the quantization range covering every vertex of a mesh.
+		 *  @param mesh Source mesh
+		 *  @return Range with the mesh's bounding box
+		 */
+		static VertexQuantization FromMesh(const aiMesh& mesh) noexcept
+		{
+			namespace dx = DirectX;
+			VertexQuantization q;
+			if (mesh.mNumVertices == 0)
+			{
+				return q;
+			}
+			auto min = dx::XMLoadFloat3(reinterpret_cast<const dx::XMFLOAT3*>(&mesh.mVertices[0]));
+			auto max = min;
+			for (unsigned int i = 1; i < mesh.mNumVertices; i++)
+			{
+				const auto p = dx::XMLoadFloat3(reinterpret_cast<const dx::XMFLOAT3*>(&mesh.mVertices[i]));
+				min = dx::XMVectorMin(min, p);
+				max = dx::XMVectorMax(max, p);
+			}
+			dx::XMStoreFloat3(&q.positionMin, min);
+			dx::XMStoreFloat3(&q.positionExtent, dx::XMVectorSubtract(max, min));
+			return q;
+		}
+	};
+
+	/** @brief Size of a mesh's compressed vertices and the largest error compression introduced.
+	 *
+	 *  Produced by VertexBuffer::MeasureCompression by decoding the packed attributes and
+	 *  comparing them with the source mesh. Errors are 0 for attributes the layout does not pack.
+	 */
+	struct CompressionReport
+	{
+		size_t vertexCount = 0;               /**< Number of vertices measured */
+		size_t rawBytes = 0;                  /**< Size with every attribute stored as 32-bit floats */
+		size_t compressedBytes = 0;           /**< Actual size of the vertex data */
+		float maxPositionError = 0.0f;        /**< Largest position error, in model units */
+		float maxNormalErrorDegrees = 0.0f;   /**< Largest angle between source and decoded normals */
+		float maxTangentErrorDegrees = 0.0f;  /**< Largest angle between source and decoded tangents or bitangents */
+		float maxTexCoordError = 0.0f;        /**< Largest texture coordinate error, in UV units */
+	};
+
+	/** @brief Encoders for the packed vertex element types, and the matching CPU decoders.
+	 *
+	 *  The decoders mirror shaders/Common/VertexDecode.hlsli and are used to measure error;
+	 *  the GPU does the real decode.
+	 */
+	namespace VertexPacking
+	{
+		/** @brief Quantizes a position to 16-bit UNORM relative to the quantization range.
+		 *  @note A zero-sized axis encodes as 0 and decodes exactly to positionMin
+		 */
+		inline DirectX::PackedVector::XMUSHORTN4 EncodePosition(const DirectX::XMFLOAT3& p, const VertexQuantization& q) noexcept
+		{
+			const auto normalize = [](float value, float min, float extent)
+			{
+				return extent > 0.0f ? std::clamp((value - min) / extent, 0.0f, 1.0f) : 0.0f;
+			};
+			return {
+				normalize(p.x, q.positionMin.x, q.positionExtent.x),
+				normalize(p.y, q.positionMin.y, q.positionExtent.y),
+				normalize(p.z, q.positionMin.z, q.positionExtent.z),
+				0.0f
+			};
+		}
+		/** @brief Decodes a quantized position. */
+		inline DirectX::XMFLOAT3 DecodePosition(const DirectX::PackedVector::XMUSHORTN4& packed, const VertexQuantization& q) noexcept
+		{
+			namespace dx = DirectX;
+			dx::XMFLOAT3 p;
+			dx::XMStoreFloat3(&p, dx::XMVectorMultiplyAdd(
+				dx::PackedVector::XMLoadUShortN4(&packed),
+				dx::XMLoadFloat3(&q.positionExtent),
+				dx::XMLoadFloat3(&q.positionMin)));
+			return p;
+		}
+		/** @brief Maps a unit vector onto the octahedron unfolded into [-1, 1]^2.
+		 *  @return Octahedral coordinates (components in [-1, 1])
+		 */
+		inline DirectX::XMFLOAT2 EncodeOctahedral(const DirectX::XMFLOAT3& v) noexcept
+		{
+			const auto signNotZero = [](float x) { return x >= 0.0f ? 1.0f : -1.0f; };
+			const float l1 = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+			if (l1 == 0.0f)
+			{
+				return { 0.0f, 0.0f };
+			}
+			float x = v.x / l1;
+			float y = v.y / l1;
+			if (v.z < 0.0f)
+			{
+				const float fx = (1.0f - std::abs(y)) * signNotZero(x);
+				const float fy = (1.0f - std::abs(x)) * signNotZero(y);
+				x = fx;
+				y = fy;
+			}
+			return { x, y };
+		}
+		/** @brief Inverse of EncodeOctahedral. */
+		inline DirectX::XMFLOAT3 DecodeOctahedral(float x, float y) noexcept
+		{
+			namespace dx = DirectX;
+			const float z = 1.0f - std::abs(x) - std::abs(y);
+			const float t = std::max(-z, 0.0f);
+			dx::XMFLOAT3 v = { x >= 0.0f ? x - t : x + t, y >= 0.0f ? y - t : y + t, z };
+			dx::XMStoreFloat3(&v, dx::XMVector3Normalize(dx::XMLoadFloat3(&v)));
+			return v;
+		}
+		/** @brief Packs a normal into two 16-bit SNORM octahedral coordinates. */
+		inline DirectX::PackedVector::XMSHORTN2 EncodeNormal(const DirectX::XMFLOAT3& n) noexcept
+		{
+			const auto e = EncodeOctahedral(n);
+			return { e.x, e.y };
+		}
+		/** @brief Decodes a packed octahedral normal. */
+		inline DirectX::XMFLOAT3 DecodeNormal(const DirectX::PackedVector::XMSHORTN2& packed) noexcept
+		{
+			DirectX::XMFLOAT2 e;
+			DirectX::XMStoreFloat2(&e, DirectX::PackedVector::XMLoadShortN2(&packed));
+			return DecodeOctahedral(e.x, e.y);
+		}
+		/** @brief Packs a tangent frame as an octahedral tangent plus the bitangent's handedness.
+		 *
+		 *  The bitangent is rebuilt as cross(normal, tangent) * sign, so the frame takes 8 bytes
+		 *  instead of the 24 of separate tangent and bitangent vectors.
+		 */
+		inline DirectX::PackedVector::XMSHORTN4 EncodeTangentFrame(
+			const DirectX::XMFLOAT3& n, const DirectX::XMFLOAT3& t, const DirectX::XMFLOAT3& b) noexcept
+		{
+			namespace dx = DirectX;
+			const auto e = EncodeOctahedral(t);
+			const float handedness = dx::XMVectorGetX(dx::XMVector3Dot(
+				dx::XMVector3Cross(dx::XMLoadFloat3(&n), dx::XMLoadFloat3(&t)), dx::XMLoadFloat3(&b)));
+			return { e.x, e.y, handedness < 0.0f ? -1.0f : 1.0f, 0.0f };
+		}
+		/** @brief Decodes a packed tangent frame given the (decoded) normal.
+		 *  @param packed Packed tangent frame
+		 *  @param n Vertex normal
+		 *  @param t Receives the tangent
+		 *  @param b Receives the bitangent
+		 */
+		inline void DecodeTangentFrame(const DirectX::PackedVector::XMSHORTN4& packed, const DirectX::XMFLOAT3& n,
+			DirectX::XMFLOAT3& t, DirectX::XMFLOAT3& b) noexcept
+		{
+			namespace dx = DirectX;
+			dx::XMFLOAT4 e;
+			dx::XMStoreFloat4(&e, dx::PackedVector::XMLoadShortN4(&packed));
+			t = DecodeOctahedral(e.x, e.y);
+			const float sign = e.z < 0.0f ? -1.0f : 1.0f;
+			dx::XMStoreFloat3(&b, dx::XMVectorScale(dx::XMVector3Cross(dx::XMLoadFloat3(&n), dx::XMLoadFloat3(&t)), sign));
+		}
+		/** @brief Packs texture coordinates as half floats (keeps tiling coordinates outside [0, 1]). */
+		inline DirectX::PackedVector::XMHALF2 EncodeTexCoord(float u, float v) noexcept
+		{
+			return { u, v };
+		}
+		/** @brief Decodes half float texture coordinates. */
+		inline DirectX::XMFLOAT2 DecodeTexCoord(const DirectX::PackedVector::XMHALF2& packed) noexcept
+		{
+			DirectX::XMFLOAT2 uv;
+			DirectX::XMStoreFloat2(&uv, DirectX::PackedVector::XMLoadHalf2(&packed));
+			return uv;
+		}
+	}
+}
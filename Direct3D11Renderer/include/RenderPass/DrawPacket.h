@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class Bindable;
+class Graphics;
+// only stored as pointers, so the builder compiles and is testable without the D3D headers
+struct ID3D11VertexShader;
+struct ID3D11PixelShader;
+struct ID3D11InputLayout;
+struct ID3D11RasterizerState;
+struct ID3D11BlendState;
+struct ID3D11DepthStencilState;
+struct ID3D11Buffer;
+struct ID3D11ShaderResourceView;
+struct ID3D11SamplerState;
+
+// A Step compiled down to raw D3D object pointers. Fixed pipeline objects live in plain fields,
+// slotted resources are grouped into contiguous (stage, slot range) runs over one flat object array,
+// and only bindables that have to do per-draw work (e.g. TransformConstantBuffer) stay virtual as hooks.
+// Hooks run after the static state so they can overwrite it if needed.
+class DrawPacket
+{
+public:
+	enum class Stage : uint8_t
+	{
+		VertexConstantBuffer,
+		PixelConstantBuffer,
+		PixelShaderResource,
+		PixelSampler,
+	};
+
+	enum StateBits : uint32_t
+	{
+		VertexShaderBit = 1u << 0,
+		PixelShaderBit = 1u << 1,
+		InputLayoutBit = 1u << 2,
+		RasterizerBit = 1u << 3,
+		BlendBit = 1u << 4,
+		DepthStencilBit = 1u << 5,
+	};
+
+	struct SlotRange
+	{
+		Stage stage;
+		uint32_t startSlot;
+		uint32_t count;
+		// index of the first object of this range in the packet's object array
+		uint32_t firstObject;
+	};
+
+public:
+	void Execute(Graphics& gfx) const noexcept;
+	uint32_t GetStateMask() const noexcept;
+	const std::vector<SlotRange>& GetRanges() const noexcept;
+	const std::vector<void*>& GetObjects() const noexcept;
+	const std::vector<Bindable*>& GetHooks() const noexcept;
+private:
+	friend class DrawPacketBuilder;
+
+	uint32_t stateMask = 0u;
+	ID3D11VertexShader* pVertexShader = nullptr;
+	ID3D11PixelShader* pPixelShader = nullptr;
+	ID3D11InputLayout* pInputLayout = nullptr;
+	ID3D11RasterizerState* pRasterizer = nullptr;
+	ID3D11BlendState* pBlender = nullptr;
+	uint32_t blendSampleMask = 0xFFFFFFFFu;
+	ID3D11DepthStencilState* pDepthStencil = nullptr;
+	uint32_t stencilRef = 0u;
+
+	std::vector<SlotRange> ranges;
+	std::vector<void*> objects;
+	std::vector<Bindable*> hooks;
+};
+
+// Collects what each bindable contributes through Bindable::Compile and lays it out as a DrawPacket.
+// Purely CPU side, none of the recorded pointers are dereferenced here.
+class DrawPacketBuilder
+{
+public:
+	void SetVertexShader(ID3D11VertexShader* pShader) noexcept;
+	void SetPixelShader(ID3D11PixelShader* pShader) noexcept;
+	void SetInputLayout(ID3D11InputLayout* pLayout) noexcept;
+	void SetRasterizerState(ID3D11RasterizerState* pState) noexcept;
+	void SetBlendState(ID3D11BlendState* pState, uint32_t sampleMask) noexcept;
+	void SetDepthStencilState(ID3D11DepthStencilState* pState, uint32_t stencilRef) noexcept;
+
+	void AddVertexConstantBuffer(uint32_t slot, ID3D11Buffer* pBuffer);
+	void AddPixelConstantBuffer(uint32_t slot, ID3D11Buffer* pBuffer);
+	void AddPixelShaderResource(uint32_t slot, ID3D11ShaderResourceView* pView);
+	void AddPixelSampler(uint32_t slot, ID3D11SamplerState* pSampler);
+
+	// bindable must be bound through its virtual Bind on every draw
+	void AddDynamic(Bindable& bindable);
+
+	// later additions to the same stage / slot win, matching the old bind-in-order behaviour
+	DrawPacket Build();
+private:
+	struct Entry
+	{
+		DrawPacket::Stage stage;
+		uint32_t slot;
+		void* pObject;
+	};
+	void AddSlotted(DrawPacket::Stage stage, uint32_t slot, void* pObject);
+private:
+	DrawPacket packet;
+	std::vector<Entry> entries;
+};
@@ -1,16 +1,102 @@
 #pragma once
 
-#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 #include "Core/Graphics.h"
 #include "Job.h"
 #include "Pass.h"
+#include "RenderGraph.h"
+#include "Utilities/FrameArena.h"
+
+class RenderTarget;
 
 class FrameManager
 {
 public:
+	// identifies a job queued with Retain()
+	struct RetainedHandle
+	{
+		size_t target;
+		size_t slot;
+	};
+	// Owns a set of retained jobs and releases them when it is reset or destroyed. A FrameManager
+	// that goes away first detaches the registrations still alive, so owners and the FrameManager
+	// can be torn down in either order.
+	class Registration
+	{
+		friend class FrameManager;
+	public:
+		Registration() = default;
+		Registration(Registration&& other) noexcept;
+		Registration& operator=(Registration&& other) noexcept;
+		Registration(const Registration&) = delete;
+		Registration& operator=(const Registration&) = delete;
+		~Registration();
+		// queues job in target for every frame until the registration is reset
+		void Retain(Job job, size_t target);
+		void Reset() noexcept;
+		bool IsActive() const noexcept;
+		// null once reset or detached
+		FrameManager* GetFrameManager() const noexcept;
+	private:
+		explicit Registration(FrameManager& frameManager);
+		void Detach() noexcept;
+	private:
+		FrameManager* pFrameManager = nullptr;
+		std::vector<RetainedHandle> handles;
+	};
+public:
+	FrameManager();
+	~FrameManager();
+	FrameManager(const FrameManager&) = delete;
+	FrameManager& operator=(const FrameManager&) = delete;
+	// Registers a pass with the graph. setup declares its resource reads / writes, bind sets whatever
+	// fixed state the pass needs before its jobs run (fullscreen passes have no jobs and draw there).
+	// The returned index is the Step target for the pass.
+	size_t AddPass(std::string name, SortKey::Policy policy,
+		const std::function<void(RenderGraph::PassBuilder&)>& setup,
+		std::function<void(Graphics&)> bind);
 	void Accept(Job job, size_t target) noexcept;
-	void Excecute(Graphics& gfx) const;
-	void Reset() noexcept;
+	// Starts a set of jobs that stay queued every frame until the registration is reset or
+	// destroyed. Used for static renderables so they do not have to resubmit each frame.
+	Registration Register();
+	size_t GetRetainedCount() const noexcept;
+	// draws issued by every pass in the last Excecute
+	Pass::DrawStats GetDrawStats() const noexcept;
+	void Excecute(Graphics& gfx);
+	// flips the frame arena and empties the pass queues for the next frame
+	void Reset();
+	// per-frame scratch memory, anything allocated here is valid until the end of the next frame
+	FrameArena& GetArena() noexcept;
+	const RenderGraph& GetGraph() const noexcept;
+	// texture backing a transient resource (any version of it), for bind callbacks. Transients the
+	// graph aliased return the same texture.
+	RenderTarget& GetTarget(RenderGraph::ResourceHandle handle) noexcept;
+	// textures allocated for the graph's transients, GetGraph().GetTransientCount() without aliasing
+	size_t GetTargetCount() const noexcept;
+	// latest versions of the imported targets, for passes registered after construction
+	RenderGraph::ResourceHandle GetBackBuffer() const noexcept;
+	RenderGraph::ResourceHandle GetDepthStencil() const noexcept;
+private:
+	RetainedHandle Retain(Job job, size_t target);
+	void Release(const RetainedHandle& handle) noexcept;
+	// one texture per physical slot of the compiled graph that is not imported
+	void AllocateTargets(Graphics& gfx);
 private:
-	std::array<Pass, 3> passes;
+	struct PassEntry
+	{
+		Pass queue;
+		std::function<void(Graphics&)> bind;
+	};
+	FrameArena arena;
+	RenderGraph graph;
+	std::vector<PassEntry> passes;
+	// indexed by physical slot, null for imported slots
+	std::vector<std::unique_ptr<RenderTarget>> targets;
+	// live registrations, detached on destruction
+	std::vector<Registration*> registrations;
+	RenderGraph::ResourceHandle backBuffer;
+	RenderGraph::ResourceHandle depthStencil;
 };
@@ -1,10 +1,21 @@
 #pragma once
 
+#include <cstdint>
+#include <DirectXMath.h>
+#include "Bindable/InstanceBuffer.h"
+
 class Job
 {
 public:
 	Job(const class Renderable* pRenderable, const class Step* pStep);
 	void Execute(class Graphics& gfx) const noexcept;
+	uint64_t GetStateKey() const noexcept;
+	float GetViewDepth(DirectX::FXMMATRIX view) const noexcept;
+	bool IsInstanceable() const noexcept;
+	bool CanInstanceWith(const Job& other) const noexcept;
+	InstanceBuffer::InstanceData GetInstanceData(DirectX::FXMMATRIX view, DirectX::CXMMATRIX projection) const noexcept;
+	// draws instanceCount copies using this job's geometry and step, instance data must already be bound
+	void ExecuteInstanced(class Graphics& gfx, UINT instanceCount) const;
 private:
 	const class Renderable* pRenderable;
 	const class Step* pStep;
@@ -2,14 +2,56 @@
 
 #include "Core/Graphics.h"
 #include "Job.h"
+#include "SortKey.h"
+#include "Bindable/InstanceBuffer.h"
+#include "Utilities/FrameArena.h"
+#include <memory>
+#include <optional>
 #include <vector>
 
 class Pass
 {
+public:
+	// what the last Excecute issued, instanced draws are counted once with all their instances
+	struct DrawStats
+	{
+		size_t draws = 0u;
+		size_t instancedDraws = 0u;
+		size_t instances = 0u;
+	};
 public:
 	void Accept(Job job) noexcept;
-	void Excecute(Graphics& gfx) const noexcept;
-	void Reset() noexcept;
+	void Excecute(Graphics& gfx);
+	// orders this frame's and the retained jobs for drawing, Excecute does this first
+	void Sort(DirectX::FXMMATRIX view) noexcept;
+	// drops this frame's jobs, the next frame's job list is carved out of arena
+	void Reset(FrameArena& arena);
+	// Retained jobs stay queued across frames until removed and are sorted / executed together with
+	// the per-frame ones. The returned slot is the handle for RemoveRetained.
+	size_t AddRetained(Job job);
+	void RemoveRetained(size_t slot) noexcept;
+	size_t GetRetainedCount() const noexcept;
+	void SetSortPolicy(SortKey::Policy policy_in) noexcept;
+	SortKey::Policy GetSortPolicy() const noexcept;
+	const DrawStats& GetDrawStats() const noexcept;
+private:
+	// indices past the per-frame jobs refer to retained slots
+	const Job& GetJob(uint32_t index) const noexcept;
+	// draws order[first, last) as one instanced draw
+	void ExecuteInstanced(Graphics& gfx, size_t first, size_t last);
 private:
-	std::vector<Job> jobs;
+	SortKey::Policy policy = SortKey::Policy::Submission;
+	// lives in the frame arena, sized up front from the previous frame's job count
+	std::vector<Job, FrameArena::Allocator<Job>> jobs;
+	// removed slots are left empty and reused so handles stay stable
+	std::vector<std::optional<Job>> retained;
+	std::vector<size_t> freeRetained;
+	size_t retainedCount = 0u;
+	// kept across frames so sorting does not allocate once the pass has warmed up
+	std::vector<SortKey::Entry> order;
+	std::vector<SortKey::Entry> scratch;
+	// created on the first instanced draw of this pass
+	std::unique_ptr<InstanceBuffer> pInstanceBuffer;
+	std::vector<InstanceBuffer::InstanceData> instanceData;
+	DrawStats drawStats;
 };
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+// CPU side of the frame's render graph. Passes declare which resource versions they read and write,
+// the graph derives an execution order from that, culls passes whose outputs nobody reads and assigns
+// transient resources with non-overlapping lifetimes to shared physical slots.
+//
+// Writing a resource produces a new version (a new handle) and implicitly reads the previous one.
+// Versions share memory, so a pass that reads a version must also run before the pass that writes
+// over it; reading a stale version from a pass that depends on that writer is a cycle and Compile
+// throws. Imported resources (back buffer, main depth/stencil) are treated as read by the outside
+// world after the frame.
+//
+// Among the passes that are ready to run, the sort prefers the one that ends the most transient
+// lifetimes and starts the fewest, so independent chains run back to back instead of interleaved
+// and their transients can share a physical slot. Ties keep declaration order.
+//
+// Knows nothing about D3D; FrameManager maps pass indices onto job queues and bind callbacks.
+class RenderGraph
+{
+public:
+	using ResourceHandle = size_t;
+	static constexpr size_t Invalid = std::numeric_limits<size_t>::max();
+
+	enum class ResourceType
+	{
+		RenderTarget,
+		DepthStencil,
+	};
+
+	struct ResourceDesc
+	{
+		ResourceType type = ResourceType::RenderTarget;
+		// 0 means the size of the back buffer, resolved by whoever allocates the physical resource
+		unsigned int width = 0u;
+		unsigned int height = 0u;
+		// DXGI_FORMAT value, kept as a plain integer so this header stays API agnostic
+		unsigned int format = 0u;
+		bool operator==(const ResourceDesc& rhs) const noexcept
+		{
+			return type == rhs.type && width == rhs.width && height == rhs.height && format == rhs.format;
+		}
+	};
+
+	class PassBuilder
+	{
+		friend class RenderGraph;
+	public:
+		ResourceHandle Read(ResourceHandle handle);
+		// returns the handle of the new version, later passes must use that one to see this pass' output
+		ResourceHandle Write(ResourceHandle handle);
+		// pass is never culled even if nothing reads its outputs
+		void SetSideEffects() noexcept;
+	private:
+		PassBuilder(RenderGraph& graph, size_t pass) noexcept;
+		RenderGraph& graph;
+		size_t pass;
+	};
+
+public:
+	ResourceHandle Import(std::string name, ResourceDesc desc);
+	ResourceHandle CreateTransient(std::string name, ResourceDesc desc);
+	// returns the pass index, which is also the index Step::targetPass refers to
+	size_t AddPass(std::string name, const std::function<void(PassBuilder&)>& setup);
+
+	// throws std::runtime_error if the passes that survive culling depend on each other in a cycle
+	void Compile();
+	bool IsCompiled() const noexcept;
+
+	const std::vector<size_t>& GetExecutionOrder() const noexcept;
+	size_t GetPassCount() const noexcept;
+	const std::string& GetPassName(size_t pass) const noexcept;
+	bool IsCulled(size_t pass) const noexcept;
+	// physical slot backing the resource the handle is a version of, Invalid if it was never used
+	size_t GetPhysicalIndex(ResourceHandle handle) const noexcept;
+	size_t GetPhysicalCount() const noexcept;
+	const ResourceDesc& GetPhysicalDesc(size_t physical) const noexcept;
+	// imported slots are backed by the outside world, everything else needs allocating
+	bool IsPhysicalImported(size_t physical) const noexcept;
+	// transient resources that survived culling, at least GetPhysicalCount() minus the imported ones
+	size_t GetTransientCount() const noexcept;
+private:
+	struct Resource
+	{
+		std::string name;
+		ResourceDesc desc;
+		bool imported;
+		size_t physical = Invalid;
+	};
+	// one version of a resource
+	struct ResourceNode
+	{
+		size_t resource;
+		size_t producer = Invalid;
+		// pass that wrote the next version over this one
+		size_t overwriter = Invalid;
+		size_t refCount = 0u;
+	};
+	struct PassNode
+	{
+		std::string name;
+		std::vector<ResourceHandle> reads;
+		std::vector<ResourceHandle> writes;
+		bool sideEffects = false;
+		bool culled = false;
+		size_t refCount = 0u;
+	};
+private:
+	ResourceHandle AddResource(std::string name, ResourceDesc desc, bool imported);
+	void Cull();
+	void SortPasses();
+	void AliasResources();
+private:
+	bool compiled = false;
+	std::vector<Resource> resources;
+	std::vector<ResourceNode> nodes;
+	std::vector<PassNode> passes;
+	std::vector<size_t> executionOrder;
+	std::vector<ResourceDesc> physicalDescs;
+	std::vector<bool> physicalImported;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Packed 64-bit key used to order jobs inside a Pass. This is deliberately free of any
+// D3D dependency so it can be exercised on its own.
+//
+// FrontToBack (opaque) layout, most significant first:
+//   [63..48] shader pair   [47..36] texture set   [35..24] material   [23..0] view depth
+// BackToFront (blended) layout, most significant first:
+//   [63..40] inverted view depth   [39..0] state (shader | texture | material)
+class SortKey
+{
+public:
+	enum class Policy
+	{
+		Submission,
+		FrontToBack,
+		BackToFront,
+	};
+
+	struct Entry
+	{
+		uint64_t key;
+		uint32_t index;
+	};
+
+	static constexpr unsigned int ShaderBits = 16u;
+	static constexpr unsigned int TextureBits = 12u;
+	static constexpr unsigned int MaterialBits = 12u;
+	static constexpr unsigned int StateBits = ShaderBits + TextureBits + MaterialBits;
+	static constexpr unsigned int DepthBits = 24u;
+
+	// Packs the per-step state identifiers into the low StateBits of the result.
+	// Each identifier is folded down to its field width, so collisions only cost sort quality.
+	static uint64_t MakeState(uint64_t shaderId, uint64_t textureId, uint64_t materialId) noexcept;
+	// Mixes a geometry identifier into the material field of a state, so jobs that only differ by
+	// transform and share a mesh end up next to each other instead of interleaved by depth.
+	static uint64_t WithGeometry(uint64_t state, uint64_t geometryId) noexcept;
+	// Replaces the material field of a state, for when a material's contents change after MakeState.
+	static uint64_t WithMaterial(uint64_t state, uint64_t materialId) noexcept;
+	// Maps a view-space depth onto DepthBits while preserving order. Negative depths clamp to 0.
+	static uint32_t QuantizeDepth(float viewDepth) noexcept;
+	static uint64_t Make(Policy policy, uint64_t state, uint32_t depth) noexcept;
+	// Stable LSD radix sort on Entry::key. scratch is resized as needed and can be reused across frames.
+	static void RadixSort(std::vector<Entry>& entries, std::vector<Entry>& scratch) noexcept;
+	// Folds an arbitrary identifier (e.g. a bindable address) down to the given number of bits.
+	static uint64_t Fold(uint64_t id, unsigned int bits) noexcept;
+};
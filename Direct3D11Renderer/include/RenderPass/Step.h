@@ -1,20 +1,58 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <cstdint>
 #include "Bindable/Bindable.h"
 #include "RenderPass/TechniqueProbe.h"
+#include "RenderPass/DrawPacket.h"
+#include "RenderPass/FrameManager.h"
 #include "Core/Graphics.h"
 
 class Step
 {
 public:
 	Step(size_t targetPass_in);
+	// copies share the cached bindables but get their own per-object ones (see Bindable::Clone)
+	Step(const Step& src);
+	Step(Step&&) noexcept = default;
+	Step& operator=(const Step&) = delete;
+	Step& operator=(Step&&) noexcept = default;
 	void AddBindable(std::shared_ptr<Bindable> bindable) noexcept;
 	void Submit(class FrameManager& frameManager, const class Renderable& renderable) const;
+	// queues this step for renderable in every frame until the registration is reset
+	void Retain(FrameManager::Registration& registration, const class Renderable& renderable) const;
 	void Bind(Graphics& gfx) const;
 	void Accept(TechniqueProbe& probe);
 	void InitializeParentReferences(const class Renderable& parent) const;
+	uint64_t GetStateKey() const noexcept;
+	// Alternative VS / input layout that read transforms from InstanceBuffer. Only steps that have one
+	// and whose transforms come from a plain vertex stage TransformConstantBuffer can be merged into
+	// instanced draws.
+	void SetInstancedVariant(std::shared_ptr<class VertexShader> pVertexShader, std::shared_ptr<class InputLayout> pInputLayout);
+	bool IsInstanceable() const noexcept;
+	// same bindables apart from the transform and material buffers with equal contents, so jobs of
+	// both steps can share one instanced draw
+	bool IsBatchCompatible(const Step& other) const noexcept;
+	void BindInstanced(Graphics& gfx) const;
+private:
+	void UpdateStateKey() noexcept;
+	void Compile();
 private:
 	size_t targetPass;
 	std::vector<std::shared_ptr<Bindable>> bindables;
+	// shader / texture / material identity packed by SortKey::MakeState
+	mutable uint64_t stateKey = 0u;
+	// material buffer compared by content and the upload the key's material field was taken from,
+	// GetStateKey refreshes the field once an edit has been uploaded
+	const class CachingDynamicConstantBufferBindable* pMaterialConstants = nullptr;
+	mutable uint64_t materialHash = 0u;
+	// flattened form of bindables, rebuilt whenever a bindable is added
+	DrawPacket packet;
+	std::shared_ptr<class VertexShader> pInstancedVertexShader;
+	std::shared_ptr<class InputLayout> pInstancedInputLayout;
+	bool instanceable = false;
+	DrawPacket instancedPacket;
+	std::vector<const Bindable*> batchSignature;
+	// per-object material buffers, kept apart from the signature because they compare by value
+	std::vector<const class CachingDynamicConstantBufferBindable*> batchConstants;
 };
\ No newline at end of file
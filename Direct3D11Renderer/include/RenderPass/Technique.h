@@ -10,15 +10,20 @@ public:
 	Technique() = default;
 	Technique(std::string name) noexcept;
 	void Submit(class FrameManager& frameManager, const class Renderable& renderable) const noexcept;
+	// retained counterpart of Submit, adds one job per step to registration when the technique is active
+	void Retain(FrameManager::Registration& registration, const class Renderable& renderable) const;
 	void AddStep(Step step) noexcept;
 	void SetActiveState(bool state) noexcept;
 	bool IsActive() const noexcept;
 	void Accept(TechniqueProbe& probe);
 	const std::string& GetName() const noexcept;
 	void InitializeParentReferences(const class Renderable& renderable) const;
+	// owner to notify when the active state changes, so its retained jobs can be patched
+	void SetOwner(class Renderable* pOwner_in) noexcept;
 
 private:
 	bool active = true;
+	class Renderable* pOwner = nullptr;
 	std::vector<Step> steps;
 	std::string name;
 
@@ -4,8 +4,11 @@
 #include <mesh.h>
 #include "Bindable/BindableCommon.h"
 #include "RenderPass/Technique.h"
+#include "Geometry/IndexedTriangleList.h"
+#include "Geometry/MeshOptimizer.h"
 #include <vector>
 #include <filesystem>
+#include <string>
 
 
 namespace D3
@@ -13,19 +16,33 @@ namespace D3
 	class Material
 	{
 	public:
-		Material(Graphics& gfx, const aiMaterial& material, const std::filesystem::path& modelPath) noexcept;
+		// compressVertices stores positions, normals, tangent frames and texture coordinates in the
+		// packed element types (24 bytes instead of 56 for a normal mapped vertex) and draws them with
+		// the BlinnPhong_*_Quantized_VS shaders
+		Material(Graphics& gfx, const aiMaterial& material, const std::filesystem::path& modelPath, bool compressVertices = false) noexcept;
 		D3::VertexBuffer ExtractVertices(const aiMesh& mesh) const noexcept;
-		std::vector<unsigned short> ExtractIndices(const aiMesh& mesh) const noexcept;
+		std::vector<unsigned int> ExtractIndices(const aiMesh& mesh) const noexcept;
+		// extracted vertices and indices after welding and cache, overdraw and fetch reordering
+		IndexedTriangleList ExtractGeometry(const aiMesh& mesh, D3::MeshOptimizer::Report* pReport = nullptr,
+			const D3::MeshOptimizer::Settings& settings = {}) const noexcept;
+		// report of the last ExtractGeometry for the mesh, for renderables whose buffers came from the cache
+		// (empty if the mesh was not optimized yet)
+		D3::MeshOptimizer::Report GetOptimizationReport(const aiMesh& mesh) const;
 		std::vector<Technique> GetTechniques() const noexcept;
-		std::shared_ptr<::VertexBuffer> MakeVertexBufferBindable(Graphics& gfx, const aiMesh& mesh) const noexcept;
-		std::shared_ptr<::IndexBuffer> MakeIndexBufferBindable(Graphics& gfx, const aiMesh& mesh) const noexcept;
-		std::vector<Technique> GetTechniques() noexcept;
+		// the sources are only called when the mesh's buffer is not cached yet
+		std::shared_ptr<::VertexBuffer> MakeVertexBufferBindable(Graphics& gfx, const aiMesh& mesh, const ::VertexBuffer::Source& vertices) const noexcept;
+		std::shared_ptr<::IndexBuffer> MakeIndexBufferBindable(Graphics& gfx, const aiMesh& mesh, const ::IndexBuffer::Source& indices) const noexcept;
+		// quantization range the vertex shader needs to decode the mesh's positions; null unless compressing
+		std::shared_ptr<Bindable> MakeVertexDecodeBindable(Graphics& gfx, const aiMesh& mesh) const noexcept;
+		// size saved and error introduced by compressing the mesh (empty report unless compressing)
+		D3::CompressionReport MeasureVertexCompression(const aiMesh& mesh) const noexcept;
 	private:
 		std::string MakeMeshTag(const aiMesh& mesh) const noexcept;
 		D3::VertexLayout vertexLayout;
 		std::vector<Technique> techniques;
 		std::string modelPath;
 		std::string name;
+		bool compressVertices = false;
 	};
 }
 
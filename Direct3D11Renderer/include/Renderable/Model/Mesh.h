@@ -3,6 +3,9 @@
 #include "Renderable/Renderable.h"
 #include "Core/Graphics.h"
 #include "Bindable/Bindable.h"
+#include "Geometry/AABB.h"
+#include "Camera/OcclusionBuffer.h"
+#include "Geometry/VertexCompression.h"
 #include <DirectXMath.h>
 #include <memory>
 #include <vector>
@@ -18,9 +21,25 @@ class Mesh : public Renderable
 public:
     Mesh(Graphics& gfx, const D3::Material& material, const aiMesh& mesh) noexcept;
 	void Submit(FrameManager& frameManager, DirectX::FXMMATRIX accumulatedTransform) const noexcept;
+    // updates the transform without submitting, for meshes whose jobs are retained
+    void SetTransform(DirectX::FXMMATRIX accumulatedTransform) const noexcept;
     DirectX::XMMATRIX GetTransformXM() const noexcept override;
+    // bounds of the vertex positions in mesh space, computed at load time
+    const AABB& GetBounds() const noexcept;
+    // keeps a CPU copy of the triangles so the mesh can be drawn into an OcclusionBuffer
+    void MakeOccluder(const aiMesh& mesh);
+    // null unless MakeOccluder was called
+    const OcclusionBuffer::OccluderMesh* GetOccluder() const noexcept;
+    // size and error of the compressed vertices, measured at load time (empty if the material does not compress)
+    const D3::CompressionReport& GetCompressionReport() const noexcept;
+    // what the load-time optimization changed, also when the buffers came from the cache; before / after
+    // metrics are only measured by tools that ask for them, see MeshOptimizer::Settings
+    const D3::MeshOptimizer::Report& GetOptimizationReport() const noexcept;
 
 private:
+    AABB bounds;
+    D3::CompressionReport compressionReport;
+    std::unique_ptr<OcclusionBuffer::OccluderMesh> pOccluder;
     mutable DirectX::XMFLOAT4X4 transform{};
 };
 
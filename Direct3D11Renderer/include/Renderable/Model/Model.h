@@ -2,6 +2,7 @@
 
 #include "Renderable/Model/Mesh.h"
 #include "RenderPass/FrameManager.h"
+#include "Camera/Frustum.h"
 #include "Core/Graphics.h"
 #include <DirectXMath.h>
 #include <scene.h>
@@ -23,12 +24,29 @@
 /// </summary>
 class Node
 {
+public:
+    struct CullStats
+    {
+        size_t submitted = 0u;
+        size_t culled = 0u;
+        // part of culled, rejected by the occlusion buffer rather than the frustum
+        size_t occluded = 0u;
+    };
 public:
     Node(int id, const std::string& name, std::vector<Mesh*> meshes, const DirectX::XMMATRIX& transform);
-	void Submit(FrameManager& frameManager, DirectX::FXMMATRIX accumulatedTransform) const noexcept;
+    // Submits the meshes of this subtree that intersect frustum and are not hidden in pOcclusion
+    // (optional). A subtree whose bounds are rejected is skipped without visiting its children.
+	void Submit(FrameManager& frameManager, DirectX::FXMMATRIX accumulatedTransform, const Frustum& frustum,
+        OcclusionBuffer* pOcclusion, CullStats& stats) const noexcept;
+    void AddOccluders(OcclusionBuffer& occlusion, DirectX::FXMMATRIX accumulatedTransform, const Frustum& frustum) const;
+    // recomputes subtree bounds, needed after any transform in the subtree changes
+    void UpdateBounds() noexcept;
+    // pushes the accumulated transforms down to the meshes without submitting anything
+    void UpdateTransforms(DirectX::FXMMATRIX accumulatedTransform) const noexcept;
     void RenderTree(Node*& pSelectedNode) const noexcept;
     void AddChild(std::unique_ptr<Node> child) noexcept;
-    void SetAppliedTransform(DirectX::FXMMATRIX transform) noexcept;
+    // returns true if the applied transform actually changed
+    bool SetAppliedTransform(DirectX::FXMMATRIX transform) noexcept;
     int GetId() const noexcept;
 private:
     int id;
@@ -37,6 +55,9 @@ private:
     std::vector<Mesh*> meshes;
     DirectX::XMFLOAT4X4 transform{};
     DirectX::XMFLOAT4X4 appliedTransform{};
+    // meshes of this node and all children, in the space the node's meshes live in
+    AABB bounds;
+    size_t subtreeMeshCount = 0u;
 };
 
 /// <summary>
@@ -47,16 +68,42 @@ private:
 class Model
 {
 public:
-    Model(Graphics& gfx, const std::string& filePath, float scale = 1.0f);
+    // compressVertices imports the meshes with packed vertices (see D3::Material), which takes about
+    // half the memory but gives up instancing
+    Model(Graphics& gfx, const std::string& filePath, float scale = 1.0f, bool compressVertices = false);
     ~Model() noexcept;
     void Submit(FrameManager& frameManager) const noexcept;
+    // culls nodes and meshes against frustum, see GetCullStats() for the results
+    void Submit(FrameManager& frameManager, const Frustum& frustum) const noexcept;
+    // also tests each node / mesh against occlusion, which must already be rasterized
+    void Submit(FrameManager& frameManager, const Frustum& frustum, OcclusionBuffer& occlusion) const noexcept;
+    // draws this model's occluder meshes that intersect frustum into occlusion
+    void AddOccluders(OcclusionBuffer& occlusion, const Frustum& frustum) const;
+    // mesh counts from the last Submit
+    const Node::CullStats& GetCullStats() const noexcept;
+    // sizes and largest errors over all meshes, empty unless the model compresses its vertices
+    D3::CompressionReport GetCompressionReport() const noexcept;
+    // Switches the model to retained mode. Its meshes queue their jobs once and Submit() only walks
+    // the node tree again when a node transform has changed.
+    void Register(FrameManager& frameManager);
+    void Unregister() noexcept;
     void ShowModelControlWindow(const char* windowName = nullptr) noexcept;
     void SetScale(float scale) noexcept;
+    // places the whole model, applied after the scale
+    void SetRootTransform(DirectX::FXMMATRIX transform) noexcept;
 private:
-    std::unique_ptr<Mesh> BuildMesh(Graphics& gfx, const aiMesh& mesh, const aiMaterial* const* pMaterials, const std::filesystem::path& path);
+    void Submit(FrameManager& frameManager, const Frustum& frustum, OcclusionBuffer* pOcclusion) const noexcept;
+    std::unique_ptr<Mesh> BuildMesh(Graphics& gfx, const aiMesh& mesh, const std::vector<D3::Material>& materials);
     std::unique_ptr<Node> BuildNode(int& nextId, const aiNode& node) noexcept;
+    DirectX::XMMATRIX GetRootTransform() const noexcept;
 private:
+    // meshes at least this fraction of the model's size get occluder geometry
+    static constexpr float OccluderSizeFraction = 0.25f;
     float scale;
+    DirectX::XMFLOAT4X4 rootTransform{ 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+    bool retained = false;
+    mutable bool transformsDirty = true;
+    mutable Node::CullStats cullStats;
     std::unique_ptr<Node> root;
     std::vector<std::unique_ptr<Mesh>> meshes;
     std::unique_ptr<class ModelWindow> pWindow;
@@ -4,6 +4,8 @@
 #include "Bindable/IndexBuffer.h"
 #include "Bindable/BindableCache.h"
 #include "RenderPass/Technique.h"
+#include "Geometry/MeshOptimizer.h"
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <DirectXMath.h>
@@ -30,13 +32,32 @@ public:
     virtual ~Renderable() = default;
 	void AddTechnique(Technique technique) noexcept;
     void Submit(class FrameManager& frameManager) const noexcept;
+    // Retained mode for static renderables: the jobs of every active technique are queued once and
+    // stay queued until Unregister() or destruction, whichever of the renderable and the FrameManager
+    // goes first. Transforms and material parameters are read when the jobs execute, so only
+    // technique activation changes need to patch the lists.
+    void Register(class FrameManager& frameManager);
+    void Unregister() noexcept;
+    bool IsRegistered() const noexcept;
+    void OnTechniqueStateChanged();
     void Accept(TechniqueProbe& probe);
     virtual DirectX::XMMATRIX GetTransformXM() const noexcept = 0;
     UINT GetIndexCount() const noexcept;
     void Bind(Graphics& gfx) const noexcept;
+    bool SharesGeometry(const Renderable& other) const noexcept;
+    // identifies the shared buffers SharesGeometry compares, for grouping jobs by mesh when sorting
+    uint64_t GetGeometryId() const noexcept;
 protected:
     std::shared_ptr<IndexBuffer> pIndices;
     std::shared_ptr<VertexBuffer> pVertices;
     std::shared_ptr<Topology> pTopology;
+    // constants the vertex shader needs to decode compressed vertices, bound with the geometry (may be null)
+    std::shared_ptr<Bindable> pVertexDecode;
+    // what the load-time optimization changed; empty unless built from an aiMesh (a cache hit reuses the
+    // buffers without optimizing again and takes the report recorded when they were built)
+    D3::MeshOptimizer::Report optimizationReport;
     std::vector<Technique> techniques;
+private:
+    // declared after techniques so the retained jobs are released before the steps they point at
+    FrameManager::Registration registration;
 };
\ No newline at end of file
@@ -2,7 +2,9 @@
 
 #include "Renderable.h"
 #include "Bindable/Bindable.h"
+#include "DynamicConstantBuffer/DynamicConstantBuffer.h"
 #include <DirectXMath.h>
+#include <vector>
 
 class TestCube : public Renderable
 {
@@ -14,6 +16,17 @@ public:
 	void SpawnControlWindow(Graphics& gfx, const char* name) noexcept;
 
 private:
+	// handles of the members the control window edits, per visited buffer, resolved when a buffer
+	// is first seen instead of looking the names up every frame
+	struct ProbeHandles
+	{
+		const D3::LayoutElement* pRoot = nullptr;
+		D3::ElementHandle outlineScale;
+		D3::ElementHandle outlineColor;
+		D3::ElementHandle specularReflectance;
+		D3::ElementHandle specularShininess;
+	};
+	std::vector<ProbeHandles> probeHandles;
 	DirectX::XMFLOAT3 pos = { 1.0f, 1.0f, 1.0f };
 	float roll = 0.0f;
 	float pitch = 0.0f;
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+
+// Counts calls to the global operator new in debug builds, so a section of the frame can be
+// checked for heap traffic. Release builds keep the default allocator and always report zero.
+class AllocationCounter
+{
+public:
+	static constexpr bool IsEnabled() noexcept
+	{
+#ifdef _DEBUG
+		return true;
+#else
+		return false;
+#endif
+	}
+	// total number of heap allocations made by the process so far
+	static size_t GetCount() noexcept;
+
+	// measures the allocations made between construction and Elapsed()
+	class Scope
+	{
+	public:
+		Scope() noexcept
+			:
+			start(GetCount())
+		{}
+		size_t Elapsed() const noexcept
+		{
+			return GetCount() - start;
+		}
+	private:
+		size_t start;
+	};
+};
@@ -0,0 +1,94 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Linear allocator for data that only lives for one frame. Two buffers are kept so that whatever
+// was allocated last frame stays valid while the next frame is being built; BeginFrame() flips to
+// the older buffer and rewinds it. Running out of space falls back to the heap for the rest of that
+// frame and the buffer is grown to fit the next time it is rewound, so a steady-state frame never
+// touches the heap.
+class FrameArena
+{
+public:
+	// STL allocator handing out arena memory. Deallocation is a no-op, the memory comes back when
+	// the arena rewinds. A default constructed allocator (no arena) uses the global heap.
+	template<typename T>
+	class Allocator
+	{
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+	public:
+		Allocator() noexcept = default;
+		explicit Allocator(FrameArena& arena) noexcept
+			:
+			pArena(&arena)
+		{}
+		template<typename U>
+		Allocator(const Allocator<U>& other) noexcept
+			:
+			pArena(other.pArena)
+		{}
+		T* allocate(size_t n)
+		{
+			if (pArena)
+			{
+				return static_cast<T*>(pArena->Allocate(n * sizeof(T), alignof(T)));
+			}
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		}
+		void deallocate(T* p, size_t) noexcept
+		{
+			if (!pArena)
+			{
+				::operator delete(p);
+			}
+		}
+		template<typename U>
+		bool operator==(const Allocator<U>& other) const noexcept
+		{
+			return pArena == other.pArena;
+		}
+		template<typename U>
+		bool operator!=(const Allocator<U>& other) const noexcept
+		{
+			return pArena != other.pArena;
+		}
+	private:
+		template<typename U> friend class Allocator;
+		FrameArena* pArena = nullptr;
+	};
+public:
+	FrameArena(size_t bytesPerFrame = 256u * 1024u);
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	// flips to the other buffer and rewinds it, everything allocated two frames ago is released
+	void BeginFrame();
+	void* Allocate(size_t size, size_t alignment);
+	template<typename T>
+	Allocator<T> GetAllocator() noexcept
+	{
+		return Allocator<T>(*this);
+	}
+	// bytes handed out from the current buffer this frame, including heap overflow
+	size_t GetUsedBytes() const noexcept;
+	size_t GetCapacity() const noexcept;
+private:
+	struct Buffer
+	{
+		std::unique_ptr<std::byte[]> memory;
+		size_t capacity = 0u;
+		size_t offset = 0u;
+		// blocks taken from the heap after the buffer ran out, folded into capacity on the next rewind
+		std::vector<std::unique_ptr<std::byte[]>> overflow;
+		size_t overflowBytes = 0u;
+	};
+	std::array<Buffer, 2> buffers;
+	size_t current = 0u;
+};
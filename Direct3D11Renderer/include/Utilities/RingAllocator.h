@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+
+// Offset bookkeeping for a ring of GPU memory, with no D3D dependency so it can be exercised on the CPU.
+// Allocations are appended at the head; when one does not fit in the space left before the end, the
+// ring starts a new generation at offset 0 and reports it through Allocation::discard, which the owner
+// turns into a MAP_WRITE_DISCARD so the driver renames the buffer instead of waiting on the GPU.
+// Everything handed out in the previous generation stays valid for draws already recorded against it.
+class RingAllocator
+{
+public:
+	struct Allocation
+	{
+		size_t offset;
+		// rounded up to the alignment
+		size_t size;
+		// first allocation of a new generation, previous contents may not be overwritten in place
+		bool discard;
+	};
+public:
+	// alignment must be a power of two and capacity a multiple of it
+	RingAllocator(size_t capacity, size_t alignment) noexcept;
+
+	// nullopt for an empty request and for one that can never fit (larger than the whole ring)
+	std::optional<Allocation> Allocate(size_t size) noexcept;
+	// forces the next allocation to start a new generation at offset 0
+	void Reset() noexcept;
+
+	size_t GetHead() const noexcept;
+	size_t GetCapacity() const noexcept;
+	size_t GetAlignment() const noexcept;
+	// number of generations started so far (including the first)
+	size_t GetGenerationCount() const noexcept;
+private:
+	size_t capacity;
+	size_t alignment;
+	// starts at capacity so the very first allocation begins a generation
+	size_t head;
+	size_t generations = 0u;
+};
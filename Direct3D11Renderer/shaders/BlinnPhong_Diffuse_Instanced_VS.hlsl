@@ -0,0 +1,34 @@
+// =============================================================================
+// Blinn-Phong Diffuse Instanced Vertex Shader
+// =============================================================================
+// Instanced variant of BlinnPhong_Diffuse_VS. Transforms come from the
+// per-instance stream instead of the TransformMatrices constant buffer.
+// =============================================================================
+
+#include "Common/CommonStructures.hlsli"
+
+// Main vertex shader entry point
+BasicVertexOutput main(
+    in float3 modelPosition : Position, 
+    in float3 modelNormal : Normal, 
+    in float2 texCoords : TexCoord,
+    in InstanceTransforms instance)
+{
+    BasicVertexOutput output;
+    
+    const float4x4 instanceModelView = GetInstanceModelView(instance);
+    
+    // Transform vertex position from model space to view space
+    output.viewSpacePosition = mul(float4(modelPosition, 1.0f), instanceModelView).xyz;
+    
+    // Transform normal from model space to view space (rotation part only)
+    output.viewSpaceNormal = normalize(mul(modelNormal, (float3x3)instanceModelView));
+    
+    // Pass texture coordinates through unchanged
+    output.textureCoords = texCoords;
+    
+    // Transform position to clip space for GPU rasterization
+    output.clipSpacePosition = mul(float4(modelPosition, 1.0f), GetInstanceModelViewProj(instance));
+    
+    return output;
+}
\ No newline at end of file
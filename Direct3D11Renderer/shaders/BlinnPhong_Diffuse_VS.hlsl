@@ -3,18 +3,34 @@
 // =============================================================================
 // Transforms vertices for textured models using Blinn-Phong shading.
 // Outputs view-space position, normal, and texture coordinates.
+// BlinnPhong_Diffuse_Quantized_VS compiles this with QUANTIZED_VERTICES defined
+// to read packed positions and octahedral normals (half float texture
+// coordinates need no decode).
 // =============================================================================
 
 #include "Common/CommonStructures.hlsli"
+#ifdef QUANTIZED_VERTICES
+#include "Common/VertexDecode.hlsli"
+#endif
 
 // Main vertex shader entry point
 BasicVertexOutput main(
+#ifdef QUANTIZED_VERTICES
+    in float4 packedPosition : Position,
+    in float2 packedNormal : Normal,
+#else
     in float3 modelPosition : Position, 
     in float3 modelNormal : Normal, 
+#endif
     in float2 texCoords : TexCoord)
 {
     BasicVertexOutput output;
     
+#ifdef QUANTIZED_VERTICES
+    const float3 modelPosition = DecodePosition(packedPosition);
+    const float3 modelNormal = DecodeOctahedral(packedNormal);
+#endif
+    
     // Transform vertex position from model space to view space
     // This is needed for per-pixel lighting calculations in the pixel shader
     output.viewSpacePosition = mul(float4(modelPosition, 1.0f), modelViewMatrix).xyz;
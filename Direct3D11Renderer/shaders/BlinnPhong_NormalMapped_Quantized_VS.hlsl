@@ -0,0 +1,9 @@
+// =============================================================================
+// Blinn-Phong NormalMapped Quantized Vertex Shader
+// =============================================================================
+// BlinnPhong_NormalMapped_VS for meshes built with the compressed vertex element
+// types. Expects the mesh's VertexQuantization constants in register b1.
+// =============================================================================
+
+#define QUANTIZED_VERTICES
+#include "BlinnPhong_NormalMapped_VS.hlsl"
@@ -3,20 +3,40 @@
 // =============================================================================
 // Transforms vertices for normal-mapped models using Blinn-Phong shading.
 // Outputs tangent-space basis vectors for normal mapping calculations.
+// BlinnPhong_NormalMapped_Quantized_VS compiles this with QUANTIZED_VERTICES
+// defined to read packed positions and octahedral normal and tangent frames
+// (the bitangent is rebuilt from the normal, tangent and handedness sign).
 // =============================================================================
 
 #include "Common/CommonStructures.hlsli"
+#ifdef QUANTIZED_VERTICES
+#include "Common/VertexDecode.hlsli"
+#endif
 
 // Main vertex shader entry point
 NormalMappedVertexOutput main(
+#ifdef QUANTIZED_VERTICES
+    in float4 packedPosition     : Position,
+    in float2 packedNormal       : Normal,
+    in float4 packedTangentFrame : Tangent,
+#else
     in float3 modelPosition  : Position, 
     in float3 modelNormal    : Normal, 
     in float3 modelTangent   : Tangent, 
     in float3 modelBitangent : Bitangent, 
+#endif
     in float2 texCoords      : TexCoord)
 {
     NormalMappedVertexOutput output;
     
+#ifdef QUANTIZED_VERTICES
+    const float3 modelPosition = DecodePosition(packedPosition);
+    const float3 modelNormal = DecodeOctahedral(packedNormal);
+    float3 modelTangent;
+    float3 modelBitangent;
+    DecodeTangentFrame(modelNormal, packedTangentFrame, modelTangent, modelBitangent);
+#endif
+    
     // Transform vertex position from model space to view space
     // This is needed for per-pixel lighting calculations in the pixel shader
     output.viewSpacePosition = mul(float4(modelPosition, 1.0f), modelViewMatrix).xyz;
@@ -3,17 +3,32 @@
 // =============================================================================
 // Transforms vertices for solid-colored models (no textures) using Blinn-Phong shading.
 // Outputs view-space position and normal for lighting calculations.
+// BlinnPhong_Solid_Quantized_VS compiles this with QUANTIZED_VERTICES defined
+// to read packed positions and octahedral normals.
 // =============================================================================
 
 #include "Common/CommonStructures.hlsli"
+#ifdef QUANTIZED_VERTICES
+#include "Common/VertexDecode.hlsli"
+#endif
 
 // Main vertex shader entry point
 SolidVertexOutput main(
+#ifdef QUANTIZED_VERTICES
+    in float4 packedPosition : Position,
+    in float2 packedNormal : Normal)
+#else
     in float3 modelPosition : Position, 
     in float3 modelNormal : Normal)
+#endif
 {
     SolidVertexOutput output;
     
+#ifdef QUANTIZED_VERTICES
+    const float3 modelPosition = DecodePosition(packedPosition);
+    const float3 modelNormal = DecodeOctahedral(packedNormal);
+#endif
+    
     // Transform vertex position from model space to view space
     // This is needed for per-pixel lighting calculations in the pixel shader
     output.viewSpacePosition = mul(float4(modelPosition, 1.0f), modelViewMatrix).xyz;
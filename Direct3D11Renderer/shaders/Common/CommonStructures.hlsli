@@ -22,6 +22,37 @@ cbuffer TransformMatrices : register(b0)
     matrix modelViewProjMatrix;   // Transform from model space to clip space for rasterization
 };
 
+// =============================================================================
+// PER-INSTANCE TRANSFORMS (INSTANCED VERTEX SHADERS)
+// =============================================================================
+
+/// <summary>
+/// Per-instance transform rows streamed from input slot 1 (see InstanceBuffer).
+/// Replaces the TransformMatrices cbuffer in the *_Instanced_VS shaders.
+/// Rows are uploaded untransposed, so rebuild with the row constructor.
+/// </summary>
+struct InstanceTransforms
+{
+    float4 modelView0     : InstanceModelView0;
+    float4 modelView1     : InstanceModelView1;
+    float4 modelView2     : InstanceModelView2;
+    float4 modelView3     : InstanceModelView3;
+    float4 modelViewProj0 : InstanceModelViewProj0;
+    float4 modelViewProj1 : InstanceModelViewProj1;
+    float4 modelViewProj2 : InstanceModelViewProj2;
+    float4 modelViewProj3 : InstanceModelViewProj3;
+};
+
+float4x4 GetInstanceModelView(InstanceTransforms instance)
+{
+    return float4x4(instance.modelView0, instance.modelView1, instance.modelView2, instance.modelView3);
+}
+
+float4x4 GetInstanceModelViewProj(InstanceTransforms instance)
+{
+    return float4x4(instance.modelViewProj0, instance.modelViewProj1, instance.modelViewProj2, instance.modelViewProj3);
+}
+
 // =============================================================================
 // LIGHTING CONSTANT BUFFER (PIXEL SHADERS) 
 // =============================================================================
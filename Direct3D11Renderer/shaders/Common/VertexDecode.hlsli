@@ -0,0 +1,67 @@
+// =============================================================================
+// Packed Vertex Decode Functions
+// =============================================================================
+// Decodes the compressed vertex element types (see Geometry/VertexCompression.h).
+// The input assembler already expands UNORM/SNORM/half formats to floats, so
+// only the octahedral mapping and the position range are applied here.
+// =============================================================================
+
+#ifndef VERTEX_DECODE_HLSLI
+#define VERTEX_DECODE_HLSLI
+
+// =============================================================================
+// QUANTIZATION CONSTANT BUFFER (VERTEX SHADERS)
+// =============================================================================
+
+/// <summary>
+/// Bounds that Position3DQuantized vertices are relative to (D3::VertexQuantization).
+/// Register b1 - Bound per mesh alongside its vertex buffer.
+/// </summary>
+cbuffer VertexQuantization : register(b1)
+{
+    float3 positionMin;     // Minimum corner of the mesh bounds
+    float3 positionExtent;  // Size of the mesh bounds on each axis
+};
+
+// =============================================================================
+// DECODE FUNCTIONS
+// =============================================================================
+
+/// <summary>
+/// Expands a 16-bit UNORM position back into model space.
+/// </summary>
+/// <param name="packedPosition">Position in [0,1] relative to the mesh bounds (w unused)</param>
+/// <returns>Model-space position</returns>
+float3 DecodePosition(in float4 packedPosition)
+{
+    return positionMin + packedPosition.xyz * positionExtent;
+}
+
+/// <summary>
+/// Maps octahedral coordinates back onto the unit sphere.
+/// </summary>
+/// <param name="encoded">Octahedral coordinates in [-1,1]</param>
+/// <returns>Unit vector</returns>
+float3 DecodeOctahedral(in float2 encoded)
+{
+    float3 v = float3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+    // fold the lower hemisphere back out of the corners of the square
+    const float t = saturate(-v.z);
+    v.xy += (v.xy >= 0.0f) ? -t : t;
+    return normalize(v);
+}
+
+/// <summary>
+/// Rebuilds the tangent and bitangent from an octahedral tangent and handedness sign.
+/// </summary>
+/// <param name="normal">Decoded model-space normal</param>
+/// <param name="packedTangentFrame">Octahedral tangent in xy, bitangent sign in z</param>
+/// <param name="tangent">Receives the model-space tangent</param>
+/// <param name="bitangent">Receives the model-space bitangent</param>
+void DecodeTangentFrame(in float3 normal, in float4 packedTangentFrame, out float3 tangent, out float3 bitangent)
+{
+    tangent = DecodeOctahedral(packedTangentFrame.xy);
+    bitangent = cross(normal, tangent) * (packedTangentFrame.z < 0.0f ? -1.0f : 1.0f);
+}
+
+#endif // VERTEX_DECODE_HLSLI
@@ -0,0 +1,14 @@
+// =============================================================================
+// Fullscreen Triangle Vertex Shader
+// =============================================================================
+// Generates a single triangle covering the whole viewport from SV_VertexID.
+// Drawn with 3 vertices and no vertex buffer or input layout bound.
+// =============================================================================
+
+// Main vertex shader entry point
+float4 main(uint id : SV_VertexID) : SV_POSITION
+{
+    // (0,0), (2,0), (0,2) mapped to clip space, clockwise so back face culling keeps it
+    const float2 uv = float2((id << 1) & 2, id & 2);
+    return float4(uv * float2(2.0f, -2.0f) + float2(-1.0f, 1.0f), 0.0f, 1.0f);
+}
@@ -0,0 +1,51 @@
+// =============================================================================
+// Outline Blur Pixel Shader
+// =============================================================================
+// One direction of a separable gaussian blur over the outline silhouette.
+// The silhouette holds each object's outline color premultiplied by its
+// alpha, so blurring all four channels keeps the colors apart from the empty
+// background. Intermediate passes write the blurred silhouette into another
+// target, the final pass divides the color back out and blends it onto the
+// back buffer, stencil masked so the objects themselves stay visible.
+// =============================================================================
+
+Texture2D silhouetteTexture : register(t0);
+
+// Per-pass blur parameters
+cbuffer OutlineBlur : register(b0)
+{
+    float2 direction;      // Texel step, (1, 0) horizontal or (0, 1) vertical
+    float composite;       // Nonzero for the final pass
+    float blurPadding;
+};
+
+// Gaussian weights (sigma 2) for offsets 0..4, normalized over the 9 taps
+static const int blurRadius = 4;
+static const float blurWeights[blurRadius + 1] = { 0.2042f, 0.1802f, 0.1238f, 0.0663f, 0.0276f };
+
+// Main pixel shader entry point
+float4 main(float4 pos : SV_POSITION) : SV_TARGET
+{
+    uint width, height;
+    silhouetteTexture.GetDimensions(width, height);
+    const int2 maxCoord = int2(width, height) - 1;
+    const int2 center = int2(pos.xy);
+
+    // texel fetches clamped to the edge, no sampler needed
+    float4 blurred = silhouetteTexture.Load(int3(center, 0)) * blurWeights[0];
+    [unroll]
+    for (int i = 1; i <= blurRadius; i++)
+    {
+        const int2 offset = int2(direction) * i;
+        blurred += silhouetteTexture.Load(int3(clamp(center + offset, 0, maxCoord), 0)) * blurWeights[i];
+        blurred += silhouetteTexture.Load(int3(clamp(center - offset, 0, maxCoord), 0)) * blurWeights[i];
+    }
+
+    if (composite != 0.0f)
+    {
+        // only the outer half of the blurred edge survives the stencil mask, so start it opaque
+        const float3 color = blurred.rgb / max(blurred.a, 1e-4f);
+        return float4(color, saturate(blurred.a * 2.0f));
+    }
+    return blurred;
+}
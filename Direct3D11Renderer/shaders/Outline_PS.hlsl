@@ -0,0 +1,21 @@
+// =============================================================================
+// Outline Pixel Shader
+// =============================================================================
+// Outputs the outline color, premultiplied by its alpha for the blur passes
+// that composite the silhouette onto the back buffer. OutlineProperties is one buffer bound to both
+// stages, the vertex shader reads the scale from it.
+// =============================================================================
+
+// Outline properties constant buffer (shared with Outline_VS)
+cbuffer OutlineProperties : register(b1)
+{
+    float4 outlineColor;    // RGBA color of the outline
+    float outlineScale;     // Model space scale of the inflated mesh
+    float3 outlinePadding;  // Padding for 16-byte alignment requirement
+};
+
+// Main pixel shader entry point
+float4 main() : SV_TARGET
+{
+    return float4(outlineColor.rgb * outlineColor.a, outlineColor.a);
+}
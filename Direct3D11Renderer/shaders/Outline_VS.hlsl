@@ -0,0 +1,31 @@
+// =============================================================================
+// Outline Vertex Shader
+// =============================================================================
+// Draws the mesh inflated by outlineScale for the outline pass.
+// OutlineProperties is one buffer bound to both stages, the pixel shader
+// reads the color from it.
+// =============================================================================
+
+#include "Common/CommonStructures.hlsli"
+
+// Outline properties constant buffer (shared with Outline_PS)
+cbuffer OutlineProperties : register(b1)
+{
+    float4 outlineColor;    // RGBA color of the outline
+    float outlineScale;     // Model space scale of the inflated mesh
+    float3 outlinePadding;  // Padding for 16-byte alignment requirement
+};
+
+// Vertex input structure
+struct VSInput
+{
+    float3 pos : Position;
+    float3 normal : Normal;
+};
+
+// Main vertex shader entry point
+float4 main(VSInput input) : SV_POSITION
+{
+    // Scale in model space, then transform to clip space
+    return mul(float4(input.pos * outlineScale, 1.0f), modelViewProjMatrix);
+}
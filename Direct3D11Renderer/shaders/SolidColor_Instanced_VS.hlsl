@@ -0,0 +1,32 @@
+// =============================================================================
+// Simple Solid Color Instanced Vertex Shader
+// =============================================================================
+// Instanced variant of SolidColor_VS. Transforms come from the
+// per-instance stream instead of the TransformMatrices constant buffer.
+// =============================================================================
+
+#include "Common/CommonStructures.hlsli"
+
+// Vertex input structure
+struct VSInput
+{
+    float3 pos : Position;
+    float3 normal : Normal;
+};
+
+// Vertex output structure (minimal for solid color)
+struct VSOutput
+{
+    float4 pos : SV_POSITION;
+};
+
+// Main vertex shader entry point
+VSOutput main(VSInput input, InstanceTransforms instance)
+{
+    VSOutput output;
+
+    // Transform vertex position to clip space
+    output.pos = mul(float4(input.pos, 1.0f), GetInstanceModelViewProj(instance));
+
+    return output;
+}
@@ -1,4 +1,5 @@
 #include "Bindable/Bindable.h"
+#include "RenderPass/DrawPacket.h"
 
 ID3D11DeviceContext* const Bindable::GetContext(Graphics& gfx) noexcept
 {
@@ -10,6 +11,32 @@ ID3D11Device* const Bindable::GetDevice(Graphics& gfx) noexcept
 	return gfx.GetDevice();
 }
 
+void Bindable::Compile(DrawPacketBuilder& builder)
+{
+	builder.AddDynamic(*this);
+}
+
+size_t Bindable::GetBufferBytes(ID3D11Buffer* pBuffer) noexcept
+{
+	if (pBuffer == nullptr)
+	{
+		return 0u;
+	}
+	D3D11_BUFFER_DESC desc;
+	pBuffer->GetDesc(&desc);
+	return desc.ByteWidth;
+}
+
+PipelineStateCache& Bindable::GetStateCache(Graphics& gfx) noexcept
+{
+	return gfx.GetStateCache();
+}
+
+ConstantRing& Bindable::GetConstantRing(Graphics& gfx) noexcept
+{
+	return gfx.GetConstantRing();
+}
+
 #ifndef NDEBUG
 DxgiDebugManager& Bindable::GetInfoManager(Graphics& gfx) noexcept
 {
@@ -0,0 +1,144 @@
+#include "Bindable/BindableCache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+std::array<BindableCache::Shard, BindableCache::ShardCount> BindableCache::shards;
+std::atomic<uint64_t> BindableCache::clock = 0u;
+// enough for a large scene's textures and buffers, well below what a desktop GPU offers
+std::atomic<size_t> BindableCache::budget = size_t(512u) * 1024u * 1024u;
+std::atomic<size_t> BindableCache::hits = 0u;
+std::atomic<size_t> BindableCache::misses = 0u;
+std::atomic<size_t> BindableCache::evictions = 0u;
+std::atomic<size_t> BindableCache::gpuBytes = 0u;
+std::atomic<size_t> BindableCache::cpuBytes = 0u;
+std::mutex BindableCache::trimMutex;
+
+void BindableCache::SetBudget(size_t bytes) noexcept
+{
+    budget.store(bytes, std::memory_order_relaxed);
+}
+
+size_t BindableCache::GetBudget() noexcept
+{
+    return budget.load(std::memory_order_relaxed);
+}
+
+void BindableCache::Trim()
+{
+    // one trim at a time, a second caller would only find the same candidates
+    std::lock_guard trimLock(trimMutex);
+    if (GetResidentBytes() <= GetBudget())
+    {
+        return;
+    }
+
+    struct Candidate
+    {
+        uint64_t lastUse;
+        uint64_t key;
+    };
+    std::vector<Candidate> candidates;
+    for (auto& shard : shards)
+    {
+        std::shared_lock lock(shard.mutex);
+        for (const auto& [key, entry] : shard.entries)
+        {
+            if (IsEvictable(entry))
+            {
+                candidates.push_back({ entry.lastUse.load(std::memory_order_relaxed), key });
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+        [](const Candidate& lhs, const Candidate& rhs)
+        {
+            return lhs.lastUse < rhs.lastUse;
+        });
+
+    for (const auto& candidate : candidates)
+    {
+        if (GetResidentBytes() <= GetBudget())
+        {
+            break;
+        }
+        // the entry may have been resolved again since it was collected
+        std::shared_ptr<Bindable> pEvicted;
+        auto& shard = GetShard(candidate.key);
+        {
+            std::unique_lock lock(shard.mutex);
+            auto it = shard.entries.find(candidate.key);
+            if (it == shard.entries.end() || !IsEvictable(it->second))
+            {
+                continue;
+            }
+            gpuBytes.fetch_sub(it->second.footprint.gpuBytes, std::memory_order_relaxed);
+            cpuBytes.fetch_sub(it->second.footprint.cpuBytes, std::memory_order_relaxed);
+            // released after the lock so the bindable's destructor does not run under it
+            pEvicted = it->second.result.get();
+            shard.entries.erase(it);
+        }
+        evictions.fetch_add(1u, std::memory_order_relaxed);
+    }
+}
+
+BindableCache::Stats BindableCache::GetStats()
+{
+    Stats stats;
+    stats.hits = hits.load(std::memory_order_relaxed);
+    stats.misses = misses.load(std::memory_order_relaxed);
+    stats.evictions = evictions.load(std::memory_order_relaxed);
+    stats.gpuBytes = gpuBytes.load(std::memory_order_relaxed);
+    stats.cpuBytes = cpuBytes.load(std::memory_order_relaxed);
+    for (auto& shard : shards)
+    {
+        std::shared_lock lock(shard.mutex);
+        stats.resident += shard.entries.size();
+    }
+    return stats;
+}
+
+std::vector<BindableCache::TypeStats> BindableCache::GetTypeStats()
+{
+    std::vector<TypeStats> types;
+    for (auto& shard : shards)
+    {
+        std::shared_lock lock(shard.mutex);
+        for (const auto& [key, entry] : shard.entries)
+        {
+            auto it = std::find_if(types.begin(), types.end(),
+                [&entry](const TypeStats& type)
+                {
+                    return std::strcmp(type.typeName, entry.typeName) == 0;
+                });
+            if (it == types.end())
+            {
+                types.push_back({ entry.typeName });
+                it = types.end() - 1;
+            }
+            it->resident++;
+            it->gpuBytes += entry.footprint.gpuBytes;
+            it->cpuBytes += entry.footprint.cpuBytes;
+        }
+    }
+    return types;
+}
+
+std::string BindableCache::GetUID(uint64_t key)
+{
+    auto& shard = GetShard(key);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.entries.find(key);
+    return it != shard.entries.end() ? it->second.uid : std::string{};
+}
+
+size_t BindableCache::GetResidentBytes() noexcept
+{
+    return gpuBytes.load(std::memory_order_relaxed) + cpuBytes.load(std::memory_order_relaxed);
+}
+
+bool BindableCache::IsEvictable(const Entry& entry) noexcept
+{
+    return entry.result.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+        entry.result.get().use_count() == 1;
+}
@@ -1,4 +1,5 @@
 #include "Bindable/Blender.h"
+#include "RenderPass/DrawPacket.h"
 #include "Bindable/BindableCache.h"
 
 Blender::Blender(Graphics& gfx, bool blendEnable) : blendEnable(blendEnable)
@@ -29,7 +30,12 @@ Blender::Blender(Graphics& gfx, bool blendEnable) : blendEnable(blendEnable)
 
 void Blender::Bind(Graphics& gfx) noexcept
 {
-	GetContext(gfx)->OMSetBlendState(pBlender.Get(), nullptr, 0xFFFFFFFFu);
+	GetStateCache(gfx).SetBlendState(pBlender.Get(), 0xFFFFFFFFu);
+}
+
+void Blender::Compile(DrawPacketBuilder& builder)
+{
+	builder.SetBlendState(pBlender.Get(), 0xFFFFFFFFu);
 }
 
 std::shared_ptr<Blender> Blender::Resolve(Graphics& gfx, bool blendEnable) noexcept
@@ -42,6 +48,11 @@ std::string Blender::GenerateUID(bool blendEnable) noexcept
 	return typeid(Blender).name() + std::string("#") + (blendEnable ? "b" : "n");
 }
 
+uint64_t Blender::GenerateKey(bool blendEnable) noexcept
+{
+	return BindableKey::Of<Blender>().Add(blendEnable).Get();
+}
+
 std::string Blender::GetUID() const noexcept
 {
 	return GenerateUID(blendEnable);
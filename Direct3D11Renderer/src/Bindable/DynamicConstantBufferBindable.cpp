@@ -1,8 +1,10 @@
 #include "Bindable/DynamicConstantBufferBindable.h"
 #include "Core/Graphics.h"
+#include "RenderPass/DrawPacket.h"
+#include <cstring>
 
 // =====================================================================================
-// DynamicPixelConstantBufferBindable Implementation
+// DynamicConstantBufferBindable Implementation
 // =====================================================================================
 /// <summary>
 /// Creates a DirectX 11 constant buffer with dynamic usage for CPU updates.
@@ -16,11 +18,13 @@
 /// </summary>
 /// <param name="gfx">Graphics context for DirectX operations</param>
 /// <param name="layoutRoot">Root layout element defining buffer size and structure</param>
-/// <param name="slot">Pixel shader slot number for binding</param>
+/// <param name="slot">Constant buffer slot, the same in every bound stage</param>
+/// <param name="stages">Shader stages the buffer binds to</param>
 /// <param name="pBuffer">Optional initial data to upload to GPU</param>
-DynamicPixelConstantBufferBindable::DynamicPixelConstantBufferBindable(Graphics& gfx, const D3::LayoutElement& layoutRoot, UINT slot, const D3::ConstantBufferData* pBuffer)
-    : slot(slot)
+DynamicConstantBufferBindable::DynamicConstantBufferBindable(Graphics& gfx, const D3::LayoutElement& layoutRoot, UINT slot, ShaderStage stages, const D3::ConstantBufferData* pBuffer)
+    : slot(slot), stages(stages)
 {
+    assert(stages != ShaderStage::None && "Dynamic constant buffer must bind to at least one stage");
     DEBUGMANAGER(gfx);
 
     // Configure buffer description for dynamic constant buffer
@@ -59,7 +63,7 @@ DynamicPixelConstantBufferBindable::DynamicPixelConstantBufferBindable(Graphics&
 /// </summary>
 /// <param name="gfx">Graphics context for DirectX operations</param>
 /// <param name="buffer">Source data to upload (layout must match)</param>
-void DynamicPixelConstantBufferBindable::Update(Graphics& gfx, const D3::ConstantBufferData& buffer)
+void DynamicConstantBufferBindable::Update(Graphics& gfx, const D3::ConstantBufferData& buffer)
 {
     // Validate that layouts match - prevents data corruption
     assert(&buffer.GetRootLayout() == &GetRootLayoutElement() && "Buffer layout mismatch");
@@ -77,17 +81,50 @@ void DynamicPixelConstantBufferBindable::Update(Graphics& gfx, const D3::Constan
 }
 
 /// <summary>
-/// Binds this constant buffer to the pixel shader stage at the configured slot.
-/// This makes the buffer data available to pixel shaders via the specified slot number.
+/// Binds this constant buffer to every stage in the mask at the configured slot.
+/// The same GPU buffer is shared by all stages, so one upload serves them all.
 /// </summary>
 /// <param name="gfx">Graphics context for DirectX operations</param>
-void DynamicPixelConstantBufferBindable::Bind(Graphics& gfx) noexcept
+void DynamicConstantBufferBindable::Bind(Graphics& gfx) noexcept
 {
-    GetContext(gfx)->PSSetConstantBuffers(slot, 1u, pConstantBuffer.GetAddressOf());
+    auto& state = GetStateCache(gfx);
+    if (HasStage(stages, ShaderStage::Vertex))
+    {
+        state.SetVertexConstantBuffer(slot, pConstantBuffer.Get());
+    }
+    if (HasStage(stages, ShaderStage::Pixel))
+    {
+        state.SetPixelConstantBuffer(slot, pConstantBuffer.Get());
+    }
+}
+
+/// <summary>
+/// Records the buffer as a static constant buffer binding in a draw packet, once per stage.
+/// </summary>
+/// <param name="builder">Draw packet builder of the owning step</param>
+void DynamicConstantBufferBindable::Compile(DrawPacketBuilder& builder)
+{
+    if (HasStage(stages, ShaderStage::Vertex))
+    {
+        builder.AddVertexConstantBuffer(slot, pConstantBuffer.Get());
+    }
+    if (HasStage(stages, ShaderStage::Pixel))
+    {
+        builder.AddPixelConstantBuffer(slot, pConstantBuffer.Get());
+    }
+}
+
+/// <summary>
+/// Returns the shader stages this buffer is bound to.
+/// </summary>
+/// <returns>Stage mask given at construction</returns>
+ShaderStage DynamicConstantBufferBindable::GetStages() const noexcept
+{
+    return stages;
 }
 
 // =====================================================================================
-// CachingDynamicPixelConstantBufferBindable Implementation
+// CachingDynamicConstantBufferBindable Implementation
 // =====================================================================================
 
 /// <summary>
@@ -96,10 +133,14 @@ void DynamicPixelConstantBufferBindable::Bind(Graphics& gfx) noexcept
 /// </summary>
 /// <param name="gfx">Graphics context for DirectX operations</param>
 /// <param name="layout">Finalized layout defining buffer structure</param>
-/// <param name="slot">Pixel shader slot number</param>
-CachingDynamicPixelConstantBufferBindable::CachingDynamicPixelConstantBufferBindable(Graphics& gfx, const D3::FinalizedLayout& layout, UINT slot)
-    : DynamicPixelConstantBufferBindable(gfx, *layout.GetRoot(), slot, nullptr), buffer(layout)
-{}
+/// <param name="slot">Constant buffer slot number</param>
+/// <param name="stages">Shader stages the buffer binds to</param>
+CachingDynamicConstantBufferBindable::CachingDynamicConstantBufferBindable(Graphics& gfx, const D3::FinalizedLayout& layout, UINT slot, ShaderStage stages)
+    : DynamicConstantBufferBindable(gfx, *layout.GetRoot(), slot, stages, nullptr), buffer(layout)
+{
+    // The GPU buffer starts uninitialized, so the zeroed CPU data must go up on first bind
+    buffer.MarkDirty(0u, buffer.GetSizeInBytes());
+}
 
 /// <summary>
 /// Creates a caching constant buffer bindable from existing buffer data.
@@ -107,17 +148,22 @@ CachingDynamicPixelConstantBufferBindable::CachingDynamicPixelConstantBufferBind
 /// </summary>
 /// <param name="gfx">Graphics context for DirectX operations</param>
 /// <param name="bufferData">Source data for initialization</param>
-/// <param name="slot">Pixel shader slot number</param>
-CachingDynamicPixelConstantBufferBindable::CachingDynamicPixelConstantBufferBindable(Graphics& gfx, const D3::ConstantBufferData& bufferData, UINT slot)
-    : DynamicPixelConstantBufferBindable(gfx, bufferData.GetRootLayout(), slot, &bufferData), buffer(bufferData)
-{}
+/// <param name="slot">Constant buffer slot number</param>
+/// <param name="stages">Shader stages the buffer binds to</param>
+CachingDynamicConstantBufferBindable::CachingDynamicConstantBufferBindable(Graphics& gfx, const D3::ConstantBufferData& bufferData, UINT slot, ShaderStage stages)
+    : DynamicConstantBufferBindable(gfx, bufferData.GetRootLayout(), slot, stages, &bufferData),
+      uploadedHash(bufferData.GetContentHash()), uploaded(true), buffer(bufferData)
+{
+    // The GPU buffer was created with this data, whatever the source had pending is now uploaded
+    buffer.ClearDirty();
+}
 
 /// <summary>
 /// Returns the root layout element from the cached buffer.
 /// Used for layout validation and size calculations.
 /// </summary>
 /// <returns>Reference to the root layout element</returns>
-const D3::LayoutElement& CachingDynamicPixelConstantBufferBindable::GetRootLayoutElement() const noexcept
+const D3::LayoutElement& CachingDynamicConstantBufferBindable::GetRootLayoutElement() const noexcept
 {
     return buffer.GetRootLayout();
 }
@@ -127,44 +173,82 @@ const D3::LayoutElement& CachingDynamicPixelConstantBufferBindable::GetRootLayou
 /// Useful for inspecting current values or creating copies.
 /// </summary>
 /// <returns>Const reference to the cached buffer data</returns>
-const D3::ConstantBufferData& CachingDynamicPixelConstantBufferBindable::GetBuffer() const noexcept
+const D3::ConstantBufferData& CachingDynamicConstantBufferBindable::GetBuffer() const noexcept
 {
     return buffer;
 }
 
+uint64_t CachingDynamicConstantBufferBindable::GetUploadedHash() const noexcept
+{
+    return uploadedHash;
+}
+
+bool CachingDynamicConstantBufferBindable::HasSameContents(const CachingDynamicConstantBufferBindable& other) const noexcept
+{
+    if (this == &other)
+    {
+        return true;
+    }
+    return slot == other.slot && stages == other.stages &&
+        buffer.GetRootLayout().GetHash() == other.buffer.GetRootLayout().GetHash() &&
+        buffer.GetSizeInBytes() == other.buffer.GetSizeInBytes() &&
+        std::memcmp(buffer.GetData(), other.buffer.GetData(), buffer.GetSizeInBytes()) == 0;
+}
+
 /// <summary>
-/// Updates the cached buffer data and marks it as dirty for next GPU upload.
+/// Updates the cached buffer data. CopyFrom only marks the byte span that actually
+/// differs, so calling this every frame with unchanged values leaves the buffer clean.
 /// The new data must have the same layout as the existing buffer to prevent corruption.
 /// </summary>
 /// <param name="bufferData">New buffer data to copy (layout must match)</param>
-void CachingDynamicPixelConstantBufferBindable::SetBuffer(const D3::ConstantBufferData& bufferData)
+void CachingDynamicConstantBufferBindable::SetBuffer(const D3::ConstantBufferData& bufferData)
 {
     buffer.CopyFrom(bufferData);  // CopyFrom validates layout compatibility
-    isDirty = true;               // Mark for upload on next bind
 }
 
 /// <summary>
 /// Binds the constant buffer, uploading dirty data to GPU if necessary.
-/// Implements lazy evaluation - data is only uploaded when dirty and binding is requested.
-/// This minimizes GPU bandwidth usage and improves performance.
+/// The dirty range is conservative (reads through mutable proxies count as writes), so a
+/// dirty buffer is hashed first and the Map/Unmap is skipped if the content matches the
+/// last upload. Constant buffers can only be updated whole, so the range is not used to
+/// narrow the copy.
 /// </summary>
 /// <param name="gfx">Graphics context for DirectX operations</param>
-void CachingDynamicPixelConstantBufferBindable::Bind(Graphics& gfx) noexcept
+void CachingDynamicConstantBufferBindable::Bind(Graphics& gfx) noexcept
 {
-    if (isDirty)
+    if (buffer.IsDirty())
     {
-        Update(gfx, buffer);  // Upload cached data to GPU
-        isDirty = false;      // Clear dirty flag
+        const auto hash = buffer.GetContentHash();
+        if (!uploaded || hash != uploadedHash)
+        {
+            Update(gfx, buffer);  // Upload cached data to GPU
+            uploadedHash = hash;
+            uploaded = true;
+            uploadStats.performed++;
+        }
+        else
+        {
+            uploadStats.skipped++;
+        }
+        buffer.ClearDirty();
     }
-    DynamicPixelConstantBufferBindable::Bind(gfx);  // Bind buffer to pipeline
+    DynamicConstantBufferBindable::Bind(gfx);  // Bind buffer to pipeline
 }
 
-void CachingDynamicPixelConstantBufferBindable::Accept(TechniqueProbe& probe)
+/// <summary>
+/// The cached data can be dirtied at any time (e.g. through a TechniqueProbe), so the
+/// upload check has to run on every draw. Registers as a dynamic hook instead of static state.
+/// </summary>
+/// <param name="builder">Draw packet builder of the owning step</param>
+void CachingDynamicConstantBufferBindable::Compile(DrawPacketBuilder& builder)
 {
-    if (probe.VisitBuffer(buffer))
-    {
-        isDirty = true;
-    }
+    builder.AddDynamic(*this);
+}
+
+void CachingDynamicConstantBufferBindable::Accept(TechniqueProbe& probe)
+{
+    // edits made by the probe go through the buffer's proxies, which already widen its dirty range
+    probe.VisitBuffer(buffer);
 }
 
 /// <summary>
@@ -173,11 +257,12 @@ void CachingDynamicPixelConstantBufferBindable::Accept(TechniqueProbe& probe)
 /// </summary>
 /// <param name="gfx">Graphics context for potential creation</param>
 /// <param name="layout">Layout for the bindable</param>
-/// <param name="slot">Pixel shader slot number</param>
+/// <param name="slot">Constant buffer slot number</param>
+/// <param name="stages">Shader stages the buffer binds to</param>
 /// <returns>Shared pointer to the bindable (may be newly created or cached)</returns>
-std::shared_ptr<CachingDynamicPixelConstantBufferBindable> CachingDynamicPixelConstantBufferBindable::Resolve(Graphics& gfx, const D3::FinalizedLayout& layout, UINT slot)
+std::shared_ptr<CachingDynamicConstantBufferBindable> CachingDynamicConstantBufferBindable::Resolve(Graphics& gfx, const D3::FinalizedLayout& layout, UINT slot, ShaderStage stages)
 {
-    return BindableCache::Resolve<CachingDynamicPixelConstantBufferBindable>(gfx, layout, slot);
+    return BindableCache::Resolve<CachingDynamicConstantBufferBindable>(gfx, layout, slot, stages);
 }
 
 /// <summary>
@@ -186,11 +271,12 @@ std::shared_ptr<CachingDynamicPixelConstantBufferBindable> CachingDynamicPixelCo
 /// </summary>
 /// <param name="gfx">Graphics context for potential creation</param>
 /// <param name="buffer">Buffer data containing layout and initial values</param>
-/// <param name="slot">Pixel shader slot number</param>
+/// <param name="slot">Constant buffer slot number</param>
+/// <param name="stages">Shader stages the buffer binds to</param>
 /// <returns>Shared pointer to the bindable (may be newly created or cached)</returns>
-std::shared_ptr<CachingDynamicPixelConstantBufferBindable> CachingDynamicPixelConstantBufferBindable::Resolve(Graphics& gfx, const D3::ConstantBufferData& buffer, UINT slot)
+std::shared_ptr<CachingDynamicConstantBufferBindable> CachingDynamicConstantBufferBindable::Resolve(Graphics& gfx, const D3::ConstantBufferData& buffer, UINT slot, ShaderStage stages)
 {
-    return BindableCache::Resolve<CachingDynamicPixelConstantBufferBindable>(gfx, buffer, slot);
+    return BindableCache::Resolve<CachingDynamicConstantBufferBindable>(gfx, buffer, slot, stages);
 }
 
 /// <summary>
@@ -199,11 +285,12 @@ std::shared_ptr<CachingDynamicPixelConstantBufferBindable> CachingDynamicPixelCo
 /// </summary>
 /// <param name="layout">Layout to include in the UID</param>
 /// <param name="slot">Slot number to include in the UID</param>
+/// <param name="stages">Stage mask to include in the UID</param>
 /// <returns>Unique identifier string for cache lookup</returns>
-std::string CachingDynamicPixelConstantBufferBindable::GenerateUID(const D3::FinalizedLayout& layout, UINT slot)
+std::string CachingDynamicConstantBufferBindable::GenerateUID(const D3::FinalizedLayout& layout, UINT slot, ShaderStage stages)
 {
     using namespace std::string_literals;
-    return typeid(CachingDynamicPixelConstantBufferBindable).name() + "#"s + layout.GetSignature() + "#"s + std::to_string(slot);
+    return typeid(CachingDynamicConstantBufferBindable).name() + "#"s + layout.GetSignature() + "#"s + std::to_string(slot) + "#"s + GetStageTag(stages);
 }
 
 /// <summary>
@@ -212,11 +299,36 @@ std::string CachingDynamicPixelConstantBufferBindable::GenerateUID(const D3::Fin
 /// </summary>
 /// <param name="buffer">Buffer data containing layout information</param>
 /// <param name="slot">Slot number to include in the UID</param>
+/// <param name="stages">Stage mask to include in the UID</param>
 /// <returns>Unique identifier string for cache lookup</returns>
-std::string CachingDynamicPixelConstantBufferBindable::GenerateUID(const D3::ConstantBufferData& buffer, UINT slot)
+std::string CachingDynamicConstantBufferBindable::GenerateUID(const D3::ConstantBufferData& buffer, UINT slot, ShaderStage stages)
 {
     using namespace std::string_literals;
-    return typeid(CachingDynamicPixelConstantBufferBindable).name() + "#"s + buffer.GetRootLayout().GetSignature() + "#"s + std::to_string(slot);
+    return typeid(CachingDynamicConstantBufferBindable).name() + "#"s + buffer.GetRootLayout().GetSignature() + "#"s + std::to_string(slot) + "#"s + GetStageTag(stages);
+}
+
+/// <summary>
+/// Generates the BindableCache key from the layout's structural hash and slot.
+/// </summary>
+/// <param name="layout">Layout to include in the key</param>
+/// <param name="slot">Slot number to include in the key</param>
+/// <param name="stages">Stage mask to include in the key</param>
+/// <returns>64-bit key for cache lookup</returns>
+uint64_t CachingDynamicConstantBufferBindable::GenerateKey(const D3::FinalizedLayout& layout, UINT slot, ShaderStage stages)
+{
+    return BindableKey::Of<CachingDynamicConstantBufferBindable>().Add(layout.GetHash()).Add(slot).Add(stages).Get();
+}
+
+/// <summary>
+/// Generates the BindableCache key from the buffer's layout hash and slot.
+/// </summary>
+/// <param name="buffer">Buffer data containing layout information</param>
+/// <param name="slot">Slot number to include in the key</param>
+/// <param name="stages">Stage mask to include in the key</param>
+/// <returns>64-bit key for cache lookup</returns>
+uint64_t CachingDynamicConstantBufferBindable::GenerateKey(const D3::ConstantBufferData& buffer, UINT slot, ShaderStage stages)
+{
+    return BindableKey::Of<CachingDynamicConstantBufferBindable>().Add(buffer.GetRootLayout().GetHash()).Add(slot).Add(stages).Get();
 }
 
 /// <summary>
@@ -224,14 +336,34 @@ std::string CachingDynamicPixelConstantBufferBindable::GenerateUID(const D3::Con
 /// Used by BindableCache for resource management and lookup.
 /// </summary>
 /// <returns>Unique identifier string for this instance</returns>
-std::string CachingDynamicPixelConstantBufferBindable::GetUID() const noexcept
+std::string CachingDynamicConstantBufferBindable::GetUID() const noexcept
 {
     using namespace std::string_literals;
-    return typeid(CachingDynamicPixelConstantBufferBindable).name() + "#"s + buffer.GetRootLayout().GetSignature() + "#"s + std::to_string(slot);
+    return typeid(CachingDynamicConstantBufferBindable).name() + "#"s + buffer.GetRootLayout().GetSignature() + "#"s + std::to_string(slot) + "#"s + GetStageTag(stages);
+}
+
+/// <summary>
+/// Returns upload counters accumulated by all caching dynamic constant buffers.
+/// </summary>
+/// <returns>Performed and skipped upload totals</returns>
+const CachingDynamicConstantBufferBindable::UploadStats& CachingDynamicConstantBufferBindable::GetUploadStats() noexcept
+{
+    return uploadStats;
+}
+
+CachingDynamicConstantBufferBindable::UploadStats CachingDynamicConstantBufferBindable::uploadStats;
+
+/// <summary>
+/// Reports the memory held by this bindable for BindableCache budgeting.
+/// </summary>
+/// <returns>GPU buffer size plus the size of the cached CPU copy</returns>
+Bindable::MemoryFootprint CachingDynamicConstantBufferBindable::GetMemoryFootprint() const noexcept
+{
+    return { GetBufferBytes(pConstantBuffer.Get()), buffer.GetSizeInBytes() };
 }
 
 // =====================================================================================
-// NoCacheDynamicPixelConstantBufferBindable Implementation
+// NoCacheDynamicConstantBufferBindable Implementation
 // =====================================================================================
 
 /// <summary>
@@ -240,9 +372,10 @@ std::string CachingDynamicPixelConstantBufferBindable::GetUID() const noexcept
 /// </summary>
 /// <param name="gfx">Graphics context for DirectX operations</param>
 /// <param name="layout">Finalized layout defining buffer structure</param>
-/// <param name="slot">Pixel shader slot number</param>
-NoCacheDynamicPixelConstantBufferBindable::NoCacheDynamicPixelConstantBufferBindable(Graphics& gfx, const D3::FinalizedLayout& layout, UINT slot)
-    : DynamicPixelConstantBufferBindable(gfx, *layout.GetRoot(), slot, nullptr), pLayoutRoot(layout.GetRoot())
+/// <param name="slot">Constant buffer slot number</param>
+/// <param name="stages">Shader stages the buffer binds to</param>
+NoCacheDynamicConstantBufferBindable::NoCacheDynamicConstantBufferBindable(Graphics& gfx, const D3::FinalizedLayout& layout, UINT slot, ShaderStage stages)
+    : DynamicConstantBufferBindable(gfx, *layout.GetRoot(), slot, stages, nullptr), pLayoutRoot(layout.GetRoot())
 {}
 
 /// <summary>
@@ -251,9 +384,10 @@ NoCacheDynamicPixelConstantBufferBindable::NoCacheDynamicPixelConstantBufferBind
 /// </summary>
 /// <param name="gfx">Graphics context for DirectX operations</param>
 /// <param name="buffer">Source data for initial GPU upload</param>
-/// <param name="slot">Pixel shader slot number</param>
-NoCacheDynamicPixelConstantBufferBindable::NoCacheDynamicPixelConstantBufferBindable(Graphics& gfx, const D3::ConstantBufferData& buffer, UINT slot)
-    : DynamicPixelConstantBufferBindable(gfx, buffer.GetRootLayout(), slot, &buffer), pLayoutRoot(buffer.GetLayoutRoot())
+/// <param name="slot">Constant buffer slot number</param>
+/// <param name="stages">Shader stages the buffer binds to</param>
+NoCacheDynamicConstantBufferBindable::NoCacheDynamicConstantBufferBindable(Graphics& gfx, const D3::ConstantBufferData& buffer, UINT slot, ShaderStage stages)
+    : DynamicConstantBufferBindable(gfx, buffer.GetRootLayout(), slot, stages, &buffer), pLayoutRoot(buffer.GetLayoutRoot())
 {}
 
 /// <summary>
@@ -261,7 +395,7 @@ NoCacheDynamicPixelConstantBufferBindable::NoCacheDynamicPixelConstantBufferBind
 /// Used for layout validation and size calculations without maintaining a data cache.
 /// </summary>
 /// <returns>Reference to the root layout element</returns>
-const D3::LayoutElement& NoCacheDynamicPixelConstantBufferBindable::GetRootLayoutElement() const noexcept
+const D3::LayoutElement& NoCacheDynamicConstantBufferBindable::GetRootLayoutElement() const noexcept
 {
     return *pLayoutRoot;
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "Bindable/IndexBuffer.h"
 #include "Bindable/BindableCache.h"
+#include <algorithm>
+#include <limits>
 
 IndexBuffer::IndexBuffer(Graphics& gfx, const std::vector<unsigned short>& indices)
 	: IndexBuffer(gfx, "?", indices)
@@ -7,7 +9,40 @@ IndexBuffer::IndexBuffer(Graphics& gfx, const std::vector<unsigned short>& indic
 }
 
 IndexBuffer::IndexBuffer(Graphics& gfx, std::string tag, const std::vector<unsigned short>& indices)
+	: count((UINT)indices.size()), format(DXGI_FORMAT_R16_UINT), tag(tag)
+{
+	CreateBuffer(gfx, indices.data(), sizeof(unsigned short));
+}
+
+IndexBuffer::IndexBuffer(Graphics& gfx, const std::vector<unsigned int>& indices)
+	: IndexBuffer(gfx, "?", indices)
+{
+}
+
+IndexBuffer::IndexBuffer(Graphics& gfx, std::string tag, const std::vector<unsigned int>& indices)
 	: count((UINT)indices.size()), tag(tag)
+{
+	// narrowest width that addresses every vertex of the mesh
+	const auto maxIndex = indices.empty() ? 0u : *std::max_element(indices.begin(), indices.end());
+	if (maxIndex <= std::numeric_limits<unsigned short>::max())
+	{
+		format = DXGI_FORMAT_R16_UINT;
+		const std::vector<unsigned short> narrowed(indices.begin(), indices.end());
+		CreateBuffer(gfx, narrowed.data(), sizeof(unsigned short));
+	}
+	else
+	{
+		format = DXGI_FORMAT_R32_UINT;
+		CreateBuffer(gfx, indices.data(), sizeof(unsigned int));
+	}
+}
+
+IndexBuffer::IndexBuffer(Graphics& gfx, std::string tag, const Source& source)
+	: IndexBuffer(gfx, std::move(tag), source())
+{
+}
+
+void IndexBuffer::CreateBuffer(Graphics& gfx, const void* pIndices, UINT indexSize)
 {
 	DEBUGMANAGER(gfx);
 
@@ -16,16 +51,16 @@ IndexBuffer::IndexBuffer(Graphics& gfx, std::string tag, const std::vector<unsig
 	indexBufferDesc.Usage = D3D11_USAGE_DEFAULT;
 	indexBufferDesc.CPUAccessFlags = 0u;
 	indexBufferDesc.MiscFlags = 0u;
-	indexBufferDesc.ByteWidth = (UINT)(count * sizeof(unsigned short));
-	indexBufferDesc.StructureByteStride = sizeof(unsigned short);
+	indexBufferDesc.ByteWidth = count * indexSize;
+	indexBufferDesc.StructureByteStride = indexSize;
 	D3D11_SUBRESOURCE_DATA indexBufferData{};
-	indexBufferData.pSysMem = indices.data();
+	indexBufferData.pSysMem = pIndices;
 	GFX_THROW_INFO(GetDevice(gfx)->CreateBuffer(&indexBufferDesc, &indexBufferData, &pIndexBuffer));
 }
 
 void IndexBuffer::Bind(Graphics& gfx) noexcept
 {
-	GetContext(gfx)->IASetIndexBuffer(pIndexBuffer.Get(), DXGI_FORMAT_R16_UINT, 0u);
+	GetStateCache(gfx).SetIndexBuffer(pIndexBuffer.Get(), format, 0u);
 }
 
 UINT IndexBuffer::GetCount() const noexcept
@@ -33,16 +68,36 @@ UINT IndexBuffer::GetCount() const noexcept
 	return count;
 }
 
+DXGI_FORMAT IndexBuffer::GetFormat() const noexcept
+{
+	return format;
+}
+
 std::string IndexBuffer::GetUID() const noexcept
 {
 	return GenerateUID_(tag);
 }
 
+Bindable::MemoryFootprint IndexBuffer::GetMemoryFootprint() const noexcept
+{
+	return { GetBufferBytes(pIndexBuffer.Get()), 0u };
+}
+
 std::shared_ptr<IndexBuffer> IndexBuffer::Resolve(Graphics& gfx, const std::string tag, const std::vector<unsigned short>& indices)
 {
 	return BindableCache::Resolve<IndexBuffer>(gfx, tag, indices);
 }
 
+std::shared_ptr<IndexBuffer> IndexBuffer::Resolve(Graphics& gfx, const std::string tag, const std::vector<unsigned int>& indices)
+{
+	return BindableCache::Resolve<IndexBuffer>(gfx, tag, indices);
+}
+
+std::shared_ptr<IndexBuffer> IndexBuffer::Resolve(Graphics& gfx, const std::string tag, const Source& source)
+{
+	return BindableCache::Resolve<IndexBuffer>(gfx, tag, source);
+}
+
 std::string IndexBuffer::GenerateUID_(const std::string& tag)
 {
 	return typeid(IndexBuffer).name() + std::string("#") + tag;
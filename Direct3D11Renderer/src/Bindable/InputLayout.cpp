@@ -1,13 +1,20 @@
 #include "Bindable/InputLayout.h"
+#include "RenderPass/DrawPacket.h"
 #include "Bindable/BindableCache.h"
+#include "Bindable/InstanceBuffer.h"
 #include "Exceptions/GraphicsExceptions.h"
 
-InputLayout::InputLayout(Graphics& gfx, D3::VertexLayout layout, ID3DBlob* pVertexShaderByteCode)
-	:layout(layout)
+InputLayout::InputLayout(Graphics& gfx, D3::VertexLayout layout, ID3DBlob* pVertexShaderByteCode, bool instanced)
+	:layout(layout), instanced(instanced)
 {
 	DEBUGMANAGER(gfx);
 
-	const auto d3dLayout = this->layout.GetD3DLayout();
+	auto d3dLayout = this->layout.GetD3DLayout();
+	if (instanced)
+	{
+		const auto& instanceElements = InstanceBuffer::GetInputElements();
+		d3dLayout.insert(d3dLayout.end(), instanceElements.begin(), instanceElements.end());
+	}
 
 	GFX_THROW_INFO(GetDevice(gfx)->CreateInputLayout(
 		d3dLayout.data(),
@@ -20,22 +27,38 @@ InputLayout::InputLayout(Graphics& gfx, D3::VertexLayout layout, ID3DBlob* pVert
 
 void InputLayout::Bind(Graphics& gfx) noexcept
 {
-	GetContext(gfx)->IASetInputLayout(pInputLayout.Get());
+	GetStateCache(gfx).SetInputLayout(pInputLayout.Get());
+}
+
+void InputLayout::Compile(DrawPacketBuilder& builder)
+{
+	builder.SetInputLayout(pInputLayout.Get());
 }
 
 std::string InputLayout::GetUID() const noexcept
 {
-	return GenerateUID(layout);
+	return GenerateUID(layout, nullptr, instanced);
+}
+
+std::shared_ptr<InputLayout> InputLayout::Resolve(Graphics& gfx, D3::VertexLayout layout, ID3DBlob* pVertexShaderByteCode, bool instanced)
+{
+	return BindableCache::Resolve<InputLayout>(gfx, layout, pVertexShaderByteCode, instanced);
 }
 
-std::shared_ptr<InputLayout> InputLayout::Resolve(Graphics& gfx, D3::VertexLayout layout, ID3DBlob* pVertexShaderByteCode)
+std::string InputLayout::GenerateUID(const D3::VertexLayout& layout, ID3DBlob* pVertexShaderByteCode, bool instanced)
 {
-	return BindableCache::Resolve<InputLayout>(gfx, layout, pVertexShaderByteCode);
+	return typeid(InputLayout).name() + std::string("#") + layout.GetCode() + (instanced ? "#instanced" : "");
 }
 
-std::string InputLayout::GenerateUID(const D3::VertexLayout& layout, ID3DBlob* pVertexShaderByteCode)
+uint64_t InputLayout::GenerateKey(const D3::VertexLayout& layout, ID3DBlob* pVertexShaderByteCode, bool instanced) noexcept
 {
-	return typeid(InputLayout).name() + std::string("#") + layout.GetCode();
+	// same content as GetCode(), hashed element by element instead of concatenated
+	auto key = BindableKey::Of<InputLayout>();
+	for (size_t i = 0; i < layout.GetElementCount(); i++)
+	{
+		key.Add(std::string_view(layout.ResolveByIndex(i).GetCode()));
+	}
+	return key.Add(instanced).Get();
 }
 
 const D3::VertexLayout InputLayout::GetLayout() const noexcept
@@ -0,0 +1,69 @@
+#include "Bindable/InstanceBuffer.h"
+#include "Exceptions/GraphicsExceptions.h"
+#include <cstring>
+
+InstanceBuffer::InstanceBuffer(Graphics& gfx, UINT capacity)
+{
+	Allocate(gfx, capacity);
+}
+
+void InstanceBuffer::Allocate(Graphics& gfx, UINT capacity_in)
+{
+	DEBUGMANAGER(gfx);
+	D3D11_BUFFER_DESC bd = {};
+	bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	bd.Usage = D3D11_USAGE_DYNAMIC;
+	bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	bd.MiscFlags = 0u;
+	bd.ByteWidth = UINT(capacity_in * sizeof(InstanceData));
+	bd.StructureByteStride = sizeof(InstanceData);
+	pInstanceBuffer.Reset();
+	GFX_THROW_INFO(GetDevice(gfx)->CreateBuffer(&bd, nullptr, &pInstanceBuffer));
+	capacity = capacity_in;
+}
+
+void InstanceBuffer::Update(Graphics& gfx, const std::vector<InstanceData>& instances)
+{
+	if (instances.size() > capacity)
+	{
+		// grow geometrically so a scene settles on one allocation
+		UINT newCapacity = capacity;
+		while (newCapacity < instances.size())
+		{
+			newCapacity *= 2u;
+		}
+		Allocate(gfx, newCapacity);
+	}
+
+	DEBUGMANAGER(gfx);
+	D3D11_MAPPED_SUBRESOURCE mappedResource;
+	GFX_THROW_INFO(GetContext(gfx)->Map(pInstanceBuffer.Get(), 0u, D3D11_MAP_WRITE_DISCARD, 0u, &mappedResource));
+	memcpy(mappedResource.pData, instances.data(), instances.size() * sizeof(InstanceData));
+	GetContext(gfx)->Unmap(pInstanceBuffer.Get(), 0u);
+}
+
+void InstanceBuffer::Bind(Graphics& gfx) noexcept
+{
+	GetStateCache(gfx).SetVertexBuffer(Slot, pInstanceBuffer.Get(), UINT(sizeof(InstanceData)), 0u);
+}
+
+UINT InstanceBuffer::GetCapacity() const noexcept
+{
+	return capacity;
+}
+
+const std::array<D3D11_INPUT_ELEMENT_DESC, 8>& InstanceBuffer::GetInputElements() noexcept
+{
+	static const std::array<D3D11_INPUT_ELEMENT_DESC, 8> elements =
+	{ {
+		{ "InstanceModelView", 0u, DXGI_FORMAT_R32G32B32A32_FLOAT, Slot, 0u, D3D11_INPUT_PER_INSTANCE_DATA, 1u },
+		{ "InstanceModelView", 1u, DXGI_FORMAT_R32G32B32A32_FLOAT, Slot, 16u, D3D11_INPUT_PER_INSTANCE_DATA, 1u },
+		{ "InstanceModelView", 2u, DXGI_FORMAT_R32G32B32A32_FLOAT, Slot, 32u, D3D11_INPUT_PER_INSTANCE_DATA, 1u },
+		{ "InstanceModelView", 3u, DXGI_FORMAT_R32G32B32A32_FLOAT, Slot, 48u, D3D11_INPUT_PER_INSTANCE_DATA, 1u },
+		{ "InstanceModelViewProj", 0u, DXGI_FORMAT_R32G32B32A32_FLOAT, Slot, 64u, D3D11_INPUT_PER_INSTANCE_DATA, 1u },
+		{ "InstanceModelViewProj", 1u, DXGI_FORMAT_R32G32B32A32_FLOAT, Slot, 80u, D3D11_INPUT_PER_INSTANCE_DATA, 1u },
+		{ "InstanceModelViewProj", 2u, DXGI_FORMAT_R32G32B32A32_FLOAT, Slot, 96u, D3D11_INPUT_PER_INSTANCE_DATA, 1u },
+		{ "InstanceModelViewProj", 3u, DXGI_FORMAT_R32G32B32A32_FLOAT, Slot, 112u, D3D11_INPUT_PER_INSTANCE_DATA, 1u },
+	} };
+	return elements;
+}
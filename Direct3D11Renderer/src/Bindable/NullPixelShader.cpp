@@ -1,4 +1,5 @@
 #include "Bindable/NullPixelShader.h"
+#include "RenderPass/DrawPacket.h"
 #include "Exceptions/GraphicsExceptions.h"
 #include "Bindable/BindableCache.h"
 
@@ -10,7 +11,12 @@ NullPixelShader::NullPixelShader(Graphics& gfx)
 void NullPixelShader::Bind(Graphics& gfx) noexcept
 {
 	// no shader bound
-	GetContext(gfx)->PSSetShader(nullptr, nullptr, 0u);
+	GetStateCache(gfx).SetPixelShader(nullptr);
+}
+
+void NullPixelShader::Compile(DrawPacketBuilder& builder)
+{
+	builder.SetPixelShader(nullptr);
 }
 
 std::shared_ptr<NullPixelShader> NullPixelShader::Resolve(Graphics& gfx)
@@ -23,6 +29,11 @@ std::string NullPixelShader::GenerateUID()
 	return typeid(NullPixelShader).name();
 }
 
+uint64_t NullPixelShader::GenerateKey() noexcept
+{
+	return BindableKey::Of<NullPixelShader>().Get();
+}
+
 std::string NullPixelShader::GetUID() const noexcept
 {
 	return GenerateUID();
@@ -1,4 +1,5 @@
 #include "Bindable/PixelShader.h"
+#include "RenderPass/DrawPacket.h"
 #include "Bindable/BindableCache.h"
 #include "Exceptions/GraphicsExceptions.h"
 #include <d3dcompiler.h>
@@ -10,11 +11,17 @@ PixelShader::PixelShader(Graphics& gfx, const std::string& path) : path(path)
 	Microsoft::WRL::ComPtr<ID3DBlob> pBlob;
 	GFX_THROW_INFO(D3DReadFileToBlob(std::wstring{path.begin(), path.end()}.c_str(), &pBlob));
 	GFX_THROW_INFO(GetDevice(gfx)->CreatePixelShader(pBlob->GetBufferPointer(), pBlob->GetBufferSize(), nullptr, &pPixelShader));
+	byteCodeSize = pBlob->GetBufferSize();
 }
 
 void PixelShader::Bind(Graphics& gfx) noexcept
 {
-	GetContext(gfx)->PSSetShader(pPixelShader.Get(), nullptr, 0u);
+	GetStateCache(gfx).SetPixelShader(pPixelShader.Get());
+}
+
+void PixelShader::Compile(DrawPacketBuilder& builder)
+{
+	builder.SetPixelShader(pPixelShader.Get());
 }
 
 std::shared_ptr<PixelShader> PixelShader::Resolve(Graphics& gfx, const std::string& path)
@@ -27,7 +34,18 @@ std::string PixelShader::GenerateUID(const std::string& path)
 	return typeid(PixelShader).name() + std::string("#") + path;
 }
 
+uint64_t PixelShader::GenerateKey(const std::string& path) noexcept
+{
+	return BindableKey::Of<PixelShader>().Add(path).Get();
+}
+
 std::string PixelShader::GetUID() const noexcept
 {
 	return GenerateUID(path);
+}
+
+Bindable::MemoryFootprint PixelShader::GetMemoryFootprint() const noexcept
+{
+	// the driver's copy of the shader is roughly the size of the bytecode
+	return { byteCodeSize, 0u };
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Bindable/Rasterizer.h"
+#include "RenderPass/DrawPacket.h"
 #include "Bindable/BindableCache.h"
 
 Rasterizer::Rasterizer(Graphics& gfx, bool twoSided) : twoSided(twoSided)
@@ -11,7 +12,12 @@ Rasterizer::Rasterizer(Graphics& gfx, bool twoSided) : twoSided(twoSided)
 
 void Rasterizer::Bind(Graphics& gfx) noexcept
 {
-	GetContext(gfx)->RSSetState(pRasterizer.Get());
+	GetStateCache(gfx).SetRasterizerState(pRasterizer.Get());
+}
+
+void Rasterizer::Compile(DrawPacketBuilder& builder)
+{
+	builder.SetRasterizerState(pRasterizer.Get());
 }
 
 std::shared_ptr<Rasterizer> Rasterizer::Resolve(Graphics& gfx, bool twoSided)
@@ -25,6 +31,11 @@ std::string Rasterizer::GenerateUID(bool twoSided)
 	return typeid(Rasterizer).name() + "#"s + (twoSided ? "2s" : "1s");
 }
 
+uint64_t Rasterizer::GenerateKey(bool twoSided) noexcept
+{
+	return BindableKey::Of<Rasterizer>().Add(twoSided).Get();
+}
+
 std::string Rasterizer::GetUID() const noexcept
 {
 	return GenerateUID(twoSided);
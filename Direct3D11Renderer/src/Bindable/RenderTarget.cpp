@@ -0,0 +1,64 @@
+#include "Bindable/RenderTarget.h"
+#include "Exceptions/GraphicsExceptions.h"
+
+RenderTarget::RenderTarget(Graphics& gfx, UINT width, UINT height, DXGI_FORMAT format, UINT slot)
+	: width(width), height(height), slot(slot), bytesPerTexel(format == DXGI_FORMAT_R16G16B16A16_FLOAT ? 8u : 4u)
+{
+	DEBUGMANAGER(gfx);
+
+	D3D11_TEXTURE2D_DESC textureDesc = {};
+	textureDesc.Width = width;
+	textureDesc.Height = height;
+	textureDesc.MipLevels = 1u;
+	textureDesc.ArraySize = 1u;
+	textureDesc.Format = format;
+	textureDesc.SampleDesc.Count = 1u;
+	textureDesc.SampleDesc.Quality = 0u;
+	textureDesc.Usage = D3D11_USAGE_DEFAULT;
+	textureDesc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+	Microsoft::WRL::ComPtr<ID3D11Texture2D> pTexture;
+	GFX_THROW_INFO(GetDevice(gfx)->CreateTexture2D(&textureDesc, nullptr, &pTexture));
+
+	GFX_THROW_INFO(GetDevice(gfx)->CreateRenderTargetView(pTexture.Get(), nullptr, &pTargetView));
+	GFX_THROW_INFO(GetDevice(gfx)->CreateShaderResourceView(pTexture.Get(), nullptr, &pTextureView));
+}
+
+void RenderTarget::Bind(Graphics& gfx) noexcept
+{
+	GetStateCache(gfx).SetPixelShaderResource(slot, pTextureView.Get());
+}
+
+void RenderTarget::BindAsTarget(Graphics& gfx) noexcept
+{
+	GetStateCache(gfx).UnbindPixelShaderResource(pTextureView.Get());
+	GetContext(gfx)->OMSetRenderTargets(1u, pTargetView.GetAddressOf(), nullptr);
+
+	D3D11_VIEWPORT vp;
+	vp.Width = (float)width;
+	vp.Height = (float)height;
+	vp.MinDepth = 0.0f;
+	vp.MaxDepth = 1.0f;
+	vp.TopLeftX = 0.0f;
+	vp.TopLeftY = 0.0f;
+	GetContext(gfx)->RSSetViewports(1u, &vp);
+}
+
+void RenderTarget::Clear(Graphics& gfx, const float color[4]) noexcept
+{
+	GetContext(gfx)->ClearRenderTargetView(pTargetView.Get(), color);
+}
+
+Bindable::MemoryFootprint RenderTarget::GetMemoryFootprint() const noexcept
+{
+	return { size_t(width) * height * bytesPerTexel, 0u };
+}
+
+UINT RenderTarget::GetWidth() const noexcept
+{
+	return width;
+}
+
+UINT RenderTarget::GetHeight() const noexcept
+{
+	return height;
+}
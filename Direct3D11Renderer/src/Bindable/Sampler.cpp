@@ -1,4 +1,5 @@
 #include "Bindable/BindableCommon.h"
+#include "RenderPass/DrawPacket.h"
 
 Sampler::Sampler(Graphics& gfx)
 {
@@ -19,7 +20,12 @@ Sampler::Sampler(Graphics& gfx)
 
 void Sampler::Bind(Graphics& gfx) noexcept
 {
-	GetContext(gfx)->PSSetSamplers(0u, 1u, pSampler.GetAddressOf());
+	GetStateCache(gfx).SetPixelSampler(0u, pSampler.Get());
+}
+
+void Sampler::Compile(DrawPacketBuilder& builder)
+{
+	builder.AddPixelSampler(0u, pSampler.Get());
 }
 
 std::shared_ptr<Sampler> Sampler::Resolve(Graphics& gfx)
@@ -32,6 +38,11 @@ std::string Sampler::GenerateUID()
 	return typeid(Sampler).name();
 }
 
+uint64_t Sampler::GenerateKey() noexcept
+{
+	return BindableKey::Of<Sampler>().Get();
+}
+
 std::string Sampler::GetUID() const noexcept
 {
 	return GenerateUID();
@@ -1,4 +1,5 @@
 #include "Bindable/Stencil.h"
+#include "RenderPass/DrawPacket.h"
 #include "Bindable/BindableCache.h"
 
 Stencil::Stencil(Graphics& gfx, Mode mode)
@@ -35,7 +36,12 @@ Stencil::Stencil(Graphics& gfx, Mode mode)
 
 void Stencil::Bind(Graphics& gfx) noexcept
 {
-	GetContext(gfx)->OMSetDepthStencilState(pDepthStencilState.Get(), 0xFF);
+	GetStateCache(gfx).SetDepthStencilState(pDepthStencilState.Get(), 0xFF);
+}
+
+void Stencil::Compile(DrawPacketBuilder& builder)
+{
+	builder.SetDepthStencilState(pDepthStencilState.Get(), 0xFF);
 }
 
 std::shared_ptr<Stencil> Stencil::Resolve(Graphics& gfx, Mode mode)
@@ -49,6 +55,11 @@ std::string Stencil::GenerateUID(Mode mode)
 	return typeid(Stencil).name() + "#"s + std::to_string(static_cast<int>(mode));
 }
 
+uint64_t Stencil::GenerateKey(Mode mode) noexcept
+{
+	return BindableKey::Of<Stencil>().Add(mode).Get();
+}
+
 std::string Stencil::GetUID() const noexcept
 {
 	return GenerateUID(mode);
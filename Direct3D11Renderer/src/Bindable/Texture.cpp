@@ -1,4 +1,5 @@
 #include "Bindable/Texture.h"
+#include "RenderPass/DrawPacket.h"
 #include "Exceptions/GraphicsExceptions.h"
 #include "Utilities/TextureLoader.h"
 
@@ -18,6 +19,11 @@ std::string Texture::GenerateUID(const std::string& path, UINT slot)
 	return typeid(Texture).name() + std::string("#") + path + "#" + std::to_string(slot);
 }
 
+uint64_t Texture::GenerateKey(const std::string& path, UINT slot) noexcept
+{
+	return BindableKey::Of<Texture>().Add(path).Add(slot).Get();
+}
+
 bool Texture::AlphaChannelLoaded() const noexcept
 {
 	return alphaChannelLoaded;
@@ -28,6 +34,54 @@ std::string Texture::GetUID() const noexcept
 	return GenerateUID(path, slot);
 }
 
+Bindable::MemoryFootprint Texture::GetMemoryFootprint() const noexcept
+{
+	if (!pTextureView)
+	{
+		return {};
+	}
+	Microsoft::WRL::ComPtr<ID3D11Resource> pResource;
+	pTextureView->GetResource(&pResource);
+	Microsoft::WRL::ComPtr<ID3D11Texture2D> pTexture;
+	if (FAILED(pResource.As(&pTexture)))
+	{
+		return {};
+	}
+	D3D11_TEXTURE2D_DESC desc;
+	pTexture->GetDesc(&desc);
+
+	// block compressed formats store 4x4 texels in 8 or 16 bytes, everything we load otherwise is 32bpp
+	size_t bitsPerTexel = 32u;
+	switch (desc.Format)
+	{
+	case DXGI_FORMAT_BC1_UNORM:
+	case DXGI_FORMAT_BC1_UNORM_SRGB:
+	case DXGI_FORMAT_BC4_UNORM:
+		bitsPerTexel = 4u;
+		break;
+	case DXGI_FORMAT_BC2_UNORM:
+	case DXGI_FORMAT_BC3_UNORM:
+	case DXGI_FORMAT_BC3_UNORM_SRGB:
+	case DXGI_FORMAT_BC5_UNORM:
+	case DXGI_FORMAT_BC7_UNORM:
+	case DXGI_FORMAT_BC7_UNORM_SRGB:
+		bitsPerTexel = 8u;
+		break;
+	case DXGI_FORMAT_R16G16B16A16_FLOAT:
+		bitsPerTexel = 64u;
+		break;
+	default:
+		break;
+	}
+	size_t bytes = size_t(desc.Width) * desc.Height * desc.ArraySize * bitsPerTexel / 8u;
+	// a full mip chain adds about a third
+	if (desc.MipLevels != 1u)
+	{
+		bytes += bytes / 3u;
+	}
+	return { bytes, 0u };
+}
+
 
 void Texture::LoadFromFile(Graphics& gfx, const std::string& path)
 {
@@ -93,6 +147,11 @@ void Texture::LoadFromFile(Graphics& gfx, const std::string& path)
 
 void Texture::Bind(Graphics& gfx) noexcept
 {
-	GetContext(gfx)->PSSetShaderResources(slot, 1u, pTextureView.GetAddressOf());
+	GetStateCache(gfx).SetPixelShaderResource(slot, pTextureView.Get());
+}
+
+void Texture::Compile(DrawPacketBuilder& builder)
+{
+	builder.AddPixelShaderResource(slot, pTextureView.Get());
 }
 
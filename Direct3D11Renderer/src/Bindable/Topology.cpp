@@ -8,7 +8,7 @@ Topology::Topology(Graphics& gfx, D3D11_PRIMITIVE_TOPOLOGY topology) noexcept
 
 void Topology::Bind(Graphics& gfx) noexcept
 {
-	GetContext(gfx)->IASetPrimitiveTopology(topology);
+	GetStateCache(gfx).SetPrimitiveTopology(topology);
 }
 
 std::string Topology::GetUID() const noexcept
@@ -25,3 +25,8 @@ std::string Topology::GenerateUID(D3D11_PRIMITIVE_TOPOLOGY topology) noexcept
 {
 	return typeid(Topology).name() + std::string("#") + std::to_string(topology);
 }
+
+uint64_t Topology::GenerateKey(D3D11_PRIMITIVE_TOPOLOGY topology) noexcept
+{
+	return BindableKey::Of<Topology>().Add(topology).Get();
+}
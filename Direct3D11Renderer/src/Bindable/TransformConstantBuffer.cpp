@@ -1,5 +1,6 @@
 #include "Bindable/TransformConstantBuffer.h"
 #include <cassert>
+#include <typeinfo>
 
 TransformConstantBuffer::TransformConstantBuffer(Graphics& gfx, UINT slot)
 	: targetStages(ShaderStage::Vertex), vertexSlot(slot), pixelSlot(0u)
@@ -14,12 +15,12 @@ TransformConstantBuffer::TransformConstantBuffer(Graphics& gfx,
 												 ShaderStage stages, UINT vertexSlot, UINT pixelSlot)
 	: targetStages(stages), vertexSlot(vertexSlot), pixelSlot(pixelSlot)
 {
-	if ((static_cast<int>(stages) & static_cast<int>(ShaderStage::Vertex)) && !pVertexConstantBuffer)
+	if (HasStage(stages, ShaderStage::Vertex) && !pVertexConstantBuffer)
 	{
 		pVertexConstantBuffer = std::make_unique<VertexConstantBuffer<TransformBuffer>>(gfx, vertexSlot);
 	}
 	
-	if ((static_cast<int>(stages) & static_cast<int>(ShaderStage::Pixel)) && !pPixelConstantBuffer)
+	if (HasStage(stages, ShaderStage::Pixel) && !pPixelConstantBuffer)
 	{
 		pPixelConstantBuffer = std::make_unique<PixelConstantBuffer<TransformBuffer>>(gfx, pixelSlot);
 	}
@@ -32,14 +33,31 @@ void TransformConstantBuffer::Bind(Graphics& gfx) noexcept
 
 void TransformConstantBuffer::UpdateBindImpl(Graphics& gfx, const TransformBuffer& tf) noexcept
 {
-	if (static_cast<int>(targetStages) & static_cast<int>(ShaderStage::Vertex))
+	auto& ring = GetConstantRing(gfx);
+	// one push serves both stages, each binds the same window of the ring
+	if (const auto allocation = ring.IsSupported() ? ring.Push(gfx, &tf, sizeof(tf)) : std::nullopt)
+	{
+		if (HasStage(targetStages, ShaderStage::Vertex))
+		{
+			assert(parent != nullptr);
+			GetStateCache(gfx).SetVertexConstantBuffer1(vertexSlot, allocation->pBuffer, allocation->firstConstant, allocation->numConstants);
+		}
+		if (HasStage(targetStages, ShaderStage::Pixel))
+		{
+			assert(parent != nullptr);
+			GetStateCache(gfx).SetPixelConstantBuffer1(pixelSlot, allocation->pBuffer, allocation->firstConstant, allocation->numConstants);
+		}
+		return;
+	}
+
+	if (HasStage(targetStages, ShaderStage::Vertex))
 	{
 		assert(parent != nullptr);
 		pVertexConstantBuffer->Update(gfx, tf);
 		pVertexConstantBuffer->Bind(gfx);
 	}
 	
-	if (static_cast<int>(targetStages) & static_cast<int>(ShaderStage::Pixel))
+	if (HasStage(targetStages, ShaderStage::Pixel))
 	{
 		assert(parent != nullptr);
 		pPixelConstantBuffer->Update(gfx, tf);
@@ -66,6 +84,18 @@ void TransformConstantBuffer::InitializeParentReference(const Renderable& parent
 	this->parent = &parent;
 }
 
+std::shared_ptr<Bindable> TransformConstantBuffer::Clone() const
+{
+	// derived buffers carry extra state and would be sliced here
+	assert(typeid(*this) == typeid(TransformConstantBuffer) && "Derived transform buffers must override Clone");
+	return std::make_shared<TransformConstantBuffer>(*this);
+}
+
+ShaderStage TransformConstantBuffer::GetStages() const noexcept
+{
+	return targetStages;
+}
+
 std::unique_ptr<VertexConstantBuffer<TransformConstantBuffer::TransformBuffer>>
 TransformConstantBuffer::pVertexConstantBuffer = nullptr;
 
@@ -17,6 +17,11 @@ VertexBuffer::VertexBuffer(Graphics& gfx, std::string tag, const D3::VertexBuffe
 	GFX_THROW_INFO(GetDevice(gfx)->CreateBuffer(&bd, &sd, &pVertexBuffer));
 }
 
+VertexBuffer::VertexBuffer(Graphics& gfx, std::string tag, const Source& source)
+	: VertexBuffer(gfx, std::move(tag), source())
+{
+}
+
 VertexBuffer::VertexBuffer(Graphics& gfx, const D3::VertexBuffer& vbuf) noexcept(!_DEBUG)
 	: VertexBuffer(gfx, "?", vbuf)
 {
@@ -24,8 +29,7 @@ VertexBuffer::VertexBuffer(Graphics& gfx, const D3::VertexBuffer& vbuf) noexcept
 
 void VertexBuffer::Bind(Graphics& gfx) noexcept
 {
-	const UINT offset = 0u;
-	GetContext(gfx)->IASetVertexBuffers(0u, 1u, pVertexBuffer.GetAddressOf(), &stride, &offset);
+	GetStateCache(gfx).SetVertexBuffer(0u, pVertexBuffer.Get(), stride, 0u);
 }
 
 std::string VertexBuffer::GetUID() const noexcept
@@ -33,11 +37,21 @@ std::string VertexBuffer::GetUID() const noexcept
 	return GenerateUID(tag);
 }
 
+Bindable::MemoryFootprint VertexBuffer::GetMemoryFootprint() const noexcept
+{
+	return { GetBufferBytes(pVertexBuffer.Get()), 0u };
+}
+
 std::shared_ptr<VertexBuffer> VertexBuffer::Resolve(Graphics& gfx, const std::string& tag, const D3::VertexBuffer& vbuf)
 {
 	return BindableCache::Resolve<VertexBuffer>(gfx, tag, vbuf);
 }
 
+std::shared_ptr<VertexBuffer> VertexBuffer::Resolve(Graphics& gfx, const std::string& tag, const Source& source)
+{
+	return BindableCache::Resolve<VertexBuffer>(gfx, tag, source);
+}
+
 std::string VertexBuffer::GenerateUID_(const std::string& tag)
 {
 	return typeid(VertexBuffer).name() + std::string("#") + tag;
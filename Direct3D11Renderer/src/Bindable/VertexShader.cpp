@@ -1,4 +1,5 @@
 #include "Bindable/BindableCommon.h"
+#include "RenderPass/DrawPacket.h"
 #include "Exceptions/GraphicsExceptions.h"
 #include <d3dcompiler.h>
 
@@ -17,7 +18,12 @@ VertexShader::VertexShader(Graphics& gfx, const std::string& path) : path(path)
 
 void VertexShader::Bind(Graphics& gfx) noexcept
 {
-	GetContext(gfx)->VSSetShader(pVertexShader.Get(), nullptr, 0u);
+	GetStateCache(gfx).SetVertexShader(pVertexShader.Get());
+}
+
+void VertexShader::Compile(DrawPacketBuilder& builder)
+{
+	builder.SetVertexShader(pVertexShader.Get());
 }
 
 ID3DBlob* VertexShader::GetByteCode() const noexcept
@@ -35,7 +41,19 @@ std::string VertexShader::GenerateUID(const std::string& path)
 	return typeid(VertexShader).name() + std::string("#") + path;
 }
 
+uint64_t VertexShader::GenerateKey(const std::string& path) noexcept
+{
+	return BindableKey::Of<VertexShader>().Add(path).Get();
+}
+
 std::string VertexShader::GetUID() const noexcept
 {
 	return GenerateUID(path);
 }
+
+Bindable::MemoryFootprint VertexShader::GetMemoryFootprint() const noexcept
+{
+	// bytecode stays on the CPU for input layout creation, the driver's copy is about the same size
+	const size_t byteCodeSize = pByteCodeBlob ? pByteCodeBlob->GetBufferSize() : 0u;
+	return { byteCodeSize, byteCodeSize };
+}
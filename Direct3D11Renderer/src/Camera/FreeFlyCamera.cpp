@@ -40,6 +40,11 @@ XMMATRIX FreeFlyCamera::GetProjectionMatrix(float viewportWidth, float viewportH
 	return XMMatrixPerspectiveFovLH(fovRadians, viewportWidth / viewportHeight, nearPlane, farPlane);
 }
 
+Frustum FreeFlyCamera::GetFrustum(float viewportWidth, float viewportHeight) const noexcept
+{
+	return Frustum::FromViewProjection(GetViewMatrix() * GetProjectionMatrix(viewportWidth, viewportHeight));
+}
+
 void FreeFlyCamera::ProcessInput(Window& wnd, Mouse& mouse, const Keyboard& keyboard, float deltaTime) noexcept
 {
 	// Handle camera mode toggle
@@ -0,0 +1,87 @@
+#include "Camera/Frustum.h"
+
+using namespace DirectX;
+
+Frustum::Frustum() noexcept
+{
+	// zero normals with positive distance, every point is in front of every plane
+	for (int i = 0; i < 2; i++)
+	{
+		planeX[i] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		planeY[i] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		planeZ[i] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		planeW[i] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	}
+}
+
+Frustum Frustum::FromViewProjection(FXMMATRIX viewProjection) noexcept
+{
+	// with row vectors clip = p * M, so the planes come from the columns of M; transposing turns
+	// them into rows. D3D clip space is -w <= x,y <= w and 0 <= z <= w.
+	const auto m = XMMatrixTranspose(viewProjection);
+	const XMVECTOR planes[6] =
+	{
+		XMVectorAdd(m.r[3], m.r[0]),      // left
+		XMVectorSubtract(m.r[3], m.r[0]), // right
+		XMVectorAdd(m.r[3], m.r[1]),      // bottom
+		XMVectorSubtract(m.r[3], m.r[1]), // top
+		m.r[2],                           // near
+		XMVectorSubtract(m.r[3], m.r[2]), // far
+	};
+
+	// only the sign of the distance matters for the box test, so the planes are left unnormalized
+	XMMATRIX first(planes[0], planes[1], planes[2], planes[3]);
+	XMMATRIX second(planes[4], planes[5], planes[4], planes[5]);
+	first = XMMatrixTranspose(first);
+	second = XMMatrixTranspose(second);
+
+	Frustum frustum;
+	XMStoreFloat4A(&frustum.planeX[0], first.r[0]);
+	XMStoreFloat4A(&frustum.planeY[0], first.r[1]);
+	XMStoreFloat4A(&frustum.planeZ[0], first.r[2]);
+	XMStoreFloat4A(&frustum.planeW[0], first.r[3]);
+	XMStoreFloat4A(&frustum.planeX[1], second.r[0]);
+	XMStoreFloat4A(&frustum.planeY[1], second.r[1]);
+	XMStoreFloat4A(&frustum.planeZ[1], second.r[2]);
+	XMStoreFloat4A(&frustum.planeW[1], second.r[3]);
+	return frustum;
+}
+
+bool Frustum::Intersects(const AABB& box) const noexcept
+{
+	if (box.IsEmpty())
+	{
+		return false;
+	}
+
+	const auto center = box.GetCenter();
+	const auto extents = box.GetExtents();
+	const auto cx = XMVectorSplatX(center);
+	const auto cy = XMVectorSplatY(center);
+	const auto cz = XMVectorSplatZ(center);
+	const auto ex = XMVectorSplatX(extents);
+	const auto ey = XMVectorSplatY(extents);
+	const auto ez = XMVectorSplatZ(extents);
+
+	for (int i = 0; i < 2; i++)
+	{
+		const auto nx = XMLoadFloat4A(&planeX[i]);
+		const auto ny = XMLoadFloat4A(&planeY[i]);
+		const auto nz = XMLoadFloat4A(&planeZ[i]);
+
+		// signed distance of the center and projected radius of the box, four planes per lane
+		auto distance = XMVectorMultiplyAdd(cx, nx, XMLoadFloat4A(&planeW[i]));
+		distance = XMVectorMultiplyAdd(cy, ny, distance);
+		distance = XMVectorMultiplyAdd(cz, nz, distance);
+		auto radius = XMVectorMultiply(ex, XMVectorAbs(nx));
+		radius = XMVectorMultiplyAdd(ey, XMVectorAbs(ny), radius);
+		radius = XMVectorMultiplyAdd(ez, XMVectorAbs(nz), radius);
+
+		// entirely behind any one plane means outside
+		if (!XMVector4GreaterOrEqual(XMVectorAdd(distance, radius), XMVectorZero()))
+		{
+			return false;
+		}
+	}
+	return true;
+}
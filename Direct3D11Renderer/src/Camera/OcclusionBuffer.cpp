@@ -0,0 +1,274 @@
+#include "Camera/OcclusionBuffer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <execution>
+#include <limits>
+
+using namespace DirectX;
+
+namespace
+{
+	// vertices closer than this (in clip w) are treated as crossing the near plane
+	constexpr float NearW = 1e-4f;
+
+	// pixel index containing v, clamped before the conversion so far off screen values stay in range
+	int ToPixel(float v, int last) noexcept
+	{
+		return int(std::floor(std::clamp(v, -1.0f, float(last) + 1.0f)));
+	}
+}
+
+OcclusionBuffer::OcclusionBuffer(unsigned int width_in, unsigned int height_in)
+	:
+	width((width_in + 3u) & ~3u),
+	height(height_in),
+	depth(size_t(width) * height, 1.0f)
+{
+	assert(width > 0u && height > 0u && "Occlusion buffer needs a non-zero size");
+	XMStoreFloat4x4(&viewProjection, XMMatrixIdentity());
+	for (unsigned int band = 0u; band * BandHeight < height; band++)
+	{
+		bands.push_back(band);
+	}
+}
+
+void OcclusionBuffer::BeginFrame(FXMMATRIX viewProjection_in) noexcept
+{
+	XMStoreFloat4x4(&viewProjection, viewProjection_in);
+	std::fill(depth.begin(), depth.end(), 1.0f);
+	triangles.clear();
+	stats = {};
+}
+
+void OcclusionBuffer::AddOccluder(const OccluderMesh& occluder, FXMMATRIX world)
+{
+	assert(occluder.indices.size() % 3u == 0u && "Occluder indices must form a triangle list");
+	const auto transform = world * XMLoadFloat4x4(&viewProjection);
+
+	clipScratch.resize(occluder.positions.size());
+	XMVector3TransformStream(clipScratch.data(), sizeof(XMFLOAT4),
+		occluder.positions.data(), sizeof(XMFLOAT3), occluder.positions.size(), transform);
+
+	for (size_t i = 0; i < occluder.indices.size(); i += 3u)
+	{
+		Triangle triangle;
+		bool clipped = false;
+		for (size_t corner = 0; corner < 3u; corner++)
+		{
+			const auto& clip = clipScratch[occluder.indices[i + corner]];
+			// dropping an occluder triangle only makes culling less aggressive, never wrong
+			if (clip.w < NearW || clip.z < 0.0f)
+			{
+				clipped = true;
+				break;
+			}
+			const float invW = 1.0f / clip.w;
+			triangle.v[corner] = {
+				(clip.x * invW * 0.5f + 0.5f) * float(width),
+				(0.5f - clip.y * invW * 0.5f) * float(height),
+				clip.z * invW };
+		}
+		if (clipped)
+		{
+			continue;
+		}
+
+		// occluders are double sided, winding is normalized so the edge functions are positive inside
+		auto& a = triangle.v[0];
+		auto& b = triangle.v[1];
+		auto& c = triangle.v[2];
+		const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if (area == 0.0f)
+		{
+			continue;
+		}
+		if (area < 0.0f)
+		{
+			std::swap(b, c);
+		}
+
+		// off screen entirely
+		if (std::max({ a.x, b.x, c.x }) < 0.0f || std::min({ a.x, b.x, c.x }) >= float(width) ||
+			std::max({ a.y, b.y, c.y }) < 0.0f || std::min({ a.y, b.y, c.y }) >= float(height) ||
+			std::min({ a.z, b.z, c.z }) > 1.0f)
+		{
+			continue;
+		}
+		triangles.push_back(triangle);
+	}
+	stats.occludersDrawn++;
+}
+
+void OcclusionBuffer::Rasterize()
+{
+	// bands own disjoint rows of the depth buffer, so they need no synchronization
+	std::for_each(std::execution::par, bands.begin(), bands.end(),
+		[this](unsigned int band)
+		{
+			RasterizeBand(band);
+		});
+	stats.trianglesRasterized += triangles.size();
+}
+
+void OcclusionBuffer::RasterizeBand(unsigned int band) noexcept
+{
+	const int bandTop = int(band * BandHeight);
+	const int bandBottom = std::min(bandTop + int(BandHeight), int(height)) - 1;
+	const auto laneOffsets = XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+	const auto zero = XMVectorZero();
+	const auto one = XMVectorSplatOne();
+
+	for (const auto& triangle : triangles)
+	{
+		const auto& a = triangle.v[0];
+		const auto& b = triangle.v[1];
+		const auto& c = triangle.v[2];
+
+		const int minY = std::max(bandTop, ToPixel(std::min({ a.y, b.y, c.y }), int(height)));
+		const int maxY = std::min(bandBottom, ToPixel(std::max({ a.y, b.y, c.y }), int(height)));
+		if (minY > maxY)
+		{
+			continue;
+		}
+		// rows are walked in groups of four pixels starting on an aligned column
+		const int minX = std::max(0, ToPixel(std::min({ a.x, b.x, c.x }), int(width))) & ~3;
+		const int maxX = std::min(int(width) - 1, ToPixel(std::max({ a.x, b.x, c.x }), int(width)));
+		if (minX > maxX)
+		{
+			continue;
+		}
+
+		// edge p -> q evaluated at s: (q.x - p.x) * (s.y - p.y) - (q.y - p.y) * (s.x - p.x) = A * x + B * y + C
+		const auto edge = [](const XMFLOAT3& p, const XMFLOAT3& q, float& A, float& B, float& C)
+		{
+			A = p.y - q.y;
+			B = q.x - p.x;
+			C = (q.y - p.y) * p.x - (q.x - p.x) * p.y;
+		};
+		float A[3], B[3], C[3];
+		edge(b, c, A[0], B[0], C[0]);
+		edge(c, a, A[1], B[1], C[1]);
+		edge(a, b, A[2], B[2], C[2]);
+
+		// depth plane from the barycentrics, w_b = E_ca / area and w_c = E_ab / area
+		const float invArea = 1.0f / (A[2] * c.x + B[2] * c.y + C[2]);
+		const float dzb = (b.z - a.z) * invArea;
+		const float dzc = (c.z - a.z) * invArea;
+		const float zA = dzb * A[1] + dzc * A[2];
+		const float zB = dzb * B[1] + dzc * B[2];
+		const float zC = a.z + dzb * C[1] + dzc * C[2];
+
+		for (int y = minY; y <= maxY; y++)
+		{
+			const auto py = XMVectorReplicate(float(y) + 0.5f);
+			float* row = &depth[size_t(y) * width];
+			for (int x = minX; x <= maxX; x += 4)
+			{
+				const auto px = XMVectorAdd(XMVectorReplicate(float(x)), laneOffsets);
+				auto inside = XMVectorTrueInt();
+				for (int e = 0; e < 3; e++)
+				{
+					const auto value = XMVectorMultiplyAdd(XMVectorReplicate(A[e]), px,
+						XMVectorMultiplyAdd(XMVectorReplicate(B[e]), py, XMVectorReplicate(C[e])));
+					inside = XMVectorAndInt(inside, XMVectorGreaterOrEqual(value, zero));
+				}
+				if (XMVector4EqualInt(inside, XMVectorFalseInt()))
+				{
+					continue;
+				}
+
+				auto z = XMVectorMultiplyAdd(XMVectorReplicate(zA), px,
+					XMVectorMultiplyAdd(XMVectorReplicate(zB), py, XMVectorReplicate(zC)));
+				z = XMVectorClamp(z, zero, one);
+				const auto old = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(row + x));
+				XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(row + x), XMVectorSelect(old, XMVectorMin(old, z), inside));
+			}
+		}
+	}
+}
+
+bool OcclusionBuffer::IsVisible(const AABB& box) noexcept
+{
+	stats.occludeesTested++;
+	if (box.IsEmpty())
+	{
+		return true;
+	}
+
+	const auto transform = XMLoadFloat4x4(&viewProjection);
+	auto screenMin = XMVectorReplicate(std::numeric_limits<float>::max());
+	auto screenMax = XMVectorReplicate(std::numeric_limits<float>::lowest());
+	for (int corner = 0; corner < 8; corner++)
+	{
+		const auto point = XMVectorSet(
+			(corner & 1) ? box.max.x : box.min.x,
+			(corner & 2) ? box.max.y : box.min.y,
+			(corner & 4) ? box.max.z : box.min.z,
+			1.0f);
+		const auto clip = XMVector4Transform(point, transform);
+		const float w = XMVectorGetW(clip);
+		// boxes reaching the camera plane cannot be projected, keep them
+		if (w < NearW)
+		{
+			return true;
+		}
+		const auto ndc = XMVectorScale(clip, 1.0f / w);
+		screenMin = XMVectorMin(screenMin, ndc);
+		screenMax = XMVectorMax(screenMax, ndc);
+	}
+
+	const float nearestDepth = XMVectorGetZ(screenMin);
+	const int minX = std::max(0, ToPixel((XMVectorGetX(screenMin) * 0.5f + 0.5f) * float(width), int(width)));
+	const int maxX = std::min(int(width) - 1, ToPixel((XMVectorGetX(screenMax) * 0.5f + 0.5f) * float(width), int(width)));
+	const int minY = std::max(0, ToPixel((0.5f - XMVectorGetY(screenMax) * 0.5f) * float(height), int(height)));
+	const int maxY = std::min(int(height) - 1, ToPixel((0.5f - XMVectorGetY(screenMin) * 0.5f) * float(height), int(height)));
+	// off screen, frustum culling decides about those
+	if (minX > maxX || minY > maxY)
+	{
+		return true;
+	}
+
+	// visible as soon as one covered pixel's occluder depth is not in front of the box
+	const auto boxDepth = XMVectorReplicate(nearestDepth);
+	const auto lanes = XMVectorSet(0.0f, 1.0f, 2.0f, 3.0f);
+	const int firstX = minX & ~3;
+	for (int y = minY; y <= maxY; y++)
+	{
+		const float* row = &depth[size_t(y) * width];
+		for (int x = firstX; x <= maxX; x += 4)
+		{
+			const auto column = XMVectorAdd(XMVectorReplicate(float(x)), lanes);
+			const auto inRange = XMVectorAndInt(
+				XMVectorGreaterOrEqual(column, XMVectorReplicate(float(minX))),
+				XMVectorLessOrEqual(column, XMVectorReplicate(float(maxX))));
+			const auto behind = XMVectorGreaterOrEqual(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(row + x)), boxDepth);
+			if (!XMVector4EqualInt(XMVectorAndInt(inRange, behind), XMVectorFalseInt()))
+			{
+				return true;
+			}
+		}
+	}
+	stats.occludeesRejected++;
+	return false;
+}
+
+const OcclusionBuffer::Stats& OcclusionBuffer::GetStats() const noexcept
+{
+	return stats;
+}
+
+unsigned int OcclusionBuffer::GetWidth() const noexcept
+{
+	return width;
+}
+
+unsigned int OcclusionBuffer::GetHeight() const noexcept
+{
+	return height;
+}
+
+const float* OcclusionBuffer::GetDepth() const noexcept
+{
+	return depth.data();
+}
@@ -1,4 +1,8 @@
 #include "Core/Application.h"
+#include "Bindable/BindableCache.h"
+#include "Bindable/DynamicConstantBufferBindable.h"
+#include "Camera/Frustum.h"
+#include "DynamicConstantBuffer/LayoutRegistry.h"
 #include "imgui.h"
 #include "imgui_impl_win32.h"
 #include "imgui_impl_dx11.h"
@@ -11,7 +15,21 @@
      camera({ 0.0f, 0.0f, -30.0f }),
      light(wnd.Gfx())
  {
-     //model = std::make_unique<Model>(wnd.Gfx(), "assets/models/Sponza/sponza.obj", 0.1f);
+	 // Build the cbuffer layouts generated from the shader sources before any material needs them
+	 D3::LayoutRegistry::Load();
+
+	 // The wall is a single large quad, so it becomes an occluder; the suits behind it are culled by the
+	 // occlusion buffer, the outer ones only when the camera turns away from them. The suits share their
+	 // mesh buffers and have equal materials, so the visible ones draw each mesh as one instanced draw.
+	 wall = std::make_unique<Model>(wnd.Gfx(), "assets/models/brick_wall/brick_wall.obj", 14.0f);
+	 wall->SetRootTransform(DirectX::XMMatrixTranslation(0.0f, 14.0f, 20.0f));
+	 // The rightmost suit imports with compressed vertices to show their size and error in the stats window,
+	 // it is drawn on its own since the quantized shaders have no instanced variants.
+	 for (int i = -3; i <= 3; ++i)
+	 {
+		 auto& suit = suits.emplace_back(std::make_unique<Model>(wnd.Gfx(), "assets/models/nano_textured/nanosuit.obj", 1.0f, i == 3));
+		 suit->SetRootTransform(DirectX::XMMatrixTranslation(float(i) * 8.0f, 0.0f, 35.0f));
+	 }
 
 	 // Create multiple test cubes for better testing
 	 testCubes.reserve(3);
@@ -24,6 +42,13 @@
 	 testCubes[1]->SetPos({ 0.0f, 0.0f, 0.0f });
 	 testCubes[2]->SetPos({ 15.0f, 0.0f, 0.0f });
 
+	 // The cubes only move through their control windows and read their transform when drawn,
+	 // so they are registered once instead of being submitted every frame
+	 for (auto& cube : testCubes)
+	 {
+		 cube->Register(frameManager);
+	 }
+
 	 // Setup camera for better scene viewing
      camera.SetSpeed(50.0f);
      camera.SetPosition({ 0.0f, 20.0f, -40.0f });
@@ -71,7 +96,7 @@ void Application::ProcessFrame()
     // UI
     SpawnSimulationWindow();
     light.SpawnControlWindow();
-    //model->ShowModelControlWindow();
+    wall->ShowModelControlWindow("Brick Wall");
 
 	// Show UI for each cube
 	for (size_t i = 0; i < testCubes.size(); ++i)
@@ -80,21 +105,43 @@ void Application::ProcessFrame()
 		testCubes[i]->SpawnControlWindow(wnd.Gfx(), windowName.c_str());
 	}
 
-    // Bind and render
 	light.Bind(wnd.Gfx());  // Bind light constants globally for all pixel shaders
-	light.Submit(frameManager);
-
-	// Submit all cubes for rendering
-	for (auto& cube : testCubes)
-	{
-		cube->Bind(wnd.Gfx());
-		cube->Submit(frameManager);
-	}
+	const auto frustum = Frustum::FromViewProjection(wnd.Gfx().GetViewProjection());
+	RasterizeOccluders(frustum);
 
+    // Submit and render, counted so debug builds can confirm the steady state stays off the heap
+	const AllocationCounter::Scope submitAllocations;
+	light.Submit(frameManager);
+	SubmitModels(frustum);
     frameManager.Excecute(wnd.Gfx());
+	frameAllocations = submitAllocations.Elapsed();
 
     wnd.Gfx().EndFrame();
     frameManager.Reset();
+	// misses trim as they go, this also catches what was released since without a miss following
+	BindableCache::Trim();
+}
+
+void Application::RasterizeOccluders(const Frustum& frustum)
+{
+	occlusion.BeginFrame(wnd.Gfx().GetViewProjection());
+	wall->AddOccluders(occlusion, frustum);
+	occlusion.Rasterize();
+}
+
+void Application::SubmitModels(const Frustum& frustum)
+{
+	// the wall would only be tested against itself
+	wall->Submit(frameManager, frustum);
+	suitCullStats = {};
+	for (const auto& suit : suits)
+	{
+		suit->Submit(frameManager, frustum, occlusion);
+		const auto& stats = suit->GetCullStats();
+		suitCullStats.submitted += stats.submitted;
+		suitCullStats.culled += stats.culled;
+		suitCullStats.occluded += stats.occluded;
+	}
 }
 
 void Application::SpawnSimulationWindow() noexcept
@@ -112,6 +159,42 @@ void Application::SpawnSimulationWindow() noexcept
         ImGui::Text("Application Average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate,
             ImGui::GetIO().Framerate);
         ImGui::Text("Status: %s", wnd.kbd.KeyIsPressed(VK_SPACE) ? "PAUSED" : "RUNNING (hold spacebar to pause)");
+
+        const auto& stateStats = wnd.Gfx().GetStateCache().GetStats();
+        ImGui::Text("State calls: %zu issued, %zu skipped", stateStats.issued, stateStats.skipped);
+        if (const auto& ring = wnd.Gfx().GetConstantRing(); ring.IsSupported())
+        {
+            const auto& ringStats = ring.GetStats();
+            ImGui::Text("Constant ring: %zu pushes, %.1f KiB, %zu discards", ringStats.pushes, ringStats.bytes / 1024.0f, ringStats.discards);
+        }
+        else
+        {
+            ImGui::Text("Constant ring: unsupported, using per-bindable buffers");
+        }
+        const auto& uploadStats = CachingDynamicConstantBufferBindable::GetUploadStats();
+        ImGui::Text("Material uploads: %zu performed, %zu skipped unchanged", uploadStats.performed, uploadStats.skipped);
+        ImGui::Text("Retained jobs: %zu", frameManager.GetRetainedCount());
+        const auto drawStats = frameManager.GetDrawStats();
+        ImGui::Text("Draws: %zu, %zu of them instanced with %zu instances", drawStats.draws, drawStats.instancedDraws, drawStats.instances);
+        ImGui::Text("Render targets: %zu for %zu transients", frameManager.GetTargetCount(), frameManager.GetGraph().GetTransientCount());
+        const auto cacheStats = BindableCache::GetStats();
+        ImGui::Text("Bindable cache: %zu resident, %.1f MiB GPU, %.1f MiB CPU",
+            cacheStats.resident, cacheStats.gpuBytes / (1024.0f * 1024.0f), cacheStats.cpuBytes / (1024.0f * 1024.0f));
+        ImGui::Text("  %zu hits, %zu misses, %zu evicted", cacheStats.hits, cacheStats.misses, cacheStats.evictions);
+        ImGui::Text("Suit meshes: %zu submitted, %zu culled (%zu occluded)",
+            suitCullStats.submitted, suitCullStats.culled, suitCullStats.occluded);
+        const auto compression = suits.back()->GetCompressionReport();
+        ImGui::Text("Compressed suit: %zu vertices, %.1f of %.1f KiB", compression.vertexCount,
+            compression.compressedBytes / 1024.0f, compression.rawBytes / 1024.0f);
+        ImGui::Text("  max error %.5f position, %.3f/%.3f deg normal/tangent, %.5f uv", compression.maxPositionError,
+            compression.maxNormalErrorDegrees, compression.maxTangentErrorDegrees, compression.maxTexCoordError);
+        const auto& occlusionStats = occlusion.GetStats();
+        ImGui::Text("Occlusion: %zu occluders, %zu triangles, %zu of %zu boxes rejected", occlusionStats.occludersDrawn,
+            occlusionStats.trianglesRasterized, occlusionStats.occludeesRejected, occlusionStats.occludeesTested);
+        if (AllocationCounter::IsEnabled())
+        {
+            ImGui::Text("Submit/execute heap allocations: %zu", frameAllocations);
+        }
     }
     ImGui::End();
 }
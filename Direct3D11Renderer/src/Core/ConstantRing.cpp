@@ -0,0 +1,91 @@
+#include "Core/ConstantRing.h"
+#include "Core/Graphics.h"
+#include <cassert>
+#include <cstring>
+
+ConstantRing::ConstantRing(Graphics& gfx, size_t capacity)
+	:
+	allocator(capacity, ConstantAlignment)
+{
+	HRESULT hr;
+#ifdef _DEBUG
+	DxgiDebugManager& infoManager = GetInfoManager(gfx);
+#endif
+	auto* pDevice = gfx.GetDevice();
+
+	// both options ship with the 11.1 runtime but are still optional per driver
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+	if (gfx.GetContext1() == nullptr ||
+		FAILED(pDevice->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) ||
+		!options.ConstantBufferOffsetting || !options.MapNoOverwriteOnDynamicConstantBuffer)
+	{
+		return;
+	}
+
+	D3D11_BUFFER_DESC bufferDesc{};
+	bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+	bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	bufferDesc.MiscFlags = 0u;
+	bufferDesc.ByteWidth = static_cast<UINT>(capacity);
+	bufferDesc.StructureByteStride = 0u;
+	GFX_THROW_INFO(pDevice->CreateBuffer(&bufferDesc, nullptr, pBuffer.GetAddressOf()));
+	supported = true;
+}
+
+bool ConstantRing::IsSupported() const noexcept
+{
+	return supported;
+}
+
+void ConstantRing::BeginFrame() noexcept
+{
+	allocator.Reset();
+}
+
+void ConstantRing::EndFrame() noexcept
+{
+	last = current;
+	current = {};
+}
+
+std::optional<ConstantRing::Allocation> ConstantRing::Push(Graphics& gfx, const void* pData, size_t size)
+{
+	assert(supported && "ConstantRing::Push called without D3D11.1 constant buffer offsetting");
+	const auto allocation = allocator.Allocate(size);
+	if (!allocation)
+	{
+		return std::nullopt;
+	}
+
+	HRESULT hr;
+#ifdef _DEBUG
+	DxgiDebugManager& infoManager = GetInfoManager(gfx);
+#endif
+	auto* pContext = gfx.GetContext();
+	const auto mapType = allocation->discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+	D3D11_MAPPED_SUBRESOURCE mappedResource;
+	GFX_THROW_INFO(pContext->Map(pBuffer.Get(), 0u, mapType, 0u, &mappedResource));
+	memcpy(static_cast<char*>(mappedResource.pData) + allocation->offset, pData, size);
+	pContext->Unmap(pBuffer.Get(), 0u);
+
+	current.pushes++;
+	current.bytes += allocation->size;
+	if (allocation->discard)
+	{
+		current.discards++;
+	}
+	return Allocation{ pBuffer.Get(), static_cast<UINT>(allocation->offset / 16u), static_cast<UINT>(allocation->size / 16u) };
+}
+
+const ConstantRing::Stats& ConstantRing::GetStats() const noexcept
+{
+	return last;
+}
+
+#ifdef _DEBUG
+DxgiDebugManager& ConstantRing::GetInfoManager(Graphics& gfx) noexcept
+{
+	return gfx.GetInfoManager();
+}
+#endif
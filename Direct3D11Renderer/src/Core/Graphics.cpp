@@ -83,18 +83,15 @@ Graphics::Graphics(HWND hwnd, int width, int height)
 	depthStencilViewDesc.Texture2D.MipSlice = 0u;
     GFX_THROW_INFO(pDevice->CreateDepthStencilView(pDepthStencilBuffer.Get(), &depthStencilViewDesc, pDepthStencilView.GetAddressOf()));
 
-	// Bind the render target and depth stencil view to the pipeline
-	pContext->OMSetRenderTargets(1u, pTarget.GetAddressOf(), pDepthStencilView.Get());
+    // the 11.1 interface is optional (pre-platform-update Windows 7), offset constant binding needs it
+    pContext.As(&pContext1);
 
-    // configure viewport
-    D3D11_VIEWPORT vp;
-    vp.Width = (float)viewportWidth;
-    vp.Height = (float)viewportHeight;
-    vp.MinDepth = 0.0f;
-    vp.MaxDepth = 1.0f;
-    vp.TopLeftX = 0.0f;
-    vp.TopLeftY = 0.0f;
-    pContext->RSSetViewports(1u, &vp);
+    // all bindables route their state changes through the shadow cache from here on
+    pStateCache = std::make_unique<PipelineStateCache>(pContext.Get(), pContext1.Get());
+    pConstantRing = std::make_unique<ConstantRing>(*this);
+
+	// Bind the render target and depth stencil view to the pipeline, and configure the viewport
+	BindBackBuffer();
 
 	// Intialize ImGui
     IMGUI_CHECKVERSION();
@@ -120,6 +117,10 @@ void Graphics::BeginFrame(float red, float green, float blue)
         ImGui::NewFrame();
 	}
 
+    // ImGui and anything else outside the bindables may have changed the context since last frame
+    pStateCache->Invalidate();
+    pConstantRing->BeginFrame();
+
     const float color[] = { red, green, blue, 1.0f };
 	pContext->ClearRenderTargetView(pTarget.Get(), color);
 	pContext->ClearDepthStencilView(pDepthStencilView.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0u);
@@ -127,6 +128,9 @@ void Graphics::BeginFrame(float red, float green, float blue)
 
 void Graphics::EndFrame()
 {
+    pStateCache->EndFrame();
+    pConstantRing->EndFrame();
+
     if (imguiEnabled)
     {
         ImGui::Render();
@@ -159,6 +163,40 @@ void Graphics::DrawIndexed(UINT count) noexcept(!_DEBUG)
 	GFX_THROW_INFO_ONLY(pContext->DrawIndexed(count, 0u, 0u));
 }
 
+void Graphics::DrawIndexedInstanced(UINT indexCount, UINT instanceCount) noexcept(!_DEBUG)
+{
+	GFX_THROW_INFO_ONLY(pContext->DrawIndexedInstanced(indexCount, instanceCount, 0u, 0u, 0u));
+}
+
+void Graphics::Draw(UINT vertexCount) noexcept(!_DEBUG)
+{
+	GFX_THROW_INFO_ONLY(pContext->Draw(vertexCount, 0u));
+}
+
+void Graphics::BindBackBuffer() noexcept
+{
+	pContext->OMSetRenderTargets(1u, pTarget.GetAddressOf(), pDepthStencilView.Get());
+
+    D3D11_VIEWPORT vp;
+    vp.Width = (float)viewportWidth;
+    vp.Height = (float)viewportHeight;
+    vp.MinDepth = 0.0f;
+    vp.MaxDepth = 1.0f;
+    vp.TopLeftX = 0.0f;
+    vp.TopLeftY = 0.0f;
+    pContext->RSSetViewports(1u, &vp);
+}
+
+UINT Graphics::GetWidth() const noexcept
+{
+	return static_cast<UINT>(viewportWidth);
+}
+
+UINT Graphics::GetHeight() const noexcept
+{
+	return static_cast<UINT>(viewportHeight);
+}
+
 DX::XMMATRIX Graphics::GetProjection() const noexcept
 {
     return projection;
@@ -209,6 +247,21 @@ ID3D11Device* const Graphics::GetDevice() noexcept
     return pDevice.Get();
 }
 
+ID3D11DeviceContext1* const Graphics::GetContext1() noexcept
+{
+    return pContext1.Get();
+}
+
+PipelineStateCache& Graphics::GetStateCache() noexcept
+{
+    return *pStateCache;
+}
+
+ConstantRing& Graphics::GetConstantRing() noexcept
+{
+    return *pConstantRing;
+}
+
 #ifdef _DEBUG
 DxgiDebugManager& Graphics::GetInfoManager() noexcept
 {
@@ -0,0 +1,220 @@
+#include "Core/PipelineStateCache.h"
+#include <cassert>
+
+PipelineStateCache::PipelineStateCache(ID3D11DeviceContext* pContext, ID3D11DeviceContext1* pContext1) noexcept
+    : pContext(pContext), pContext1(pContext1)
+{
+}
+
+void PipelineStateCache::Invalidate() noexcept
+{
+    inputLayout.valid = false;
+    topology.valid = false;
+    for (auto& s : vertexBuffers) { s.valid = false; }
+    indexBuffer.valid = false;
+
+    vertexShader.valid = false;
+    for (auto& s : vertexConstantBuffers) { s.valid = false; }
+
+    pixelShader.valid = false;
+    for (auto& s : pixelConstantBuffers) { s.valid = false; }
+    for (auto& s : pixelShaderResources) { s.valid = false; }
+    for (auto& s : pixelSamplers) { s.valid = false; }
+
+    rasterizerState.valid = false;
+    blendState.valid = false;
+    depthStencilState.valid = false;
+}
+
+void PipelineStateCache::EndFrame() noexcept
+{
+    last = current;
+    current = {};
+}
+
+const PipelineStateCache::Stats& PipelineStateCache::GetStats() const noexcept
+{
+    return last;
+}
+
+void PipelineStateCache::SetInputLayout(ID3D11InputLayout* pLayout) noexcept
+{
+    if (Filter(inputLayout, pLayout))
+    {
+        pContext->IASetInputLayout(pLayout);
+    }
+}
+
+void PipelineStateCache::SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology_in) noexcept
+{
+    if (Filter(topology, topology_in))
+    {
+        pContext->IASetPrimitiveTopology(topology_in);
+    }
+}
+
+void PipelineStateCache::SetVertexBuffer(UINT slot, ID3D11Buffer* pBuffer, UINT stride, UINT offset) noexcept
+{
+    if (Filter(vertexBuffers, slot, VertexBufferState{ pBuffer, stride, offset }))
+    {
+        pContext->IASetVertexBuffers(slot, 1u, &pBuffer, &stride, &offset);
+    }
+}
+
+void PipelineStateCache::SetIndexBuffer(ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset) noexcept
+{
+    if (Filter(indexBuffer, IndexBufferState{ pBuffer, format, offset }))
+    {
+        pContext->IASetIndexBuffer(pBuffer, format, offset);
+    }
+}
+
+void PipelineStateCache::SetVertexShader(ID3D11VertexShader* pShader) noexcept
+{
+    if (Filter(vertexShader, pShader))
+    {
+        pContext->VSSetShader(pShader, nullptr, 0u);
+    }
+}
+
+void PipelineStateCache::SetVertexConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept
+{
+    if (Filter(vertexConstantBuffers, slot, ConstantBufferState{ pBuffer, 0u, 0u }))
+    {
+        pContext->VSSetConstantBuffers(slot, 1u, &pBuffer);
+    }
+}
+
+void PipelineStateCache::SetPixelShader(ID3D11PixelShader* pShader) noexcept
+{
+    if (Filter(pixelShader, pShader))
+    {
+        pContext->PSSetShader(pShader, nullptr, 0u);
+    }
+}
+
+void PipelineStateCache::SetPixelConstantBuffer(UINT slot, ID3D11Buffer* pBuffer) noexcept
+{
+    if (Filter(pixelConstantBuffers, slot, ConstantBufferState{ pBuffer, 0u, 0u }))
+    {
+        pContext->PSSetConstantBuffers(slot, 1u, &pBuffer);
+    }
+}
+
+void PipelineStateCache::SetPixelShaderResource(UINT slot, ID3D11ShaderResourceView* pView) noexcept
+{
+    if (Filter(pixelShaderResources, slot, pView))
+    {
+        pContext->PSSetShaderResources(slot, 1u, &pView);
+    }
+}
+
+void PipelineStateCache::UnbindPixelShaderResource(ID3D11ShaderResourceView* pView) noexcept
+{
+    for (UINT slot = 0u; slot < pixelShaderResources.size(); slot++)
+    {
+        // invalid slots are reissued on their next set anyway, only a shadow we trust can go stale
+        const auto& shadow = pixelShaderResources[slot];
+        if (shadow.valid && shadow.value == pView)
+        {
+            SetPixelShaderResource(slot, nullptr);
+        }
+    }
+}
+
+void PipelineStateCache::SetPixelSampler(UINT slot, ID3D11SamplerState* pSampler) noexcept
+{
+    if (Filter(pixelSamplers, slot, pSampler))
+    {
+        pContext->PSSetSamplers(slot, 1u, &pSampler);
+    }
+}
+
+void PipelineStateCache::SetVertexConstantBuffers(UINT startSlot, UINT count, ID3D11Buffer* const* ppBuffers) noexcept
+{
+    if (FilterConstantBufferRange(vertexConstantBuffers, startSlot, count, ppBuffers))
+    {
+        pContext->VSSetConstantBuffers(startSlot, count, ppBuffers);
+    }
+}
+
+void PipelineStateCache::SetPixelConstantBuffers(UINT startSlot, UINT count, ID3D11Buffer* const* ppBuffers) noexcept
+{
+    if (FilterConstantBufferRange(pixelConstantBuffers, startSlot, count, ppBuffers))
+    {
+        pContext->PSSetConstantBuffers(startSlot, count, ppBuffers);
+    }
+}
+
+void PipelineStateCache::SetPixelShaderResources(UINT startSlot, UINT count, ID3D11ShaderResourceView* const* ppViews) noexcept
+{
+    if (FilterRange(pixelShaderResources, startSlot, count, ppViews))
+    {
+        pContext->PSSetShaderResources(startSlot, count, ppViews);
+    }
+}
+
+void PipelineStateCache::SetPixelSamplers(UINT startSlot, UINT count, ID3D11SamplerState* const* ppSamplers) noexcept
+{
+    if (FilterRange(pixelSamplers, startSlot, count, ppSamplers))
+    {
+        pContext->PSSetSamplers(startSlot, count, ppSamplers);
+    }
+}
+
+void PipelineStateCache::SetRasterizerState(ID3D11RasterizerState* pState) noexcept
+{
+    if (Filter(rasterizerState, pState))
+    {
+        pContext->RSSetState(pState);
+    }
+}
+
+void PipelineStateCache::SetBlendState(ID3D11BlendState* pState, UINT sampleMask) noexcept
+{
+    if (Filter(blendState, WithRef<ID3D11BlendState>{ pState, sampleMask }))
+    {
+        pContext->OMSetBlendState(pState, nullptr, sampleMask);
+    }
+}
+
+void PipelineStateCache::SetDepthStencilState(ID3D11DepthStencilState* pState, UINT stencilRef) noexcept
+{
+    if (Filter(depthStencilState, WithRef<ID3D11DepthStencilState>{ pState, stencilRef }))
+    {
+        pContext->OMSetDepthStencilState(pState, stencilRef);
+    }
+}
+
+void PipelineStateCache::SetVertexConstantBuffer1(UINT slot, ID3D11Buffer* pBuffer, UINT firstConstant, UINT numConstants) noexcept
+{
+    assert(pContext1 != nullptr && "Offset constant buffer binding requires a D3D11.1 context");
+    if (Filter(vertexConstantBuffers, slot, ConstantBufferState{ pBuffer, firstConstant, numConstants }))
+    {
+        pContext1->VSSetConstantBuffers1(slot, 1u, &pBuffer, &firstConstant, &numConstants);
+    }
+}
+
+void PipelineStateCache::SetPixelConstantBuffer1(UINT slot, ID3D11Buffer* pBuffer, UINT firstConstant, UINT numConstants) noexcept
+{
+    assert(pContext1 != nullptr && "Offset constant buffer binding requires a D3D11.1 context");
+    if (Filter(pixelConstantBuffers, slot, ConstantBufferState{ pBuffer, firstConstant, numConstants }))
+    {
+        pContext1->PSSetConstantBuffers1(slot, 1u, &pBuffer, &firstConstant, &numConstants);
+    }
+}
+
+bool PipelineStateCache::FilterConstantBufferRange(ConstantBufferSlots& shadows, UINT startSlot, UINT count, ID3D11Buffer* const* ppBuffers) noexcept
+{
+    if (size_t(startSlot) + count > shadows.size())
+    {
+        current.issued++;
+        return true;
+    }
+    std::array<ConstantBufferState, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT> states;
+    for (UINT i = 0; i < count; i++)
+    {
+        states[i] = { ppBuffers[i], 0u, 0u };
+    }
+    return FilterRange(shadows, startSlot, count, states.data());
+}
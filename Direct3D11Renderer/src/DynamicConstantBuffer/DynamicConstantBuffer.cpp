@@ -1,10 +1,34 @@
 #include "DynamicConstantBuffer/DynamicConstantBuffer.h"
+#include "DynamicConstantBuffer/LayoutRegistry.h"
 #include <string>
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 
 namespace D3
 {
+    namespace
+    {
+        constexpr uint64_t FnvOffsetBasis = 14695981039346656037ull;
+        constexpr uint64_t FnvPrime = 1099511628211ull;
+
+        /// <summary>Mixes raw bytes into an FNV-1a hash</summary>
+        void HashBytes(uint64_t& hash, const void* bytes, size_t size) noexcept
+        {
+            const auto* p = static_cast<const unsigned char*>(bytes);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash = (hash ^ p[i]) * FnvPrime;
+            }
+        }
+
+        /// <summary>Mixes a 64-bit value into an FNV-1a hash</summary>
+        void HashValue(uint64_t& hash, uint64_t value) noexcept
+        {
+            HashBytes(hash, &value, sizeof(value));
+        }
+    }
+
     // =====================================================================================
     // TypeRegistry Implementation
     // =====================================================================================
@@ -85,7 +109,7 @@ namespace D3
     /// </summary>
     /// <param name="other">LayoutElement to copy from</param>
     LayoutElement::LayoutElement(const LayoutElement& other)
-        : type(other.type), offset(other.offset), members(other.members), arraySize(other.arraySize)
+        : type(other.type), offset(other.offset), hash(other.hash), members(other.members), arraySize(other.arraySize)
     {
         // Deep copy the array element type if it exists
         if (other.arrayElementType)
@@ -107,6 +131,7 @@ namespace D3
         {
             type = other.type;
             offset = other.offset;
+            hash = other.hash;
             members = other.members;  // vector assignment handles deep copy of members
             arraySize = other.arraySize;
 
@@ -204,6 +229,91 @@ namespace D3
         }
     }
 
+    /// <summary>
+    /// Gets the structural hash of this element. Finalized elements are immutable, so their
+    /// hash is computed once in Finalize and returned directly; builders are hashed on demand
+    /// without allocating.
+    /// </summary>
+    /// <returns>64-bit structural hash</returns>
+    uint64_t LayoutElement::GetHash() const noexcept
+    {
+        return offset.has_value() ? hash : ComputeHash();
+    }
+
+    /// <summary>
+    /// Hashes the element type and, for containers, the member names or array count together
+    /// with each child's hash. Composing child hashes (rather than re-walking the subtree)
+    /// lets finalized subtrees contribute their cached value. Names are prefixed by their
+    /// length so that adjacent names cannot alias (e.g. "ab"+"c" vs "a"+"bc").
+    /// </summary>
+    /// <returns>64-bit structural hash</returns>
+    uint64_t LayoutElement::ComputeHash() const noexcept
+    {
+        uint64_t h = FnvOffsetBasis;
+        HashValue(h, static_cast<uint64_t>(type));
+        switch (type)
+        {
+        case ElementType::Struct:
+            HashValue(h, members.size());
+            for (const auto& member : members)
+            {
+                HashValue(h, member.first.size());
+                HashBytes(h, member.first.data(), member.first.size());
+                HashValue(h, member.second.GetHash());
+            }
+            break;
+        case ElementType::Array:
+            HashValue(h, arraySize);
+            if (arrayElementType)
+            {
+                HashValue(h, arrayElementType->GetHash());
+            }
+            break;
+        default:
+            break;
+        }
+        return h;
+    }
+
+    /// <summary>
+    /// Recursively compares two layout trees. Used by LayoutCache to confirm that a hash
+    /// match really is the same layout before sharing it.
+    /// </summary>
+    /// <param name="other">Element to compare against</param>
+    /// <returns>True if types, member names and array counts all match</returns>
+    bool LayoutElement::IsSameStructure(const LayoutElement& other) const noexcept
+    {
+        if (type != other.type)
+        {
+            return false;
+        }
+        switch (type)
+        {
+        case ElementType::Struct:
+            if (members.size() != other.members.size())
+            {
+                return false;
+            }
+            for (size_t i = 0; i < members.size(); ++i)
+            {
+                if (members[i].first != other.members[i].first ||
+                    !members[i].second.IsSameStructure(other.members[i].second))
+                {
+                    return false;
+                }
+            }
+            return true;
+        case ElementType::Array:
+            if (arraySize != other.arraySize || !arrayElementType != !other.arrayElementType)
+            {
+                return false;
+            }
+            return !arrayElementType || arrayElementType->IsSameStructure(*other.arrayElementType);
+        default:
+            return true;
+        }
+    }
+
     /// <summary>
     /// Adds a new member to this struct element. The struct must be of type Struct,
     /// and the member name must be a valid C++ identifier and unique within the struct.
@@ -262,6 +372,28 @@ namespace D3
         return const_cast<LayoutElement&>(*this)[name];
     }
 
+    /// <summary>
+    /// Non-allocating member lookup by name. Unlike operator[], this does not assert on
+    /// non-struct elements so that path resolution can report failure through its result.
+    /// </summary>
+    /// <param name="name">Name of the member to find</param>
+    /// <returns>Pointer to the member element, or nullptr if not found</returns>
+    const LayoutElement* LayoutElement::FindMember(std::string_view name) const noexcept
+    {
+        if (type != ElementType::Struct)
+        {
+            return nullptr;
+        }
+        for (const auto& member : members)
+        {
+            if (member.first == name)
+            {
+                return &member.second;
+            }
+        }
+        return nullptr;
+    }
+
     /// <summary>
     /// Configures this element as an array with the specified element type and count.
     /// This element must be of type Array before calling this method.
@@ -340,6 +472,20 @@ namespace D3
     /// <param name="startOffset">Starting byte offset for this element</param>
     /// <returns>Next available offset after this element (for placing subsequent elements)</returns>
     size_t LayoutElement::Finalize(size_t startOffset)
+    {
+        // Children are finalized (and hashed) before their parent reads them below
+        const auto next = FinalizeOffsets(startOffset);
+        hash = ComputeHash();
+        return next;
+    }
+
+    /// <summary>
+    /// Dispatches offset calculation by element type. Split from Finalize so that the
+    /// structural hash can be cached after all offsets are known.
+    /// </summary>
+    /// <param name="startOffset">Starting byte offset for this element</param>
+    /// <returns>Next available offset after this element</returns>
+    size_t LayoutElement::FinalizeOffsets(size_t startOffset)
     {
         switch (type)
         {
@@ -367,6 +513,41 @@ namespace D3
         }
     }
 
+    /// <summary>
+    /// Rebuilds a finalized element from generated records (see LayoutRegistry). Children are
+    /// built first so the parent's hash can compose their cached hashes, as in Finalize.
+    /// </summary>
+    /// <param name="pRecord">Cursor at this element's record; advanced past its subtree</param>
+    /// <returns>Finalized element</returns>
+    LayoutElement LayoutElement::FromRecords(const LayoutRecord*& pRecord)
+    {
+        const auto& record = *pRecord++;
+        LayoutElement element(record.type);
+        element.offset = record.offset;
+        switch (record.type)
+        {
+        case ElementType::Struct:
+            assert(record.count > 0 && "Struct must have at least one member");
+            element.members.reserve(record.count);
+            for (uint32_t i = 0; i < record.count; i++)
+            {
+                const char* name = pRecord->name;
+                element.members.emplace_back(name, FromRecords(pRecord));
+            }
+            break;
+        case ElementType::Array:
+            assert(record.count > 0 && "Array count must be greater than 0");
+            element.arrayElementType = std::make_unique<LayoutElement>(FromRecords(pRecord));
+            element.arraySize = record.count;
+            break;
+        default:
+            assert(TypeRegistry::IsValidSystemType(record.type) && "Invalid element type in generated layout");
+            break;
+        }
+        element.hash = element.ComputeHash();
+        return element;
+    }
+
     /// <summary>
     /// Returns a static empty element used for error cases when member access fails.
     /// This element has type Empty and will return false for Exists() checks.
@@ -544,6 +725,16 @@ namespace D3
         return rootElement->GetSignature();
     }
 
+    /// <summary>
+    /// Gets the structural hash for this layout used in caching.
+    /// Delegates to the root element's GetHash() method.
+    /// </summary>
+    /// <returns>64-bit structural hash</returns>
+    uint64_t Layout::GetHash() const noexcept
+    {
+        return rootElement->GetHash();
+    }
+
     // =====================================================================================
     // LayoutBuilder Implementation
     // =====================================================================================
@@ -610,6 +801,94 @@ namespace D3
         return (*rootElement)[name];
     }
 
+    /// <summary>
+    /// Resolves a member path against this layout's root element.
+    /// </summary>
+    /// <param name="path">Member path to resolve</param>
+    /// <returns>Handle to the element, or an invalid handle if the path does not resolve</returns>
+    ElementHandle FinalizedLayout::Resolve(std::string_view path) const
+    {
+        return ElementHandle::Resolve(*rootElement, path);
+    }
+
+    // =====================================================================================
+    // ElementHandle Implementation
+    // =====================================================================================
+
+    /// <summary>
+    /// Walks a member path through the layout tree, accumulating array strides on the way.
+    /// Element offsets are absolute once finalized, so the final offset is the leaf's offset
+    /// plus the stride of every array index taken along the path.
+    /// </summary>
+    /// <param name="root">Finalized root element of the layout</param>
+    /// <param name="path">Member path such as "lights[3].color"</param>
+    /// <returns>Handle to the element, or an invalid handle if any segment fails to resolve</returns>
+    ElementHandle ElementHandle::Resolve(const LayoutElement& root, std::string_view path)
+    {
+        const LayoutElement* element = &root;
+        size_t arrayOffset = 0;
+        size_t pos = 0;
+
+        while (pos < path.size())
+        {
+            if (path[pos] == '[')
+            {
+                // Array index: "[n]"
+                const auto close = path.find(']', pos);
+                if (element->GetType() != ElementType::Array || close == std::string_view::npos)
+                {
+                    return {};
+                }
+                size_t index = 0;
+                const auto first = path.data() + pos + 1;
+                const auto last = path.data() + close;
+                const auto [ptr, ec] = std::from_chars(first, last, index);
+                if (ec != std::errc{} || ptr != last || first == last || index >= element->GetArraySize())
+                {
+                    return {};
+                }
+                const auto offsetData = element->CalculateArrayOffset(arrayOffset, index);
+                arrayOffset = offsetData.first;
+                element = offsetData.second;
+                pos = close + 1;
+            }
+            else
+            {
+                // Struct member: the first name starts the path, every later one follows a '.'
+                // (so "a[0]b" and ".a" are rejected rather than read as "a[0].b" and "a")
+                if ((pos == 0) == (path[pos] == '.'))
+                {
+                    return {};
+                }
+                if (path[pos] == '.')
+                {
+                    ++pos;
+                }
+                const auto end = path.find_first_of(".[", pos);
+                const auto name = path.substr(pos, end == std::string_view::npos ? std::string_view::npos : end - pos);
+                element = name.empty() ? nullptr : element->FindMember(name);
+                if (element == nullptr)
+                {
+                    return {};
+                }
+                pos = end == std::string_view::npos ? path.size() : end;
+            }
+        }
+
+        if (element == &root)
+        {
+            return {};
+        }
+
+        ElementHandle handle;
+        handle.offset = static_cast<uint32_t>(arrayOffset + element->GetOffset());
+        handle.type = element->GetType();
+#ifndef NDEBUG
+        handle.root = &root;
+#endif
+        return handle;
+    }
+
     // =====================================================================================
     // ConstantBufferData Implementation
     // =====================================================================================
@@ -639,7 +918,8 @@ namespace D3
     /// </summary>
     /// <param name="other">ConstantBufferData to copy from</param>
     ConstantBufferData::ConstantBufferData(const ConstantBufferData& other)
-        : rootLayout(other.rootLayout), data(other.data)  // Layout shared, data copied
+        : rootLayout(other.rootLayout), data(other.data),  // Layout shared, data copied
+          dirtyBegin(other.dirtyBegin), dirtyEnd(other.dirtyEnd)
     {}
 
     /// <summary>
@@ -648,7 +928,8 @@ namespace D3
     /// </summary>
     /// <param name="other">ConstantBufferData to move from</param>
     ConstantBufferData::ConstantBufferData(ConstantBufferData&& other) noexcept
-        : rootLayout(std::move(other.rootLayout)), data(std::move(other.data))
+        : rootLayout(std::move(other.rootLayout)), data(std::move(other.data)),
+          dirtyBegin(other.dirtyBegin), dirtyEnd(other.dirtyEnd)
     {}
 
     /// <summary>
@@ -659,7 +940,7 @@ namespace D3
     /// <returns>Mutable proxy object for type-safe data access</returns>
     ConstantBufferDataRef ConstantBufferData::operator[](const std::string& name)
     {
-        return { &(*rootLayout)[name], data.data(), 0u };
+        return { &(*rootLayout)[name], data.data(), 0u, this };
     }
 
     /// <summary>
@@ -673,6 +954,16 @@ namespace D3
         return { &(*rootLayout)[name], data.data(), 0u };
     }
 
+    /// <summary>
+    /// Resolves a member path against the layout this buffer was created with.
+    /// </summary>
+    /// <param name="path">Member path to resolve</param>
+    /// <returns>Handle to the element, or an invalid handle if the path does not resolve</returns>
+    ElementHandle ConstantBufferData::Resolve(std::string_view path) const
+    {
+        return ElementHandle::Resolve(*rootLayout, path);
+    }
+
     /// <summary>
     /// Copies data from another ConstantBufferData instance. Both instances must
     /// use the exact same layout (verified by pointer comparison) to ensure
@@ -682,7 +973,34 @@ namespace D3
     void ConstantBufferData::CopyFrom(const ConstantBufferData& other)
     {
         assert(rootLayout.get() == other.rootLayout.get() && "Cannot copy between different layouts");
-        std::copy(other.data.begin(), other.data.end(), data.begin());
+
+        // Only the span between the first and last differing byte is marked dirty, so copying
+        // identical contents (e.g. an editor re-applying the same values every frame) stays clean
+        const auto mismatch = std::mismatch(data.begin(), data.end(), other.data.begin());
+        if (mismatch.first == data.end())
+        {
+            return;
+        }
+        const auto first = static_cast<size_t>(mismatch.first - data.begin());
+        size_t last = data.size();
+        while (last > first && data[last - 1u] == other.data[last - 1u])
+        {
+            --last;
+        }
+        std::copy(other.data.begin() + first, other.data.begin() + last, data.begin() + first);
+        MarkDirty(first, last - first);
+    }
+
+    /// <summary>
+    /// Hashes the current data bytes with FNV-1a. Constant buffers are small (a few hundred
+    /// bytes at most), so hashing the whole buffer is cheaper than the Map/Unmap it can avoid.
+    /// </summary>
+    /// <returns>64-bit content hash</returns>
+    uint64_t ConstantBufferData::GetContentHash() const noexcept
+    {
+        uint64_t hash = FnvOffsetBasis;
+        HashBytes(hash, data.data(), data.size());
+        return hash;
     }
 
     // =====================================================================================
@@ -744,8 +1062,9 @@ namespace D3
     /// <param name="element">Pointer to the LayoutElement being referenced</param>
     /// <param name="dataPtr">Pointer to the start of the mutable data buffer</param>
     /// <param name="offset">Current offset within the data buffer</param>
-    ConstantBufferDataRef::ConstantBufferDataRef(const LayoutElement* element, char* dataPtr, size_t offset)
-        : element(element), dataPtr(dataPtr), currentOffset(offset)
+    /// <param name="pOwner">Buffer whose dirty range is widened on mutable access</param>
+    ConstantBufferDataRef::ConstantBufferDataRef(const LayoutElement* element, char* dataPtr, size_t offset, ConstantBufferData* pOwner)
+        : element(element), dataPtr(dataPtr), currentOffset(offset), pOwner(pOwner)
     {}
 
     /// <summary>
@@ -777,7 +1096,7 @@ namespace D3
     /// <returns>Mutable reference proxy to the member</returns>
     ConstantBufferDataRef ConstantBufferDataRef::operator[](const std::string& name) const
     {
-        return { &(*element)[name], dataPtr, currentOffset };
+        return { &(*element)[name], dataPtr, currentOffset, pOwner };
     }
 
     /// <summary>
@@ -789,6 +1108,6 @@ namespace D3
     ConstantBufferDataRef ConstantBufferDataRef::operator[](size_t index) const
     {
         const auto offsetData = element->CalculateArrayOffset(currentOffset, index);
-        return { offsetData.second, dataPtr, offsetData.first };
+        return { offsetData.second, dataPtr, offsetData.first, pOwner };
     }
 }
\ No newline at end of file
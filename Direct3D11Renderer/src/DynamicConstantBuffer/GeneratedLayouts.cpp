@@ -0,0 +1,138 @@
+// Generated by tools/generate_cbuffer_layouts.py from shaders/*.hlsl - do not edit.
+// Rerun the generator (also done by the pre-build step) after changing a cbuffer.
+
+#include "DynamicConstantBuffer/LayoutRegistry.h"
+
+namespace D3
+{
+    namespace GeneratedLayouts
+    {
+        // Pre-order element records: Struct count = member count, Array count = element count
+        const LayoutRecord records[] = {
+            // [0] TransformMatrices (128 bytes)
+            { ElementType::Struct, "", 0u, 2u },
+            { ElementType::Matrix4x4, "modelViewMatrix", 0u, 0u },
+            { ElementType::Matrix4x4, "modelViewProjMatrix", 64u, 0u },
+            // [3] PointLightProperties (64 bytes)
+            { ElementType::Struct, "", 0u, 7u },
+            { ElementType::Float3, "lightPositionViewSpace", 0u, 0u },
+            { ElementType::Float3, "ambientLightColor", 16u, 0u },
+            { ElementType::Float3, "diffuseLightColor", 32u, 0u },
+            { ElementType::Float, "diffuseLightIntensity", 44u, 0u },
+            { ElementType::Float, "attenuationConstant", 48u, 0u },
+            { ElementType::Float, "attenuationLinear", 52u, 0u },
+            { ElementType::Float, "attenuationQuadratic", 56u, 0u },
+            // [11] MaterialProperties (16 bytes)
+            { ElementType::Struct, "", 0u, 3u },
+            { ElementType::Float, "specularReflectance", 0u, 0u },
+            { ElementType::Float, "specularShininess", 4u, 0u },
+            { ElementType::Float2, "materialPadding", 8u, 0u },
+            // [15] VertexQuantization (32 bytes)
+            { ElementType::Struct, "", 0u, 2u },
+            { ElementType::Float3, "positionMin", 0u, 0u },
+            { ElementType::Float3, "positionExtent", 16u, 0u },
+            // [18] NormalMappedMaterialProperties (16 bytes)
+            { ElementType::Struct, "", 0u, 4u },
+            { ElementType::Float, "specularReflectance", 0u, 0u },
+            { ElementType::Float, "specularShininess", 4u, 0u },
+            { ElementType::Bool, "normalMappingEnabled", 8u, 0u },
+            { ElementType::Float, "materialPadding", 12u, 0u },
+            // [23] SolidMaterialProperties (32 bytes)
+            { ElementType::Struct, "", 0u, 4u },
+            { ElementType::Float4, "materialDiffuseColor", 0u, 0u },
+            { ElementType::Float, "specularReflectance", 16u, 0u },
+            { ElementType::Float, "specularShininess", 20u, 0u },
+            { ElementType::Float, "materialPadding", 24u, 0u },
+            // [28] SpecularNormalMappedMaterialProperties (16 bytes)
+            { ElementType::Struct, "", 0u, 4u },
+            { ElementType::Bool, "hasGlossInAlphaChannel", 0u, 0u },
+            { ElementType::Bool, "normalMappingEnabled", 4u, 0u },
+            { ElementType::Float, "baseSpecularShininess", 8u, 0u },
+            { ElementType::Float, "materialPadding", 12u, 0u },
+            // [33] OutlineBlur (16 bytes)
+            { ElementType::Struct, "", 0u, 3u },
+            { ElementType::Float2, "direction", 0u, 0u },
+            { ElementType::Float, "composite", 8u, 0u },
+            { ElementType::Float, "blurPadding", 12u, 0u },
+            // [37] OutlineProperties (32 bytes)
+            { ElementType::Struct, "", 0u, 3u },
+            { ElementType::Float4, "outlineColor", 0u, 0u },
+            { ElementType::Float, "outlineScale", 16u, 0u },
+            { ElementType::Float3, "outlinePadding", 20u, 0u },
+            // [41] MaterialProperties (32 bytes)
+            { ElementType::Struct, "", 0u, 5u },
+            { ElementType::Float3, "specularColor", 0u, 0u },
+            { ElementType::Float, "specularWeight", 12u, 0u },
+            { ElementType::Float, "specularGloss", 16u, 0u },
+            { ElementType::Bool, "useNormalMap", 20u, 0u },
+            { ElementType::Float, "normalMapWeight", 24u, 0u },
+            // [47] LightIndicatorProperties (16 bytes)
+            { ElementType::Struct, "", 0u, 1u },
+            { ElementType::Float4, "lightIndicatorColor", 0u, 0u },
+            // [49] SolidColorMaterial (16 bytes)
+            { ElementType::Struct, "", 0u, 1u },
+            { ElementType::Float4, "color", 0u, 0u },
+        };
+
+        const GeneratedLayout layouts[] = {
+            { "BlinnPhong_Diffuse_Instanced_VS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_Diffuse_Instanced_VS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_Diffuse_PS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_Diffuse_PS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_Diffuse_PS", "MaterialProperties", 1, 16u, 11u },
+            { "BlinnPhong_Diffuse_Quantized_VS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_Diffuse_Quantized_VS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_Diffuse_Quantized_VS", "VertexQuantization", 1, 32u, 15u },
+            { "BlinnPhong_Diffuse_VS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_Diffuse_VS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_NormalMapped_Instanced_VS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_NormalMapped_Instanced_VS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_NormalMapped_PS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_NormalMapped_PS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_NormalMapped_PS", "NormalMappedMaterialProperties", 1, 16u, 18u },
+            { "BlinnPhong_NormalMapped_Quantized_VS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_NormalMapped_Quantized_VS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_NormalMapped_Quantized_VS", "VertexQuantization", 1, 32u, 15u },
+            { "BlinnPhong_NormalMapped_VS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_NormalMapped_VS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_Solid_Instanced_VS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_Solid_Instanced_VS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_Solid_PS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_Solid_PS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_Solid_PS", "SolidMaterialProperties", 1, 32u, 23u },
+            { "BlinnPhong_Solid_Quantized_VS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_Solid_Quantized_VS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_Solid_Quantized_VS", "VertexQuantization", 1, 32u, 15u },
+            { "BlinnPhong_Solid_VS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_Solid_VS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_SpecularNormalMapMasked_PS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_SpecularNormalMapMasked_PS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_SpecularNormalMapMasked_PS", "SpecularNormalMappedMaterialProperties", 1, 16u, 28u },
+            { "BlinnPhong_SpecularNormalMapped_PS", "TransformMatrices", 0, 128u, 0u },
+            { "BlinnPhong_SpecularNormalMapped_PS", "PointLightProperties", 0, 64u, 3u },
+            { "BlinnPhong_SpecularNormalMapped_PS", "SpecularNormalMappedMaterialProperties", 1, 16u, 28u },
+            { "OutlineBlur_PS", "OutlineBlur", 0, 16u, 33u },
+            { "Outline_PS", "OutlineProperties", 1, 32u, 37u },
+            { "Outline_VS", "TransformMatrices", 0, 128u, 0u },
+            { "Outline_VS", "PointLightProperties", 0, 64u, 3u },
+            { "Outline_VS", "OutlineProperties", 1, 32u, 37u },
+            { "PhongDiffNrmPS", "TransformMatrices", 0, 128u, 0u },
+            { "PhongDiffNrmPS", "PointLightProperties", 0, 64u, 3u },
+            { "PhongDiffNrmPS", "MaterialProperties", 1, 32u, 41u },
+            { "PhongDiffNrmVS", "TransformMatrices", 0, 128u, 0u },
+            { "PhongDiffNrmVS", "PointLightProperties", 0, 64u, 3u },
+            { "PointLightIndicator_PS", "TransformMatrices", 0, 128u, 0u },
+            { "PointLightIndicator_PS", "PointLightProperties", 0, 64u, 3u },
+            { "PointLightIndicator_PS", "LightIndicatorProperties", 1, 16u, 47u },
+            { "PointLightIndicator_VS", "TransformMatrices", 0, 128u, 0u },
+            { "PointLightIndicator_VS", "PointLightProperties", 0, 64u, 3u },
+            { "SolidColor_Instanced_VS", "TransformMatrices", 0, 128u, 0u },
+            { "SolidColor_Instanced_VS", "PointLightProperties", 0, 64u, 3u },
+            { "SolidColor_PS", "SolidColorMaterial", 1, 16u, 49u },
+            { "SolidColor_VS", "TransformMatrices", 0, 128u, 0u },
+            { "SolidColor_VS", "PointLightProperties", 0, 64u, 3u },
+        };
+
+        const size_t layoutCount = sizeof(layouts) / sizeof(layouts[0]);
+    }
+}
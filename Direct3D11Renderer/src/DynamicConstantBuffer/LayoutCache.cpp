@@ -1,4 +1,5 @@
 #include "DynamicConstantBuffer/LayoutCache.h"
+#include <mutex>
 
 namespace D3
 {
@@ -6,10 +7,11 @@ namespace D3
     /// Resolves a LayoutBuilder into a FinalizedLayout using caching for performance optimization.
     ///
     /// Algorithm:
-    /// 1. Generate a signature string from the current builder state
-    /// 2. Check if a layout with this signature already exists in the cache
+    /// 1. Compute the structural hash of the current builder state (no allocations)
+    /// 2. Under a shared lock, look for a layout with this hash and identical structure
     /// 3. If found: reset the builder and return the cached layout
-    /// 4. If not found: extract and finalize the layout from the builder, cache it, then return it
+    /// 4. If not found: extract and finalize the layout outside the lock, then insert it under
+    ///    an exclusive lock unless another thread inserted the same layout first
     ///
     /// This approach ensures that identical layouts (same structure, member names, and types)
     /// are shared across multiple ConstantBufferData instances, reducing memory usage and
@@ -19,24 +21,75 @@ namespace D3
     /// <returns>FinalizedLayout ready for use in creating ConstantBufferData</returns>
     FinalizedLayout LayoutCache::Resolve(LayoutBuilder&& builder)
     {
-        // Generate signature before extracting to avoid modifying the builder
-        auto signature = builder.GetSignature();
+        const auto key = builder.GetHash();
         auto& instance = GetInstance();
 
-        // Check if we already have a layout with this signature
-        auto it = instance.layoutCache.find(signature);
-        if (it != instance.layoutCache.end())
         {
-            // Cache hit: layout already exists, clear the builder and return cached layout
-            builder.Reset();
-            return FinalizedLayout(it->second);
+            std::shared_lock lock(instance.mutex);
+            auto it = instance.layoutCache.find(key);
+            if (it != instance.layoutCache.end())
+            {
+                if (auto cached = Find(it->second, *builder.rootElement))
+                {
+                    // Cache hit: layout already exists, clear the builder and return cached layout
+                    builder.Reset();
+                    return FinalizedLayout(std::move(cached));
+                }
+            }
         }
 
-        // Cache miss: extract and finalize the new layout, then cache it
+        // Cache miss: extract and finalize the new layout without holding the lock
         auto layoutRoot = builder.ExtractRoot();  // This finalizes the layout and resets the builder
-        auto result = instance.layoutCache.emplace(std::move(signature), layoutRoot);
 
-        return FinalizedLayout(result.first->second);
+        std::unique_lock lock(instance.mutex);
+        auto& bucket = instance.layoutCache[key];
+        if (auto cached = Find(bucket, *layoutRoot))
+        {
+            // Another thread resolved the same layout while we were finalizing
+            return FinalizedLayout(std::move(cached));
+        }
+        bucket.push_back(layoutRoot);
+        return FinalizedLayout(std::move(layoutRoot));
+    }
+
+    /// <summary>
+    /// Inserts a layout that is already finalized, e.g. one rebuilt from the generated layout
+    /// registry. Structurally identical layouts resolved earlier are shared instead.
+    /// </summary>
+    /// <param name="root">Finalized root element</param>
+    /// <returns>FinalizedLayout for the cached root</returns>
+    FinalizedLayout LayoutCache::Register(std::shared_ptr<LayoutElement> root)
+    {
+        const auto key = root->GetHash();
+        auto& instance = GetInstance();
+
+        std::unique_lock lock(instance.mutex);
+        auto& bucket = instance.layoutCache[key];
+        if (auto cached = Find(bucket, *root))
+        {
+            return FinalizedLayout(std::move(cached));
+        }
+        bucket.push_back(root);
+        return FinalizedLayout(std::move(root));
+    }
+
+    /// <summary>
+    /// Searches a hash bucket for a structurally identical layout. Buckets only hold more
+    /// than one entry on a genuine 64-bit hash collision.
+    /// </summary>
+    /// <param name="bucket">Bucket to search</param>
+    /// <param name="element">Element to compare against</param>
+    /// <returns>Matching finalized layout, or nullptr if none matches</returns>
+    std::shared_ptr<LayoutElement> LayoutCache::Find(const Bucket& bucket, const LayoutElement& element)
+    {
+        for (const auto& candidate : bucket)
+        {
+            if (candidate->IsSameStructure(element))
+            {
+                return candidate;
+            }
+        }
+        return nullptr;
     }
 
     /// <summary>
@@ -55,4 +108,4 @@ namespace D3
         static LayoutCache instance;
         return instance;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,107 @@
+#include "DynamicConstantBuffer/LayoutRegistry.h"
+#include "DynamicConstantBuffer/LayoutCache.h"
+#include <unordered_map>
+
+namespace D3
+{
+    /// <summary>
+    /// Forces the registry to be built. Called once at startup so the first material or
+    /// renderable that looks up a layout does not pay for building all of them.
+    /// </summary>
+    void LayoutRegistry::Load()
+    {
+        GetInstance();
+    }
+
+    /// <summary>
+    /// Finds a generated layout by shader and cbuffer name.
+    /// </summary>
+    /// <param name="shader">Shader name without extension</param>
+    /// <param name="cbuffer">cbuffer name in HLSL</param>
+    /// <returns>Layout, or nullptr if not declared by the shader</returns>
+    const FinalizedLayout* LayoutRegistry::Find(std::string_view shader, std::string_view cbuffer)
+    {
+        for (const auto& entry : GetInstance().entries)
+        {
+            if (entry.pSource->shader == shader && entry.pSource->cbuffer == cbuffer)
+            {
+                return &entry.layout;
+            }
+        }
+        return nullptr;
+    }
+
+    /// <summary>
+    /// Finds a generated layout by shader and register slot.
+    /// </summary>
+    /// <param name="shader">Shader name without extension</param>
+    /// <param name="slot">Register number of the cbuffer</param>
+    /// <returns>Layout, or nullptr if the shader has no cbuffer at that slot</returns>
+    const FinalizedLayout* LayoutRegistry::Find(std::string_view shader, uint32_t slot)
+    {
+        for (const auto& entry : GetInstance().entries)
+        {
+            if (entry.pSource->shader == shader && entry.pSource->slot == static_cast<int32_t>(slot))
+            {
+                return &entry.layout;
+            }
+        }
+        return nullptr;
+    }
+
+    /// <summary>
+    /// Gets a generated layout by shader and cbuffer name. Asserts if missing, which means the
+    /// shader changed without the C++ code being updated (or the generator was not rerun).
+    /// </summary>
+    const FinalizedLayout& LayoutRegistry::Get(std::string_view shader, std::string_view cbuffer)
+    {
+        const auto* pLayout = Find(shader, cbuffer);
+        assert(pLayout != nullptr && "Shader does not declare this cbuffer; rerun generate_cbuffer_layouts.py");
+        return *pLayout;
+    }
+
+    /// <summary>
+    /// Gets a generated layout by shader and register slot. Asserts if missing.
+    /// </summary>
+    const FinalizedLayout& LayoutRegistry::Get(std::string_view shader, uint32_t slot)
+    {
+        const auto* pLayout = Find(shader, slot);
+        assert(pLayout != nullptr && "Shader has no cbuffer at this slot; rerun generate_cbuffer_layouts.py");
+        return *pLayout;
+    }
+
+    /// <summary>
+    /// Builds one finalized layout per distinct record table (shared includes such as
+    /// TransformMatrices appear in most shaders but are built once) and registers each with
+    /// the LayoutCache, so layouts resolved from identical LayoutBuilders share the same root.
+    /// </summary>
+    LayoutRegistry::LayoutRegistry()
+    {
+        std::unordered_map<uint32_t, FinalizedLayout> built;
+        entries.reserve(GeneratedLayouts::layoutCount);
+        for (size_t i = 0; i < GeneratedLayouts::layoutCount; i++)
+        {
+            const auto& source = GeneratedLayouts::layouts[i];
+            auto it = built.find(source.firstRecord);
+            if (it == built.end())
+            {
+                const LayoutRecord* pRecord = &GeneratedLayouts::records[source.firstRecord];
+                auto root = std::make_shared<LayoutElement>(LayoutElement::FromRecords(pRecord));
+                assert(root->GetSize() == source.size && "Generated layout size does not match its records");
+                it = built.emplace(source.firstRecord, LayoutCache::Register(std::move(root))).first;
+            }
+            entries.push_back({ &source, it->second });
+        }
+    }
+
+    /// <summary>
+    /// Provides the singleton registry. Static local initialization is thread-safe, and the
+    /// registry is never modified after construction.
+    /// </summary>
+    /// <returns>Reference to the registry</returns>
+    const LayoutRegistry& LayoutRegistry::GetInstance()
+    {
+        static const LayoutRegistry instance;
+        return instance;
+    }
+}
@@ -7,6 +7,14 @@ BindableLookupException::BindableLookupException(int line, const char* file, con
     bindable_id = id;
 }
 
+BindableLookupException::BindableLookupException(int line, const char* file, const char* type, const std::string& id,
+    const char* cachedType, const std::string& cachedId)
+    : BindableLookupException(line, file, type, id)
+{
+    cached_type_name = cachedType;
+    cached_bindable_id = cachedId;
+}
+
 const char* BindableLookupException::GetType() const noexcept
 {
     return "Bindable Lookup Exception";
@@ -17,9 +25,18 @@ const char* BindableLookupException::what() const noexcept
     std::ostringstream oss;
     oss << GetType() << std::endl
         << "[Type] " << type_name << std::endl
-        << "[ID] " << bindable_id << std::endl
-        << "[Error] Failed to find bindable in cache" << std::endl
-        << GetOriginString();
+        << "[ID] " << bindable_id << std::endl;
+    if (cached_type_name.empty())
+    {
+        oss << "[Error] Failed to find bindable in cache" << std::endl;
+    }
+    else
+    {
+        oss << "[Cached Type] " << cached_type_name << std::endl
+            << "[Cached ID] " << cached_bindable_id << std::endl
+            << "[Error] Cache key collision" << std::endl;
+    }
+    oss << GetOriginString();
     whatBuffer = oss.str();
     return whatBuffer.c_str();
 }
@@ -0,0 +1,503 @@
+#include "Geometry/MeshOptimizer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+
+using namespace DirectX;
+
+namespace
+{
+	// resolution of the axis views overdraw is measured in
+	constexpr int OverdrawGridSize = 256;
+
+	// FIFO post-transform cache. A vertex is cached while fewer than size misses happened since it
+	// was inserted, so lookups are one comparison and flushing is just advancing the clock.
+	class FifoCache
+	{
+	public:
+		FifoCache(size_t vertexCount, unsigned int size)
+			: inserted(vertexCount, 0u), size(size)
+		{}
+		// returns true if the vertex had to be transformed
+		bool Access(unsigned int vertex) noexcept
+		{
+			if (inserted[vertex] != 0u && clock - inserted[vertex] < size)
+			{
+				return false;
+			}
+			inserted[vertex] = ++clock;
+			return true;
+		}
+		// evicts everything, as if the draw started here
+		void Flush() noexcept
+		{
+			clock += size;
+		}
+	private:
+		std::vector<size_t> inserted;
+		size_t clock = 0u;
+		size_t size;
+	};
+
+	size_t CountVertices(const std::vector<unsigned int>& indices) noexcept
+	{
+		return indices.empty() ? 0u : size_t(*std::max_element(indices.begin(), indices.end())) + 1u;
+	}
+
+	XMVECTOR LoadCorner(const std::vector<XMFLOAT3>& positions, const std::vector<unsigned int>& indices, size_t triangle, size_t corner) noexcept
+	{
+		return XMLoadFloat3(&positions[indices[triangle * 3u + corner]]);
+	}
+
+	// front faces are clockwise (cross(b - a, c - a) points out of the mesh), length is twice the area
+	XMVECTOR FaceNormal(XMVECTOR a, XMVECTOR b, XMVECTOR c) noexcept
+	{
+		return XMVector3Cross(XMVectorSubtract(b, a), XMVectorSubtract(c, a));
+	}
+
+	// Rasterizes the triangles in order from the six axis directions with back face culling and a
+	// depth test, and returns pixels shaded over pixels covered
+	float MeasureOverdraw(const std::vector<unsigned int>& indices, const std::vector<XMFLOAT3>& positions)
+	{
+		auto min = XMVectorReplicate(std::numeric_limits<float>::max());
+		auto max = XMVectorReplicate(-std::numeric_limits<float>::max());
+		for (const auto index : indices)
+		{
+			const auto p = XMLoadFloat3(&positions[index]);
+			min = XMVectorMin(min, p);
+			max = XMVectorMax(max, p);
+		}
+		XMFLOAT3 extent;
+		XMStoreFloat3(&extent, XMVectorSubtract(max, min));
+		const float scale = std::max({ extent.x, extent.y, extent.z });
+		if (scale <= 0.0f)
+		{
+			return 0.0f;
+		}
+
+		// positions normalized into the unit cube
+		std::vector<XMFLOAT3> unit(positions.size());
+		for (const auto index : indices)
+		{
+			XMStoreFloat3(&unit[index], XMVectorScale(XMVectorSubtract(XMLoadFloat3(&positions[index]), min), 1.0f / scale));
+		}
+
+		std::vector<float> depth(size_t(OverdrawGridSize) * OverdrawGridSize);
+		size_t shaded = 0u;
+		size_t covered = 0u;
+		for (int forward = 0; forward < 3; forward++)
+		{
+			// right x up = forward, so clockwise triangles stay clockwise on screen
+			const int right = (forward + 1) % 3;
+			const int up = (forward + 2) % 3;
+			for (const float direction : { 1.0f, -1.0f })
+			{
+				std::fill(depth.begin(), depth.end(), std::numeric_limits<float>::max());
+				const auto project = [&](unsigned int index)
+				{
+					const float* p = &unit[index].x;
+					const float u = direction > 0.0f ? p[right] : 1.0f - p[right];
+					const float z = direction > 0.0f ? p[forward] : 1.0f - p[forward];
+					return XMFLOAT3{ u * OverdrawGridSize, p[up] * OverdrawGridSize, z };
+				};
+				for (size_t i = 0; i < indices.size(); i += 3u)
+				{
+					const auto a = project(indices[i]);
+					const auto b = project(indices[i + 1u]);
+					const auto c = project(indices[i + 2u]);
+					const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+					if (area >= 0.0f)
+					{
+						continue;
+					}
+					const int x0 = std::max(int(std::floor(std::min({ a.x, b.x, c.x }))), 0);
+					const int x1 = std::min(int(std::ceil(std::max({ a.x, b.x, c.x }))), OverdrawGridSize - 1);
+					const int y0 = std::max(int(std::floor(std::min({ a.y, b.y, c.y }))), 0);
+					const int y1 = std::min(int(std::ceil(std::max({ a.y, b.y, c.y }))), OverdrawGridSize - 1);
+					const auto edge = [](const XMFLOAT3& from, const XMFLOAT3& to, float x, float y)
+					{
+						return (to.x - from.x) * (y - from.y) - (to.y - from.y) * (x - from.x);
+					};
+					for (int y = y0; y <= y1; y++)
+					{
+						for (int x = x0; x <= x1; x++)
+						{
+							const float px = float(x) + 0.5f;
+							const float py = float(y) + 0.5f;
+							const float w0 = edge(b, c, px, py);
+							const float w1 = edge(c, a, px, py);
+							const float w2 = edge(a, b, px, py);
+							// area is negative, so inside means every edge function is <= 0
+							if (w0 > 0.0f || w1 > 0.0f || w2 > 0.0f)
+							{
+								continue;
+							}
+							const float z = (w0 * a.z + w1 * b.z + w2 * c.z) / area;
+							auto& stored = depth[size_t(y) * OverdrawGridSize + x];
+							if (z < stored)
+							{
+								stored = z;
+								shaded++;
+							}
+						}
+					}
+				}
+				covered += size_t(std::count_if(depth.begin(), depth.end(),
+					[](float d) { return d != std::numeric_limits<float>::max(); }));
+			}
+		}
+		return covered == 0u ? 0.0f : float(shaded) / float(covered);
+	}
+}
+
+namespace D3
+{
+	namespace MeshOptimizer
+	{
+		Report Optimize(VertexBuffer& vertices, std::vector<unsigned int>& indices, const Settings& settings)
+		{
+			assert(indices.size() % 3u == 0u && "Mesh indices must form a triangle list");
+			Report report;
+			if (indices.empty())
+			{
+				return report;
+			}
+			const auto positions = ExtractPositions(vertices);
+			if (settings.measureMetrics)
+			{
+				report.before = Analyze(indices, positions, settings.cacheSize);
+			}
+
+			report.weldedVertices = WeldVertices(vertices, indices);
+			std::vector<size_t> clusters;
+			indices = OptimizeVertexCache(indices, vertices.Size(), settings.cacheSize, &clusters);
+			indices = OptimizeOverdraw(indices, positions, clusters, settings.cacheSize, settings.overdrawThreshold, &report.clusterCount);
+			vertices.Remap(OptimizeVertexFetch(indices, vertices.Size()));
+
+			if (settings.measureMetrics)
+			{
+				report.after = Analyze(indices, ExtractPositions(vertices), settings.cacheSize);
+			}
+			return report;
+		}
+
+		size_t WeldVertices(const VertexBuffer& vertices, std::vector<unsigned int>& indices)
+		{
+			const size_t stride = vertices.GetLayout().Size();
+			const char* pData = vertices.GetData();
+			std::unordered_map<std::string_view, unsigned int> firstCopies;
+			firstCopies.reserve(vertices.Size());
+			std::vector<unsigned int> remap(vertices.Size());
+			for (unsigned int i = 0; i < remap.size(); i++)
+			{
+				remap[i] = firstCopies.emplace(std::string_view(pData + stride * i, stride), i).first->second;
+			}
+			for (auto& index : indices)
+			{
+				index = remap[index];
+			}
+			return vertices.Size() - firstCopies.size();
+		}
+
+		std::vector<unsigned int> OptimizeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount,
+			unsigned int cacheSize, std::vector<size_t>* pClusters)
+		{
+			assert(CountVertices(indices) <= vertexCount && "Index out of range");
+			if (pClusters)
+			{
+				pClusters->clear();
+			}
+
+			// triangles using each vertex, and how many of them are still to be emitted
+			std::vector<unsigned int> live(vertexCount, 0u);
+			for (const auto index : indices)
+			{
+				live[index]++;
+			}
+			std::vector<size_t> adjacencyOffsets(vertexCount + 1u, 0u);
+			std::partial_sum(live.begin(), live.end(), adjacencyOffsets.begin() + 1);
+			std::vector<unsigned int> adjacency(indices.size());
+			{
+				auto cursor = adjacencyOffsets;
+				for (size_t i = 0; i < indices.size(); i++)
+				{
+					adjacency[cursor[indices[i]]++] = static_cast<unsigned int>(i / 3u);
+				}
+			}
+
+			std::vector<unsigned int> cacheTime(vertexCount, 0u);
+			std::vector<bool> emitted(indices.size() / 3u, false);
+			std::vector<unsigned int> deadEnds;
+			std::vector<unsigned int> candidates;
+			std::vector<unsigned int> result;
+			result.reserve(indices.size());
+			unsigned int time = cacheSize + 1u;
+			size_t scanCursor = 0u;
+
+			// recently used vertices with triangles left, then any vertex with triangles left
+			const auto skipDeadEnd = [&]() -> long long
+			{
+				while (!deadEnds.empty())
+				{
+					const auto vertex = deadEnds.back();
+					deadEnds.pop_back();
+					if (live[vertex] > 0u)
+					{
+						return vertex;
+					}
+				}
+				for (; scanCursor < vertexCount; scanCursor++)
+				{
+					if (live[scanCursor] > 0u)
+					{
+						return (long long)scanCursor;
+					}
+				}
+				return -1;
+			};
+
+			long long fan = skipDeadEnd();
+			bool newCluster = true;
+			while (fan >= 0)
+			{
+				// emit every remaining triangle around the fanning vertex
+				candidates.clear();
+				for (size_t k = adjacencyOffsets[fan]; k < adjacencyOffsets[fan + 1]; k++)
+				{
+					const auto triangle = adjacency[k];
+					if (emitted[triangle])
+					{
+						continue;
+					}
+					if (newCluster && pClusters)
+					{
+						pClusters->push_back(result.size() / 3u);
+					}
+					newCluster = false;
+					for (size_t corner = 0; corner < 3u; corner++)
+					{
+						const auto vertex = indices[triangle * 3u + corner];
+						result.push_back(vertex);
+						deadEnds.push_back(vertex);
+						candidates.push_back(vertex);
+						live[vertex]--;
+						if (time - cacheTime[vertex] > cacheSize)
+						{
+							cacheTime[vertex] = time++;
+						}
+					}
+					emitted[triangle] = true;
+				}
+				// continue from the candidate that has been cached longest and will still be cached
+				// after its remaining triangles are emitted
+				long long next = -1;
+				long long bestPriority = -1;
+				for (const auto vertex : candidates)
+				{
+					if (live[vertex] == 0u)
+					{
+						continue;
+					}
+					long long priority = 0;
+					if (time - cacheTime[vertex] + 2u * live[vertex] <= cacheSize)
+					{
+						priority = time - cacheTime[vertex];
+					}
+					if (priority > bestPriority)
+					{
+						bestPriority = priority;
+						next = vertex;
+					}
+				}
+				// a dead end breaks locality, which is where overdraw clusters can be cut for free
+				newCluster = next < 0;
+				fan = next >= 0 ? next : skipDeadEnd();
+			}
+			return result;
+		}
+
+		std::vector<unsigned int> OptimizeOverdraw(const std::vector<unsigned int>& indices, const std::vector<XMFLOAT3>& positions,
+			const std::vector<size_t>& clusters, unsigned int cacheSize, float threshold, size_t* pClusterCount)
+		{
+			const size_t triangleCount = indices.size() / 3u;
+			if (triangleCount == 0u || clusters.empty())
+			{
+				if (pClusterCount)
+				{
+					*pClusterCount = 0u;
+				}
+				return indices;
+			}
+			assert(clusters.front() == 0u && "Clusters must start at the first triangle");
+
+			// split the hard clusters wherever a cold-started prefix is already within threshold of
+			// the whole mesh's cache efficiency, so reordering them costs little ACMR
+			FifoCache cache(positions.size(), cacheSize);
+			size_t meshMisses = 0u;
+			for (const auto index : indices)
+			{
+				meshMisses += cache.Access(index) ? 1u : 0u;
+			}
+			const float targetAcmr = threshold * float(meshMisses) / float(triangleCount);
+			std::vector<size_t> starts;
+			for (size_t c = 0; c < clusters.size(); c++)
+			{
+				const size_t end = c + 1u < clusters.size() ? clusters[c + 1u] : triangleCount;
+				size_t start = clusters[c];
+				size_t misses = 0u;
+				cache.Flush();
+				starts.push_back(start);
+				for (size_t t = start; t < end; t++)
+				{
+					for (size_t corner = 0; corner < 3u; corner++)
+					{
+						misses += cache.Access(indices[t * 3u + corner]) ? 1u : 0u;
+					}
+					if (t + 1u < end && float(misses) <= targetAcmr * float(t + 1u - start))
+					{
+						start = t + 1u;
+						misses = 0u;
+						cache.Flush();
+						starts.push_back(start);
+					}
+				}
+			}
+			starts.push_back(triangleCount);
+			const size_t clusterCount = starts.size() - 1u;
+
+			// area weighted centroid and normal of each cluster and of the whole mesh
+			std::vector<XMFLOAT3> centroids(clusterCount);
+			std::vector<XMFLOAT3> normals(clusterCount);
+			auto meshCentroid = XMVectorZero();
+			float meshWeight = 0.0f;
+			for (size_t c = 0; c < clusterCount; c++)
+			{
+				auto centroid = XMVectorZero();
+				auto normal = XMVectorZero();
+				float weight = 0.0f;
+				for (size_t t = starts[c]; t < starts[c + 1u]; t++)
+				{
+					const auto a = LoadCorner(positions, indices, t, 0u);
+					const auto b = LoadCorner(positions, indices, t, 1u);
+					const auto cc = LoadCorner(positions, indices, t, 2u);
+					const auto faceNormal = FaceNormal(a, b, cc);
+					const float area = XMVectorGetX(XMVector3Length(faceNormal));
+					centroid = XMVectorAdd(centroid, XMVectorScale(XMVectorAdd(XMVectorAdd(a, b), cc), area / 3.0f));
+					normal = XMVectorAdd(normal, faceNormal);
+					weight += area;
+				}
+				meshCentroid = XMVectorAdd(meshCentroid, centroid);
+				meshWeight += weight;
+				XMStoreFloat3(&centroids[c], weight > 0.0f ? XMVectorScale(centroid, 1.0f / weight) : XMVectorZero());
+				XMStoreFloat3(&normals[c], XMVector3Normalize(normal));
+			}
+			if (meshWeight > 0.0f)
+			{
+				meshCentroid = XMVectorScale(meshCentroid, 1.0f / meshWeight);
+			}
+
+			// clusters facing away from the centre sit on the outside of the mesh and occlude the
+			// rest, so they are drawn first
+			std::vector<float> keys(clusterCount);
+			for (size_t c = 0; c < clusterCount; c++)
+			{
+				const auto offset = XMVectorSubtract(XMLoadFloat3(&centroids[c]), meshCentroid);
+				keys[c] = XMVectorGetX(XMVector3Dot(offset, XMLoadFloat3(&normals[c])));
+			}
+			std::vector<size_t> order(clusterCount);
+			std::iota(order.begin(), order.end(), size_t(0));
+			std::stable_sort(order.begin(), order.end(), [&keys](size_t lhs, size_t rhs) { return keys[lhs] > keys[rhs]; });
+
+			std::vector<unsigned int> result;
+			result.reserve(indices.size());
+			for (const auto c : order)
+			{
+				result.insert(result.end(), indices.begin() + starts[c] * 3u, indices.begin() + starts[c + 1u] * 3u);
+			}
+			if (pClusterCount)
+			{
+				*pClusterCount = clusterCount;
+			}
+			return result;
+		}
+
+		std::vector<unsigned int> OptimizeVertexFetch(std::vector<unsigned int>& indices, size_t vertexCount)
+		{
+			constexpr auto Unused = std::numeric_limits<unsigned int>::max();
+			std::vector<unsigned int> remap(vertexCount, Unused);
+			std::vector<unsigned int> order;
+			order.reserve(vertexCount);
+			for (auto& index : indices)
+			{
+				assert(index < vertexCount && "Index out of range");
+				if (remap[index] == Unused)
+				{
+					remap[index] = static_cast<unsigned int>(order.size());
+					order.push_back(index);
+				}
+				index = remap[index];
+			}
+			return order;
+		}
+
+		Metrics Analyze(const std::vector<unsigned int>& indices, const std::vector<XMFLOAT3>& positions, unsigned int cacheSize)
+		{
+			assert(indices.size() % 3u == 0u && "Mesh indices must form a triangle list");
+			Metrics metrics;
+			metrics.triangleCount = indices.size() / 3u;
+			if (metrics.triangleCount == 0u)
+			{
+				return metrics;
+			}
+			const size_t vertexCount = CountVertices(indices);
+			assert((positions.empty() || positions.size() >= vertexCount) && "Index out of range");
+
+			FifoCache cache(vertexCount, cacheSize);
+			std::vector<bool> referenced(vertexCount, false);
+			size_t transformed = 0u;
+			for (const auto index : indices)
+			{
+				transformed += cache.Access(index) ? 1u : 0u;
+				if (!referenced[index])
+				{
+					referenced[index] = true;
+					metrics.vertexCount++;
+				}
+			}
+			metrics.acmr = float(transformed) / float(metrics.triangleCount);
+			metrics.atvr = float(transformed) / float(metrics.vertexCount);
+			metrics.overdraw = positions.empty() ? 0.0f : MeasureOverdraw(indices, positions);
+			return metrics;
+		}
+
+		std::vector<XMFLOAT3> ExtractPositions(const VertexBuffer& vertices)
+		{
+			std::vector<XMFLOAT3> positions;
+			positions.reserve(vertices.Size());
+			const auto& layout = vertices.GetLayout();
+			if (layout.Has<VertexLayout::Position3D>())
+			{
+				for (const auto& position : vertices.View<VertexLayout::Position3D>())
+				{
+					positions.push_back(position);
+				}
+			}
+			else if (layout.Has<VertexLayout::Position3DQuantized>())
+			{
+				for (const auto& packed : vertices.View<VertexLayout::Position3DQuantized>())
+				{
+					positions.push_back(VertexPacking::DecodePosition(packed, vertices.GetQuantization()));
+				}
+			}
+			else
+			{
+				assert(false && "Vertex layout has no 3D positions");
+			}
+			return positions;
+		}
+	}
+}
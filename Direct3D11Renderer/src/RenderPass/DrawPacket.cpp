@@ -0,0 +1,41 @@
+#include "RenderPass/DrawPacket.h"
+#include "Bindable/Bindable.h"
+#include "Core/Graphics.h"
+
+void DrawPacket::Execute(Graphics& gfx) const noexcept
+{
+	auto& state = gfx.GetStateCache();
+
+	if (stateMask & VertexShaderBit) { state.SetVertexShader(pVertexShader); }
+	if (stateMask & PixelShaderBit) { state.SetPixelShader(pPixelShader); }
+	if (stateMask & InputLayoutBit) { state.SetInputLayout(pInputLayout); }
+	if (stateMask & RasterizerBit) { state.SetRasterizerState(pRasterizer); }
+	if (stateMask & BlendBit) { state.SetBlendState(pBlender, blendSampleMask); }
+	if (stateMask & DepthStencilBit) { state.SetDepthStencilState(pDepthStencil, stencilRef); }
+
+	// every entry in objects is an interface pointer of the type implied by its range's stage
+	for (const auto& range : ranges)
+	{
+		void* const* ppObjects = objects.data() + range.firstObject;
+		switch (range.stage)
+		{
+		case Stage::VertexConstantBuffer:
+			state.SetVertexConstantBuffers(range.startSlot, range.count, reinterpret_cast<ID3D11Buffer* const*>(ppObjects));
+			break;
+		case Stage::PixelConstantBuffer:
+			state.SetPixelConstantBuffers(range.startSlot, range.count, reinterpret_cast<ID3D11Buffer* const*>(ppObjects));
+			break;
+		case Stage::PixelShaderResource:
+			state.SetPixelShaderResources(range.startSlot, range.count, reinterpret_cast<ID3D11ShaderResourceView* const*>(ppObjects));
+			break;
+		case Stage::PixelSampler:
+			state.SetPixelSamplers(range.startSlot, range.count, reinterpret_cast<ID3D11SamplerState* const*>(ppObjects));
+			break;
+		}
+	}
+
+	for (auto* pHook : hooks)
+	{
+		pHook->Bind(gfx);
+	}
+}
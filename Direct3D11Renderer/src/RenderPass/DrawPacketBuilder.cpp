@@ -0,0 +1,127 @@
+#include "RenderPass/DrawPacket.h"
+#include <algorithm>
+
+uint32_t DrawPacket::GetStateMask() const noexcept
+{
+	return stateMask;
+}
+
+const std::vector<DrawPacket::SlotRange>& DrawPacket::GetRanges() const noexcept
+{
+	return ranges;
+}
+
+const std::vector<void*>& DrawPacket::GetObjects() const noexcept
+{
+	return objects;
+}
+
+const std::vector<Bindable*>& DrawPacket::GetHooks() const noexcept
+{
+	return hooks;
+}
+
+void DrawPacketBuilder::SetVertexShader(ID3D11VertexShader* pShader) noexcept
+{
+	packet.pVertexShader = pShader;
+	packet.stateMask |= DrawPacket::VertexShaderBit;
+}
+
+void DrawPacketBuilder::SetPixelShader(ID3D11PixelShader* pShader) noexcept
+{
+	packet.pPixelShader = pShader;
+	packet.stateMask |= DrawPacket::PixelShaderBit;
+}
+
+void DrawPacketBuilder::SetInputLayout(ID3D11InputLayout* pLayout) noexcept
+{
+	packet.pInputLayout = pLayout;
+	packet.stateMask |= DrawPacket::InputLayoutBit;
+}
+
+void DrawPacketBuilder::SetRasterizerState(ID3D11RasterizerState* pState) noexcept
+{
+	packet.pRasterizer = pState;
+	packet.stateMask |= DrawPacket::RasterizerBit;
+}
+
+void DrawPacketBuilder::SetBlendState(ID3D11BlendState* pState, uint32_t sampleMask) noexcept
+{
+	packet.pBlender = pState;
+	packet.blendSampleMask = sampleMask;
+	packet.stateMask |= DrawPacket::BlendBit;
+}
+
+void DrawPacketBuilder::SetDepthStencilState(ID3D11DepthStencilState* pState, uint32_t stencilRef) noexcept
+{
+	packet.pDepthStencil = pState;
+	packet.stencilRef = stencilRef;
+	packet.stateMask |= DrawPacket::DepthStencilBit;
+}
+
+void DrawPacketBuilder::AddVertexConstantBuffer(uint32_t slot, ID3D11Buffer* pBuffer)
+{
+	AddSlotted(DrawPacket::Stage::VertexConstantBuffer, slot, pBuffer);
+}
+
+void DrawPacketBuilder::AddPixelConstantBuffer(uint32_t slot, ID3D11Buffer* pBuffer)
+{
+	AddSlotted(DrawPacket::Stage::PixelConstantBuffer, slot, pBuffer);
+}
+
+void DrawPacketBuilder::AddPixelShaderResource(uint32_t slot, ID3D11ShaderResourceView* pView)
+{
+	AddSlotted(DrawPacket::Stage::PixelShaderResource, slot, pView);
+}
+
+void DrawPacketBuilder::AddPixelSampler(uint32_t slot, ID3D11SamplerState* pSampler)
+{
+	AddSlotted(DrawPacket::Stage::PixelSampler, slot, pSampler);
+}
+
+void DrawPacketBuilder::AddDynamic(Bindable& bindable)
+{
+	packet.hooks.push_back(&bindable);
+}
+
+void DrawPacketBuilder::AddSlotted(DrawPacket::Stage stage, uint32_t slot, void* pObject)
+{
+	entries.push_back({ stage, slot, pObject });
+}
+
+DrawPacket DrawPacketBuilder::Build()
+{
+	// stable so that for duplicate stage / slot pairs the last one added ends up last
+	std::stable_sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs)
+	{
+		return lhs.stage != rhs.stage ? lhs.stage < rhs.stage : lhs.slot < rhs.slot;
+	});
+
+	packet.ranges.clear();
+	packet.objects.clear();
+	packet.objects.reserve(entries.size());
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		const auto& e = entries[i];
+		if (i + 1 < entries.size() && entries[i + 1].stage == e.stage && entries[i + 1].slot == e.slot)
+		{
+			continue;
+		}
+
+		auto* pLast = packet.ranges.empty() ? nullptr : &packet.ranges.back();
+		if (pLast && pLast->stage == e.stage && pLast->startSlot + pLast->count == e.slot)
+		{
+			pLast->count++;
+		}
+		else
+		{
+			packet.ranges.push_back({ e.stage, e.slot, 1u, uint32_t(packet.objects.size()) });
+		}
+		packet.objects.push_back(e.pObject);
+	}
+
+	entries.clear();
+	DrawPacket result = std::move(packet);
+	packet = {};
+	return result;
+}
@@ -1,41 +1,374 @@
 #include "RenderPass/FrameManager.h"
 #include "Bindable/BindableCommon.h"
+#include "Bindable/RenderTarget.h"
+#include <algorithm>
 
-void FrameManager::Accept(Job job, size_t target) noexcept
+namespace
 {
-	passes[target].Accept(std::move(job));
+	// separable blur iterations softening the outline, each is a horizontal and a vertical pass
+	constexpr int outlineBlurIterations = 2;
+
+	// mirrors the OutlineBlur cbuffer in OutlineBlur_PS.hlsl
+	struct OutlineBlurBuffer
+	{
+		DirectX::XMFLOAT2 direction;
+		float composite;
+		float padding;
+	};
+	static_assert(sizeof(OutlineBlurBuffer) == 16u, "OutlineBlurBuffer must match the OutlineBlur cbuffer");
 }
 
-void FrameManager::Excecute(Graphics& gfx) const
+FrameManager::FrameManager()
 {
-	// normally this would be a loop with each pass defining it setup / etc.
-	// and later on it would be a complex graph with parallel execution contingent
-    // on input / output requirements
+	backBuffer = graph.Import("backBuffer", { RenderGraph::ResourceType::RenderTarget });
+	depthStencil = graph.Import("depthStencil", { RenderGraph::ResourceType::DepthStencil });
 
 	// Main phong lighting pass
-	Stencil::Resolve(gfx, Stencil::Mode::Off)->Bind(gfx);
-	passes[0].Excecute(gfx);
-	
+	AddPass("Phong", SortKey::Policy::FrontToBack,
+		[this](RenderGraph::PassBuilder& builder)
+		{
+			backBuffer = builder.Write(backBuffer);
+			depthStencil = builder.Write(depthStencil);
+		},
+		[pStencil = std::shared_ptr<Stencil>(), pBlender = std::shared_ptr<Blender>()](Graphics& gfx) mutable
+		{
+			// resolved on first use and kept, Resolve builds its UID string on every call
+			if (!pStencil)
+			{
+				pStencil = Stencil::Resolve(gfx, Stencil::Mode::Off);
+				pBlender = Blender::Resolve(gfx, false);
+			}
+			// the outline passes leave another target and blending bound
+			gfx.BindBackBuffer();
+			pStencil->Bind(gfx);
+			pBlender->Bind(gfx);
+		});
+
 	// Outline mask pass
-	Stencil::Resolve(gfx, Stencil::Mode::Write)->Bind(gfx);
-	NullPixelShader::Resolve(gfx)->Bind(gfx);
-	passes[1].Excecute(gfx);
+	AddPass("OutlineMask", SortKey::Policy::FrontToBack,
+		[this](RenderGraph::PassBuilder& builder)
+		{
+			depthStencil = builder.Write(depthStencil);
+		},
+		[pStencil = std::shared_ptr<Stencil>(), pNullPixelShader = std::shared_ptr<NullPixelShader>()](Graphics& gfx) mutable
+		{
+			if (!pStencil)
+			{
+				pStencil = Stencil::Resolve(gfx, Stencil::Mode::Write);
+				pNullPixelShader = NullPixelShader::Resolve(gfx);
+			}
+			// the stencil lives with the back buffer, whatever pass ran before may have bound another target
+			gfx.BindBackBuffer();
+			pStencil->Bind(gfx);
+			pNullPixelShader->Bind(gfx);
+		});
+
+	// Outline draw pass: silhouettes of the outlined objects into a transient, each in its own
+	// premultiplied outline color, blurred below
+	const RenderGraph::ResourceDesc coverageDesc{ RenderGraph::ResourceType::RenderTarget, 0u, 0u, DXGI_FORMAT_R8G8B8A8_UNORM };
+	auto coverage = graph.CreateTransient("outlineSilhouette", coverageDesc);
+	AddPass("OutlineDraw", SortKey::Policy::FrontToBack,
+		[&coverage](RenderGraph::PassBuilder& builder)
+		{
+			coverage = builder.Write(coverage);
+		},
+		[this, silhouette = coverage, pStencil = std::shared_ptr<Stencil>(), pBlender = std::shared_ptr<Blender>()](Graphics& gfx) mutable
+		{
+			if (!pStencil)
+			{
+				pStencil = Stencil::Resolve(gfx, Stencil::Mode::Off);
+				pBlender = Blender::Resolve(gfx, false);
+			}
+			const float clearColor[] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			auto& target = GetTarget(silhouette);
+			target.Clear(gfx, clearColor);
+			target.BindAsTarget(gfx);
+			pStencil->Bind(gfx);
+			// written as is so the premultiplied colors stay intact where silhouettes overlap
+			pBlender->Bind(gfx);
+		});
+
+	// Outline blur passes: ping-pong between transients, the last one blends onto the back buffer
+	// outside the stencil mask. The graph aliases the transients down to two textures.
+	for (int i = 0; i < outlineBlurIterations; i++)
+	{
+		for (const bool vertical : { false, true })
+		{
+			const bool composite = vertical && i == outlineBlurIterations - 1;
+			const auto input = coverage;
+			const auto output = composite ? RenderGraph::Invalid :
+				graph.CreateTransient("outlineBlur" + std::to_string(i) + (vertical ? "V" : "H"), coverageDesc);
+			OutlineBlurBuffer blurBuffer = {
+				vertical ? DirectX::XMFLOAT2{ 0.0f, 1.0f } : DirectX::XMFLOAT2{ 1.0f, 0.0f },
+				composite ? 1.0f : 0.0f,
+			};
+			AddPass(std::string("OutlineBlur") + (vertical ? "V" : "H") + std::to_string(i), SortKey::Policy::Submission,
+				[this, &coverage, input, output, composite](RenderGraph::PassBuilder& builder)
+				{
+					builder.Read(input);
+					if (composite)
+					{
+						builder.Read(depthStencil);
+						backBuffer = builder.Write(backBuffer);
+					}
+					else
+					{
+						coverage = builder.Write(output);
+					}
+				},
+				[this, input, output, composite, blurBuffer, pBlur = std::shared_ptr<Bindable>(),
+					pVertexShader = std::shared_ptr<VertexShader>(), pPixelShader = std::shared_ptr<PixelShader>(),
+					pStencil = std::shared_ptr<Stencil>(), pBlender = std::shared_ptr<Blender>()](Graphics& gfx) mutable
+				{
+					if (!pBlur)
+					{
+						// each pass has its own direction, PixelConstantBuffer::Resolve would share one buffer
+						pBlur = std::make_shared<PixelConstantBuffer<OutlineBlurBuffer>>(gfx, blurBuffer, 0u);
+						pVertexShader = VertexShader::Resolve(gfx, "shaders\\Output\\Fullscreen_VS.cso");
+						pPixelShader = PixelShader::Resolve(gfx, "shaders\\Output\\OutlineBlur_PS.cso");
+						pStencil = Stencil::Resolve(gfx, composite ? Stencil::Mode::Mask : Stencil::Mode::Off);
+						pBlender = Blender::Resolve(gfx, composite);
+					}
+					if (composite)
+					{
+						gfx.BindBackBuffer();
+					}
+					else
+					{
+						GetTarget(output).BindAsTarget(gfx);
+					}
+					GetTarget(input).Bind(gfx);
+					pStencil->Bind(gfx);
+					pBlender->Bind(gfx);
+					pBlur->Bind(gfx);
+					pVertexShader->Bind(gfx);
+					pPixelShader->Bind(gfx);
+
+					// the fullscreen triangle comes from SV_VertexID, no vertex input
+					auto& state = gfx.GetStateCache();
+					state.SetInputLayout(nullptr);
+					state.SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+					gfx.Draw(3u);
+				});
+		}
+	}
+}
+
+FrameManager::~FrameManager()
+{
+	// the pass queues go away with this object, outstanding registrations only need to forget it
+	for (auto* pRegistration : registrations)
+	{
+		pRegistration->pFrameManager = nullptr;
+		pRegistration->handles.clear();
+	}
+}
+
+size_t FrameManager::AddPass(std::string name, SortKey::Policy policy,
+	const std::function<void(RenderGraph::PassBuilder&)>& setup,
+	std::function<void(Graphics&)> bind)
+{
+	const auto index = graph.AddPass(std::move(name), setup);
+	passes.resize(index + 1);
+	passes[index].queue.SetSortPolicy(policy);
+	passes[index].bind = std::move(bind);
+	return index;
+}
+
+void FrameManager::Accept(Job job, size_t target) noexcept
+{
+	passes[target].queue.Accept(std::move(job));
+}
+
+FrameManager::Registration FrameManager::Register()
+{
+	return Registration{ *this };
+}
+
+FrameManager::RetainedHandle FrameManager::Retain(Job job, size_t target)
+{
+	return { target, passes[target].queue.AddRetained(job) };
+}
+
+void FrameManager::Release(const RetainedHandle& handle) noexcept
+{
+	passes[handle.target].queue.RemoveRetained(handle.slot);
+}
+
+size_t FrameManager::GetRetainedCount() const noexcept
+{
+	size_t count = 0u;
+	for (const auto& pass : passes)
+	{
+		count += pass.queue.GetRetainedCount();
+	}
+	return count;
+}
+
+Pass::DrawStats FrameManager::GetDrawStats() const noexcept
+{
+	Pass::DrawStats total;
+	for (const auto& pass : passes)
+	{
+		const auto& stats = pass.queue.GetDrawStats();
+		total.draws += stats.draws;
+		total.instancedDraws += stats.instancedDraws;
+		total.instances += stats.instances;
+	}
+	return total;
+}
 
-	// Outline draw pass
-	Stencil::Resolve(gfx, Stencil::Mode::Mask)->Bind(gfx);
-	struct SolidColorBuffer
+void FrameManager::Excecute(Graphics& gfx)
+{
+	if (!graph.IsCompiled())
 	{
-		DirectX::XMFLOAT4 color = { 1.0f, 0.4f, 0.4f, 1.0f };
-	} solidColorBuffer;
+		graph.Compile();
+		AllocateTargets(gfx);
+	}
 
-	PixelConstantBuffer<SolidColorBuffer>::Resolve(gfx, solidColorBuffer, 1u)->Bind(gfx);
-	passes[2].Excecute(gfx);
+	for (auto index : graph.GetExecutionOrder())
+	{
+		auto& pass = passes[index];
+		if (pass.bind)
+		{
+			pass.bind(gfx);
+		}
+		pass.queue.Excecute(gfx);
+	}
 }
 
-void FrameManager::Reset() noexcept
+void FrameManager::Reset()
 {
+	arena.BeginFrame();
 	for (auto& pass : passes)
 	{
-		pass.Reset();
+		pass.queue.Reset(arena);
 	}
-}
\ No newline at end of file
+}
+
+FrameArena& FrameManager::GetArena() noexcept
+{
+	return arena;
+}
+
+const RenderGraph& FrameManager::GetGraph() const noexcept
+{
+	return graph;
+}
+
+RenderTarget& FrameManager::GetTarget(RenderGraph::ResourceHandle handle) noexcept
+{
+	const auto physical = graph.GetPhysicalIndex(handle);
+	assert(physical < targets.size() && targets[physical] && "Resource has no target, it is imported, culled or the graph is not compiled");
+	return *targets[physical];
+}
+
+size_t FrameManager::GetTargetCount() const noexcept
+{
+	return static_cast<size_t>(std::count_if(targets.begin(), targets.end(), [](const auto& pTarget)
+	{
+		return pTarget != nullptr;
+	}));
+}
+
+void FrameManager::AllocateTargets(Graphics& gfx)
+{
+	targets.clear();
+	targets.resize(graph.GetPhysicalCount());
+	for (size_t physical = 0; physical < targets.size(); physical++)
+	{
+		if (graph.IsPhysicalImported(physical))
+		{
+			continue;
+		}
+		const auto& desc = graph.GetPhysicalDesc(physical);
+		assert(desc.type == RenderGraph::ResourceType::RenderTarget && "Only transient render targets are supported");
+		targets[physical] = std::make_unique<RenderTarget>(gfx,
+			desc.width != 0u ? desc.width : gfx.GetWidth(),
+			desc.height != 0u ? desc.height : gfx.GetHeight(),
+			static_cast<DXGI_FORMAT>(desc.format));
+	}
+}
+
+RenderGraph::ResourceHandle FrameManager::GetBackBuffer() const noexcept
+{
+	return backBuffer;
+}
+
+RenderGraph::ResourceHandle FrameManager::GetDepthStencil() const noexcept
+{
+	return depthStencil;
+}
+
+FrameManager::Registration::Registration(FrameManager& frameManager)
+	:
+	pFrameManager(&frameManager)
+{
+	frameManager.registrations.push_back(this);
+}
+
+FrameManager::Registration::Registration(Registration&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+FrameManager::Registration& FrameManager::Registration::operator=(Registration&& other) noexcept
+{
+	if (this != &other)
+	{
+		Reset();
+		pFrameManager = other.pFrameManager;
+		handles = std::move(other.handles);
+		if (pFrameManager != nullptr)
+		{
+			// the FrameManager tracks registrations by address
+			auto& registrations = pFrameManager->registrations;
+			*std::find(registrations.begin(), registrations.end(), &other) = this;
+		}
+		other.pFrameManager = nullptr;
+		other.handles.clear();
+	}
+	return *this;
+}
+
+FrameManager::Registration::~Registration()
+{
+	Reset();
+}
+
+void FrameManager::Registration::Retain(Job job, size_t target)
+{
+	assert(pFrameManager != nullptr && "Retaining a job through an inactive registration");
+	handles.push_back(pFrameManager->Retain(job, target));
+}
+
+void FrameManager::Registration::Reset() noexcept
+{
+	if (pFrameManager == nullptr)
+	{
+		return;
+	}
+	for (const auto& handle : handles)
+	{
+		pFrameManager->Release(handle);
+	}
+	handles.clear();
+	Detach();
+}
+
+bool FrameManager::Registration::IsActive() const noexcept
+{
+	return pFrameManager != nullptr;
+}
+
+FrameManager* FrameManager::Registration::GetFrameManager() const noexcept
+{
+	return pFrameManager;
+}
+
+void FrameManager::Registration::Detach() noexcept
+{
+	auto& registrations = pFrameManager->registrations;
+	registrations.erase(std::find(registrations.begin(), registrations.end(), this));
+	pFrameManager = nullptr;
+}
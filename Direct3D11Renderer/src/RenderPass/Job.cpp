@@ -1,5 +1,6 @@
 #include "RenderPass/Job.h"
 #include "RenderPass/Step.h"
+#include "RenderPass/SortKey.h"
 #include "Renderable/Renderable.h"
 
 Job::Job(const Renderable* pRenderable, const Step* pStep)
@@ -14,4 +15,47 @@ void Job::Execute(Graphics& gfx) const noexcept
 	pRenderable->Bind(gfx);
 	pStep->Bind(gfx);
 	gfx.DrawIndexed(pRenderable->GetIndexCount());
+}
+
+uint64_t Job::GetStateKey() const noexcept
+{
+	// jobs that can merge into one instanced draw have to be adjacent after sorting
+	if (pStep->IsInstanceable())
+	{
+		return SortKey::WithGeometry(pStep->GetStateKey(), pRenderable->GetGeometryId());
+	}
+	return pStep->GetStateKey();
+}
+
+float Job::GetViewDepth(DirectX::FXMMATRIX view) const noexcept
+{
+	// depth of the renderable's origin is good enough for ordering purposes
+	const auto modelView = pRenderable->GetTransformXM() * view;
+	return DirectX::XMVectorGetZ(modelView.r[3]);
+}
+
+bool Job::IsInstanceable() const noexcept
+{
+	return pStep->IsInstanceable();
+}
+
+bool Job::CanInstanceWith(const Job& other) const noexcept
+{
+	return pRenderable->SharesGeometry(*other.pRenderable) && pStep->IsBatchCompatible(*other.pStep);
+}
+
+InstanceBuffer::InstanceData Job::GetInstanceData(DirectX::FXMMATRIX view, DirectX::CXMMATRIX projection) const noexcept
+{
+	const auto modelView = pRenderable->GetTransformXM() * view;
+	InstanceBuffer::InstanceData data;
+	DirectX::XMStoreFloat4x4(&data.modelView, modelView);
+	DirectX::XMStoreFloat4x4(&data.modelViewProj, modelView * projection);
+	return data;
+}
+
+void Job::ExecuteInstanced(Graphics& gfx, UINT instanceCount) const
+{
+	pRenderable->Bind(gfx);
+	pStep->BindInstanced(gfx);
+	gfx.DrawIndexedInstanced(pRenderable->GetIndexCount(), instanceCount);
 }
\ No newline at end of file
@@ -1,19 +1,140 @@
 #include "RenderPass/Pass.h"
+#include <cassert>
 
 void Pass::Accept(Job job) noexcept
 {
 	jobs.push_back(std::move(job));
 }	
 
-void Pass::Excecute(Graphics& gfx) const noexcept
+void Pass::Excecute(Graphics& gfx)
 {
-	for (const auto& job : jobs)
+	Sort(gfx.GetView());
+	drawStats = {};
+
+	// runs of jobs that only differ by transform collapse into one instanced draw
+	for (size_t i = 0; i < order.size();)
 	{
-		job.Execute(gfx);
+		const auto& job = GetJob(order[i].index);
+		size_t runEnd = i + 1;
+		if (job.IsInstanceable())
+		{
+			while (runEnd < order.size() && job.CanInstanceWith(GetJob(order[runEnd].index)))
+			{
+				runEnd++;
+			}
+		}
+
+		if (runEnd - i > 1)
+		{
+			ExecuteInstanced(gfx, i, runEnd);
+		}
+		else
+		{
+			job.Execute(gfx);
+		}
+		drawStats.draws++;
+		i = runEnd;
 	}
 }
 
-void Pass::Reset() noexcept
+void Pass::Reset(FrameArena& arena)
+{
+	// the old list belongs to an arena buffer, so it is dropped rather than cleared
+	const auto lastCount = jobs.size();
+	jobs = std::vector<Job, FrameArena::Allocator<Job>>(arena.GetAllocator<Job>());
+	jobs.reserve(lastCount);
+}
+
+size_t Pass::AddRetained(Job job)
+{
+	retainedCount++;
+	if (!freeRetained.empty())
+	{
+		const auto slot = freeRetained.back();
+		freeRetained.pop_back();
+		retained[slot] = job;
+		return slot;
+	}
+	retained.push_back(job);
+	return retained.size() - 1u;
+}
+
+void Pass::RemoveRetained(size_t slot) noexcept
+{
+	assert(slot < retained.size() && retained[slot] && "Removing a retained job that is not queued");
+	retained[slot].reset();
+	freeRetained.push_back(slot);
+	retainedCount--;
+}
+
+size_t Pass::GetRetainedCount() const noexcept
+{
+	return retainedCount;
+}
+
+void Pass::SetSortPolicy(SortKey::Policy policy_in) noexcept
+{
+	policy = policy_in;
+}
+
+SortKey::Policy Pass::GetSortPolicy() const noexcept
+{
+	return policy;
+}
+
+const Pass::DrawStats& Pass::GetDrawStats() const noexcept
 {
-	jobs.clear();
+	return drawStats;
+}
+
+const Job& Pass::GetJob(uint32_t index) const noexcept
+{
+	return index < jobs.size() ? jobs[index] : *retained[index - jobs.size()];
+}
+
+void Pass::Sort(DirectX::FXMMATRIX view) noexcept
+{
+	order.clear();
+	order.reserve(jobs.size() + retainedCount);
+	for (size_t i = 0; i < jobs.size() + retained.size(); i++)
+	{
+		if (i >= jobs.size() && !retained[i - jobs.size()])
+		{
+			continue;
+		}
+		order.push_back({ 0u, uint32_t(i) });
+	}
+	if (policy == SortKey::Policy::Submission)
+	{
+		return;
+	}
+
+	for (auto& entry : order)
+	{
+		const auto& job = GetJob(entry.index);
+		const auto depth = SortKey::QuantizeDepth(job.GetViewDepth(view));
+		entry.key = SortKey::Make(policy, job.GetStateKey(), depth);
+	}
+	SortKey::RadixSort(order, scratch);
+}
+
+void Pass::ExecuteInstanced(Graphics& gfx, size_t first, size_t last)
+{
+	const auto view = gfx.GetView();
+	const auto projection = gfx.GetProjection();
+	instanceData.clear();
+	for (size_t i = first; i < last; i++)
+	{
+		instanceData.push_back(GetJob(order[i].index).GetInstanceData(view, projection));
+	}
+
+	if (!pInstanceBuffer)
+	{
+		pInstanceBuffer = std::make_unique<InstanceBuffer>(gfx);
+	}
+	pInstanceBuffer->Update(gfx, instanceData);
+	pInstanceBuffer->Bind(gfx);
+	GetJob(order[first].index).ExecuteInstanced(gfx, UINT(instanceData.size()));
+	drawStats.instancedDraws++;
+	drawStats.instances += instanceData.size();
 }
\ No newline at end of file
@@ -0,0 +1,383 @@
+#include "RenderPass/RenderGraph.h"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <stdexcept>
+
+RenderGraph::PassBuilder::PassBuilder(RenderGraph& graph, size_t pass) noexcept
+	:
+	graph(graph),
+	pass(pass)
+{
+}
+
+RenderGraph::ResourceHandle RenderGraph::PassBuilder::Read(ResourceHandle handle)
+{
+	assert(handle < graph.nodes.size() && "Invalid resource handle");
+	auto& reads = graph.passes[pass].reads;
+	if (std::find(reads.begin(), reads.end(), handle) == reads.end())
+	{
+		reads.push_back(handle);
+	}
+	return handle;
+}
+
+RenderGraph::ResourceHandle RenderGraph::PassBuilder::Write(ResourceHandle handle)
+{
+	assert(handle < graph.nodes.size() && "Invalid resource handle");
+	assert(graph.nodes[handle].producer != pass && "Pass writes the same resource version twice");
+	// two passes writing over the same version would race for its memory
+	assert(graph.nodes[handle].overwriter == Invalid && "Resource version was already written, use the latest handle");
+	// the previous contents are the starting point of this pass (load, not clear)
+	Read(handle);
+	graph.nodes[handle].overwriter = pass;
+	graph.nodes.push_back({ graph.nodes[handle].resource, pass });
+	const auto newHandle = graph.nodes.size() - 1;
+	graph.passes[pass].writes.push_back(newHandle);
+	return newHandle;
+}
+
+void RenderGraph::PassBuilder::SetSideEffects() noexcept
+{
+	graph.passes[pass].sideEffects = true;
+}
+
+RenderGraph::ResourceHandle RenderGraph::Import(std::string name, ResourceDesc desc)
+{
+	return AddResource(std::move(name), desc, true);
+}
+
+RenderGraph::ResourceHandle RenderGraph::CreateTransient(std::string name, ResourceDesc desc)
+{
+	return AddResource(std::move(name), desc, false);
+}
+
+RenderGraph::ResourceHandle RenderGraph::AddResource(std::string name, ResourceDesc desc, bool imported)
+{
+	compiled = false;
+	resources.push_back({ std::move(name), desc, imported });
+	nodes.push_back({ resources.size() - 1 });
+	return nodes.size() - 1;
+}
+
+size_t RenderGraph::AddPass(std::string name, const std::function<void(PassBuilder&)>& setup)
+{
+	compiled = false;
+	passes.emplace_back().name = std::move(name);
+	const auto index = passes.size() - 1;
+	PassBuilder builder{ *this, index };
+	setup(builder);
+	return index;
+}
+
+void RenderGraph::Compile()
+{
+	compiled = false;
+	Cull();
+	SortPasses();
+	AliasResources();
+	compiled = true;
+}
+
+bool RenderGraph::IsCompiled() const noexcept
+{
+	return compiled;
+}
+
+void RenderGraph::Cull()
+{
+	// reference counting flood from unread versions backwards, as in Frostbite's frame graph
+	for (auto& node : nodes)
+	{
+		node.refCount = 0u;
+	}
+	for (const auto& pass : passes)
+	{
+		for (auto read : pass.reads)
+		{
+			nodes[read].refCount++;
+		}
+	}
+	// the latest version of an imported resource is what the outside world sees
+	std::vector<bool> latestSeen(resources.size(), false);
+	for (size_t i = nodes.size(); i-- > 0;)
+	{
+		const auto resource = nodes[i].resource;
+		if (resources[resource].imported && !latestSeen[resource])
+		{
+			nodes[i].refCount++;
+		}
+		latestSeen[resource] = true;
+	}
+
+	std::vector<ResourceHandle> unreferenced;
+	for (auto& pass : passes)
+	{
+		pass.culled = false;
+		pass.refCount = pass.writes.size();
+	}
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		if (nodes[i].refCount == 0u)
+		{
+			unreferenced.push_back(i);
+		}
+	}
+	while (!unreferenced.empty())
+	{
+		const auto& node = nodes[unreferenced.back()];
+		unreferenced.pop_back();
+		if (node.producer == Invalid)
+		{
+			continue;
+		}
+		auto& producer = passes[node.producer];
+		if (--producer.refCount > 0u || producer.sideEffects)
+		{
+			continue;
+		}
+		producer.culled = true;
+		for (auto read : producer.reads)
+		{
+			if (--nodes[read].refCount == 0u)
+			{
+				unreferenced.push_back(read);
+			}
+		}
+	}
+
+	// a pass that writes nothing has no way to be referenced, keep it only if it asked for that
+	for (auto& pass : passes)
+	{
+		if (pass.writes.empty() && !pass.sideEffects)
+		{
+			pass.culled = true;
+		}
+	}
+}
+
+void RenderGraph::SortPasses()
+{
+	// Kahn's algorithm over read-after-write and write-after-read edges
+	std::vector<size_t> inDegree(passes.size(), 0u);
+	std::vector<std::vector<size_t>> dependents(passes.size());
+	auto addEdge = [&](size_t from, size_t to)
+	{
+		if (from != Invalid && to != Invalid && from != to && !passes[from].culled && !passes[to].culled)
+		{
+			dependents[from].push_back(to);
+			inDegree[to]++;
+		}
+	};
+	// transient resources each live pass touches, and how many live passes are left to touch them
+	std::vector<std::vector<size_t>> transients(passes.size());
+	std::vector<size_t> remainingUses(resources.size(), 0u);
+	std::vector<bool> started(resources.size(), false);
+	size_t liveCount = 0u;
+	for (size_t i = 0; i < passes.size(); i++)
+	{
+		if (passes[i].culled)
+		{
+			continue;
+		}
+		liveCount++;
+		for (auto read : passes[i].reads)
+		{
+			addEdge(nodes[read].producer, i);
+			// the pass writing over what we read has to wait for us
+			addEdge(i, nodes[read].overwriter);
+		}
+		auto touch = [&](ResourceHandle handle)
+		{
+			const auto resource = nodes[handle].resource;
+			auto& touched = transients[i];
+			if (!resources[resource].imported && std::find(touched.begin(), touched.end(), resource) == touched.end())
+			{
+				touched.push_back(resource);
+				remainingUses[resource]++;
+			}
+		};
+		std::for_each(passes[i].reads.begin(), passes[i].reads.end(), touch);
+		std::for_each(passes[i].writes.begin(), passes[i].writes.end(), touch);
+	}
+	// transient lifetimes ended minus transient lifetimes begun by running the pass now
+	auto score = [&](size_t pass)
+	{
+		int result = 0;
+		for (auto resource : transients[pass])
+		{
+			if (!started[resource])
+			{
+				result--;
+			}
+			else if (remainingUses[resource] == 1u)
+			{
+				result++;
+			}
+		}
+		return result;
+	};
+
+	std::vector<size_t> ready;
+	for (size_t i = 0; i < passes.size(); i++)
+	{
+		if (!passes[i].culled && inDegree[i] == 0u)
+		{
+			ready.push_back(i);
+		}
+	}
+	executionOrder.clear();
+	while (!ready.empty())
+	{
+		// ready stays short (a handful of passes), a linear scan beats keeping it ordered
+		auto best = ready.begin();
+		auto bestScore = score(*best);
+		for (auto it = std::next(best); it != ready.end(); ++it)
+		{
+			const auto candidateScore = score(*it);
+			if (candidateScore > bestScore || (candidateScore == bestScore && *it < *best))
+			{
+				best = it;
+				bestScore = candidateScore;
+			}
+		}
+		const auto pass = *best;
+		ready.erase(best);
+		executionOrder.push_back(pass);
+		for (auto resource : transients[pass])
+		{
+			started[resource] = true;
+			remainingUses[resource]--;
+		}
+		for (auto dependent : dependents[pass])
+		{
+			if (--inDegree[dependent] == 0u)
+			{
+				ready.push_back(dependent);
+			}
+		}
+	}
+
+	if (executionOrder.size() < liveCount)
+	{
+		std::string cycle;
+		for (size_t i = 0; i < passes.size(); i++)
+		{
+			if (!passes[i].culled && inDegree[i] > 0u)
+			{
+				cycle += (cycle.empty() ? "" : ", ") + passes[i].name;
+			}
+		}
+		throw std::runtime_error("Render graph passes depend on each other in a cycle: " + cycle);
+	}
+}
+
+void RenderGraph::AliasResources()
+{
+	constexpr size_t unused = Invalid;
+	std::vector<size_t> firstUse(resources.size(), unused);
+	std::vector<size_t> lastUse(resources.size(), 0u);
+	for (size_t position = 0; position < executionOrder.size(); position++)
+	{
+		const auto& pass = passes[executionOrder[position]];
+		auto touch = [&](ResourceHandle handle)
+		{
+			const auto resource = nodes[handle].resource;
+			firstUse[resource] = std::min(firstUse[resource], position);
+			lastUse[resource] = std::max(lastUse[resource], position);
+		};
+		std::for_each(pass.reads.begin(), pass.reads.end(), touch);
+		std::for_each(pass.writes.begin(), pass.writes.end(), touch);
+	}
+
+	physicalDescs.clear();
+	physicalImported.clear();
+	// end of lifetime of the resource currently occupying each physical slot
+	std::vector<size_t> physicalBusyUntil;
+	std::vector<size_t> byFirstUse;
+	for (size_t i = 0; i < resources.size(); i++)
+	{
+		resources[i].physical = Invalid;
+		if (firstUse[i] != unused)
+		{
+			byFirstUse.push_back(i);
+		}
+	}
+	std::stable_sort(byFirstUse.begin(), byFirstUse.end(), [&](size_t lhs, size_t rhs)
+	{
+		return firstUse[lhs] < firstUse[rhs];
+	});
+
+	for (auto i : byFirstUse)
+	{
+		auto& resource = resources[i];
+		if (!resource.imported)
+		{
+			for (size_t p = 0; p < physicalDescs.size(); p++)
+			{
+				if (physicalBusyUntil[p] < firstUse[i] && physicalDescs[p] == resource.desc)
+				{
+					resource.physical = p;
+					physicalBusyUntil[p] = lastUse[i];
+					break;
+				}
+			}
+		}
+		if (resource.physical == Invalid)
+		{
+			physicalDescs.push_back(resource.desc);
+			physicalImported.push_back(resource.imported);
+			// imported resources live for the whole frame and are never shared
+			physicalBusyUntil.push_back(resource.imported ? Invalid : lastUse[i]);
+			resource.physical = physicalDescs.size() - 1;
+		}
+	}
+}
+
+const std::vector<size_t>& RenderGraph::GetExecutionOrder() const noexcept
+{
+	return executionOrder;
+}
+
+size_t RenderGraph::GetPassCount() const noexcept
+{
+	return passes.size();
+}
+
+const std::string& RenderGraph::GetPassName(size_t pass) const noexcept
+{
+	return passes[pass].name;
+}
+
+bool RenderGraph::IsCulled(size_t pass) const noexcept
+{
+	return passes[pass].culled;
+}
+
+size_t RenderGraph::GetPhysicalIndex(ResourceHandle handle) const noexcept
+{
+	return resources[nodes[handle].resource].physical;
+}
+
+size_t RenderGraph::GetPhysicalCount() const noexcept
+{
+	return physicalDescs.size();
+}
+
+const RenderGraph::ResourceDesc& RenderGraph::GetPhysicalDesc(size_t physical) const noexcept
+{
+	return physicalDescs[physical];
+}
+
+bool RenderGraph::IsPhysicalImported(size_t physical) const noexcept
+{
+	return physicalImported[physical];
+}
+
+size_t RenderGraph::GetTransientCount() const noexcept
+{
+	return static_cast<size_t>(std::count_if(resources.begin(), resources.end(), [](const Resource& resource)
+	{
+		return !resource.imported && resource.physical != Invalid;
+	}));
+}
@@ -0,0 +1,99 @@
+#include "RenderPass/SortKey.h"
+#include <array>
+#include <cstring>
+#include <utility>
+
+uint64_t SortKey::Fold(uint64_t id, unsigned int bits) noexcept
+{
+	// fibonacci hashing keeps the high bits well mixed for pointer-like inputs
+	return (id * 0x9E3779B97F4A7C15ull) >> (64u - bits);
+}
+
+uint64_t SortKey::MakeState(uint64_t shaderId, uint64_t textureId, uint64_t materialId) noexcept
+{
+	return (Fold(shaderId, ShaderBits) << (TextureBits + MaterialBits)) |
+		(Fold(textureId, TextureBits) << MaterialBits) |
+		Fold(materialId, MaterialBits);
+}
+
+uint64_t SortKey::WithGeometry(uint64_t state, uint64_t geometryId) noexcept
+{
+	return state ^ Fold(geometryId, MaterialBits);
+}
+
+uint64_t SortKey::WithMaterial(uint64_t state, uint64_t materialId) noexcept
+{
+	return (state & ~((1ull << MaterialBits) - 1u)) | Fold(materialId, MaterialBits);
+}
+
+uint32_t SortKey::QuantizeDepth(float viewDepth) noexcept
+{
+	if (!(viewDepth > 0.0f))
+	{
+		return 0u;
+	}
+	// bit patterns of positive floats sort the same way as their values,
+	// so keeping the top bits is a monotonic quantization with no far plane needed
+	uint32_t bits;
+	std::memcpy(&bits, &viewDepth, sizeof(bits));
+	return bits >> (31u - DepthBits);
+}
+
+uint64_t SortKey::Make(Policy policy, uint64_t state, uint32_t depth) noexcept
+{
+	constexpr uint64_t depthMask = (1ull << DepthBits) - 1ull;
+	constexpr uint64_t stateMask = (1ull << StateBits) - 1ull;
+	switch (policy)
+	{
+	case Policy::FrontToBack:
+		return ((state & stateMask) << DepthBits) | (depth & depthMask);
+	case Policy::BackToFront:
+		return ((~uint64_t(depth) & depthMask) << StateBits) | (state & stateMask);
+	case Policy::Submission:
+	default:
+		return 0u;
+	}
+}
+
+void SortKey::RadixSort(std::vector<Entry>& entries, std::vector<Entry>& scratch) noexcept
+{
+	const size_t count = entries.size();
+	if (count < 2)
+	{
+		return;
+	}
+	scratch.resize(count);
+
+	Entry* pSrc = entries.data();
+	Entry* pDst = scratch.data();
+	for (unsigned int shift = 0u; shift < 64u; shift += 8u)
+	{
+		std::array<size_t, 256> histogram = {};
+		for (size_t i = 0; i < count; i++)
+		{
+			histogram[(pSrc[i].key >> shift) & 0xFFu]++;
+		}
+		// every key shares this digit, the pass would be an identity copy
+		if (histogram[(pSrc[0].key >> shift) & 0xFFu] == count)
+		{
+			continue;
+		}
+		size_t offset = 0;
+		for (auto& bucket : histogram)
+		{
+			const size_t bucketCount = bucket;
+			bucket = offset;
+			offset += bucketCount;
+		}
+		for (size_t i = 0; i < count; i++)
+		{
+			pDst[histogram[(pSrc[i].key >> shift) & 0xFFu]++] = pSrc[i];
+		}
+		std::swap(pSrc, pDst);
+	}
+
+	if (pSrc != entries.data())
+	{
+		std::memcpy(entries.data(), pSrc, count * sizeof(Entry));
+	}
+}
@@ -1,6 +1,11 @@
 #include "RenderPass/Step.h"
 #include "RenderPass/FrameManager.h"	
 #include "RenderPass/Job.h"
+#include "RenderPass/SortKey.h"
+#include "Bindable/BindableCommon.h"
+#include "Bindable/DynamicConstantBufferBindable.h"
+#include <algorithm>
+#include <typeinfo>
 
 Step::Step(size_t targetPass_in)
 	:
@@ -8,9 +13,30 @@ Step::Step(size_t targetPass_in)
 {
 }
 
+Step::Step(const Step& src)
+	:
+	targetPass(src.targetPass),
+	bindables(src.bindables),
+	pInstancedVertexShader(src.pInstancedVertexShader),
+	pInstancedInputLayout(src.pInstancedInputLayout)
+{
+	for (auto& b : bindables)
+	{
+		if (auto pClone = b->Clone())
+		{
+			b = std::move(pClone);
+		}
+	}
+	// the packets and the material key point at the bindables they were taken from
+	UpdateStateKey();
+	Compile();
+}
+
 void Step::AddBindable(std::shared_ptr<Bindable> bindable) noexcept
 {
 	bindables.push_back(std::move(bindable));
+	UpdateStateKey();
+	Compile();
 }
 
 void Step::Submit(FrameManager& frameManager, const class Renderable& renderable) const
@@ -18,12 +44,14 @@ void Step::Submit(FrameManager& frameManager, const class Renderable& renderable
 	frameManager.Accept(Job{ &renderable, this }, targetPass);
 }
 
+void Step::Retain(FrameManager::Registration& registration, const Renderable& renderable) const
+{
+	registration.Retain(Job{ &renderable, this }, targetPass);
+}
+
 void Step::Bind(Graphics& gfx) const
 {
-	for (const auto& b : bindables)
-	{
-		b->Bind(gfx);
-	}
+	packet.Execute(gfx);
 }
 
 void Step::Accept(TechniqueProbe& probe)
@@ -40,4 +68,143 @@ void Step::InitializeParentReferences(const class Renderable& parent) const
 	{
 		b->InitializeParentReference(parent);
 	}
+}
+
+uint64_t Step::GetStateKey() const noexcept
+{
+	// a probe edit reaches the key once the buffer has uploaded it, one frame late at most
+	if (pMaterialConstants && pMaterialConstants->GetUploadedHash() != materialHash)
+	{
+		materialHash = pMaterialConstants->GetUploadedHash();
+		stateKey = SortKey::WithMaterial(stateKey, materialHash);
+	}
+	return stateKey;
+}
+
+void Step::UpdateStateKey() noexcept
+{
+	// bindables are shared through the BindableCache, so their addresses identify the state
+	auto id = [](const Bindable* p) { return uint64_t(reinterpret_cast<uintptr_t>(p)); };
+	uint64_t vertexShader = 0u;
+	uint64_t pixelShader = 0u;
+	uint64_t textures = 0u;
+	uint64_t material = 0u;
+	pMaterialConstants = nullptr;
+	for (const auto& b : bindables)
+	{
+		const auto* p = b.get();
+		if (dynamic_cast<const VertexShader*>(p))
+		{
+			vertexShader = id(p);
+		}
+		else if (dynamic_cast<const PixelShader*>(p) || dynamic_cast<const NullPixelShader*>(p))
+		{
+			pixelShader = id(p);
+		}
+		else if (dynamic_cast<const Texture*>(p))
+		{
+			textures = textures * 31u + id(p);
+		}
+		else if (const auto* pConstants = dynamic_cast<const CachingDynamicConstantBufferBindable*>(p))
+		{
+			// by content, so equal materials of different objects sort together and can merge
+			pMaterialConstants = pConstants;
+			materialHash = pConstants->GetUploadedHash();
+			material = materialHash;
+		}
+		else if (dynamic_cast<const DynamicConstantBufferBindable*>(p))
+		{
+			pMaterialConstants = nullptr;
+			material = id(p);
+		}
+	}
+	stateKey = SortKey::MakeState(vertexShader * 31u + pixelShader, textures, material);
+}
+
+void Step::Compile()
+{
+	DrawPacketBuilder builder;
+	for (const auto& b : bindables)
+	{
+		b->Compile(builder);
+	}
+	packet = builder.Build();
+
+	instanceable = false;
+	batchSignature.clear();
+	batchConstants.clear();
+	if (!pInstancedVertexShader || !pInstancedInputLayout)
+	{
+		return;
+	}
+	DrawPacketBuilder instancedBuilder;
+	std::vector<const Bindable*> signature;
+	std::vector<const CachingDynamicConstantBufferBindable*> constants;
+	for (const auto& b : bindables)
+	{
+		if (const auto* pTransform = dynamic_cast<const TransformConstantBuffer*>(b.get()))
+		{
+			// The instance stream only reaches the vertex shader. Derived transform buffers carry
+			// extra per-draw data and a pixel stage one would still need the per-object matrices.
+			if (typeid(*b) != typeid(TransformConstantBuffer) || pTransform->GetStages() != ShaderStage::Vertex)
+			{
+				return;
+			}
+			continue;
+		}
+		if (const auto* pConstants = dynamic_cast<const CachingDynamicConstantBufferBindable*>(b.get()))
+		{
+			// compared by content in IsBatchCompatible, each object usually owns its material buffer
+			b->Compile(instancedBuilder);
+			constants.push_back(pConstants);
+			continue;
+		}
+		if (dynamic_cast<const VertexShader*>(b.get()))
+		{
+			pInstancedVertexShader->Compile(instancedBuilder);
+		}
+		else if (dynamic_cast<const InputLayout*>(b.get()))
+		{
+			pInstancedInputLayout->Compile(instancedBuilder);
+		}
+		else
+		{
+			b->Compile(instancedBuilder);
+		}
+		signature.push_back(b.get());
+	}
+	instancedPacket = instancedBuilder.Build();
+	batchSignature = std::move(signature);
+	batchConstants = std::move(constants);
+	instanceable = true;
+}
+
+void Step::SetInstancedVariant(std::shared_ptr<VertexShader> pVertexShader, std::shared_ptr<InputLayout> pInputLayout)
+{
+	pInstancedVertexShader = std::move(pVertexShader);
+	pInstancedInputLayout = std::move(pInputLayout);
+	Compile();
+}
+
+bool Step::IsInstanceable() const noexcept
+{
+	return instanceable;
+}
+
+bool Step::IsBatchCompatible(const Step& other) const noexcept
+{
+	return instanceable && other.instanceable &&
+		pInstancedVertexShader == other.pInstancedVertexShader &&
+		pInstancedInputLayout == other.pInstancedInputLayout &&
+		batchSignature == other.batchSignature &&
+		std::equal(batchConstants.begin(), batchConstants.end(), other.batchConstants.begin(), other.batchConstants.end(),
+			[](const CachingDynamicConstantBufferBindable* pLeft, const CachingDynamicConstantBufferBindable* pRight)
+			{
+				return pLeft->HasSameContents(*pRight);
+			});
+}
+
+void Step::BindInstanced(Graphics& gfx) const
+{
+	instancedPacket.Execute(gfx);
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "RenderPass/Technique.h"
+#include "Renderable/Renderable.h"
+#include <cassert>
 
 Technique::Technique(std::string name) noexcept : name(name)
 {
@@ -15,8 +17,21 @@ void Technique::Submit(class FrameManager& frameManager, const class Renderable&
 	}
 }
 
+void Technique::Retain(FrameManager::Registration& registration, const Renderable& renderable) const
+{
+	if (active)
+	{
+		for (const auto& step : steps)
+		{
+			step.Retain(registration, renderable);
+		}
+	}
+}
+
 void Technique::AddStep(Step step) noexcept
 {
+	// retained jobs point at the steps, so they must not move once the owner is registered
+	assert((pOwner == nullptr || !pOwner->IsRegistered()) && "Adding a step to a registered renderable");
 	steps.push_back(std::move(step));
 }
 
@@ -41,7 +56,20 @@ const std::string& Technique::GetName() const noexcept
 
 void Technique::SetActiveState(bool state) noexcept
 {
+	if (active == state)
+	{
+		return;
+	}
 	active = state;
+	if (pOwner != nullptr)
+	{
+		pOwner->OnTechniqueStateChanged();
+	}
+}
+
+void Technique::SetOwner(Renderable* pOwner_in) noexcept
+{
+	pOwner = pOwner_in;
 }
 
 void Technique::InitializeParentReferences(const class Renderable& parent) const
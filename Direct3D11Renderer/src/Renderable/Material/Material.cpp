@@ -1,11 +1,22 @@
 #include "Renderable/Material/Material.h"
 #include "DynamicConstantBuffer/DynamicConstantBuffer.h"
+#include "DynamicConstantBuffer/LayoutRegistry.h"
 #include "Bindable/DynamicConstantBufferBindable.h"
+#include <cassert>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+	// optimization reports by mesh tag, a few dozen bytes for every mesh optimized in this process
+	std::mutex reportMutex;
+	std::unordered_map<std::string, D3::MeshOptimizer::Report> reports;
+}
 
 namespace D3
 {
-	Material::Material(Graphics& gfx, const aiMaterial& material, const std::filesystem::path& modelPath) noexcept
-		: modelPath(modelPath.string())
+	Material::Material(Graphics& gfx, const aiMaterial& material, const std::filesystem::path& modelPath, bool compressVertices) noexcept
+		: modelPath(modelPath.string()), compressVertices(compressVertices)
 	{
 		const auto rootPath = modelPath.parent_path().string() + "\\";
 		{
@@ -17,107 +28,100 @@ namespace D3
 		{
 			Technique phong("Phong");
 			Step step(0);
-			std::string shaderCode = "Phong";
-			aiString textureFileName;
+			aiString diffuseFile;
+			aiString specularFile;
+			aiString normalFile;
+			const bool hasDiffuse = material.GetTexture(aiTextureType_DIFFUSE, 0, &diffuseFile) == aiReturn_SUCCESS;
+			const bool hasSpecular = material.GetTexture(aiTextureType_SPECULAR, 0, &specularFile) == aiReturn_SUCCESS;
+			const bool hasNormal = material.GetTexture(aiTextureType_NORMALS, 0, &normalFile) == aiReturn_SUCCESS;
 
-			// Common
-			vertexLayout.Append(D3::VertexLayout::ElementType::Position3D);
-			vertexLayout.Append(D3::VertexLayout::ElementType::Normal);
-			LayoutBuilder pscLayout;
-			bool hasTexture = false;
-			bool hasGlossAlpha = false;
+			// Picks the richest BlinnPhong shader family the maps allow. Normal and specular maps are
+			// only sampled with a diffuse map, a specular map without a normal map is not used.
+			const bool normalMapped = hasDiffuse && hasNormal;
+			const bool specularMapped = normalMapped && hasSpecular;
+			const std::string family = !hasDiffuse ? "Solid" : !normalMapped ? "Diffuse" : "NormalMapped";
 
-			// Diffuse
+			// Common
+			vertexLayout.Append(compressVertices ? D3::VertexLayout::ElementType::Position3DQuantized : D3::VertexLayout::ElementType::Position3D);
+			vertexLayout.Append(compressVertices ? D3::VertexLayout::ElementType::NormalOctahedral : D3::VertexLayout::ElementType::Normal);
+			if (normalMapped)
 			{
-				bool hasAlpha = false;
-				if (material.GetTexture(aiTextureType_DIFFUSE, 0, &textureFileName) == aiReturn_SUCCESS)
+				if (compressVertices)
 				{
-					hasTexture = true;
-					shaderCode += "Diff";
-					vertexLayout.Append(D3::VertexLayout::ElementType::Texture2D);
-					auto tex = Texture::Resolve(gfx, rootPath + textureFileName.C_Str());
-					if (tex->AlphaChannelLoaded())
-					{
-						hasAlpha = true;
-						shaderCode += "Msk";
-					}
-					step.AddBindable(std::move(tex));
+					vertexLayout.Append(D3::VertexLayout::ElementType::TangentFrameOctahedral);
 				}
 				else
 				{
-					pscLayout.Add<D3::ElementType::Float3>("materialColor");
+					vertexLayout.Append(D3::VertexLayout::ElementType::Tangent);
+					vertexLayout.Append(D3::VertexLayout::ElementType::Bitangent);
 				}
-				step.AddBindable(Rasterizer::Resolve(gfx, hasAlpha));
 			}
-			// Specular
+			if (hasDiffuse)
 			{
-				if (material.GetTexture(aiTextureType_SPECULAR, 0, &textureFileName) == aiReturn_SUCCESS)
-				{
-					hasTexture = true;
-					shaderCode += "Spc";
-					vertexLayout.Append(D3::VertexLayout::ElementType::Texture2D);
-					auto tex = Texture::Resolve(gfx, rootPath + textureFileName.C_Str(), 1);
-					hasGlossAlpha = tex->AlphaChannelLoaded();
-					step.AddBindable(std::move(tex));
-					pscLayout.Add<D3::ElementType::Bool>("useGlassAlpha");
-				}
-				pscLayout.Add<D3::ElementType::Float3>("specularColor");
-				pscLayout.Add<D3::ElementType::Float>("specularWeight");
-				pscLayout.Add<D3::ElementType::Float>("specularGloss");
+				vertexLayout.Append(compressVertices ? D3::VertexLayout::ElementType::Texture2DHalf : D3::VertexLayout::ElementType::Texture2D);
 			}
-			// Normal
+
+			// Textures
+			bool hasAlpha = false;
+			bool hasGlossAlpha = false;
+			if (hasDiffuse)
 			{
-				if (material.GetTexture(aiTextureType_NORMALS, 0, &textureFileName) == aiReturn_SUCCESS)
-				{
-					hasTexture = true;
-					shaderCode += "Nrm";
-					vertexLayout.Append(D3::VertexLayout::ElementType::Texture2D);
-					vertexLayout.Append(D3::VertexLayout::ElementType::Tangent);
-					vertexLayout.Append(D3::VertexLayout::ElementType::Bitangent);
-					auto tex = Texture::Resolve(gfx, rootPath + textureFileName.C_Str(), 2);
-					step.AddBindable(std::move(tex));
-					pscLayout.Add<D3::ElementType::Bool>("useNormalMap");
-					pscLayout.Add<D3::ElementType::Float>("normalMapWeight");
-				};
+				auto tex = Texture::Resolve(gfx, rootPath + diffuseFile.C_Str());
+				hasAlpha = tex->AlphaChannelLoaded();
+				step.AddBindable(std::move(tex));
+				step.AddBindable(Sampler::Resolve(gfx));
 			}
-			// common (post)
+			if (specularMapped)
 			{
-				step.AddBindable(std::make_shared<TransformConstantBuffer>(gfx, 0u));
-				step.AddBindable(Blender::Resolve(gfx, false));
-				auto pvs = VertexShader::Resolve(gfx, shaderCode + "VS.cso");
+				auto tex = Texture::Resolve(gfx, rootPath + specularFile.C_Str(), 1);
+				hasGlossAlpha = tex->AlphaChannelLoaded();
+				step.AddBindable(std::move(tex));
+			}
+			if (normalMapped)
+			{
+				step.AddBindable(Texture::Resolve(gfx, rootPath + normalFile.C_Str(), 2));
+			}
+			// alpha tested meshes (leaves, grates) are seen from both sides
+			step.AddBindable(Rasterizer::Resolve(gfx, hasAlpha));
+
+			// Shaders
+			{
+				const std::string shaderPath = "shaders\\Output\\BlinnPhong_";
+				const std::string psName = specularMapped
+					? (hasAlpha ? "SpecularNormalMapMasked_PS" : "SpecularNormalMapped_PS")
+					: family + "_PS";
+				auto pvs = VertexShader::Resolve(gfx, shaderPath + family + (compressVertices ? "_Quantized_VS.cso" : "_VS.cso"));
 				auto pvsbc = pvs->GetByteCode();
 				step.AddBindable(std::move(pvs));
-				step.AddBindable(PixelShader::Resolve(gfx, shaderCode + "PS.cso"));
+				step.AddBindable(PixelShader::Resolve(gfx, shaderPath + psName + ".cso"));
 				step.AddBindable(InputLayout::Resolve(gfx, vertexLayout, pvsbc));
-				if (hasTexture)
-				{
-					step.AddBindable(Sampler::Resolve(gfx));
-				}
-				// PS Material params (constant buffer)
-				D3::ConstantBufferData buffer{ std::move(pscLayout) };
-				if (auto r = buffer["materialColor"]; r.Exists())
-				{
-					aiColor3D color = { 0.45f, 0.45f, 0.85f };
-					material.Get(AI_MATKEY_COLOR_DIFFUSE, color);
-					r = reinterpret_cast<DirectX::XMFLOAT3&>(color);
-				}
-				buffer["useGlossAlpha"].TrySet(hasGlossAlpha);
-				if (auto r = buffer["specularColor"]; r.Exists())
-				{
-					aiColor3D color = { 0.18f,0.18f,0.18f };
-					material.Get(AI_MATKEY_COLOR_SPECULAR, color);
-					r = reinterpret_cast<DirectX::XMFLOAT3&>(color);
-				}
-				buffer["specularWeight"].TrySet(1.0f);
-				if (auto r = buffer["specularGloss"]; r.Exists())
+				step.AddBindable(std::make_shared<TransformConstantBuffer>(gfx, 0u));
+				step.AddBindable(Blender::Resolve(gfx, false));
+				// the quantized vertex shaders have no instanced variants
+				if (!compressVertices)
 				{
-					float gloss = 8.0f;
-					material.Get(AI_MATKEY_SHININESS, gloss);
-					r = gloss;
+					auto pivs = VertexShader::Resolve(gfx, shaderPath + family + "_Instanced_VS.cso");
+					auto pil = InputLayout::Resolve(gfx, vertexLayout, pivs->GetByteCode(), true);
+					step.SetInstancedVariant(std::move(pivs), std::move(pil));
 				}
-				buffer["useNormalMap"].TrySet(true);
-				buffer["normalMapWeight"].TrySet(1.0f);
-				step.AddBindable(std::make_unique<CachingDynamicPixelConstantBufferBindable>(gfx, std::move(buffer), 1u));
+
+				// PS material params, laid out like the shader's cbuffer; every family fills the members it has
+				const auto* pLayout = LayoutRegistry::Find("BlinnPhong_" + psName, 1u);
+				assert(pLayout != nullptr && "Material pixel shader has no generated cbuffer layout, rerun the generator");
+				D3::ConstantBufferData buffer{ *pLayout };
+				aiColor3D diffuseColor = { 0.45f, 0.45f, 0.85f };
+				material.Get(AI_MATKEY_COLOR_DIFFUSE, diffuseColor);
+				aiColor3D specularColor = { 0.18f, 0.18f, 0.18f };
+				material.Get(AI_MATKEY_COLOR_SPECULAR, specularColor);
+				float shininess = 35.0f;
+				material.Get(AI_MATKEY_SHININESS, shininess);
+				buffer["materialDiffuseColor"].TrySet(DirectX::XMFLOAT4{ diffuseColor.r, diffuseColor.g, diffuseColor.b, 1.0f });
+				buffer["specularReflectance"].TrySet((specularColor.r + specularColor.g + specularColor.b) / 3.0f);
+				buffer["specularShininess"].TrySet(shininess);
+				buffer["baseSpecularShininess"].TrySet(shininess);
+				buffer["hasGlossInAlphaChannel"].TrySet(hasGlossAlpha);
+				buffer["normalMappingEnabled"].TrySet(true);
+				step.AddBindable(std::make_unique<CachingDynamicConstantBufferBindable>(gfx, std::move(buffer), 1u));
 			}
 			phong.AddStep(std::move(step));
 			techniques.push_back(std::move(phong));
@@ -133,9 +137,9 @@ namespace D3
 		return VertexBuffer{ vertexLayout, mesh };
 	}
 
-	std::vector<unsigned short> Material::ExtractIndices(const aiMesh& mesh) const noexcept
+	std::vector<unsigned int> Material::ExtractIndices(const aiMesh& mesh) const noexcept
 	{
-		std::vector<unsigned short> indices;
+		std::vector<unsigned int> indices;
 		indices.reserve(mesh.mNumFaces * 3);
 		for (unsigned int i = 0; i < mesh.mNumFaces; i++)
 		{
@@ -148,23 +152,66 @@ namespace D3
 		return indices;
 	}
 
+	IndexedTriangleList Material::ExtractGeometry(const aiMesh& mesh, D3::MeshOptimizer::Report* pReport,
+		const D3::MeshOptimizer::Settings& settings) const noexcept
+	{
+		IndexedTriangleList geometry{ ExtractVertices(mesh), ExtractIndices(mesh) };
+		const auto report = D3::MeshOptimizer::Optimize(geometry.vertices, geometry.indices, settings);
+		if (pReport)
+		{
+			*pReport = report;
+		}
+		{
+			std::lock_guard lock(reportMutex);
+			reports[MakeMeshTag(mesh)] = report;
+		}
+		return geometry;
+	}
+
+	D3::MeshOptimizer::Report Material::GetOptimizationReport(const aiMesh& mesh) const
+	{
+		std::lock_guard lock(reportMutex);
+		const auto it = reports.find(MakeMeshTag(mesh));
+		return it != reports.end() ? it->second : D3::MeshOptimizer::Report{};
+	}
+
 	std::vector<Technique> Material::GetTechniques() const noexcept
 	{
 		return techniques;
 	}
 
-	std::shared_ptr<::VertexBuffer> Material::MakeVertexBufferBindable(Graphics& gfx, const aiMesh& mesh) const noexcept
+	std::shared_ptr<::VertexBuffer> Material::MakeVertexBufferBindable(Graphics& gfx, const aiMesh& mesh, const ::VertexBuffer::Source& vertices) const noexcept
+	{
+		return ::VertexBuffer::Resolve(gfx, MakeMeshTag(mesh), vertices);
+	}
+
+	std::shared_ptr<::IndexBuffer> Material::MakeIndexBufferBindable(Graphics& gfx, const aiMesh& mesh, const ::IndexBuffer::Source& indices) const noexcept
+	{
+		return ::IndexBuffer::Resolve(gfx, MakeMeshTag(mesh), indices);
+	}
+
+	std::shared_ptr<Bindable> Material::MakeVertexDecodeBindable(Graphics& gfx, const aiMesh& mesh) const noexcept
 	{
-		return ::VertexBuffer::Resolve(gfx, MakeMeshTag(mesh), ExtractVertices(mesh));
+		if (!compressVertices)
+		{
+			return nullptr;
+		}
+		// per mesh data, so not resolved through the cache (which keys constant buffers by slot)
+		return std::make_shared<VertexConstantBuffer<D3::VertexQuantization>>(gfx, D3::VertexQuantization::FromMesh(mesh), 1u);
 	}
 
-	std::shared_ptr<::IndexBuffer> Material::MakeIndexBufferBindable(Graphics& gfx, const aiMesh& mesh) const noexcept
+	D3::CompressionReport Material::MeasureVertexCompression(const aiMesh& mesh) const noexcept
 	{
-		return ::IndexBuffer::Resolve(gfx, MakeMeshTag(mesh), ExtractIndices(mesh));
+		if (!compressVertices)
+		{
+			return {};
+		}
+		return ExtractVertices(mesh).MeasureCompression(mesh);
 	}
 
 	std::string Material::MakeMeshTag(const aiMesh& mesh) const noexcept
 	{
-		return modelPath + "%" + mesh.mName.C_Str();
+		// compressed and float vertices of the same mesh are different buffers
+		return modelPath + "%" + mesh.mName.C_Str() + (compressVertices ? "%q" : "");
 	}
 }
\ No newline at end of file
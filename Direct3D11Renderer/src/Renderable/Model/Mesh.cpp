@@ -1,20 +1,70 @@
 #include "Renderable/Model/Mesh.h"
 #include "Bindable/BindableCommon.h"
+#include "Renderable/Material/Material.h"
+#include <scene.h>
 
 Mesh::Mesh(Graphics& gfx, const D3::Material& material, const aiMesh& mesh) noexcept
-    : Renderable(gfx, material, mesh)
+    : Renderable(gfx, material, mesh), compressionReport(material.MeasureVertexCompression(mesh))
 {
+    for (unsigned int i = 0; i < mesh.mNumVertices; i++)
+    {
+        bounds.Merge(*reinterpret_cast<const DirectX::XMFLOAT3*>(&mesh.mVertices[i]));
+    }
 }
 
 void Mesh::Submit(FrameManager& frameManager, DirectX::FXMMATRIX accumulatedTransform) const noexcept
 {
-    DirectX::XMStoreFloat4x4(&transform, accumulatedTransform);
+    SetTransform(accumulatedTransform);
 	this->Renderable::Submit(frameManager);
 }
 
+void Mesh::SetTransform(DirectX::FXMMATRIX accumulatedTransform) const noexcept
+{
+    DirectX::XMStoreFloat4x4(&transform, accumulatedTransform);
+}
+
 DirectX::XMMATRIX Mesh::GetTransformXM() const noexcept
 {
     return DirectX::XMLoadFloat4x4(&transform);
 }
 
+const AABB& Mesh::GetBounds() const noexcept
+{
+    return bounds;
+}
+
+void Mesh::MakeOccluder(const aiMesh& mesh)
+{
+    pOccluder = std::make_unique<OcclusionBuffer::OccluderMesh>();
+    pOccluder->positions.reserve(mesh.mNumVertices);
+    for (unsigned int i = 0; i < mesh.mNumVertices; i++)
+    {
+        pOccluder->positions.push_back(*reinterpret_cast<const DirectX::XMFLOAT3*>(&mesh.mVertices[i]));
+    }
+    pOccluder->indices.reserve(size_t(mesh.mNumFaces) * 3u);
+    for (unsigned int i = 0; i < mesh.mNumFaces; i++)
+    {
+        const auto& face = mesh.mFaces[i];
+        if (face.mNumIndices == 3u)
+        {
+            pOccluder->indices.insert(pOccluder->indices.end(), face.mIndices, face.mIndices + 3u);
+        }
+    }
+}
+
+const OcclusionBuffer::OccluderMesh* Mesh::GetOccluder() const noexcept
+{
+    return pOccluder.get();
+}
+
+const D3::CompressionReport& Mesh::GetCompressionReport() const noexcept
+{
+    return compressionReport;
+}
+
+const D3::MeshOptimizer::Report& Mesh::GetOptimizationReport() const noexcept
+{
+    return optimizationReport;
+}
+
 
@@ -3,8 +3,11 @@
 #include "Bindable/DynamicConstantBufferBindable.h"
 #include "DynamicConstantBuffer/LayoutCache.h"
 #include "Exceptions/ModelException.h"
+#include "Renderable/Material/Material.h"
 #include "Geometry/Vertex.h"
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <imgui.h>
 #include <unordered_map>
 #include <filesystem>
@@ -20,20 +23,110 @@ Node::Node(int id, const std::string& name, std::vector<Mesh*> meshesIn, const D
     DirectX::XMStoreFloat4x4(&appliedTransform, DirectX::XMMatrixIdentity());
 }
 
-void Node::Submit(FrameManager& frameManager, DirectX::FXMMATRIX parentTransform) const noexcept
+void Node::Submit(FrameManager& frameManager, DirectX::FXMMATRIX parentTransform, const Frustum& frustum,
+    OcclusionBuffer* pOcclusion, CullStats& stats) const noexcept
 {
     const auto built = 
         DirectX::XMLoadFloat4x4(&appliedTransform) * 
         DirectX::XMLoadFloat4x4(&transform) * 
         parentTransform;
-        
+
+    // true if the box survives both tests, counting the meshes it stands for otherwise
+    const auto isVisible = [&](const AABB& box, size_t meshCount)
+    {
+        if (!frustum.Intersects(box))
+        {
+            stats.culled += meshCount;
+            return false;
+        }
+        if (pOcclusion != nullptr && !pOcclusion->IsVisible(box))
+        {
+            stats.culled += meshCount;
+            stats.occluded += meshCount;
+            return false;
+        }
+        return true;
+    };
+
+    if (!isVisible(bounds.Transformed(built), subtreeMeshCount))
+    {
+        return;
+    }
+
+    // a node with several meshes or children can still reject some of its meshes individually
+    const bool testMeshes = meshes.size() > 1 || !children.empty();
     for (auto* m : meshes)
     {
+        if (testMeshes && !isVisible(m->GetBounds().Transformed(built), 1u))
+        {
+            continue;
+        }
         m->Submit(frameManager, built);
+        stats.submitted++;
     }
     for (const auto& child : children)
     {
-        child->Submit(frameManager, built);
+        child->Submit(frameManager, built, frustum, pOcclusion, stats);
+    }
+}
+
+void Node::AddOccluders(OcclusionBuffer& occlusion, DirectX::FXMMATRIX parentTransform, const Frustum& frustum) const
+{
+    const auto built =
+        DirectX::XMLoadFloat4x4(&appliedTransform) *
+        DirectX::XMLoadFloat4x4(&transform) *
+        parentTransform;
+
+    if (!frustum.Intersects(bounds.Transformed(built)))
+    {
+        return;
+    }
+    for (auto* m : meshes)
+    {
+        if (m->GetOccluder() != nullptr && frustum.Intersects(m->GetBounds().Transformed(built)))
+        {
+            occlusion.AddOccluder(*m->GetOccluder(), built);
+        }
+    }
+    for (const auto& child : children)
+    {
+        child->AddOccluders(occlusion, built, frustum);
+    }
+}
+
+void Node::UpdateBounds() noexcept
+{
+    bounds = {};
+    subtreeMeshCount = meshes.size();
+    for (auto* m : meshes)
+    {
+        bounds.Merge(m->GetBounds());
+    }
+    for (const auto& child : children)
+    {
+        child->UpdateBounds();
+        const auto childTransform =
+            DirectX::XMLoadFloat4x4(&child->appliedTransform) *
+            DirectX::XMLoadFloat4x4(&child->transform);
+        bounds.Merge(child->bounds.Transformed(childTransform));
+        subtreeMeshCount += child->subtreeMeshCount;
+    }
+}
+
+void Node::UpdateTransforms(DirectX::FXMMATRIX parentTransform) const noexcept
+{
+    const auto built =
+        DirectX::XMLoadFloat4x4(&appliedTransform) *
+        DirectX::XMLoadFloat4x4(&transform) *
+        parentTransform;
+
+    for (auto* m : meshes)
+    {
+        m->SetTransform(built);
+    }
+    for (const auto& child : children)
+    {
+        child->UpdateTransforms(built);
     }
 }
 
@@ -68,9 +161,16 @@ void Node::AddChild(std::unique_ptr<Node> child) noexcept
     children.push_back(std::move(child));
 }
 
-void Node::SetAppliedTransform(DirectX::FXMMATRIX transform) noexcept
+bool Node::SetAppliedTransform(DirectX::FXMMATRIX transform) noexcept
 {
-    DirectX::XMStoreFloat4x4(&appliedTransform, transform);
+    DirectX::XMFLOAT4X4 applied;
+    DirectX::XMStoreFloat4x4(&applied, transform);
+    if (std::memcmp(&applied, &appliedTransform, sizeof(applied)) == 0)
+    {
+        return false;
+    }
+    appliedTransform = applied;
+    return true;
 }
 
 int Node::GetId() const noexcept
@@ -179,7 +279,7 @@ private:
     } modelPose;
 };
 
-Model::Model(Graphics& gfx, const std::string& modelPath, float scale) : pWindow(std::make_unique<ModelWindow>()), scale(scale)
+Model::Model(Graphics& gfx, const std::string& modelPath, float scale, bool compressVertices) : pWindow(std::make_unique<ModelWindow>()), scale(scale)
 {
     Assimp::Importer importer;
     const aiScene* scene = importer.ReadFile(
@@ -196,24 +296,135 @@ Model::Model(Graphics& gfx, const std::string& modelPath, float scale) : pWindow
         throw ModelException(__LINE__, __FILE__, importer.GetErrorString());
     }
 
+    // one material per aiMaterial, its shaders and textures are shared by every mesh using it
+    std::vector<D3::Material> materials;
+    materials.reserve(scene->mNumMaterials);
+    for (unsigned int i = 0; i < scene->mNumMaterials; ++i)
+    {
+        materials.emplace_back(gfx, *scene->mMaterials[i], modelPath, compressVertices);
+    }
     for (unsigned int i = 0; i < scene->mNumMeshes; ++i)
     {
-        meshes.push_back(BuildMesh(gfx, *scene->mMeshes[i], scene->mMaterials, modelPath));
+        meshes.push_back(BuildMesh(gfx, *scene->mMeshes[i], materials));
     }
+
+    // Meshes that span a good part of the model (walls, floors) are worth rasterizing as occluders.
+    // Measured on the untransformed mesh bounds, which is close enough for picking candidates.
+    AABB modelBounds;
+    for (const auto& mesh : meshes)
+    {
+        modelBounds.Merge(mesh->GetBounds());
+    }
+    const auto largestExtent = [](const AABB& box)
+    {
+        return std::max({ box.max.x - box.min.x, box.max.y - box.min.y, box.max.z - box.min.z });
+    };
+    const float occluderSize = largestExtent(modelBounds) * OccluderSizeFraction;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i)
+    {
+        if (!meshes[i]->GetBounds().IsEmpty() && largestExtent(meshes[i]->GetBounds()) >= occluderSize)
+        {
+            meshes[i]->MakeOccluder(*scene->mMeshes[i]);
+        }
+    }
+
     int nextId = 0;
     root = BuildNode(nextId, *scene->mRootNode);
+    root->UpdateBounds();
 }
 
 void Model::Submit(FrameManager& frameManager) const noexcept
+{
+    Submit(frameManager, Frustum{});
+}
+
+void Model::Submit(FrameManager& frameManager, const Frustum& frustum) const noexcept
+{
+    Submit(frameManager, frustum, nullptr);
+}
+
+void Model::Submit(FrameManager& frameManager, const Frustum& frustum, OcclusionBuffer& occlusion) const noexcept
+{
+    Submit(frameManager, frustum, &occlusion);
+}
+
+void Model::AddOccluders(OcclusionBuffer& occlusion, const Frustum& frustum) const
+{
+    if (transformsDirty)
+    {
+        root->UpdateBounds();
+    }
+    root->AddOccluders(occlusion, GetRootTransform(), frustum);
+}
+
+void Model::Submit(FrameManager& frameManager, const Frustum& frustum, OcclusionBuffer* pOcclusion) const noexcept
 {
     // Apply transform to selected node if any
     if (auto node = pWindow->GetSelectedNode())
     {
-        node->SetAppliedTransform(pWindow->GetTransform());
+        transformsDirty = node->SetAppliedTransform(pWindow->GetTransform()) || transformsDirty;
+    }
+
+    if (transformsDirty)
+    {
+        root->UpdateBounds();
+    }
+
+    // Retained meshes are already queued, they only need new transforms when something moved
+    if (retained)
+    {
+        if (transformsDirty)
+        {
+            root->UpdateTransforms(GetRootTransform());
+        }
+        transformsDirty = false;
+        return;
     }
+    transformsDirty = false;
+
+    cullStats = {};
+    root->Submit(frameManager, GetRootTransform(), frustum, pOcclusion, cullStats);
+}
+
+const Node::CullStats& Model::GetCullStats() const noexcept
+{
+    return cullStats;
+}
 
-    // Render the model with identity as initial transform
-    root->Submit(frameManager, DirectX::XMMatrixIdentity());
+D3::CompressionReport Model::GetCompressionReport() const noexcept
+{
+    D3::CompressionReport total;
+    for (const auto& mesh : meshes)
+    {
+        const auto& report = mesh->GetCompressionReport();
+        total.vertexCount += report.vertexCount;
+        total.rawBytes += report.rawBytes;
+        total.compressedBytes += report.compressedBytes;
+        total.maxPositionError = std::max(total.maxPositionError, report.maxPositionError);
+        total.maxNormalErrorDegrees = std::max(total.maxNormalErrorDegrees, report.maxNormalErrorDegrees);
+        total.maxTangentErrorDegrees = std::max(total.maxTangentErrorDegrees, report.maxTangentErrorDegrees);
+        total.maxTexCoordError = std::max(total.maxTexCoordError, report.maxTexCoordError);
+    }
+    return total;
+}
+
+void Model::Register(FrameManager& frameManager)
+{
+    for (auto& mesh : meshes)
+    {
+        mesh->Register(frameManager);
+    }
+    retained = true;
+    transformsDirty = true;
+}
+
+void Model::Unregister() noexcept
+{
+    for (auto& mesh : meshes)
+    {
+        mesh->Unregister();
+    }
+    retained = false;
 }
 
 void Model::ShowModelControlWindow(const char* windowName) noexcept
@@ -224,300 +435,23 @@ void Model::ShowModelControlWindow(const char* windowName) noexcept
 void Model::SetScale(float scale) noexcept
 {
     this->scale = scale;
+    transformsDirty = true;
 }
 
-std::unique_ptr<Mesh> Model::BuildMesh(
-    Graphics& gfx,
-    const aiMesh& mesh, 
-    const aiMaterial* const* pMaterials,
-    const std::filesystem::path& modelPath)
+void Model::SetRootTransform(DirectX::FXMMATRIX transform) noexcept
 {
- //   using namespace DirectX;
-
- //   std::vector<std::shared_ptr<Bindable>> bindablePtrs;
-
- //   const auto rootPath = modelPath.parent_path().string() + "\\";
-
- //   bool hasSpecularTexture = false;
- //   bool hasNormalTexture = false;
- //   bool hasDiffuseTexture = false;
-	//bool hasGlossMapInSpecularAlpha = false;
- //   bool hasAlphaChannelInDiffuse = false;
- //   float shininess = 35.0f;
- //   XMFLOAT4 meshSpecularColor = { 0.18f, 0.18f, 0.18f, 1.0f };
-	//XMFLOAT4 meshDiffuseColor = { 0.45f, 0.45f, 0.45f, 1.0f };
-
- //   const std::string shaderBasePath = "shaders/Output/";
-
- //   if (mesh.mMaterialIndex >= 0)
- //   {
- //       auto& material = *pMaterials[mesh.mMaterialIndex];
- //       aiString textureFileName;
-
- //       if(material.GetTexture(aiTextureType_DIFFUSE, 0, &textureFileName) == aiReturn_SUCCESS)
- //       {
- //           auto texture = Texture::Resolve(gfx, rootPath + textureFileName.C_Str(), 0u);
- //           hasAlphaChannelInDiffuse = texture->AlphaChannelLoaded();
-	//		bindablePtrs.push_back(std::move(texture));
-	//		hasDiffuseTexture = true;
- //       }
- //       else
- //       {
-	//		material.Get(AI_MATKEY_COLOR_DIFFUSE, reinterpret_cast<aiColor3D&>(meshDiffuseColor));
- //       }
-
- //       if (material.GetTexture(aiTextureType_SPECULAR, 0, &textureFileName) == aiReturn_SUCCESS)
- //       {
-	//		auto specularTexture = Texture::Resolve(gfx, rootPath + textureFileName.C_Str(), 1u);
- //           hasGlossMapInSpecularAlpha = specularTexture->AlphaChannelLoaded();
- //           bindablePtrs.push_back(std::move(specularTexture));
- //           hasSpecularTexture = true;
- //       }
- //       else
- //       {
-	//		material.Get(AI_MATKEY_COLOR_SPECULAR, reinterpret_cast<aiColor3D&>(meshSpecularColor));
- //       }
- //       if (!hasGlossMapInSpecularAlpha)
- //       {
-	//		material.Get(AI_MATKEY_SHININESS, hasGlossMapInSpecularAlpha);
- //       }
-
- //       if(material.GetTexture(aiTextureType_NORMALS, 0, &textureFileName) == aiReturn_SUCCESS)
- //       {
-	//		auto normalMap = Texture::Resolve(gfx, rootPath + textureFileName.C_Str(), 2u);
-	//		hasGlossMapInSpecularAlpha = normalMap->AlphaChannelLoaded();
- //           bindablePtrs.push_back(std::move(normalMap));
- //           hasNormalTexture = true;
-	//	}
-
- //       if(hasDiffuseTexture || hasSpecularTexture || hasNormalTexture)
- //       {
- //           bindablePtrs.push_back(Sampler::Resolve(gfx));
-	//	}
-
- //       const std::string meshTag = modelPath.string() + "%" + mesh.mName.C_Str();
-
- //       if (hasDiffuseTexture && hasNormalTexture && hasSpecularTexture)
- //       {
- //           D3::VertexLayout layout;
- //           layout.Append(D3::VertexLayout::Position3D)
- //               .Append(D3::VertexLayout::Normal)
- //               .Append(D3::VertexLayout::Tangent)
- //               .Append(D3::VertexLayout::Bitangent)
- //               .Append(D3::VertexLayout::Texture2D);
- //           D3::VertexBuffer vertexBuffer(layout);
-
- //           for (unsigned int i = 0; i < mesh.mNumVertices; i++)
- //           {
- //               vertexBuffer.EmplaceBack(
- //                   XMFLOAT3(mesh.mVertices[i].x * scale, mesh.mVertices[i].y * scale, mesh.mVertices[i].z * scale),
- //                   *reinterpret_cast<XMFLOAT3*>(&mesh.mNormals[i]),
- //                   *reinterpret_cast<XMFLOAT3*>(&mesh.mTangents[i]),
- //                   *reinterpret_cast<XMFLOAT3*>(&mesh.mBitangents[i]),
- //                   *reinterpret_cast<XMFLOAT2*>(&mesh.mTextureCoords[0][i])
- //               );
- //           }
-
- //           std::vector<unsigned short> indices;
- //           indices.reserve(mesh.mNumFaces * 3);
- //           for(unsigned int i = 0; i < mesh.mNumFaces; i++)
- //           {
- //               const auto& face = mesh.mFaces[i];
- //               assert(face.mNumIndices == 3);
- //               indices.push_back(static_cast<unsigned short>(face.mIndices[0]));
- //               indices.push_back(static_cast<unsigned short>(face.mIndices[1]));
- //               indices.push_back(static_cast<unsigned short>(face.mIndices[2]));
-	//		}
-
- //           bindablePtrs.push_back(VertexBuffer::Resolve(gfx, meshTag, vertexBuffer));
-	//		bindablePtrs.push_back(IndexBuffer::Resolve(gfx, meshTag, indices));
-
-	//		auto vertexShader = VertexShader::Resolve(gfx, shaderBasePath + "BlinnPhong_NormalMapped_VS.cso");
- //           auto vertexShaderByteCode = vertexShader->GetByteCode();
- //           bindablePtrs.push_back(std::move(vertexShader));
-	//		bindablePtrs.push_back(PixelShader::Resolve(gfx, hasAlphaChannelInDiffuse ? 
- //               shaderBasePath + "BlinnPhong_SpecularNormalMapMasked_PS.cso" : shaderBasePath + "BlinnPhong_SpecularNormalMapped_PS.cso"));
-	//		bindablePtrs.push_back(InputLayout::Resolve(gfx, vertexBuffer.GetLayout(), vertexShaderByteCode));
-
- //           D3::LayoutBuilder cbLayoutBuilder;
- //           cbLayoutBuilder.Add<D3::ElementType::Bool>("hasAlphaChannel");
- //           cbLayoutBuilder.Add<D3::ElementType::Bool>("specularMapEnabled");
- //           cbLayoutBuilder.Add<D3::ElementType::Float>("specularPowerConstant");
-
- //           auto cbLayout = D3::LayoutCache::Resolve(std::move(cbLayoutBuilder));
- //           D3::ConstantBufferData constantBuffer(cbLayout);
-
- //           constantBuffer["hasAlphaChannel"] = hasGlossMapInSpecularAlpha;
- //           constantBuffer["specularMapEnabled"] = true;
- //           constantBuffer["specularPowerConstant"] = shininess;
-
- //           bindablePtrs.push_back(CachingDynamicPixelConstantBufferBindable::Resolve(gfx, constantBuffer, 1u));
- //       }
- //       else if (hasDiffuseTexture && hasNormalTexture)
- //       {
- //           D3::VertexLayout layout;
- //           layout.Append(D3::VertexLayout::Position3D)
- //               .Append(D3::VertexLayout::Normal)
- //               .Append(D3::VertexLayout::Tangent)
- //               .Append(D3::VertexLayout::Bitangent)
- //               .Append(D3::VertexLayout::Texture2D);
- //           D3::VertexBuffer vertexBuffer(layout);
-
- //           for (unsigned int i = 0; i < mesh.mNumVertices; i++)
- //           {
- //               vertexBuffer.EmplaceBack(
- //                   XMFLOAT3(mesh.mVertices[i].x * scale, mesh.mVertices[i].y * scale, mesh.mVertices[i].z * scale),
- //                   *reinterpret_cast<XMFLOAT3*>(&mesh.mNormals[i]),
- //                   *reinterpret_cast<XMFLOAT3*>(&mesh.mTangents[i]),
- //                   *reinterpret_cast<XMFLOAT3*>(&mesh.mBitangents[i]),
- //                   *reinterpret_cast<XMFLOAT2*>(&mesh.mTextureCoords[0][i])
- //               );
- //           }
-
- //           std::vector<unsigned short> indices;
- //           indices.reserve(mesh.mNumFaces * 3);
- //           for (unsigned int i = 0; i < mesh.mNumFaces; i++)
- //           {
- //               const auto& face = mesh.mFaces[i];
- //               assert(face.mNumIndices == 3);
- //               indices.push_back(static_cast<unsigned short>(face.mIndices[0]));
- //               indices.push_back(static_cast<unsigned short>(face.mIndices[1]));
- //               indices.push_back(static_cast<unsigned short>(face.mIndices[2]));
- //           }
-
- //           bindablePtrs.push_back(VertexBuffer::Resolve(gfx, meshTag, vertexBuffer));
- //           bindablePtrs.push_back(IndexBuffer::Resolve(gfx, meshTag, indices));
-
- //           auto vertexShader = VertexShader::Resolve(gfx, shaderBasePath + "BlinnPhong_NormalMapped_VS.cso");
- //           auto vertexShaderByteCode = vertexShader->GetByteCode();
- //           bindablePtrs.push_back(std::move(vertexShader));
- //           bindablePtrs.push_back(PixelShader::Resolve(gfx, shaderBasePath + "BlinnPhong_NormalMapped_PS.cso"));
- //           bindablePtrs.push_back(InputLayout::Resolve(gfx, vertexBuffer.GetLayout(), vertexShaderByteCode));
-
- //           D3::LayoutBuilder cbLayoutBuilder;
- //           cbLayoutBuilder.Add<D3::ElementType::Float>("specularIntensity");
- //           cbLayoutBuilder.Add<D3::ElementType::Float>("specularPower");
- //           cbLayoutBuilder.Add<D3::ElementType::Bool>("normalMapEnabled");
-
- //           auto cbLayout = D3::LayoutCache::Resolve(std::move(cbLayoutBuilder));
- //           D3::ConstantBufferData constantBuffer(cbLayout);
-
- //           constantBuffer["specularPower"] = shininess;
- //           constantBuffer["specularIntensity"] = (meshSpecularColor.x + meshSpecularColor.y + meshSpecularColor.z) / 3.0f;
- //           constantBuffer["normalMapEnabled"] = true;
-
- //           bindablePtrs.push_back(CachingDynamicPixelConstantBufferBindable::Resolve(gfx, constantBuffer, 1u));
- //       }
- //       else if (hasDiffuseTexture)
- //       {
-	//		D3::VertexLayout layout;
-	//		layout.Append(D3::VertexLayout::Position3D)
-	//			.Append(D3::VertexLayout::Normal)
-	//			.Append(D3::VertexLayout::Texture2D);
-	//		D3::VertexBuffer vertexBuffer(layout);
-
- //           for (unsigned int i = 0; i < mesh.mNumVertices; i++)
- //           {
- //               vertexBuffer.EmplaceBack(
- //                   XMFLOAT3(mesh.mVertices[i].x * scale, mesh.mVertices[i].y * scale, mesh.mVertices[i].z * scale),
- //                   *reinterpret_cast<XMFLOAT3*>(&mesh.mNormals[i]),
- //                   *reinterpret_cast<XMFLOAT2*>(&mesh.mTextureCoords[0][i])
-	//			);
- //           }
-
-	//		std::vector<unsigned short> indices;
-	//		indices.reserve(mesh.mNumFaces * 3);
- //           for (unsigned int i = 0; i < mesh.mNumFaces; i++)
- //           {
-	//			const auto& face = mesh.mFaces[i];
-	//			assert(face.mNumIndices == 3);
-	//			indices.push_back(static_cast<unsigned short>(face.mIndices[0]));
-	//			indices.push_back(static_cast<unsigned short>(face.mIndices[1]));
-	//			indices.push_back(static_cast<unsigned short>(face.mIndices[2]));
- //           }
-
-	//		bindablePtrs.push_back(VertexBuffer::Resolve(gfx, meshTag, vertexBuffer));
-	//		bindablePtrs.push_back(IndexBuffer::Resolve(gfx, meshTag, indices));
-
- //           auto vertexShader = VertexShader::Resolve(gfx, shaderBasePath + "BlinnPhong_Diffuse_VS.cso");
-	//		auto vertexShaderByteCode = vertexShader->GetByteCode();
-
-	//		bindablePtrs.push_back(std::move(vertexShader));
-	//		bindablePtrs.push_back(PixelShader::Resolve(gfx, shaderBasePath + "BlinnPhong_Diffuse_PS.cso"));
- //           bindablePtrs.push_back(InputLayout::Resolve(gfx, vertexBuffer.GetLayout(), vertexShaderByteCode));
- //           D3::LayoutBuilder cbLayoutBuilder;
- //           cbLayoutBuilder.Add<D3::ElementType::Float>("specularIntensity");
- //           cbLayoutBuilder.Add<D3::ElementType::Float>("specularPower");
-
- //           auto cbLayout = D3::LayoutCache::Resolve(std::move(cbLayoutBuilder));
- //           D3::ConstantBufferData constantBuffer(cbLayout);
-
- //           constantBuffer["specularPower"] = shininess;
- //           constantBuffer["specularIntensity"] = (meshSpecularColor.x + meshSpecularColor.y + meshSpecularColor.z) / 3.0f;
-
- //           bindablePtrs.push_back(CachingDynamicPixelConstantBufferBindable::Resolve(gfx, constantBuffer, 1u));
- //       }
- //       else if (!hasDiffuseTexture && !hasNormalTexture && !hasSpecularTexture)
- //       {
- //           D3::VertexLayout layout;
- //           layout.Append(D3::VertexLayout::Position3D)
- //               .Append(D3::VertexLayout::Normal);
- //           D3::VertexBuffer vertexBuffer(layout);
- //           for (unsigned int i = 0; i < mesh.mNumVertices; i++)
- //           {
- //               vertexBuffer.EmplaceBack(
- //                   XMFLOAT3(mesh.mVertices[i].x * scale, mesh.mVertices[i].y * scale, mesh.mVertices[i].z * scale),
- //                   *reinterpret_cast<XMFLOAT3*>(&mesh.mNormals[i])
- //               );
- //           }
- //           std::vector<unsigned short> indices;
- //           indices.reserve(mesh.mNumFaces * 3);
- //           for (unsigned int i = 0; i < mesh.mNumFaces; i++)
- //           {
- //               const auto& face = mesh.mFaces[i];
- //               assert(face.mNumIndices == 3);
- //               indices.push_back(static_cast<unsigned short>(face.mIndices[0]));
- //               indices.push_back(static_cast<unsigned short>(face.mIndices[1]));
- //               indices.push_back(static_cast<unsigned short>(face.mIndices[2]));
- //           }
- //           bindablePtrs.push_back(VertexBuffer::Resolve(gfx, meshTag, vertexBuffer));
- //           bindablePtrs.push_back(IndexBuffer::Resolve(gfx, meshTag, indices));
- //           auto vertexShader = VertexShader::Resolve(gfx, shaderBasePath + "BlinnPhong_Solid_VS.cso");
- //           auto vertexShaderByteCode = vertexShader->GetByteCode();
- //           bindablePtrs.push_back(std::move(vertexShader));
- //           bindablePtrs.push_back(PixelShader::Resolve(gfx, shaderBasePath + "BlinnPhong_Solid_PS.cso"));
- //           bindablePtrs.push_back(InputLayout::Resolve(gfx, vertexBuffer.GetLayout(), vertexShaderByteCode));
- //           D3::LayoutBuilder cbLayoutBuilder;
- //           cbLayoutBuilder.Add<D3::ElementType::Float4>("materialColor");
- //           cbLayoutBuilder.Add<D3::ElementType::Float>("specularIntensity");
- //           cbLayoutBuilder.Add<D3::ElementType::Float>("specularPower");
-
- //           auto cbLayout = D3::LayoutCache::Resolve(std::move(cbLayoutBuilder));
- //           D3::ConstantBufferData constantBuffer(cbLayout);
-
- //           constantBuffer["specularPower"] = shininess;
- //           constantBuffer["specularIntensity"] = (meshSpecularColor.x + meshSpecularColor.y + meshSpecularColor.z) / 3.0f;
- //           constantBuffer["materialColor"] = meshDiffuseColor;
-
- //           bindablePtrs.push_back(CachingDynamicPixelConstantBufferBindable::Resolve(gfx, constantBuffer, 1u));
- //       }
-
-	//	// Setup Rasterizer based on if there's alpha in diffuse map
-	//	// If there's alpha, disable backface culling to avoid visual artifacts when viewing the model from certain angles
-	//	bindablePtrs.push_back(Rasterizer::Resolve(gfx, hasAlphaChannelInDiffuse));
-
-	//	bindablePtrs.push_back(Topology::Resolve(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST));
-
- //       bindablePtrs.push_back(std::make_shared<Stencil>(gfx, Stencil::Mode::Off));
-    /*}
-    else
-    {
-		throw std::runtime_error("Mesh has no material.");
-    }
+    DirectX::XMStoreFloat4x4(&rootTransform, transform);
+    transformsDirty = true;
+}
 
-    return std::make_unique<Mesh>(gfx, std::move(bindablePtrs));*/
+DirectX::XMMATRIX Model::GetRootTransform() const noexcept
+{
+    return DirectX::XMMatrixScaling(scale, scale, scale) * DirectX::XMLoadFloat4x4(&rootTransform);
+}
 
-    return {};
+std::unique_ptr<Mesh> Model::BuildMesh(Graphics& gfx, const aiMesh& mesh, const std::vector<D3::Material>& materials)
+{
+    return std::make_unique<Mesh>(gfx, materials.at(mesh.mMaterialIndex), mesh);
 }
 
 std::unique_ptr<Node> Model::BuildNode(int& nextId, const aiNode& node) noexcept
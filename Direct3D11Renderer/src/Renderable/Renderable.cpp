@@ -4,14 +4,34 @@
 #include "Exceptions/GraphicsExceptions.h"
 #include "Renderable/Material/Material.h"
 #include <cassert>
+#include <optional>
 #include <typeinfo>
 #include <scene.h>
 
 Renderable::Renderable(Graphics& gfx, const D3::Material& material, const aiMesh& mesh) noexcept
 {
-	pVertices = material.MakeVertexBufferBindable(gfx, mesh);
-	pIndices = material.MakeIndexBufferBindable(gfx, mesh);
+	// Extracting and optimizing the geometry is the expensive part of loading a mesh, and both buffers
+	// are usually cached already when the same model is loaded again. It only runs for a cache miss,
+	// once for both buffers; the optimizer is deterministic, so a rebuilt buffer still matches the
+	// cached other half.
+	std::optional<IndexedTriangleList> geometry;
+	const auto getGeometry = [&]() -> const IndexedTriangleList&
+	{
+		if (!geometry)
+		{
+			geometry = material.ExtractGeometry(mesh, &optimizationReport);
+		}
+		return *geometry;
+	};
+	pVertices = material.MakeVertexBufferBindable(gfx, mesh, [&]() -> const D3::VertexBuffer& { return getGeometry().vertices; });
+	pIndices = material.MakeIndexBufferBindable(gfx, mesh, [&]() -> const std::vector<unsigned int>& { return getGeometry().indices; });
+	if (!geometry)
+	{
+		// both buffers were cached, the report is the one from when they were built
+		optimizationReport = material.GetOptimizationReport(mesh);
+	}
 	pTopology = Topology::Resolve(gfx, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	pVertexDecode = material.MakeVertexDecodeBindable(gfx, mesh);
 
 	for (auto& technique : material.GetTechniques())
 	{
@@ -27,9 +47,41 @@ void Renderable::Submit(FrameManager& frameManager) const noexcept
 	}
 }
 
+void Renderable::Register(FrameManager& frameManager)
+{
+	assert(!registration.IsActive() && "Renderable is already registered");
+	registration = frameManager.Register();
+	for (const auto& technique : techniques)
+	{
+		technique.Retain(registration, *this);
+	}
+}
+
+void Renderable::Unregister() noexcept
+{
+	registration.Reset();
+}
+
+bool Renderable::IsRegistered() const noexcept
+{
+	return registration.IsActive();
+}
+
+void Renderable::OnTechniqueStateChanged()
+{
+	if (auto* pFrameManager = registration.GetFrameManager())
+	{
+		Unregister();
+		Register(*pFrameManager);
+	}
+}
+
 void Renderable::AddTechnique(Technique technique) noexcept
 {
+	// techniques are moved on insertion, which would leave retained jobs pointing at stale steps
+	assert(!registration.IsActive() && "Adding a technique to a registered renderable");
 	technique.InitializeParentReferences(*this);
+	technique.SetOwner(this);
 	techniques.push_back(std::move(technique));
 }
 
@@ -38,6 +90,10 @@ void Renderable::Bind(Graphics& gfx) const noexcept
 	pVertices->Bind(gfx);
 	pIndices->Bind(gfx);
 	pTopology->Bind(gfx);
+	if (pVertexDecode)
+	{
+		pVertexDecode->Bind(gfx);
+	}
 }
 
 void Renderable::Accept(TechniqueProbe& probe)
@@ -48,6 +104,17 @@ void Renderable::Accept(TechniqueProbe& probe)
 	}
 }
 
+bool Renderable::SharesGeometry(const Renderable& other) const noexcept
+{
+	// decode constants are derived from the vertex data, so the same vertex buffer implies the same constants
+	return pVertices == other.pVertices && pIndices == other.pIndices && pTopology == other.pTopology;
+}
+
+uint64_t Renderable::GetGeometryId() const noexcept
+{
+	return uint64_t(reinterpret_cast<uintptr_t>(pVertices.get())) * 31u + uint64_t(reinterpret_cast<uintptr_t>(pIndices.get()));
+}
+
 UINT Renderable::GetIndexCount() const noexcept
 {
 	return pIndices->GetCount();
@@ -8,15 +8,7 @@ SolidSphere::SolidSphere(Graphics& gfx, float radius)
 	auto sphereMesh = GeometryFactory::CreateSphere<VertexPositionNormal>(radius, 10, 10);
 	sphereMesh.Transform(DirectX::XMMatrixScaling(radius, radius, radius));
 	const auto geometryTag = "$sphere." + std::to_string(radius);
-
-	D3::VertexLayout dynLayout;
-	dynLayout.Append(D3::VertexLayout::Position3D);
-	dynLayout.Append(D3::VertexLayout::Normal);
-	D3::VertexBuffer dynVbuf(std::move(dynLayout));
-	for (const auto& v : sphereMesh.vertices)
-	{
-		dynVbuf.EmplaceBack(v.position, v.normal);
-	}
+	const auto dynVbuf = sphereMesh.MakeVertexBuffer();
 
 	pVertices = VertexBuffer::Resolve(gfx, geometryTag, dynVbuf);
 	pIndices = IndexBuffer::Resolve(gfx, geometryTag, sphereMesh.indices);
@@ -38,8 +30,13 @@ SolidSphere::SolidSphere(Graphics& gfx, float radius)
 	only.AddBindable(InputLayout::Resolve(gfx, dynVbuf.GetLayout(), pvsbc));
 	only.AddBindable(std::make_shared<TransformConstantBuffer>(gfx));
 	only.AddBindable(Rasterizer::Resolve(gfx, false));
+	{
+		auto pivs = VertexShader::Resolve(gfx, "shaders\\Output\\SolidColor_Instanced_VS.cso");
+		auto pil = InputLayout::Resolve(gfx, dynVbuf.GetLayout(), pivs->GetByteCode(), true);
+		only.SetInstancedVariant(std::move(pivs), std::move(pil));
+	}
 
-	solid.AddStep(only);
+	solid.AddStep(std::move(only));
 	AddTechnique(std::move(solid));
 }
 
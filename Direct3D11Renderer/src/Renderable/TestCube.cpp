@@ -1,10 +1,28 @@
 #include "Renderable/TestCube.h"
 #include "Geometry/Cube.h"
 #include "DynamicConstantBuffer/DynamicConstantBuffer.h"
+#include "DynamicConstantBuffer/StaticLayout.h"
+#include "DynamicConstantBuffer/LayoutRegistry.h"
 #include "Bindable/DynamicConstantBufferBindable.h"
 #include "Bindable/BindableCommon.h"
 #include "Bindable/Stencil.h"
 #include "imgui.h"
+#include <utility>
+
+namespace
+{
+	// Compile-time layouts for the cube's constant buffers, mirroring the shader cbuffers
+	// (checked against the generated LayoutRegistry in debug builds)
+	struct SpecularReflectance : D3::StaticMember<D3::ElementType::Float> { static constexpr const char* name = "specularReflectance"; };
+	struct SpecularShininess : D3::StaticMember<D3::ElementType::Float> { static constexpr const char* name = "specularShininess"; };
+	struct MaterialPadding : D3::StaticMember<D3::ElementType::Float2> { static constexpr const char* name = "materialPadding"; };
+	using SpecularLayout = D3::StaticLayout<SpecularReflectance, SpecularShininess, MaterialPadding>;
+
+	struct OutlineColor : D3::StaticMember<D3::ElementType::Float4> { static constexpr const char* name = "outlineColor"; };
+	struct OutlineScale : D3::StaticMember<D3::ElementType::Float> { static constexpr const char* name = "outlineScale"; };
+	struct OutlinePadding : D3::StaticMember<D3::ElementType::Float3> { static constexpr const char* name = "outlinePadding"; };
+	using OutlineLayout = D3::StaticLayout<OutlineColor, OutlineScale, OutlinePadding>;
+}
 
 
 TestCube::TestCube(Graphics& gfx, float size)
@@ -31,15 +49,19 @@ TestCube::TestCube(Graphics& gfx, float size)
 		auto pvsbc = pvs->GetByteCode();
 		only.AddBindable(std::move(pvs));
 		only.AddBindable(PixelShader::Resolve(gfx, "shaders\\Output\\BlinnPhong_Diffuse_PS.cso"));
-		D3::LayoutBuilder layout;
-		layout.Add<D3::ElementType::Float>("specularIntensity");
-		layout.Add<D3::ElementType::Float>("specularPower");
-		auto buffer = D3::ConstantBufferData(std::move(layout));
-		buffer["specularIntensity"] = 0.6f; 
-		buffer["specularPower"] = 30.0f; 
-		only.AddBindable(std::make_shared<CachingDynamicPixelConstantBufferBindable>(gfx, buffer, 1u));
+		assert(SpecularLayout::GetFinalized().GetHash() == D3::LayoutRegistry::Get("BlinnPhong_Diffuse_PS", 1u).GetHash() && "SpecularLayout has drifted from the shader cbuffer");
+		auto buffer = SpecularLayout::MakeBuffer();
+		D3::StaticView<SpecularLayout> params(buffer);
+		params.Get<SpecularReflectance>() = 0.6f;
+		params.Get<SpecularShininess>() = 30.0f;
+		only.AddBindable(std::make_shared<CachingDynamicConstantBufferBindable>(gfx, buffer, 1u));
 		only.AddBindable(InputLayout::Resolve(gfx, model.vertices.GetLayout(), pvsbc));
 		only.AddBindable(std::make_shared<TransformConstantBuffer>(gfx));
+		{
+			auto pivs = VertexShader::Resolve(gfx, "shaders\\Output\\BlinnPhong_Diffuse_Instanced_VS.cso");
+			auto pil = InputLayout::Resolve(gfx, model.vertices.GetLayout(), pivs->GetByteCode(), true);
+			only.SetInstancedVariant(std::move(pivs), std::move(pil));
+		}
 		shade.AddStep(std::move(only));
 	}
 	AddTechnique(std::move(shade));
@@ -53,56 +75,26 @@ TestCube::TestCube(Graphics& gfx, float size)
 
 		mask.AddBindable(InputLayout::Resolve(gfx, model.vertices.GetLayout(), pvsbc));
 		mask.AddBindable(std::make_shared<TransformConstantBuffer>(gfx));
-		outline.AddStep(mask);
+		outline.AddStep(std::move(mask));
 	}
 	{
 		Step draw(2);
-		auto pvs = VertexShader::Resolve(gfx, "shaders\\Output\\SolidColor_VS.cso");
+		auto pvs = VertexShader::Resolve(gfx, "shaders\\Output\\Outline_VS.cso");
 		auto pvsbc = pvs->GetByteCode();
 		draw.AddBindable(std::move(pvs));
-		draw.AddBindable(PixelShader::Resolve(gfx, "shaders\\Output\\SolidColor_PS.cso"));
-
-		D3::LayoutBuilder layout;
-		layout.Add<D3::ElementType::Float4>("color");
-		auto buffer = D3::ConstantBufferData(std::move(layout));
-		buffer["color"] = DirectX::XMFLOAT4{ 1.0f, 0.4f, 1.0f, 1.0f };
-		draw.AddBindable(std::make_shared<CachingDynamicPixelConstantBufferBindable>(gfx, buffer, 1u));
+		draw.AddBindable(PixelShader::Resolve(gfx, "shaders\\Output\\Outline_PS.cso"));
+
+		// The vertex shader reads the scale and the pixel shader the color, so the buffer is bound to
+		// both stages and uploaded once when either changes
+		assert(OutlineLayout::GetFinalized().GetHash() == D3::LayoutRegistry::Get("Outline_VS", 1u).GetHash() && "OutlineLayout has drifted from the shader cbuffer");
+		auto buffer = OutlineLayout::MakeBuffer();
+		D3::StaticView<OutlineLayout> params(buffer);
+		params.Get<OutlineColor>() = DirectX::XMFLOAT4{ 1.0f, 0.4f, 1.0f, 1.0f };
+		params.Get<OutlineScale>() = 1.04f;
+		draw.AddBindable(std::make_shared<CachingDynamicConstantBufferBindable>(gfx, buffer, 1u, ShaderStage::Both));
 		draw.AddBindable(InputLayout::Resolve(gfx, model.vertices.GetLayout(), pvsbc));
-		class TransformConstantBufferScaling : public TransformConstantBuffer
-		{
-		public:
-			TransformConstantBufferScaling(Graphics& gfx, float scale = 1.04f)
-				: TransformConstantBuffer(gfx), buffer(MakeLayout()) 
-			{
-				buffer["scale"] = scale;
-			}
-
-			void Accept(TechniqueProbe& probe) override
-			{
-				probe.VisitBuffer(buffer);
-			}
-
-			void Bind(Graphics& gfx) noexcept override
-			{
-				const auto scale = buffer["scale"];
-				const auto scaleMatrix = DirectX::XMMatrixScaling(scale, scale, scale);
-				auto xf = GetTransformBuffer(gfx);
-				xf.modelView = xf.modelView * scaleMatrix;
-				xf.modelViewProj = xf.modelViewProj * scaleMatrix;
-				UpdateBindImpl(gfx, xf);
-			}
-
-		private:
-			static D3::LayoutBuilder MakeLayout()
-			{
-				D3::LayoutBuilder layout;
-				layout.Add<D3::ElementType::Float>("scale");
-				return layout;
-			}
-			D3::ConstantBufferData buffer;
-		};
-		draw.AddBindable(std::make_shared<TransformConstantBufferScaling>(gfx));
-		outline.AddStep(draw);
+		draw.AddBindable(std::make_shared<TransformConstantBuffer>(gfx));
+		outline.AddStep(std::move(draw));
 	}
 	AddTechnique(std::move(outline));
 }
@@ -141,6 +133,11 @@ void TestCube::SpawnControlWindow(Graphics& gfx, const char* name) noexcept
 		class Probe : public TechniqueProbe
 		{
 		public:
+			Probe(std::vector<ProbeHandles>& handles)
+				:
+				handles(handles)
+			{}
+
 			void OnSetTechnique() override
 			{
 				ImGui::TextColored({ 0.4f, 1.0f, 0.6f, 1.0f }, pTechnique->GetName().c_str());
@@ -152,41 +149,49 @@ void TestCube::SpawnControlWindow(Graphics& gfx, const char* name) noexcept
 			bool OnVisitBuffer(D3::ConstantBufferData& buffer) override
 			{
 				bool dirty = false;
-				const auto dCheck = [&dirty](bool changed) {dirty = dirty || changed; };
 				auto tag = [tagScratch = std::string{}, tagString = "##" + std::to_string(bufferIdx)](const char* label) mutable
 				{
 					tagScratch = std::string(label) + tagString;
 					return tagScratch.c_str();
 				};
-
-				if (auto v = buffer["scale"]; v.Exists())
+				// reads go through the const buffer so only an actual edit marks it dirty
+				const auto edit = [&](const D3::ElementHandle& handle, auto value, auto&& widget)
 				{
-					float scaleValue = v;  
-					dCheck(ImGui::SliderFloat(tag("Scale"), &scaleValue, 1.0f, 2.0f, "%.3f"));
-					v = scaleValue; 
-				}
-				if(auto v = buffer["color"]; v.Exists())
-				{
-					DirectX::XMFLOAT4 colorValue = v; 
-					dCheck(ImGui::ColorPicker4(tag("Color"), reinterpret_cast<float*>(&colorValue)));
-					v = colorValue; 
-				}
-				if(auto v = buffer["specularIntensity"]; v.Exists())
+					if (handle.Exists())
+					{
+						value = std::as_const(buffer).Get<decltype(value)>(handle);
+						if (widget(&value))
+						{
+							buffer.Set(handle, value);
+							dirty = true;
+						}
+					}
+				};
+
+				if (handles.size() <= bufferIdx)
 				{
-					float specularIntensityValue = v; 
-					dCheck(ImGui::SliderFloat(tag("Specular Intensity"), &specularIntensityValue, 0.0f, 1.0f));
-					v = specularIntensityValue; 
+					handles.resize(bufferIdx + 1u);
 				}
-				if(auto v = buffer["specularPower"]; v.Exists())
+				auto& h = handles[bufferIdx];
+				if (h.pRoot != &buffer.GetRootLayout())
 				{
-					float specularPowerValue = v; 
-					dCheck(ImGui::SliderFloat(tag("Glossiness"), &specularPowerValue, 1.0f, 100.0f, "%.1f", 1.5f));
-					v = specularPowerValue; 
+					h.pRoot = &buffer.GetRootLayout();
+					h.outlineScale = buffer.Resolve("outlineScale");
+					h.outlineColor = buffer.Resolve("outlineColor");
+					h.specularReflectance = buffer.Resolve("specularReflectance");
+					h.specularShininess = buffer.Resolve("specularShininess");
 				}
 
+				edit(h.outlineScale, 0.0f, [&](float* pValue) { return ImGui::SliderFloat(tag("Scale"), pValue, 1.0f, 2.0f, "%.3f"); });
+				edit(h.outlineColor, DirectX::XMFLOAT4{}, [&](DirectX::XMFLOAT4* pValue) { return ImGui::ColorPicker4(tag("Color"), &pValue->x); });
+				edit(h.specularReflectance, 0.0f, [&](float* pValue) { return ImGui::SliderFloat(tag("Specular Intensity"), pValue, 0.0f, 1.0f); });
+				edit(h.specularShininess, 0.0f, [&](float* pValue) { return ImGui::SliderFloat(tag("Glossiness"), pValue, 1.0f, 100.0f, "%.1f", 1.5f); });
+
 				return dirty;
 			}
-		} probe;
+		private:
+			std::vector<ProbeHandles>& handles;
+		} probe{ probeHandles };
 
 		Accept(probe);
 	}
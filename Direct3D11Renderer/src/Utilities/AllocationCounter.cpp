@@ -0,0 +1,62 @@
+#include "Utilities/AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _DEBUG
+namespace
+{
+	std::atomic<size_t> allocationCount = 0u;
+
+	void* CountedAllocate(size_t size)
+	{
+		allocationCount.fetch_add(1u, std::memory_order_relaxed);
+		if (void* p = std::malloc(size == 0u ? 1u : size))
+		{
+			return p;
+		}
+		throw std::bad_alloc();
+	}
+}
+
+// the nothrow forms forward to these in the standard library
+void* operator new(size_t size)
+{
+	return CountedAllocate(size);
+}
+
+void* operator new[](size_t size)
+{
+	return CountedAllocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+size_t AllocationCounter::GetCount() noexcept
+{
+	return allocationCount.load(std::memory_order_relaxed);
+}
+#else
+size_t AllocationCounter::GetCount() noexcept
+{
+	return 0u;
+}
+#endif
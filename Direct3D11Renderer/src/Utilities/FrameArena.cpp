@@ -0,0 +1,61 @@
+#include "Utilities/FrameArena.h"
+#include <cassert>
+#include <cstdint>
+
+FrameArena::FrameArena(size_t bytesPerFrame)
+{
+	for (auto& buffer : buffers)
+	{
+		buffer.memory = std::make_unique<std::byte[]>(bytesPerFrame);
+		buffer.capacity = bytesPerFrame;
+	}
+}
+
+void FrameArena::BeginFrame()
+{
+	current = (current + 1u) % buffers.size();
+	auto& buffer = buffers[current];
+	if (buffer.overflowBytes > 0u)
+	{
+		// grow once so the frame that overflowed fits in a single block from now on
+		const auto capacity = buffer.capacity + buffer.overflowBytes;
+		buffer.overflow.clear();
+		buffer.overflowBytes = 0u;
+		buffer.memory = std::make_unique<std::byte[]>(capacity);
+		buffer.capacity = capacity;
+	}
+	buffer.offset = 0u;
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+	assert((alignment & (alignment - 1u)) == 0u && "Arena alignment must be a power of two");
+	auto& buffer = buffers[current];
+
+	const auto base = reinterpret_cast<uintptr_t>(buffer.memory.get());
+	const auto aligned = (base + buffer.offset + alignment - 1u) & ~uintptr_t(alignment - 1u);
+	const auto end = size_t(aligned - base) + size;
+	if (end <= buffer.capacity)
+	{
+		buffer.offset = end;
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	// out of space for this frame, the padding makes sure the block can be aligned by hand
+	const auto blockSize = size + alignment;
+	buffer.overflow.push_back(std::make_unique<std::byte[]>(blockSize));
+	buffer.overflowBytes += blockSize;
+	const auto blockBase = reinterpret_cast<uintptr_t>(buffer.overflow.back().get());
+	return reinterpret_cast<void*>((blockBase + alignment - 1u) & ~uintptr_t(alignment - 1u));
+}
+
+size_t FrameArena::GetUsedBytes() const noexcept
+{
+	const auto& buffer = buffers[current];
+	return buffer.offset + buffer.overflowBytes;
+}
+
+size_t FrameArena::GetCapacity() const noexcept
+{
+	return buffers[current].capacity;
+}
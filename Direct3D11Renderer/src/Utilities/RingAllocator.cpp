@@ -0,0 +1,59 @@
+#include "Utilities/RingAllocator.h"
+#include <cassert>
+
+RingAllocator::RingAllocator(size_t capacity, size_t alignment) noexcept
+	:
+	capacity(capacity),
+	alignment(alignment),
+	head(capacity)
+{
+	assert(alignment > 0u && (alignment & (alignment - 1u)) == 0u && "Ring alignment must be a power of two");
+	assert(capacity % alignment == 0u && "Ring capacity must be a multiple of its alignment");
+}
+
+std::optional<RingAllocator::Allocation> RingAllocator::Allocate(size_t size) noexcept
+{
+	const auto alignedSize = (size + alignment - 1u) & ~(alignment - 1u);
+	if (alignedSize == 0u || alignedSize > capacity)
+	{
+		return std::nullopt;
+	}
+
+	// head is always aligned since every allocation is rounded up to the alignment
+	bool discard = false;
+	if (alignedSize > capacity - head)
+	{
+		head = 0u;
+		discard = true;
+		generations++;
+	}
+
+	const Allocation allocation{ head, alignedSize, discard };
+	head += alignedSize;
+	return allocation;
+}
+
+void RingAllocator::Reset() noexcept
+{
+	head = capacity;
+}
+
+size_t RingAllocator::GetHead() const noexcept
+{
+	return head;
+}
+
+size_t RingAllocator::GetCapacity() const noexcept
+{
+	return capacity;
+}
+
+size_t RingAllocator::GetAlignment() const noexcept
+{
+	return alignment;
+}
+
+size_t RingAllocator::GetGenerationCount() const noexcept
+{
+	return generations;
+}
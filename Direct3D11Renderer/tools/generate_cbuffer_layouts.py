@@ -0,0 +1,445 @@
+#!/usr/bin/env python3
+"""Generates the constant buffer layout registry from the HLSL shader sources.
+
+Every shader in shaders/*.hlsl is preprocessed (#include, #define, #ifdef/#ifndef/#else/#endif)
+and its cbuffer declarations are packed with the same rules as LayoutElement::Finalize. The
+result is written to src/DynamicConstantBuffer/GeneratedLayouts.cpp as flat record tables that
+LayoutRegistry turns into finalized layouts at startup, so C++ code no longer has to repeat
+the cbuffer structure by hand.
+
+The dynamic constant buffer system pads arrays and nested structs to a whole number of
+16-byte registers, while HLSL lets a following scalar pack into the unused tail. Any cbuffer
+where the two disagree is rejected with an error instead of producing a layout that silently
+differs from what the shader reads; add explicit padding members to such cbuffers.
+
+Usage:
+    python3 tools/generate_cbuffer_layouts.py           regenerate (only writes on change)
+    python3 tools/generate_cbuffer_layouts.py --check   exit 1 if the generated file is stale
+
+Only the Python standard library is used, so the generator runs the same on Windows
+(pre-build step of the Visual Studio project) and on Linux CI.
+"""
+
+import argparse
+import re
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+DEFAULT_SHADERS = ROOT / "shaders"
+DEFAULT_OUTPUT = ROOT / "src" / "DynamicConstantBuffer" / "GeneratedLayouts.cpp"
+
+# HLSL type name -> (ElementType enumerator, size in bytes)
+PRIMITIVES = {
+    "float": ("Float", 4),
+    "float1": ("Float", 4),
+    "float2": ("Float2", 8),
+    "float3": ("Float3", 12),
+    "float4": ("Float4", 16),
+    "float4x4": ("Matrix4x4", 64),
+    "matrix": ("Matrix4x4", 64),
+    "bool": ("Bool", 4),
+}
+
+# modifiers that do not change the packed layout
+IGNORED_MODIFIERS = {"row_major", "column_major", "uniform", "precise", "const"}
+
+
+class LayoutError(Exception):
+    """Raised for shader constructs the generator (or the runtime layout system) cannot represent."""
+
+
+# ---------------------------------------------------------------------------------------------
+# Preprocessing
+# ---------------------------------------------------------------------------------------------
+
+COMMENT_RE = re.compile(r"//[^\n]*|/\*.*?\*/", re.DOTALL)
+INCLUDE_RE = re.compile(r'#\s*include\s+"([^"]+)"')
+DIRECTIVE_RE = re.compile(r"#\s*(\w+)\s*(\w*)")
+
+
+def strip_comments(text):
+    # keep newlines of block comments so error line numbers stay meaningful
+    return COMMENT_RE.sub(lambda m: "\n" * m.group(0).count("\n"), text)
+
+
+def preprocess(path, defines, included):
+    """Expands includes (each file once, like the include guards in shaders/Common) and
+    evaluates #ifdef/#ifndef/#else/#endif. Macro values are not substituted."""
+    path = path.resolve()
+    if path in included:
+        return ""
+    included.add(path)
+
+    out = []
+    active = [True]
+    for number, line in enumerate(strip_comments(path.read_text(encoding="utf-8")).splitlines(), 1):
+        stripped = line.strip()
+        if not stripped.startswith("#"):
+            if all(active):
+                out.append(line)
+            continue
+
+        include = INCLUDE_RE.match(stripped)
+        directive = DIRECTIVE_RE.match(stripped)
+        name, arg = directive.groups() if directive else ("", "")
+        if include:
+            if all(active):
+                target = path.parent / include.group(1)
+                if not target.exists():
+                    raise LayoutError(f"{path.name}:{number}: include not found: {include.group(1)}")
+                out.append(preprocess(target, defines, included))
+        elif name in ("ifdef", "ifndef"):
+            active.append((arg in defines) == (name == "ifdef"))
+        elif name == "else":
+            if len(active) == 1:
+                raise LayoutError(f"{path.name}:{number}: #else without #if")
+            active[-1] = not active[-1]
+        elif name == "endif":
+            if len(active) == 1:
+                raise LayoutError(f"{path.name}:{number}: #endif without #if")
+            active.pop()
+        elif name == "define":
+            if all(active):
+                defines.add(arg)
+        elif name == "undef":
+            if all(active):
+                defines.discard(arg)
+        elif name in ("if", "elif"):
+            raise LayoutError(f"{path.name}:{number}: #{name} is not supported, use #ifdef/#ifndef")
+        # other directives (#pragma, ...) do not affect declarations
+    if len(active) != 1:
+        raise LayoutError(f"{path.name}: unterminated #ifdef/#ifndef")
+    return "\n".join(out)
+
+
+# ---------------------------------------------------------------------------------------------
+# Parsing
+# ---------------------------------------------------------------------------------------------
+
+TOKEN_RE = re.compile(r"\s*(?:(\w+)|(.))", re.DOTALL)
+
+
+def tokenize(text):
+    tokens = []
+    for m in TOKEN_RE.finditer(text):
+        token = m.group(1) or m.group(2)
+        if token and not token.isspace():
+            tokens.append(token)
+    return tokens
+
+
+class Node:
+    """Parsed layout element: kind is 'leaf', 'struct' or 'array'."""
+
+    def __init__(self, kind, name, type_name=None, size=0, members=None, element=None, count=0):
+        self.kind = kind
+        self.name = name
+        self.type_name = type_name
+        self.size = size
+        self.members = members or []
+        self.element = element
+        self.count = count
+        self.offset = None
+
+
+def parse_members(tokens, pos, structs, context):
+    """Parses declarations up to the closing brace; returns (members, position after '}')."""
+    members = []
+    while tokens[pos] != "}":
+        while tokens[pos] in IGNORED_MODIFIERS:
+            pos += 1
+        type_name = tokens[pos]
+        pos += 1
+        if type_name == "matrix" and tokens[pos] == "<":
+            # matrix<float, 4, 4>
+            spec = []
+            while tokens[pos] != ">":
+                pos += 1
+                spec.append(tokens[pos])
+            pos += 1
+            if spec[:-1] != ["float", ",", "4", ",", "4"]:
+                raise LayoutError(f"{context}: unsupported matrix type matrix<{''.join(spec[:-1])}>")
+        while True:
+            name = tokens[pos]
+            pos += 1
+            count = 0
+            if tokens[pos] == "[":
+                count = int(tokens[pos + 1])
+                if tokens[pos + 2] != "]" or count <= 0:
+                    raise LayoutError(f"{context}: invalid array size for '{name}'")
+                pos += 3
+            if tokens[pos] == ":":
+                if tokens[pos + 1] == "packoffset":
+                    raise LayoutError(f"{context}: packoffset on '{name}' is not supported")
+                pos += 2  # semantic, only present on struct members
+            members.append(make_node(type_name, name, count, structs, context))
+            if tokens[pos] == ",":
+                pos += 1
+                continue
+            if tokens[pos] != ";":
+                raise LayoutError(f"{context}: expected ';' after '{name}', found '{tokens[pos]}'")
+            pos += 1
+            break
+    return members, pos + 1
+
+
+def make_node(type_name, name, count, structs, context):
+    if type_name in PRIMITIVES:
+        element_type, size = PRIMITIVES[type_name]
+        element = Node("leaf", "", type_name=element_type, size=size)
+    elif type_name in structs:
+        element = clone(structs[type_name])
+    else:
+        raise LayoutError(f"{context}: member '{name}' has unsupported type '{type_name}'")
+    if count:
+        return Node("array", name, element=element, count=count)
+    element.name = name
+    return element
+
+
+def clone(node):
+    copy = Node(node.kind, node.name, node.type_name, node.size,
+                [clone(m) for m in node.members], clone(node.element) if node.element else None, node.count)
+    return copy
+
+
+def parse_cbuffers(text, shader):
+    """Returns [(cbuffer name, slot or None, root Node)] for one preprocessed shader."""
+    tokens = tokenize(text) + ["<eof>"]
+    structs = {}
+    cbuffers = []
+    depth = 0
+    pos = 0
+    while tokens[pos] != "<eof>":
+        token = tokens[pos]
+        if token == "{":
+            depth += 1
+        elif token == "}":
+            depth -= 1
+        elif depth == 0 and token == "struct" and tokens[pos + 2] == "{":
+            name = tokens[pos + 1]
+            context = f"{shader}: struct {name}"
+            try:
+                members, pos = parse_members(tokens, pos + 3, structs, context)
+                structs[name] = Node("struct", "", members=members)
+            except LayoutError:
+                # structs with unsupported members are fine as long as no cbuffer uses them
+                # (e.g. vertex input structs with uint or int fields)
+                pos = skip_block(tokens, pos + 2)
+            continue
+        elif depth == 0 and token == "cbuffer":
+            name = tokens[pos + 1]
+            pos += 2
+            slot = None
+            if tokens[pos] == ":":
+                # : register(bN)
+                register = tokens[pos + 3]
+                if not re.fullmatch(r"b\d+", register):
+                    raise LayoutError(f"{shader}: cbuffer {name} has invalid register '{register}'")
+                slot = int(register[1:])
+                pos += 5
+            if tokens[pos] != "{":
+                raise LayoutError(f"{shader}: expected '{{' after cbuffer {name}")
+            members, pos = parse_members(tokens, pos + 1, structs, f"{shader}: cbuffer {name}")
+            if not members:
+                raise LayoutError(f"{shader}: cbuffer {name} is empty")
+            cbuffers.append((name, slot, Node("struct", "", members=members)))
+            continue
+        pos += 1
+    return cbuffers
+
+
+def skip_block(tokens, pos):
+    """Skips a balanced {...} block starting at tokens[pos] == '{'."""
+    depth = 0
+    while True:
+        if tokens[pos] == "{":
+            depth += 1
+        elif tokens[pos] == "}":
+            depth -= 1
+            if depth == 0:
+                return pos + 1
+        pos += 1
+
+
+# ---------------------------------------------------------------------------------------------
+# Packing
+# ---------------------------------------------------------------------------------------------
+
+def advance_to_boundary(offset):
+    return offset + (16 - offset % 16) % 16
+
+
+def crosses_boundary(offset, size):
+    end = offset + size
+    return (offset // 16 != end // 16 and end % 16 != 0) or size > 16
+
+
+def runtime_size(node):
+    """Mirror of LayoutElement::GetSize."""
+    if node.kind == "leaf":
+        return node.size
+    if node.kind == "struct":
+        last = node.members[-1]
+        return advance_to_boundary(last.offset + runtime_size(last)) - node.offset
+    return advance_to_boundary(runtime_size(node.element)) * node.count
+
+
+def finalize(node, start):
+    """Mirror of LayoutElement::Finalize; assigns node.offset and returns the next offset."""
+    if node.kind == "leaf":
+        node.offset = advance_to_boundary(start) if crosses_boundary(start, node.size) else start
+        return node.offset + node.size
+    node.offset = advance_to_boundary(start)
+    if node.kind == "struct":
+        current = node.offset
+        for member in node.members:
+            current = finalize(member, current)
+        return current
+    finalize(node.element, node.offset)
+    return node.offset + runtime_size(node)
+
+
+def hlsl_pack(node, start, offsets):
+    """Reference HLSL packing (as fxc does it); appends member offsets in pre-order."""
+    if node.kind == "leaf":
+        offset = advance_to_boundary(start) if crosses_boundary(start, node.size) else start
+        offsets.append(offset)
+        return offset + node.size
+    offset = advance_to_boundary(start)
+    offsets.append(offset)
+    if node.kind == "struct":
+        current = offset
+        for member in node.members:
+            current = hlsl_pack(member, current, offsets)
+        # a struct forces the next variable onto a new register
+        return advance_to_boundary(current)
+    span = hlsl_pack(node.element, offset, offsets) - offset
+    # every element starts a new register, the last one is not padded
+    return offset + advance_to_boundary(span) * (node.count - 1) + span
+
+
+def walk(node, path=""):
+    yield path or "<root>", node
+    if node.kind == "struct":
+        for member in node.members:
+            yield from walk(member, f"{path}.{member.name}" if path else member.name)
+    elif node.kind == "array":
+        yield from walk(node.element, f"{path}[0]")
+
+
+def pack(root, context):
+    """Finalizes the layout and checks it against HLSL packing; returns the cbuffer size."""
+    runtime_end = finalize(root, 0)
+    expected = []
+    hlsl_end = hlsl_pack(root, 0, expected)
+    for (path, node), offset in zip(walk(root), expected):
+        if node.offset != offset:
+            raise LayoutError(f"{context}: '{path}' is at byte {offset} in HLSL but the dynamic layout "
+                              f"system would place it at {node.offset}; add explicit padding")
+    size = advance_to_boundary(runtime_end)
+    if size != advance_to_boundary(hlsl_end) or size != runtime_size(root):
+        raise LayoutError(f"{context}: cbuffer size differs between HLSL and the dynamic layout system")
+    return size
+
+
+# ---------------------------------------------------------------------------------------------
+# Emission
+# ---------------------------------------------------------------------------------------------
+
+def records(node, name=""):
+    """Flattens a finalized layout in pre-order as (type, name, offset, count) records."""
+    if node.kind == "leaf":
+        return [(node.type_name, name, node.offset, 0)]
+    if node.kind == "struct":
+        result = [("Struct", name, node.offset, len(node.members))]
+        for member in node.members:
+            result += records(member, member.name)
+        return result
+    return [("Array", name, node.offset, node.count)] + records(node.element)
+
+
+def generate(shaders_dir):
+    tables = []         # unique record tables, in first-use order
+    table_index = {}    # tuple(records) -> index into tables
+    layouts = []        # (shader, cbuffer, slot, size, table index)
+    for path in sorted(shaders_dir.glob("*.hlsl")):
+        shader = path.stem
+        for name, slot, root in parse_cbuffers(preprocess(path, set(), set()), path.name):
+            size = pack(root, f"{path.name}: cbuffer {name}")
+            table = tuple(records(root))
+            if table not in table_index:
+                table_index[table] = len(tables)
+                tables.append((table, f"{name} ({size} bytes)"))
+            layouts.append((shader, name, slot, size, table_index[table]))
+
+    lines = [
+        "// Generated by tools/generate_cbuffer_layouts.py from shaders/*.hlsl - do not edit.",
+        "// Rerun the generator (also done by the pre-build step) after changing a cbuffer.",
+        "",
+        '#include "DynamicConstantBuffer/LayoutRegistry.h"',
+        "",
+        "namespace D3",
+        "{",
+        "    namespace GeneratedLayouts",
+        "    {",
+        "        // Pre-order element records: Struct count = member count, Array count = element count",
+        "        const LayoutRecord records[] = {",
+    ]
+    first_record = []
+    total = 0
+    for table, comment in tables:
+        first_record.append(total)
+        lines.append(f"            // [{total}] {comment}")
+        for element_type, name, offset, count in table:
+            lines.append(f'            {{ ElementType::{element_type}, "{name}", {offset}u, {count}u }},')
+        total += len(table)
+    lines += [
+        "        };",
+        "",
+        "        const GeneratedLayout layouts[] = {",
+    ]
+    for shader, name, slot, size, index in layouts:
+        slot_text = str(slot) if slot is not None else "-1"
+        lines.append(f'            {{ "{shader}", "{name}", {slot_text}, {size}u, {first_record[index]}u }},')
+    lines += [
+        "        };",
+        "",
+        "        const size_t layoutCount = sizeof(layouts) / sizeof(layouts[0]);",
+        "    }",
+        "}",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--shaders", type=Path, default=DEFAULT_SHADERS, help="directory containing *.hlsl")
+    parser.add_argument("--output", type=Path, default=DEFAULT_OUTPUT, help="generated C++ source file")
+    parser.add_argument("--check", action="store_true", help="fail if the output is out of date instead of writing it")
+    args = parser.parse_args()
+
+    try:
+        text = generate(args.shaders)
+    except LayoutError as error:
+        print(f"error: {error}", file=sys.stderr)
+        return 1
+
+    current = args.output.read_text(encoding="utf-8") if args.output.exists() else None
+    if current == text:
+        return 0
+    if args.check:
+        print(f"error: {args.output} is out of date with the shader cbuffers; "
+              f"rerun tools/generate_cbuffer_layouts.py", file=sys.stderr)
+        return 1
+    # newline="\n" keeps the file byte-identical between Windows and Linux runs
+    with open(args.output, "w", encoding="utf-8", newline="\n") as file:
+        file.write(text)
+    print(f"wrote {args.output}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())